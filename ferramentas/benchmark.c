@@ -0,0 +1,822 @@
+/**
+ * @file benchmark.c
+ * @brief Medições de desempenho das estruturas de dados do Detective Quest.
+ *
+ * Cada caso mede uma operação das estruturas usadas pelos três níveis sobre
+ * dados sintéticos de 10 a 10^7 elementos (potências de 10), com os
+ * identificadores em ordem crescente ou embaralhados por uma semente fixa:
+ *
+ *   inserirPista       inserção na AVL de pistas (pistas.h)
+ *   listarPistas       percurso em ordem da AVL, o mesmo de exibirPistas() sem o printf
+ *   construirPistas    a mesma AVL montada de uma vez com construirPistas(), por pista
+ *   mesclarPistas      mesclarPistas() de duas AVLs com metade das pistas cada, que
+ *                      dividem um quarto delas (a união tem 3/4 das pistas), por pista
+ *   inserirConjunto    inserção no conjunto de pistas de uma sessão (conjunto.h)
+ *   listarConjunto     percurso em ordem desse conjunto (listarConjuntoPistas())
+ *   unirConjuntos      conjuntoUnir() de dois conjuntos divididos como em mesclarPistas
+ *   consultarEsparso   consulta ao conjunto esparso de salas coletadas (filtro.h), com
+ *                      metade dos ids presente: o filtro de Bloom recusa a outra metade
+ *   calcularHash       hash dos textos de pista (internador.h)
+ *   inserirNaHash      inserção na tabela pista -> suspeito (suspeitos.h)
+ *   encontrarSuspeito  consulta a essa tabela
+ *   contagemSuspeito   pistas contra um suspeito pelo nome, como em sessaoAcusar()
+ *                      (substitui o antigo contarPistasParaSuspeito)
+ *   montarMapa         criarSala() + ligarSalas() + mapaFinalizar(), por sala
+ *   liberarMapa        liberação de um mapa inteiro, por chamada
+ *
+ * Cada combinação (caso, ordem, n) roda em um processo filho, para que o pico
+ * de memória (ru_maxrss, que inclui os dados de entrada gerados) seja só dela.
+ * O filho repete a medição e informa o menor e o mediano tempo por operação;
+ * casos pequenos repetem a operação até somar BENCHMARK_OPERACOES_RODADA.
+ * As alocações (malloc/calloc/realloc feitos pelas estruturas) são contadas
+ * envolvendo essas funções na ligação, e não dependem do tempo: com a mesma
+ * semente, o número é sempre o mesmo.
+ *
+ * A saída é uma tabela TSV. Com --base, cada linha é comparada à de uma
+ * execução anterior e o programa termina com falha se o tempo mínimo crescer
+ * mais que a tolerância ou se houver mais alocações, o que permite usá-lo como
+ * portão de regressão. Para resultados estáveis, fixe a CPU (ex.: taskset -c 2).
+ *
+ * Compilado pelo CMake como o alvo "benchmark" (use a configuração Release).
+ * Uso: benchmark [--min N] [--max N] [--repeticoes R] [--semente S] [--caso nome]
+ *                [--base medicoes.tsv] [--tolerancia P]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// --- Contagem de Alocações ---
+
+// Chamadas a malloc/calloc/realloc desde o início do processo
+static unsigned long long benchmarkAlocacoes;
+
+// O alvo é ligado com --wrap=malloc,--wrap=calloc,--wrap=realloc (CMakeLists.txt):
+// as chamadas da biblioteca e deste arquivo chegam aqui, e __real_* são as originais
+void *__real_malloc(size_t tamanho);
+void *__real_calloc(size_t quantidade, size_t tamanho);
+void *__real_realloc(void *memoria, size_t tamanho);
+void *__wrap_malloc(size_t tamanho);
+void *__wrap_calloc(size_t quantidade, size_t tamanho);
+void *__wrap_realloc(void *memoria, size_t tamanho);
+
+void *__wrap_malloc(size_t tamanho) {
+    benchmarkAlocacoes++;
+    return __real_malloc(tamanho);
+}
+
+void *__wrap_calloc(size_t quantidade, size_t tamanho) {
+    benchmarkAlocacoes++;
+    return __real_calloc(quantidade, tamanho);
+}
+
+void *__wrap_realloc(void *memoria, size_t tamanho) {
+    benchmarkAlocacoes++;
+    return __real_realloc(memoria, tamanho);
+}
+
+#include "arena.h"
+#include "conjunto.h"
+#include "filtro.h"
+#include "internador.h"
+#include "mapa.h"
+#include "motor.h"
+#include "pistas.h"
+#include "suspeitos.h"
+
+// --- Constantes do Benchmark ---
+#define BENCHMARK_OPERACOES_RODADA 1000000 // Operações mínimas por repetição
+#define BENCHMARK_REPETICOES       5
+#define BENCHMARK_SEMENTE          20240601u
+#define BENCHMARK_TOLERANCIA       15.0    // Em porcentagem do tempo mínimo
+#define BENCHMARK_SUSPEITOS        64
+#define BENCHMARK_TEXTO            20      // Espaço de cada texto gerado (com o '\0')
+#define BENCHMARK_REPETICOES_MAXIMO 101
+
+// --- Estruturas ---
+
+// Entrada sintética de uma medição; os textos só são gerados para os casos que os usam
+typedef struct Dados {
+    uint32_t n;
+    uint32_t *ids;        // Permutação de 0..n-1 (crescente ou embaralhada)
+    char *pistas;         // Texto da pista de cada id, BENCHMARK_TEXTO bytes cada
+    char *salas;          // Nome da sala de cada posição, BENCHMARK_TEXTO bytes cada
+    char suspeitos[BENCHMARK_SUSPEITOS][BENCHMARK_TEXTO];
+    uint64_t rodadas;     // Quantas vezes o caso repete a operação sobre os n elementos
+} Dados;
+
+// Mede uma repetição completa; devolve os nanossegundos gastos só na parte medida
+typedef uint64_t (*FuncaoCaso)(Dados *dados);
+
+typedef struct CasoBenchmark {
+    const char *nome;
+    const char *unidade; // O que é uma operação no tempo reportado
+    int usaTextos;
+    int porChamada;      // 1 quando a operação é uma por rodada, e não uma por elemento
+    FuncaoCaso medir;
+} CasoBenchmark;
+
+// Resultado enviado do processo filho para o pai
+typedef struct Medicao {
+    double nsMinimo;
+    double nsMediano;
+    double alocacoes;    // Por rodada
+    long picoKb;
+    int ok;
+} Medicao;
+
+// Resultado de referência lido de --base
+typedef struct LinhaBase {
+    char caso[32];
+    char ordem[16];
+    unsigned long n;
+    double nsMinimo;
+    double alocacoes;
+} LinhaBase;
+
+// Impede que o compilador elimine os laços medidos
+static volatile uint64_t benchmarkSumidouro;
+
+// --- Utilitários ---
+
+static uint64_t agoraNs(void) {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return (uint64_t)instante.tv_sec * 1000000000u + (uint64_t)instante.tv_nsec;
+}
+
+/**
+ * @brief Gerador xorshift64*: determinístico para a mesma semente em qualquer plataforma.
+ */
+static uint64_t proximoAleatorio(uint64_t *estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 2685821657736338717ull;
+}
+
+static void *reservarDados(size_t tamanho) {
+    void *memoria = malloc(tamanho > 0 ? tamanho : 1);
+    if (memoria == NULL) {
+        printf("Erro de alocação de memória para o Benchmark!\n");
+        exit(EXIT_FAILURE);
+    }
+    return memoria;
+}
+
+static const char *textoPista(const Dados *dados, uint32_t id) {
+    return dados->pistas + (size_t)id * BENCHMARK_TEXTO;
+}
+
+static const char *nomeSala(const Dados *dados, uint32_t posicao) {
+    return dados->salas + (size_t)posicao * BENCHMARK_TEXTO;
+}
+
+/**
+ * @brief Gera os ids (embaralhados por Fisher-Yates, se pedido) e, opcionalmente, os textos.
+ */
+static void gerarDados(Dados *dados, uint32_t n, int embaralhar, uint64_t semente, int usaTextos) {
+    memset(dados, 0, sizeof(Dados));
+    dados->n = n;
+    dados->ids = (uint32_t*)reservarDados((size_t)n * sizeof(uint32_t));
+    for (uint32_t i = 0; i < n; i++) {
+        dados->ids[i] = i;
+    }
+    if (embaralhar) {
+        uint64_t estado = semente ? semente : 1;
+        for (uint32_t i = n; i > 1; i--) {
+            uint32_t j = (uint32_t)(proximoAleatorio(&estado) % i);
+            uint32_t temp = dados->ids[i - 1];
+            dados->ids[i - 1] = dados->ids[j];
+            dados->ids[j] = temp;
+        }
+    }
+    if (usaTextos) {
+        // Zeros à esquerda: a ordem dos textos é a ordem dos ids
+        dados->pistas = (char*)reservarDados((size_t)n * BENCHMARK_TEXTO);
+        dados->salas = (char*)reservarDados((size_t)n * BENCHMARK_TEXTO);
+        for (uint32_t i = 0; i < n; i++) {
+            snprintf(dados->pistas + (size_t)i * BENCHMARK_TEXTO, BENCHMARK_TEXTO, "pista %08u", i);
+            snprintf(dados->salas + (size_t)i * BENCHMARK_TEXTO, BENCHMARK_TEXTO, "sala %08u", i);
+        }
+    }
+    for (uint32_t s = 0; s < BENCHMARK_SUSPEITOS; s++) {
+        snprintf(dados->suspeitos[s], BENCHMARK_TEXTO, "suspeito %02u", s);
+    }
+    dados->rodadas = n >= BENCHMARK_OPERACOES_RODADA ? 1 : (BENCHMARK_OPERACOES_RODADA + n - 1) / n;
+}
+
+static void liberarDados(Dados *dados) {
+    free(dados->ids);
+    free(dados->pistas);
+    free(dados->salas);
+}
+
+// --- Montagens Auxiliares (fora da parte medida) ---
+
+static PistaNode *montarArvore(const Dados *dados, PoolNos *pool) {
+    PistaNode *raiz = NULL;
+    for (uint32_t i = 0; i < dados->n; i++) {
+        raiz = inserirPista(pool, raiz, dados->ids[i]);
+    }
+    return raiz;
+}
+
+static void montarHash(const Dados *dados, SuspeitoHash *sh, PlacarSuspeitos *placar) {
+    for (uint32_t i = 0; i < dados->n; i++) {
+        uint32_t id = dados->ids[i];
+        uint32_t suspeito = id % BENCHMARK_SUSPEITOS;
+        uint32_t anterior = inserirNaHash(sh, id, suspeito);
+        if (placar != NULL) {
+            if (anterior != TEXTO_NENHUM) {
+                placarSubtrair(placar, anterior, 1);
+            }
+            placarSomar(placar, suspeito, 1);
+        }
+    }
+}
+
+/**
+ * @brief Cria uma sala por id, na ordem dos ids, e as liga como uma árvore binária completa.
+ */
+static void montarMapaSintetico(const Dados *dados, Mapa *mapa) {
+    mapaInicializar(mapa);
+    for (uint32_t i = 0; i < dados->n; i++) {
+        uint32_t id = dados->ids[i];
+        criarSala(mapa, nomeSala(dados, i), textoPista(dados, id), dados->suspeitos[id % BENCHMARK_SUSPEITOS]);
+    }
+    for (uint32_t i = 0; i < dados->n; i++) {
+        uint64_t esquerda = 2 * (uint64_t)i + 1;
+        uint64_t direita = esquerda + 1;
+        ligarSalas(mapa, i, esquerda < dados->n ? (uint32_t)esquerda : MAPA_NENHUM,
+                   direita < dados->n ? (uint32_t)direita : MAPA_NENHUM);
+    }
+    mapaFinalizar(mapa);
+}
+
+// --- Casos ---
+
+static uint64_t medirInserirPista(Dados *dados) {
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    PoolNos pool;
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        arenaReiniciar(&arena);
+        poolInicializar(&pool, &arena, sizeof(PistaNode));
+        PistaNode *raiz = montarArvore(dados, &pool);
+        soma += raiz->pista;
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    arenaLiberar(&arena);
+    return gasto;
+}
+
+static uint64_t medirListarPistas(Dados *dados) {
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    PoolNos pool;
+    poolInicializar(&pool, &arena, sizeof(PistaNode));
+    PistaNode *raiz = montarArvore(dados, &pool);
+    uint32_t *destino = (uint32_t*)reservarDados((size_t)dados->n * sizeof(uint32_t));
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        soma += listarPistas(raiz, destino);
+        soma += destino[r % dados->n];
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    free(destino);
+    arenaLiberar(&arena);
+    return gasto;
+}
+
+static uint64_t medirConstruirPistas(Dados *dados) {
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    PoolNos pool;
+    uint32_t *ids = (uint32_t*)reservarDados((size_t)dados->n * sizeof(uint32_t));
+    uint64_t soma = 0;
+    uint64_t gasto = 0;
+
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        // construirPistas() ordena o vetor: cada rodada recebe a ordem original
+        memcpy(ids, dados->ids, (size_t)dados->n * sizeof(uint32_t));
+        arenaReiniciar(&arena);
+        poolInicializar(&pool, &arena, sizeof(PistaNode));
+
+        uint64_t inicio = agoraNs();
+        PistaNode *raiz = construirPistas(&pool, ids, dados->n);
+        gasto += agoraNs() - inicio;
+        soma += raiz->pista;
+    }
+
+    benchmarkSumidouro += soma;
+    free(ids);
+    arenaLiberar(&arena);
+    return gasto;
+}
+
+static uint64_t medirMesclarPistas(Dados *dados) {
+    Arena arenaEntradas;
+    Arena arena;
+    arenaInicializar(&arenaEntradas, ARENA_BLOCO_PADRAO);
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    PoolNos poolEntradas;
+    PoolNos pool;
+    poolInicializar(&poolEntradas, &arenaEntradas, sizeof(PistaNode));
+    // A: a primeira metade dos ids; B: a metade do meio, com um quarto em comum com A
+    uint32_t metade = dados->n / 2;
+    PistaNode *a = NULL;
+    PistaNode *b = NULL;
+    for (uint32_t i = 0; i < metade; i++) {
+        a = inserirPista(&poolEntradas, a, dados->ids[i]);
+        b = inserirPista(&poolEntradas, b, dados->ids[dados->n / 4 + i]);
+    }
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        arenaReiniciar(&arena);
+        poolInicializar(&pool, &arena, sizeof(PistaNode));
+        PistaNode *raiz = mesclarPistas(&pool, a, b);
+        soma += raiz != NULL ? raiz->pista : 0;
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    arenaLiberar(&arenaEntradas);
+    arenaLiberar(&arena);
+    return gasto;
+}
+
+static uint64_t medirInserirConjunto(Dados *dados) {
+    ConjuntoPistas conjunto;
+    iniciarConjuntoPistas(&conjunto, dados->n);
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        esvaziarConjuntoPistas(&conjunto);
+        for (uint32_t i = 0; i < dados->n; i++) {
+            conjuntoInserir(&conjunto, dados->ids[i]);
+        }
+        soma += conjunto.total;
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    liberarConjuntoPistas(&conjunto);
+    return gasto;
+}
+
+static uint64_t medirUnirConjuntos(Dados *dados) {
+    ConjuntoPistas a;
+    ConjuntoPistas b;
+    ConjuntoPistas uniao;
+    iniciarConjuntoPistas(&a, dados->n);
+    iniciarConjuntoPistas(&b, dados->n);
+    iniciarConjuntoPistas(&uniao, dados->n);
+    uint32_t metade = dados->n / 2;
+    conjuntoInserirLote(&a, dados->ids, metade);
+    conjuntoInserirLote(&b, dados->ids + dados->n / 4, metade);
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        esvaziarConjuntoPistas(&uniao);
+        conjuntoUnir(&uniao, &a);
+        conjuntoUnir(&uniao, &b);
+        soma += uniao.total;
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    liberarConjuntoPistas(&a);
+    liberarConjuntoPistas(&b);
+    liberarConjuntoPistas(&uniao);
+    return gasto;
+}
+
+static uint64_t medirConsultarEsparso(Dados *dados) {
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    ConjuntoEsparso conjunto;
+    iniciarConjuntoEsparso(&conjunto, &arena);
+    for (uint32_t i = 0; i < dados->n / 2; i++) {
+        esparsoInserir(&conjunto, dados->ids[i]);
+    }
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        for (uint32_t i = 0; i < dados->n; i++) {
+            soma += (uint64_t)esparsoContem(&conjunto, dados->ids[i]);
+        }
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    arenaLiberar(&arena);
+    return gasto;
+}
+
+static uint64_t medirListarConjunto(Dados *dados) {
+    ConjuntoPistas conjunto;
+    iniciarConjuntoPistas(&conjunto, dados->n);
+    for (uint32_t i = 0; i < dados->n; i++) {
+        conjuntoInserir(&conjunto, dados->ids[i]);
+    }
+    uint32_t *destino = (uint32_t*)reservarDados((size_t)dados->n * sizeof(uint32_t));
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        soma += listarConjuntoPistas(&conjunto, destino);
+        soma += destino[r % dados->n];
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    free(destino);
+    liberarConjuntoPistas(&conjunto);
+    return gasto;
+}
+
+static uint64_t medirCalcularHash(Dados *dados) {
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        for (uint32_t i = 0; i < dados->n; i++) {
+            soma += calcularHash(textoPista(dados, dados->ids[i]));
+        }
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    return gasto;
+}
+
+static uint64_t medirInserirNaHash(Dados *dados) {
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    SuspeitoHash sh;
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        arenaReiniciar(&arena);
+        inicializarHash(&sh, &arena, 0);
+        montarHash(dados, &sh, NULL);
+        soma += sh.total;
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    arenaLiberar(&arena);
+    return gasto;
+}
+
+static uint64_t medirEncontrarSuspeito(Dados *dados) {
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    SuspeitoHash sh;
+    inicializarHash(&sh, &arena, 0);
+    montarHash(dados, &sh, NULL);
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        for (uint32_t i = 0; i < dados->n; i++) {
+            soma += encontrarSuspeito(&sh, dados->ids[i]);
+        }
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    arenaLiberar(&arena);
+    return gasto;
+}
+
+static uint64_t medirContagemSuspeito(Dados *dados) {
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    Internador suspeitos;
+    inicializarInternador(&suspeitos);
+    for (uint32_t s = 0; s < BENCHMARK_SUSPEITOS; s++) {
+        internar(&suspeitos, dados->suspeitos[s]);
+    }
+    SuspeitoHash sh;
+    PlacarSuspeitos placar;
+    inicializarHash(&sh, &arena, 0);
+    inicializarPlacar(&placar, &arena, suspeitos.total);
+    montarHash(dados, &sh, &placar);
+    uint64_t soma = 0;
+
+    uint64_t inicio = agoraNs();
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        for (uint32_t i = 0; i < dados->n; i++) {
+            const char *acusado = dados->suspeitos[dados->ids[i] % BENCHMARK_SUSPEITOS];
+            soma += placarContagem(&placar, internadorProcurar(&suspeitos, acusado));
+        }
+    }
+    uint64_t gasto = agoraNs() - inicio;
+
+    benchmarkSumidouro += soma;
+    liberarInternador(&suspeitos);
+    arenaLiberar(&arena);
+    return gasto;
+}
+
+static uint64_t medirMontarMapa(Dados *dados) {
+    uint64_t gasto = 0;
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        Mapa mapa;
+        uint64_t inicio = agoraNs();
+        montarMapaSintetico(dados, &mapa);
+        gasto += agoraNs() - inicio;
+
+        benchmarkSumidouro += mapa.pistas.total;
+        liberarMapa(&mapa);
+    }
+    return gasto;
+}
+
+static uint64_t medirLiberarMapa(Dados *dados) {
+    uint64_t gasto = 0;
+    for (uint64_t r = 0; r < dados->rodadas; r++) {
+        Mapa mapa;
+        montarMapaSintetico(dados, &mapa);
+
+        uint64_t inicio = agoraNs();
+        liberarMapa(&mapa);
+        gasto += agoraNs() - inicio;
+    }
+    return gasto;
+}
+
+static const CasoBenchmark casos[] = {
+    { "inserirPista",      "pista",    0, 0, medirInserirPista },
+    { "listarPistas",      "pista",    0, 0, medirListarPistas },
+    { "construirPistas",   "pista",    0, 0, medirConstruirPistas },
+    { "mesclarPistas",     "pista",    0, 0, medirMesclarPistas },
+    { "inserirConjunto",   "pista",    0, 0, medirInserirConjunto },
+    { "listarConjunto",    "pista",    0, 0, medirListarConjunto },
+    { "unirConjuntos",     "pista",    0, 0, medirUnirConjuntos },
+    { "consultarEsparso",  "consulta", 0, 0, medirConsultarEsparso },
+    { "calcularHash",      "texto",    1, 0, medirCalcularHash },
+    { "inserirNaHash",     "pista",    0, 0, medirInserirNaHash },
+    { "encontrarSuspeito", "consulta", 0, 0, medirEncontrarSuspeito },
+    { "contagemSuspeito",  "consulta", 0, 0, medirContagemSuspeito },
+    { "montarMapa",        "sala",     1, 0, medirMontarMapa },
+    { "liberarMapa",       "mapa",     1, 1, medirLiberarMapa },
+};
+
+#define TOTAL_CASOS (sizeof(casos) / sizeof(casos[0]))
+
+// --- Execução das Medições ---
+
+static int compararDoubles(const void *a, const void *b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return x < y ? -1 : (x > y);
+}
+
+/**
+ * @brief Corpo do processo filho: gera os dados, repete a medição e resume os tempos.
+ */
+static Medicao medirNoFilho(const CasoBenchmark *caso, uint32_t n, int embaralhar, uint64_t semente,
+                            unsigned repeticoes) {
+    Dados dados;
+    gerarDados(&dados, n, embaralhar, semente, caso->usaTextos);
+
+    double tempos[BENCHMARK_REPETICOES_MAXIMO];
+    double operacoes = caso->porChamada ? (double)dados.rodadas : (double)dados.rodadas * n;
+    unsigned long long alocacoes = 0;
+    for (unsigned r = 0; r < repeticoes; r++) {
+        unsigned long long antes = benchmarkAlocacoes;
+        tempos[r] = (double)caso->medir(&dados) / operacoes;
+        if (r == 0) {
+            alocacoes = benchmarkAlocacoes - antes;
+        }
+    }
+    qsort(tempos, repeticoes, sizeof(double), compararDoubles);
+
+    Medicao medicao;
+    medicao.nsMinimo = tempos[0];
+    medicao.nsMediano = tempos[repeticoes / 2];
+    medicao.alocacoes = (double)alocacoes / (double)dados.rodadas;
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    medicao.picoKb = uso.ru_maxrss;
+    medicao.ok = 1;
+
+    liberarDados(&dados);
+    return medicao;
+}
+
+/**
+ * @brief Roda uma combinação em um processo filho e recebe o resultado por um pipe.
+ */
+static Medicao medirIsolado(const CasoBenchmark *caso, uint32_t n, int embaralhar, uint64_t semente,
+                            unsigned repeticoes) {
+    Medicao medicao;
+    memset(&medicao, 0, sizeof(Medicao));
+
+    int canal[2];
+    if (pipe(canal) != 0) {
+        perror("pipe");
+        return medicao;
+    }
+    fflush(stdout);
+    pid_t filho = fork();
+    if (filho < 0) {
+        perror("fork");
+        close(canal[0]);
+        close(canal[1]);
+        return medicao;
+    }
+    if (filho == 0) {
+        close(canal[0]);
+        Medicao resultado = medirNoFilho(caso, n, embaralhar, semente, repeticoes);
+        ssize_t escrito = write(canal[1], &resultado, sizeof(Medicao));
+        _exit(escrito == (ssize_t)sizeof(Medicao) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(canal[1]);
+    ssize_t lido = read(canal[0], &medicao, sizeof(Medicao));
+    close(canal[0]);
+    int estado = 0;
+    waitpid(filho, &estado, 0);
+    if (lido != (ssize_t)sizeof(Medicao) || !WIFEXITED(estado) || WEXITSTATUS(estado) != EXIT_SUCCESS) {
+        memset(&medicao, 0, sizeof(Medicao));
+    }
+    return medicao;
+}
+
+// --- Comparação com a Base ---
+
+/**
+ * @brief Lê uma saída anterior do benchmark (linhas que não são de medição são ignoradas).
+ * @return A quantidade de linhas lidas, ou -1 se o arquivo não abrir.
+ */
+static long lerBase(const char *caminho, LinhaBase **linhas) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) {
+        perror(caminho);
+        return -1;
+    }
+    size_t total = 0, capacidade = 64;
+    *linhas = (LinhaBase*)reservarDados(capacidade * sizeof(LinhaBase));
+
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), arquivo) != NULL) {
+        LinhaBase linha;
+        char unidade[16];
+        double nsMediano;
+        if (sscanf(buffer, "%31s %15s %lu %15s %lf %lf %lf", linha.caso, linha.ordem, &linha.n, unidade,
+                   &linha.nsMinimo, &nsMediano, &linha.alocacoes) != 7) {
+            continue; // Cabeçalho ou linha inválida
+        }
+        if (total == capacidade) {
+            capacidade *= 2;
+            LinhaBase *maiores = (LinhaBase*)realloc(*linhas, capacidade * sizeof(LinhaBase));
+            if (maiores == NULL) {
+                printf("Erro de alocação de memória para o Benchmark!\n");
+                exit(EXIT_FAILURE);
+            }
+            *linhas = maiores;
+        }
+        (*linhas)[total++] = linha;
+    }
+    fclose(arquivo);
+    return (long)total;
+}
+
+static const LinhaBase *procurarBase(const LinhaBase *linhas, long total, const char *caso, const char *ordem,
+                                     uint32_t n) {
+    for (long i = 0; i < total; i++) {
+        if (linhas[i].n == n && strcmp(linhas[i].caso, caso) == 0 && strcmp(linhas[i].ordem, ordem) == 0) {
+            return &linhas[i];
+        }
+    }
+    return NULL;
+}
+
+// --- Main ---
+
+int main(int argc, char *argv[]) {
+    // ------------------------------------------------------------------
+    // 1. Argumentos
+    // ------------------------------------------------------------------
+    unsigned long minimo = 10, maximo = 10000000;
+    unsigned repeticoes = BENCHMARK_REPETICOES;
+    uint64_t semente = BENCHMARK_SEMENTE;
+    const char *filtro = NULL;
+    const char *arquivoBase = NULL;
+    double tolerancia = BENCHMARK_TOLERANCIA;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min") == 0 && i + 1 < argc) {
+            minimo = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            maximo = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--repeticoes") == 0 && i + 1 < argc) {
+            repeticoes = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            semente = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--caso") == 0 && i + 1 < argc) {
+            filtro = argv[++i];
+        } else if (strcmp(argv[i], "--base") == 0 && i + 1 < argc) {
+            arquivoBase = argv[++i];
+        } else if (strcmp(argv[i], "--tolerancia") == 0 && i + 1 < argc) {
+            tolerancia = strtod(argv[++i], NULL);
+        } else {
+            printf("Uso: %s [--min N] [--max N] [--repeticoes R] [--semente S] [--caso nome]\n"
+                   "       [--base medicoes.tsv] [--tolerancia P]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (repeticoes == 0 || repeticoes > BENCHMARK_REPETICOES_MAXIMO) {
+        printf("O número de repetições deve estar entre 1 e %d.\n", BENCHMARK_REPETICOES_MAXIMO);
+        return EXIT_FAILURE;
+    }
+    if (minimo < 10) {
+        minimo = 10;
+    }
+    if (maximo > UINT32_MAX / 2) {
+        maximo = UINT32_MAX / 2;
+    }
+
+    LinhaBase *base = NULL;
+    long totalBase = 0;
+    if (arquivoBase != NULL && (totalBase = lerBase(arquivoBase, &base)) < 0) {
+        return EXIT_FAILURE;
+    }
+
+    // ------------------------------------------------------------------
+    // 2. Medições: caso x ordem x tamanho, cada uma em um processo próprio
+    // ------------------------------------------------------------------
+    printf("caso\tordem\tn\tunidade\tns_op_min\tns_op_mediana\talocacoes\tpico_rss_kb\n");
+    int regressoes = 0, falhas = 0;
+    for (size_t c = 0; c < TOTAL_CASOS; c++) {
+        const CasoBenchmark *caso = &casos[c];
+        if (filtro != NULL && strcmp(filtro, caso->nome) != 0) {
+            continue;
+        }
+        for (int embaralhar = 0; embaralhar <= 1; embaralhar++) {
+            const char *ordem = embaralhar ? "aleatoria" : "ordenada";
+            for (unsigned long n = 10; n <= maximo; n *= 10) {
+                if (n < minimo) {
+                    continue;
+                }
+                Medicao medicao = medirIsolado(caso, (uint32_t)n, embaralhar, semente, repeticoes);
+                if (!medicao.ok) {
+                    fprintf(stderr, "%s/%s/%lu: a medição falhou\n", caso->nome, ordem, n);
+                    falhas++;
+                    continue;
+                }
+                printf("%s\t%s\t%lu\t%s\t%.2f\t%.2f\t%.2f\t%ld\n", caso->nome, ordem, n, caso->unidade,
+                       medicao.nsMinimo, medicao.nsMediano, medicao.alocacoes, medicao.picoKb);
+
+                const LinhaBase *referencia = procurarBase(base, totalBase, caso->nome, ordem, (uint32_t)n);
+                if (referencia == NULL) {
+                    continue;
+                }
+                if (medicao.nsMinimo > referencia->nsMinimo * (1.0 + tolerancia / 100.0)) {
+                    fprintf(stderr, "REGRESSÃO %s/%s/%lu: %.2f ns/%s (base %.2f)\n", caso->nome, ordem, n,
+                            medicao.nsMinimo, caso->unidade, referencia->nsMinimo);
+                    regressoes++;
+                }
+                // Valores impressos com duas casas: compara com meia unidade da última casa
+                if (medicao.alocacoes > referencia->alocacoes + 0.005) {
+                    fprintf(stderr, "REGRESSÃO %s/%s/%lu: %.2f alocações (base %.2f)\n", caso->nome, ordem, n,
+                            medicao.alocacoes, referencia->alocacoes);
+                    regressoes++;
+                }
+            }
+        }
+    }
+
+    free(base);
+    if (regressoes > 0 || falhas > 0) {
+        fprintf(stderr, "%d regressão(ões), %d falha(s)\n", regressoes, falhas);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,498 @@
+/**
+ * @file compilador_mapa.c
+ * @brief Converte mapas no formato texto (.txt) para o formato binário mapeável (.dqm).
+ *
+ * Formato texto, uma declaração por linha ('#' inicia comentário):
+ *
+ *   sala <id> | <nome> | <pista> | <suspeitos>
+ *   caminhos <id> <esquerda> <direita>      (use '-' para caminho inexistente)
+ *   saida <id> <destino> [<tecla>] [| <rótulo>]
+ *   raiz <id>                               (opcional; padrão: a primeira sala)
+ *
+ * <suspeitos> é uma lista separada por ',' de suspeitos incriminados pela
+ * pista, cada um com um peso opcional após ':' (padrão 1), ex.:
+ * "Coronel Mostarda: 2, D. Branca".
+ *
+ * "caminhos" cria as saídas 'e' e 'd' das mansões binárias; "saida" acrescenta
+ * uma passagem qualquer, inclusive de volta a uma sala anterior, com uma tecla
+ * própria (padrão: o primeiro algarismo livre da sala) e um rótulo opcional,
+ * ex.: "saida quarto hall h | Escada para o Hall". As saídas de uma sala
+ * aparecem na ordem em que foram declaradas.
+ *
+ * Os identificadores são livres (sem espaços) e podem ser usados em "caminhos"
+ * e "saida" antes de a sala ser declarada. Uso: compilador_mapa <entrada.txt> <saida.dqm>
+ *
+ * Com "--c <símbolo>", a mesma imagem .dqm sai como um arquivo-fonte C que
+ * define "const MapaEmbutido <símbolo>" sobre um vetor constante alinhado
+ * (mapa_arquivo.h), para ser ligado ao executável e aberto com
+ * abrirMapaEmbutido(). É assim que a compilação embute as mansões dos jogos:
+ * compilador_mapa --c mansaoEmbutida mapas/mansao_mestre.txt mansao_mestre.c
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "mapa.h"
+#include "mapa_arquivo.h"
+
+// --- Tabela de Identificadores (id textual -> índice da sala) ---
+
+typedef struct Identificador {
+    const char *nome;  // NULL indica posição livre
+    uint32_t sala;
+} Identificador;
+
+typedef struct TabelaIds {
+    Identificador *posicoes;
+    uint32_t capacidade; // Sempre potência de 2
+    uint32_t total;
+    Arena *arena;        // Guarda as cópias dos nomes
+} TabelaIds;
+
+// Saída lida do texto, resolvida depois que todas as salas forem conhecidas
+typedef struct CaminhoPendente {
+    const char *origem;
+    const char *destino;
+    const char *rotulo; // NULL: rótulo da tecla
+    char tecla;         // '\0': algarismo atribuído por mapaFinalizar()
+    unsigned long linha;
+} CaminhoPendente;
+
+/**
+ * @brief Hash FNV-1a de 32 bits para os identificadores.
+ */
+static uint32_t hashId(const char *texto) {
+    uint32_t hash = 2166136261u;
+    while (*texto) {
+        hash ^= (unsigned char)*texto++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void inicializarTabelaIds(TabelaIds *tabela, Arena *arena) {
+    tabela->capacidade = 1024;
+    tabela->total = 0;
+    tabela->arena = arena;
+    tabela->posicoes = (Identificador*)calloc(tabela->capacidade, sizeof(Identificador));
+    if (tabela->posicoes == NULL) {
+        fprintf(stderr, "Erro de alocação de memória para a tabela de identificadores!\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static Identificador *procurarId(const TabelaIds *tabela, const char *nome) {
+    uint32_t mascara = tabela->capacidade - 1;
+    for (uint32_t i = hashId(nome) & mascara;; i = (i + 1) & mascara) {
+        Identificador *id = &tabela->posicoes[i];
+        if (id->nome == NULL || strcmp(id->nome, nome) == 0) {
+            return id;
+        }
+    }
+}
+
+static void crescerTabelaIds(TabelaIds *tabela) {
+    Identificador *antigas = tabela->posicoes;
+    uint32_t capacidadeAntiga = tabela->capacidade;
+
+    tabela->capacidade *= 2;
+    tabela->posicoes = (Identificador*)calloc(tabela->capacidade, sizeof(Identificador));
+    if (tabela->posicoes == NULL) {
+        fprintf(stderr, "Erro de alocação de memória para a tabela de identificadores!\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t i = 0; i < capacidadeAntiga; i++) {
+        if (antigas[i].nome != NULL) {
+            *procurarId(tabela, antigas[i].nome) = antigas[i];
+        }
+    }
+    free(antigas);
+}
+
+/**
+ * @brief Copia um texto para a arena do compilador.
+ */
+static const char *copiarTexto(Arena *arena, const char *texto) {
+    size_t tamanho = strlen(texto) + 1;
+    char *copia = (char*)arenaAlocar(arena, tamanho);
+    memcpy(copia, texto, tamanho);
+    return copia;
+}
+
+// --- Leitura do Formato Texto ---
+
+/**
+ * @brief Remove espaços do início e do fim de um campo, no próprio buffer.
+ */
+static char *aparar(char *texto) {
+    while (isspace((unsigned char)*texto)) {
+        texto++;
+    }
+    char *fim = texto + strlen(texto);
+    while (fim > texto && isspace((unsigned char)fim[-1])) {
+        *--fim = '\0';
+    }
+    return texto;
+}
+
+/**
+ * @brief Separa o próximo campo delimitado por '|'.
+ * @return O campo aparado; o cursor avança para depois do delimitador.
+ */
+static char *proximoCampo(char **cursor) {
+    char *inicio = *cursor;
+    char *barra = strchr(inicio, '|');
+    if (barra != NULL) {
+        *barra = '\0';
+        *cursor = barra + 1;
+    } else {
+        *cursor = inicio + strlen(inicio);
+    }
+    return aparar(inicio);
+}
+
+/**
+ * @brief Acrescenta à última sala os suspeitos de uma lista "<nome>[:<peso>], ...".
+ *
+ * Só é peso o que vem depois do último ':' quando são apenas algarismos; fora
+ * isso, o ':' faz parte do nome.
+ * @return 0 em caso de sucesso, -1 se algum peso for inválido.
+ */
+static int lerAlvos(Mapa *mapa, char *lista) {
+    char *cursor = lista;
+    while (*cursor != '\0') {
+        char *virgula = strchr(cursor, ',');
+        char *proximo = virgula != NULL ? virgula + 1 : cursor + strlen(cursor);
+        if (virgula != NULL) {
+            *virgula = '\0';
+        }
+        char *nome = aparar(cursor);
+        unsigned long peso = 1;
+        char *doisPontos = strrchr(nome, ':');
+        if (doisPontos != NULL) {
+            char *textoPeso = aparar(doisPontos + 1);
+            if (*textoPeso != '\0' && strspn(textoPeso, "0123456789") == strlen(textoPeso)) {
+                peso = strtoul(textoPeso, NULL, 10);
+                if (peso == 0 || peso > UINT32_MAX / 2) {
+                    return -1;
+                }
+                *doisPontos = '\0';
+                nome = aparar(nome);
+                if (*nome == '\0') {
+                    return -1; // Peso sem suspeito
+                }
+            }
+        }
+        mapaAdicionarAlvo(mapa, nome, (uint32_t)peso);
+        cursor = proximo;
+    }
+    return 0;
+}
+
+/**
+ * @brief Resolve um identificador de caminho; '-' significa caminho inexistente.
+ * @return 0 em caso de sucesso, -1 se a sala não foi declarada.
+ */
+static int resolverCaminho(TabelaIds *ids, const char *nome, uint32_t *sala) {
+    if (strcmp(nome, "-") == 0) {
+        *sala = MAPA_NENHUM;
+        return 0;
+    }
+    Identificador *id = procurarId(ids, nome);
+    if (id->nome == NULL) {
+        return -1;
+    }
+    *sala = id->sala;
+    return 0;
+}
+
+/**
+ * @brief Guarda uma saída para ser resolvida no fim da leitura; destino '-' é ignorado.
+ */
+static void adicionarCaminho(CaminhoPendente **caminhos, size_t *total, size_t *capacidade, Arena *arena,
+                             const char *origem, const char *destino, const char *rotulo, char tecla,
+                             unsigned long linha) {
+    if (strcmp(destino, "-") == 0) {
+        return;
+    }
+    if (*total == *capacidade) {
+        *capacidade = *capacidade > 0 ? *capacidade * 2 : 256;
+        *caminhos = (CaminhoPendente*)realloc(*caminhos, *capacidade * sizeof(CaminhoPendente));
+        if (*caminhos == NULL) {
+            fprintf(stderr, "Erro de alocação de memória para os caminhos!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    CaminhoPendente *caminho = &(*caminhos)[(*total)++];
+    caminho->origem = copiarTexto(arena, origem);
+    caminho->destino = copiarTexto(arena, destino);
+    caminho->rotulo = rotulo != NULL && *rotulo != '\0' ? copiarTexto(arena, rotulo) : NULL;
+    caminho->tecla = tecla;
+    caminho->linha = linha;
+}
+
+/**
+ * @brief Confere se as saídas de cada sala usam teclas distintas.
+ * @return 0 se sim, -1 caso contrário (já reportado em stderr).
+ */
+static int conferirTeclas(const Mapa *mapa, const char *nomeEntrada) {
+    for (uint32_t sala = 0; sala < mapa->totalSalas; sala++) {
+        const SaidaSala *saidas = mapaSaidas(mapa, sala);
+        uint32_t total = mapaTotalSaidas(mapa, sala);
+        uint64_t usadas[4] = { 0, 0, 0, 0 };
+        for (uint32_t i = 0; i < total; i++) {
+            unsigned char tecla = (unsigned char)saidas[i].tecla;
+            if (tecla == '\0') {
+                continue;
+            }
+            if ((usadas[tecla / 64] >> (tecla % 64)) & 1) {
+                fprintf(stderr, "%s: a sala '%s' tem mais de uma saída com a tecla '%c'\n", nomeEntrada,
+                        mapaNomeSala(mapa, sala), tecla);
+                return -1;
+            }
+            usadas[tecla / 64] |= UINT64_C(1) << (tecla % 64);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Lê o mapa em formato texto e o constrói em memória.
+ * @return 0 em caso de sucesso, -1 em caso de erro (já reportado em stderr).
+ */
+static int lerMapaTexto(FILE *entrada, const char *nomeEntrada, Mapa *mapa, Arena *arena) {
+    TabelaIds ids;
+    inicializarTabelaIds(&ids, arena);
+
+    CaminhoPendente *caminhos = NULL;
+    size_t totalCaminhos = 0, capacidadeCaminhos = 0;
+    const char *raiz = NULL;
+    unsigned long linhaRaiz = 0;
+
+    char *linha = NULL;
+    size_t capacidadeLinha = 0;
+    unsigned long numeroLinha = 0;
+    int erro = 0;
+
+    while (!erro && getline(&linha, &capacidadeLinha, entrada) != -1) {
+        numeroLinha++;
+        char *comentario = strchr(linha, '#');
+        if (comentario != NULL) {
+            *comentario = '\0';
+        }
+        char *conteudo = aparar(linha);
+        if (*conteudo == '\0') {
+            continue;
+        }
+
+        char *resto = conteudo;
+        while (*resto != '\0' && !isspace((unsigned char)*resto)) {
+            resto++;
+        }
+        if (*resto != '\0') {
+            *resto++ = '\0';
+        }
+
+        if (strcmp(conteudo, "sala") == 0) {
+            char *cursor = resto;
+            char *id = proximoCampo(&cursor);
+            char *nome = proximoCampo(&cursor);
+            char *pista = proximoCampo(&cursor);
+            char *suspeito = proximoCampo(&cursor);
+            if (*id == '\0' || *nome == '\0' || strpbrk(id, " \t") != NULL) {
+                fprintf(stderr, "%s:%lu: esperado 'sala <id> | <nome> | <pista> | <suspeitos>'\n", nomeEntrada, numeroLinha);
+                erro = 1;
+                break;
+            }
+            if (ids.total * 2 >= ids.capacidade) {
+                crescerTabelaIds(&ids);
+            }
+            Identificador *posicao = procurarId(&ids, id);
+            if (posicao->nome != NULL) {
+                fprintf(stderr, "%s:%lu: sala '%s' declarada mais de uma vez\n", nomeEntrada, numeroLinha, id);
+                erro = 1;
+                break;
+            }
+            posicao->nome = copiarTexto(arena, id);
+            posicao->sala = criarSala(mapa, nome, pista, "");
+            ids.total++;
+            if (lerAlvos(mapa, suspeito) != 0) {
+                fprintf(stderr, "%s:%lu: esperado '<suspeito>[: <peso>], ...' com pesos inteiros positivos\n", nomeEntrada, numeroLinha);
+                erro = 1;
+                break;
+            }
+        } else if (strcmp(conteudo, "caminhos") == 0) {
+            char *origem = strtok(resto, " \t");
+            char *esquerda = strtok(NULL, " \t");
+            char *direita = strtok(NULL, " \t");
+            if (origem == NULL || esquerda == NULL || direita == NULL || strtok(NULL, " \t") != NULL) {
+                fprintf(stderr, "%s:%lu: esperado 'caminhos <id> <esquerda> <direita>'\n", nomeEntrada, numeroLinha);
+                erro = 1;
+                break;
+            }
+            adicionarCaminho(&caminhos, &totalCaminhos, &capacidadeCaminhos, arena, origem, esquerda, NULL, 'e', numeroLinha);
+            adicionarCaminho(&caminhos, &totalCaminhos, &capacidadeCaminhos, arena, origem, direita, NULL, 'd', numeroLinha);
+        } else if (strcmp(conteudo, "saida") == 0) {
+            char *cursor = resto;
+            char *ligacao = proximoCampo(&cursor);
+            char *rotulo = proximoCampo(&cursor);
+            char *origem = strtok(ligacao, " \t");
+            char *destino = strtok(NULL, " \t");
+            char *tecla = strtok(NULL, " \t");
+            if (origem == NULL || destino == NULL || strcmp(destino, "-") == 0 || strtok(NULL, " \t") != NULL ||
+                *cursor != '\0' || (tecla != NULL && (strlen(tecla) != 1 || !isgraph((unsigned char)*tecla) ||
+                                                      tolower((unsigned char)*tecla) == 's' || *tecla == '?'))) {
+                fprintf(stderr, "%s:%lu: esperado 'saida <id> <destino> [<tecla>] [| <rótulo>]', com uma tecla diferente de 's' e '?'\n",
+                        nomeEntrada, numeroLinha);
+                erro = 1;
+                break;
+            }
+            adicionarCaminho(&caminhos, &totalCaminhos, &capacidadeCaminhos, arena, origem, destino, rotulo,
+                             tecla != NULL ? *tecla : '\0', numeroLinha);
+        } else if (strcmp(conteudo, "raiz") == 0) {
+            char *id = aparar(resto);
+            if (*id == '\0') {
+                fprintf(stderr, "%s:%lu: esperado 'raiz <id>'\n", nomeEntrada, numeroLinha);
+                erro = 1;
+                break;
+            }
+            raiz = copiarTexto(arena, id);
+            linhaRaiz = numeroLinha;
+        } else {
+            fprintf(stderr, "%s:%lu: declaração desconhecida '%s'\n", nomeEntrada, numeroLinha, conteudo);
+            erro = 1;
+        }
+    }
+    free(linha);
+
+    // Resolve os caminhos e a raiz agora que todas as salas foram declaradas
+    for (size_t i = 0; !erro && i < totalCaminhos; i++) {
+        CaminhoPendente *caminho = &caminhos[i];
+        uint32_t origem, destino;
+        if (resolverCaminho(&ids, caminho->origem, &origem) != 0 || origem == MAPA_NENHUM ||
+            resolverCaminho(&ids, caminho->destino, &destino) != 0) {
+            fprintf(stderr, "%s:%lu: caminho referencia sala não declarada\n", nomeEntrada, caminho->linha);
+            erro = 1;
+            break;
+        }
+        mapaAdicionarSaida(mapa, origem, destino, caminho->rotulo, caminho->tecla);
+    }
+    if (!erro && raiz != NULL) {
+        if (resolverCaminho(&ids, raiz, &mapa->raiz) != 0 || mapa->raiz == MAPA_NENHUM) {
+            fprintf(stderr, "%s:%lu: raiz '%s' não declarada\n", nomeEntrada, linhaRaiz, raiz);
+            erro = 1;
+        }
+    }
+    if (!erro && mapa->totalSalas == 0) {
+        fprintf(stderr, "%s: o mapa não tem nenhuma sala\n", nomeEntrada);
+        erro = 1;
+    }
+    if (!erro) {
+        mapaFinalizar(mapa);
+        erro = conferirTeclas(mapa, nomeEntrada) != 0;
+    }
+
+    free(caminhos);
+    free(ids.posicoes);
+    return erro ? -1 : 0;
+}
+
+// --- Gravação como Fonte C ---
+
+/**
+ * @brief Grava a imagem .dqm do mapa como um vetor constante em C (ver o cabeçalho do arquivo).
+ * @return 0 em caso de sucesso, -1 em caso de erro de escrita.
+ */
+static int gravarFonteC(const Mapa *mapa, const char *simbolo, const char *nomeEntrada, FILE *arquivo) {
+    char *imagem = NULL;
+    size_t tamanho = 0;
+    FILE *memoria = open_memstream(&imagem, &tamanho);
+    if (memoria == NULL) {
+        return -1;
+    }
+    int resultado = mapaSalvar(mapa, memoria);
+    if (fclose(memoria) != 0) {
+        resultado = -1;
+    }
+
+    const char *barra = strrchr(nomeEntrada, '/');
+    const unsigned char *bytes = (const unsigned char*)imagem;
+    if (resultado == 0 &&
+        (fprintf(arquivo, "// Gerado por compilador_mapa a partir de %s; não edite.\n\n"
+                          "#include \"mapa_arquivo.h\"\n\n"
+                          "static _Alignas(MAPA_ARQUIVO_ALINHAMENTO) const unsigned char dados[%zu] = {",
+                 barra != NULL ? barra + 1 : nomeEntrada, tamanho) < 0)) {
+        resultado = -1;
+    }
+    for (size_t i = 0; resultado == 0 && i < tamanho; i++) {
+        if (fprintf(arquivo, "%s0x%02x,", i % 16 == 0 ? "\n    " : " ", bytes[i]) < 0) {
+            resultado = -1;
+        }
+    }
+    if (resultado == 0 && fprintf(arquivo, "\n};\n\nconst MapaEmbutido %s = { dados, sizeof(dados) };\n", simbolo) < 0) {
+        resultado = -1;
+    }
+    free(imagem);
+    return resultado;
+}
+
+// --- Main ---
+
+int main(int argc, char *argv[]) {
+    const char *programa = argv[0];
+    const char *simbolo = NULL;
+    if (argc == 5 && strcmp(argv[1], "--c") == 0) {
+        simbolo = argv[2];
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc != 3) {
+        fprintf(stderr, "Uso: %s [--c <símbolo>] <entrada.txt> <saida.dqm|saida.c>\n", programa);
+        return EXIT_FAILURE;
+    }
+
+    FILE *entrada = fopen(argv[1], "r");
+    if (entrada == NULL) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    Mapa mapa;
+    mapaInicializar(&mapa);
+
+    int resultado = lerMapaTexto(entrada, argv[1], &mapa, &arena);
+    fclose(entrada);
+
+    if (resultado == 0) {
+        FILE *saida = fopen(argv[2], simbolo != NULL ? "w" : "wb");
+        if (saida == NULL) {
+            perror(argv[2]);
+            resultado = -1;
+        } else {
+            if ((simbolo != NULL ? gravarFonteC(&mapa, simbolo, argv[1], saida) : mapaSalvar(&mapa, saida)) != 0) {
+                fprintf(stderr, "%s: erro de escrita\n", argv[2]);
+                resultado = -1;
+            }
+            if (fclose(saida) != 0) {
+                resultado = -1;
+            }
+        }
+    }
+    if (resultado == 0) {
+        printf("%s: %u salas, %u saídas, %u pistas, %u suspeitos, %u alvos, %u bytes de texto\n", argv[2],
+               mapa.totalSalas, mapa.totalSaidas, mapa.pistas.total, mapa.suspeitos.total, mapa.totalAlvos,
+               mapa.tamanhoTextos + mapa.pistas.tamanhoTextos + mapa.suspeitos.tamanhoTextos);
+    }
+
+    liberarMapa(&mapa);
+    arenaLiberar(&arena);
+    return resultado == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
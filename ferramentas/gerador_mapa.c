@@ -0,0 +1,162 @@
+/**
+ * @file gerador_mapa.c
+ * @brief Gera mansões sintéticas (gerador.h) e as grava no formato binário mapeável (.dqm).
+ *
+ * Uso: gerador_mapa [opções] <saida.dqm>
+ *
+ *   --salas N                 total de salas (padrão 1000)
+ *   --forma F                 equilibrada, desequilibrada ou corrente (padrão equilibrada)
+ *   --vies V                  desequilibrada: fração das salas à esquerda, 0 a 1 (padrão 0.8)
+ *   --densidade D             probabilidade de uma sala ter pista, 0 a 1 (padrão 0.5)
+ *   --pistas-distintas N      sorteia as pistas entre N textos (padrão 0: uma por sala)
+ *   --suspeitos N             suspeitos distintos (padrão 6)
+ *   --alvos N                 máximo de suspeitos incriminados por pista (padrão 2)
+ *   --tamanho-pista MIN:MAX   bytes do texto de cada pista (padrão 16:48)
+ *   --nomes-distintos N       repete os nomes das salas a cada N salas (padrão 0: todos distintos)
+ *   --semente S               semente dos sorteios (padrão 1)
+ *
+ * A mesma semente e as mesmas opções gravam sempre o mesmo arquivo. Ex.:
+ * "gerador_mapa --salas 10000000 --forma desequilibrada --vies 0.9 grande.dqm".
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gerador.h"
+#include "mapa.h"
+#include "mapa_arquivo.h"
+
+/**
+ * @brief Lê um inteiro sem sinal de 32 bits; encerra com uma mensagem se o texto for inválido.
+ */
+static uint32_t lerInteiro(const char *opcao, const char *texto) {
+    char *fim;
+    unsigned long long valor = strtoull(texto, &fim, 10);
+    if (fim == texto || *fim != '\0' || texto[0] == '-' || valor > UINT32_MAX) {
+        fprintf(stderr, "%s: valor inválido \"%s\"\n", opcao, texto);
+        exit(EXIT_FAILURE);
+    }
+    return (uint32_t)valor;
+}
+
+/**
+ * @brief Lê uma fração entre 0 e 1; encerra com uma mensagem se o texto for inválido.
+ */
+static double lerFracao(const char *opcao, const char *texto) {
+    char *fim;
+    double valor = strtod(texto, &fim);
+    if (fim == texto || *fim != '\0' || !(valor >= 0.0 && valor <= 1.0)) {
+        fprintf(stderr, "%s: esperava um número entre 0 e 1, recebido \"%s\"\n", opcao, texto);
+        exit(EXIT_FAILURE);
+    }
+    return valor;
+}
+
+static double segundosDesde(const struct timespec *inicio) {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (double)(agora.tv_sec - inicio->tv_sec) + (double)(agora.tv_nsec - inicio->tv_nsec) / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    ParametrosGerador parametros;
+    parametrosGeradorPadrao(&parametros);
+    const char *arquivoSaida = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *opcao = argv[i];
+        if (strcmp(opcao, "--salas") == 0 && i + 1 < argc) {
+            parametros.salas = lerInteiro(opcao, argv[++i]);
+        } else if (strcmp(opcao, "--forma") == 0 && i + 1 < argc) {
+            const char *forma = argv[++i];
+            if (strcmp(forma, "equilibrada") == 0) {
+                parametros.forma = GERADOR_EQUILIBRADA;
+            } else if (strcmp(forma, "desequilibrada") == 0) {
+                parametros.forma = GERADOR_DESEQUILIBRADA;
+            } else if (strcmp(forma, "corrente") == 0) {
+                parametros.forma = GERADOR_CORRENTE;
+            } else {
+                fprintf(stderr, "--forma: esperava equilibrada, desequilibrada ou corrente, recebido \"%s\"\n", forma);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(opcao, "--vies") == 0 && i + 1 < argc) {
+            parametros.vies = lerFracao(opcao, argv[++i]);
+        } else if (strcmp(opcao, "--densidade") == 0 && i + 1 < argc) {
+            parametros.densidade = lerFracao(opcao, argv[++i]);
+        } else if (strcmp(opcao, "--pistas-distintas") == 0 && i + 1 < argc) {
+            parametros.pistasDistintas = lerInteiro(opcao, argv[++i]);
+        } else if (strcmp(opcao, "--suspeitos") == 0 && i + 1 < argc) {
+            parametros.suspeitos = lerInteiro(opcao, argv[++i]);
+        } else if (strcmp(opcao, "--alvos") == 0 && i + 1 < argc) {
+            parametros.alvosMaximos = lerInteiro(opcao, argv[++i]);
+        } else if (strcmp(opcao, "--tamanho-pista") == 0 && i + 1 < argc) {
+            char faixa[64];
+            snprintf(faixa, sizeof(faixa), "%s", argv[++i]);
+            char *separador = strchr(faixa, ':');
+            if (separador == NULL) {
+                fprintf(stderr, "--tamanho-pista: esperava MIN:MAX, recebido \"%s\"\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+            *separador = '\0';
+            parametros.tamanhoPistaMinimo = lerInteiro(opcao, faixa);
+            parametros.tamanhoPistaMaximo = lerInteiro(opcao, separador + 1);
+        } else if (strcmp(opcao, "--nomes-distintos") == 0 && i + 1 < argc) {
+            parametros.nomesDistintos = lerInteiro(opcao, argv[++i]);
+        } else if (strcmp(opcao, "--semente") == 0 && i + 1 < argc) {
+            parametros.semente = strtoull(argv[++i], NULL, 10);
+        } else if (arquivoSaida == NULL && opcao[0] != '-') {
+            arquivoSaida = opcao;
+        } else {
+            fprintf(stderr, "Uso: %s [--salas N] [--forma equilibrada|desequilibrada|corrente] [--vies V]\n"
+                            "       [--densidade D] [--pistas-distintas N] [--suspeitos N] [--alvos N]\n"
+                            "       [--tamanho-pista MIN:MAX] [--nomes-distintos N] [--semente S] <saida.dqm>\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (arquivoSaida == NULL) {
+        fprintf(stderr, "Uso: %s [opções] <saida.dqm>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    Mapa mapa;
+    mapaInicializar(&mapa);
+    if (gerarMansao(&mapa, &parametros) != 0) {
+        fprintf(stderr, "Parâmetros inválidos: confira salas, suspeitos (>= 1), alvos (entre 1 e os suspeitos) "
+                        "e tamanho da pista (MIN <= MAX <= %d), ou os textos passam de 4 GiB\n",
+                GERADOR_TAMANHO_PISTA_MAXIMO);
+        liberarMapa(&mapa);
+        return EXIT_FAILURE;
+    }
+    double segundosGerar = segundosDesde(&inicio);
+
+    int resultado = 0;
+    FILE *saida = fopen(arquivoSaida, "wb");
+    if (saida == NULL) {
+        perror(arquivoSaida);
+        resultado = -1;
+    } else {
+        if (mapaSalvar(&mapa, saida) != 0) {
+            fprintf(stderr, "%s: erro de escrita\n", arquivoSaida);
+            resultado = -1;
+        }
+        if (fclose(saida) != 0) {
+            resultado = -1;
+        }
+    }
+    if (resultado == 0) {
+        printf("%s: %u salas, %u saídas, %u pistas, %u suspeitos, %u alvos, %u bytes de texto "
+               "(gerado em %.2f s, gravado em %.2f s)\n", arquivoSaida,
+               mapa.totalSalas, mapa.totalSaidas, mapa.pistas.total, mapa.suspeitos.total, mapa.totalAlvos,
+               mapa.tamanhoTextos + mapa.pistas.tamanhoTextos + mapa.suspeitos.tamanhoTextos,
+               segundosGerar, segundosDesde(&inicio) - segundosGerar);
+    }
+
+    liberarMapa(&mapa);
+    return resultado == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file reprodutor_diario.c
+ * @brief Refaz no motor as partidas gravadas em um diário (diario.h) e confere os resultados.
+ *
+ * Uso: reprodutor_diario [--partidas] [--json] <mapa.dqm> <diario>
+ *
+ *   --partidas   escreve uma linha por partida refeita, em ordem de término
+ *   --json       um objeto JSON por linha, em vez de texto
+ *
+ * O diário é mapeado em memória e reproduzido sem nenhuma E/S: as linhas das
+ * partidas são montadas em memória e escritas só no fim, junto com o resumo
+ * (eventos, partidas julgadas e abertas, divergências e eventos por segundo).
+ * Cada linha de partida traz, separados por tabulações:
+ *   <id> <sala final> <movimentos> <pistas> <acusado> <contagem> <veredito> <pistas em ordem, separadas por " | ">
+ * com os mesmos campos do modo em lote do nível mestre (sem o número da linha
+ * e os recusados, que o diário não guarda; o acusado fica vazio se o nome
+ * não era de um suspeito do mapa). Uma partida sem veredito no fim do
+ * diário, como a de um jogador durante uma queda, sai com o veredito ABERTA.
+ *
+ * Termina com erro se o diário for de outro mapa ou se algum evento divergir
+ * do que o motor calcula, o que indica um diário adulterado ou um mapa diferente.
+ */
+
+#define _DEFAULT_SOURCE // MAP_POPULATE
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "conjunto.h"
+#include "diario.h"
+#include "mapa.h"
+#include "mapa_arquivo.h"
+#include "motor.h"
+#include "saida.h"
+
+// Destino das linhas das partidas, preenchido durante a reprodução
+typedef struct SaidaPartidas {
+    Saida saida;       // Sem descritor: só acumula
+    uint32_t *ordem;   // Ids das pistas da partida, em ordem alfabética
+} SaidaPartidas;
+
+static const char *nomeVeredito(const EventoDiario *veredito) {
+    if (veredito == NULL) {
+        return "ABERTA";
+    }
+    switch ((Veredito)veredito->detalhe) {
+        case VEREDITO_SUSTENTADO: return "SUSTENTADA";
+        case VEREDITO_FRACO:      return "FRACA";
+        default:                  return "SEM_PISTAS";
+    }
+}
+
+/**
+ * @brief Formata uma partida refeita (ver o cabeçalho do arquivo).
+ */
+static void formatarPartida(void *contexto, uint32_t id, const Sessao *sessao, const EventoDiario *veredito) {
+    SaidaPartidas *partidas = (SaidaPartidas*)contexto;
+    Saida *saida = &partidas->saida;
+    const Mapa *mapa = sessao->mapa;
+    // O diário guarda o id: um nome que não é de suspeito do mapa sai vazio (null no JSON)
+    const char *acusado = veredito != NULL && veredito->argumento < mapa->suspeitos.total
+                              ? textoDoId(&mapa->suspeitos, veredito->argumento) : NULL;
+    uint32_t contagem = veredito != NULL ? veredito->resultado : 0;
+    uint32_t totalPistas = listarConjuntoPistas(&sessao->pistas, partidas->ordem);
+
+    if (saida->formato == SAIDA_JSON) {
+        saidaTexto(saida, "{\"partida\":");
+        saidaNumero(saida, id);
+        saidaTexto(saida, ",\"salaFinal\":");
+        saidaJsonTexto(saida, mapaNomeSala(mapa, sessao->salaAtual));
+        saidaTexto(saida, ",\"movimentos\":");
+        saidaNumero(saida, sessao->movimentos);
+        saidaTexto(saida, ",\"totalPistas\":");
+        saidaNumero(saida, sessao->totalPistas);
+        saidaTexto(saida, ",\"acusado\":");
+        if (acusado != NULL) {
+            saidaJsonTexto(saida, acusado);
+        } else {
+            saidaTexto(saida, "null");
+        }
+        saidaTexto(saida, ",\"contagem\":");
+        saidaNumero(saida, contagem);
+        saidaTexto(saida, ",\"veredito\":\"");
+        saidaTexto(saida, nomeVeredito(veredito));
+        saidaTexto(saida, "\",\"pistas\":[");
+        for (uint32_t i = 0; i < totalPistas; i++) {
+            if (i > 0) {
+                saidaBytes(saida, ",", 1);
+            }
+            saidaJsonTexto(saida, textoDoId(&mapa->pistas, partidas->ordem[i]));
+        }
+        saidaTexto(saida, "]}\n");
+        return;
+    }
+
+    saidaNumero(saida, id);
+    saidaBytes(saida, "\t", 1);
+    saidaTexto(saida, mapaNomeSala(mapa, sessao->salaAtual));
+    saidaBytes(saida, "\t", 1);
+    saidaNumero(saida, sessao->movimentos);
+    saidaBytes(saida, "\t", 1);
+    saidaNumero(saida, sessao->totalPistas);
+    saidaBytes(saida, "\t", 1);
+    saidaTexto(saida, acusado != NULL ? acusado : "");
+    saidaBytes(saida, "\t", 1);
+    saidaNumero(saida, contagem);
+    saidaBytes(saida, "\t", 1);
+    saidaTexto(saida, nomeVeredito(veredito));
+    saidaBytes(saida, "\t", 1);
+    for (uint32_t i = 0; i < totalPistas; i++) {
+        if (i > 0) {
+            saidaBytes(saida, " | ", 3);
+        }
+        saidaTexto(saida, textoDoId(&mapa->pistas, partidas->ordem[i]));
+    }
+    saidaBytes(saida, "\n", 1);
+}
+
+static void anexarResumo(Saida *saida, const ResumoReproducao *resumo, double segundos) {
+    double porSegundo = segundos > 0 ? (double)resumo->eventos / segundos : 0;
+    if (saida->formato == SAIDA_JSON) {
+        saidaAnexar(saida, "{\"evento\":\"reproducao\",\"eventos\":%llu,\"partidas\":%llu,\"julgadas\":%llu,"
+                           "\"abertas\":%llu,\"divergencias\":%llu,\"bytesIgnorados\":%zu,\"segundos\":%.6f,"
+                           "\"eventosPorSegundo\":%.0f}\n",
+                    (unsigned long long)resumo->eventos, (unsigned long long)resumo->sessoes,
+                    (unsigned long long)resumo->julgadas, (unsigned long long)resumo->abertas,
+                    (unsigned long long)resumo->divergencias, resumo->bytesIgnorados, segundos, porSegundo);
+        return;
+    }
+    saidaAnexar(saida, "Eventos reproduzidos: %llu em %.3f ms (%.1f milhões por segundo)\n",
+                (unsigned long long)resumo->eventos, segundos * 1000.0, porSegundo / 1e6);
+    saidaAnexar(saida, "Partidas: %llu (julgadas: %llu, abertas: %llu)\n", (unsigned long long)resumo->sessoes,
+                (unsigned long long)resumo->julgadas, (unsigned long long)resumo->abertas);
+    saidaAnexar(saida, "Divergências: %llu\n", (unsigned long long)resumo->divergencias);
+    if (resumo->bytesIgnorados > 0) {
+        saidaAnexar(saida, "Evento incompleto no fim do diário: %zu bytes ignorados\n", resumo->bytesIgnorados);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *arquivoMapa = NULL;
+    const char *arquivoDiario = NULL;
+    int comPartidas = 0;
+    int json = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--partidas") == 0) {
+            comPartidas = 1;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else if (argv[i][0] != '-' && arquivoMapa == NULL) {
+            arquivoMapa = argv[i];
+        } else if (argv[i][0] != '-' && arquivoDiario == NULL) {
+            arquivoDiario = argv[i];
+        } else {
+            arquivoDiario = NULL;
+            break;
+        }
+    }
+    if (arquivoDiario == NULL) {
+        fprintf(stderr, "Uso: %s [--partidas] [--json] <mapa.dqm> <diario>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Mapa mapa;
+    mapaInicializar(&mapa);
+    if (abrirMapaArquivo(&mapa, arquivoMapa, 1) != 0) {
+        fprintf(stderr, "Erro ao carregar o mapa '%s'!\n", arquivoMapa);
+        return EXIT_FAILURE;
+    }
+    int descritor = open(arquivoDiario, O_RDONLY | O_CLOEXEC);
+    struct stat informacoes;
+    if (descritor < 0 || fstat(descritor, &informacoes) != 0) {
+        perror(arquivoDiario);
+        if (descritor >= 0) {
+            close(descritor);
+        }
+        fecharMapaArquivo(&mapa);
+        return EXIT_FAILURE;
+    }
+    if (informacoes.st_size == 0) {
+        fprintf(stderr, "'%s' está vazio!\n", arquivoDiario);
+        close(descritor);
+        fecharMapaArquivo(&mapa);
+        return EXIT_FAILURE;
+    }
+    size_t tamanho = (size_t)informacoes.st_size;
+    void *dados = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE | MAP_POPULATE, descritor, 0);
+    close(descritor);
+    if (dados == MAP_FAILED) {
+        perror(arquivoDiario);
+        fecharMapaArquivo(&mapa);
+        return EXIT_FAILURE;
+    }
+
+    SaidaPartidas partidas;
+    iniciarSaida(&partidas.saida, -1, json ? SAIDA_JSON : SAIDA_TEXTO);
+    partidas.ordem = (uint32_t*)malloc(((size_t)mapa.pistas.total + 1) * sizeof(uint32_t));
+    if (partidas.ordem == NULL) {
+        printf("Erro de alocação de memória para a reprodução!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    ResumoReproducao resumo;
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    int resultado = reproduzirDiario(&mapa, (const unsigned char*)dados, tamanho,
+                                     comPartidas ? formatarPartida : NULL, &partidas, &resumo);
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    munmap(dados, tamanho);
+
+    Saida saida;
+    iniciarSaida(&saida, STDOUT_FILENO, json ? SAIDA_JSON : SAIDA_TEXTO);
+    if (resultado != 0) {
+        fprintf(stderr, "'%s' não é um diário do mapa '%s'!\n", arquivoDiario, arquivoMapa);
+    } else {
+        double segundos = (double)(fim.tv_sec - inicio.tv_sec) + (double)(fim.tv_nsec - inicio.tv_nsec) / 1e9;
+        if (partidas.saida.tamanho > 0) {
+            saidaBytes(&saida, partidas.saida.texto, partidas.saida.tamanho);
+        }
+        anexarResumo(&saida, &resumo, segundos);
+        saidaDescarregar(&saida);
+    }
+    liberarSaida(&saida);
+    liberarSaida(&partidas.saida);
+    free(partidas.ordem);
+    fecharMapaArquivo(&mapa);
+    return resultado == 0 && resumo.divergencias == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
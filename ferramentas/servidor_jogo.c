@@ -0,0 +1,168 @@
+/**
+ * @file servidor_jogo.c
+ * @brief Serve partidas do Detective Quest pela rede, muitas por thread (servidor.h).
+ *
+ * Uso: servidor_jogo [opções] <mapa.dqm>
+ *
+ *   --porta N                 porta TCP (padrão 7070; 0: uma porta livre)
+ *   --endereco A              endereço IPv4 de escuta (padrão: todos)
+ *   --threads N               threads do servidor (padrão: uma por processador)
+ *   --paginas N               abre o mapa paginado (paginas.h), com até N páginas residentes
+ *   --diario <arquivo>        registra as partidas no diário (diario.h), para auditoria e reprodução
+ *   --instrumentos            ao encerrar, escreve na saída de erro o resumo dos instrumentos
+ *   --rastro <arquivo.json>   grava os eventos de cada requisição no formato de rastro do Chrome
+ *
+ * Cada conexão é uma partida, conduzida pelo protocolo de protocolo.h (uma
+ * requisição por linha, uma resposta JSON por linha), ex.:
+ * "printf 'm ee\na Coronel Mostarda\nf\n' | nc localhost 7070". O servidor
+ * roda até receber SIGINT ou SIGTERM. Com "--instrumentos" (e
+ * -DDQ_INSTRUMENTOS=ON), o resumo traz o tempo de cada requisição e a memória
+ * de cada sessão, medida ao fechar a conexão.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "diario.h"
+#include "instrumentos.h"
+#include "mapa.h"
+#include "mapa_arquivo.h"
+#include "paginas.h"
+#include "saida.h"
+#include "servidor.h"
+
+static Servidor servidor;
+
+static void aoSinal(int sinal) {
+    (void)sinal;
+    servidorParar(&servidor);
+}
+
+/**
+ * @brief Lê um inteiro sem sinal até `maximo`; encerra com uma mensagem se o texto for inválido.
+ */
+static unsigned long lerInteiro(const char *opcao, const char *texto, unsigned long maximo) {
+    char *fim;
+    unsigned long long valor = strtoull(texto, &fim, 10);
+    if (fim == texto || *fim != '\0' || texto[0] == '-' || valor > maximo) {
+        fprintf(stderr, "%s: valor inválido \"%s\"\n", opcao, texto);
+        exit(EXIT_FAILURE);
+    }
+    return (unsigned long)valor;
+}
+
+int main(int argc, char *argv[]) {
+    const char *arquivoMapa = NULL;
+    const char *endereco = NULL;
+    const char *arquivoRastro = NULL;
+    const char *arquivoDiario = NULL;
+    uint16_t porta = 7070;
+    unsigned totalThreads = 0;
+    int comInstrumentos = 0;
+    int paginado = 0;
+    uint32_t paginasResidentes = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--porta") == 0 && i + 1 < argc) {
+            porta = (uint16_t)lerInteiro(argv[i], argv[i + 1], UINT16_MAX);
+            i++;
+        } else if (strcmp(argv[i], "--endereco") == 0 && i + 1 < argc) {
+            endereco = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            totalThreads = (unsigned)lerInteiro(argv[i], argv[i + 1], 4096);
+            i++;
+        } else if (strcmp(argv[i], "--paginas") == 0 && i + 1 < argc) {
+            paginado = 1;
+            paginasResidentes = (uint32_t)lerInteiro(argv[i], argv[i + 1], UINT32_MAX);
+            i++;
+        } else if (strcmp(argv[i], "--diario") == 0 && i + 1 < argc) {
+            arquivoDiario = argv[++i];
+        } else if (strcmp(argv[i], "--instrumentos") == 0) {
+            comInstrumentos = 1;
+        } else if (strcmp(argv[i], "--rastro") == 0 && i + 1 < argc) {
+            arquivoRastro = argv[++i];
+        } else if (arquivoMapa == NULL && argv[i][0] != '-') {
+            arquivoMapa = argv[i];
+        } else {
+            arquivoMapa = NULL;
+            break;
+        }
+    }
+    if (arquivoMapa == NULL) {
+        fprintf(stderr, "Uso: %s [--porta N] [--endereco A] [--threads N] [--paginas N] [--diario <arquivo>]\n"
+                        "       [--instrumentos] [--rastro <arquivo.json>] <mapa.dqm>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if ((comInstrumentos || arquivoRastro != NULL) && !INSTRUMENTOS_LIGADOS) {
+        fprintf(stderr, "Aviso: instrumentos desligados nesta compilação (use -DDQ_INSTRUMENTOS=ON).\n");
+        comInstrumentos = 0;
+        arquivoRastro = NULL;
+    }
+
+    Mapa mapa;
+    mapaInicializar(&mapa);
+    if (abrirMapaArquivo(&mapa, arquivoMapa, !paginado) != 0 || mapa.totalSalas == 0 ||
+        (paginado && mapaAtivarPaginas(&mapa, paginasResidentes) != 0)) {
+        fprintf(stderr, "Erro ao carregar o mapa '%s'!\n", arquivoMapa);
+        fecharMapaArquivo(&mapa);
+        return EXIT_FAILURE;
+    }
+    Diario diario;
+    if (arquivoDiario != NULL && abrirDiario(&diario, &mapa, arquivoDiario) != 0) {
+        fprintf(stderr, "Erro ao abrir o diário '%s': %s\n", arquivoDiario, strerror(errno));
+        fecharMapaArquivo(&mapa);
+        return EXIT_FAILURE;
+    }
+    if (iniciarServidor(&servidor, &mapa, endereco, porta, totalThreads) != 0) {
+        fprintf(stderr, "Erro ao abrir o servidor na porta %u: %s\n", porta, strerror(errno));
+        if (arquivoDiario != NULL) {
+            fecharDiario(&diario);
+        }
+        fecharMapaArquivo(&mapa);
+        return EXIT_FAILURE;
+    }
+    if (arquivoDiario != NULL) {
+        servidorAtivarDiario(&servidor, &diario);
+    }
+
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = aoSinal;
+    sigemptyset(&acao.sa_mask);
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+
+    if (arquivoRastro != NULL) {
+        instrumentosIniciarRastro();
+    }
+    printf("Servidor ouvindo na porta %u com %u threads.\n", servidor.porta, servidor.totalThreads);
+    fflush(stdout);
+    servidorRodar(&servidor);
+    encerrarServidor(&servidor);
+    int resultado = EXIT_SUCCESS;
+    if (arquivoDiario != NULL && fecharDiario(&diario) != 0) {
+        fprintf(stderr, "Erro ao gravar o diário '%s': %s\n", arquivoDiario, strerror(errno));
+        resultado = EXIT_FAILURE;
+    }
+
+    if (comInstrumentos) {
+        Instrumentos instrumentos;
+        instrumentosSomar(&instrumentos);
+        Saida erro;
+        iniciarSaida(&erro, STDERR_FILENO, SAIDA_TEXTO);
+        anexarResumoInstrumentos(&erro, &instrumentos);
+        saidaDescarregar(&erro);
+        liberarSaida(&erro);
+    }
+    if (arquivoRastro != NULL && instrumentosGravarRastro(arquivoRastro) != 0) {
+        fprintf(stderr, "Erro ao gravar o rastro '%s'!\n", arquivoRastro);
+    }
+    fecharMapaArquivo(&mapa);
+    return resultado;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file detective_quest_aventureiro.c
+ * @brief Simula a exploração da mansão e a coleta de pistas: uma Árvore Binária
+ * para o mapa e um conjunto ordenado (bits por id) para as pistas.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "conjunto.h"
+#include "mapa.h"
+#include "mapa_arquivo.h"
+#include "motor.h"
+#include "saida.h"
+
+// --- Definição das Estruturas ---
+// O mapa usa a representação plana de mapa.h (Mapa/SalaPlana), embutida no
+// executável a partir de mapas/mansao_aventureiro.txt (abrirMapaEmbutido()).
+// As pistas são internadas no mapa em ordem alfabética, e a sessão guarda só
+// os ids coletados.
+
+// --- Funções para as Pistas Coletadas ---
+// ConjuntoPistas e anexarConjuntoPistas() vêm de conjunto.h (um bit por id,
+// percorrido em ordem alfabética); a BST de pistas.h fica para quem monta a
+// própria árvore.
+
+// --- Função Principal de Exploração ---
+
+/**
+ * @brief Controla a navegação do jogador entre salas e coleta de pistas.
+ *
+ * Permite a escolha de uma saída pela tecla ('e' para esquerda, 'd' para
+ * direita nas salas binárias) ou 's' (sair).
+ * Coleta automaticamente pistas ao entrar em novos cômodos (via motor.h).
+ * Cada turno é escrito de uma vez, antes de ler a escolha.
+ * @param sessao A sessão em andamento.
+ * @param saida A saída do jogo.
+ */
+void explorarSalasComPistas(Sessao* sessao, Saida* saida) {
+    const Mapa *mapa = sessao->mapa;
+    char escolha;
+    
+    saidaTexto(saida, "\n--- Explorando a Mansão em Busca de Pistas ---\n");
+    
+    while (!sessao->encerrada) {
+        const SaidaSala *saidas = mapaSaidas(mapa, sessao->salaAtual);
+        uint32_t totalSaidas = mapaTotalSaidas(mapa, sessao->salaAtual);
+        saidaTexto(saida, "\nVocê está em: **");
+        saidaTexto(saida, mapaNomeSala(mapa, sessao->salaAtual));
+        saidaTexto(saida, "**\n");
+        
+        // Coleta de Pista (a pista sai da sala para evitar coleta duplicada)
+        uint32_t pista = sessaoColetar(sessao);
+        if (pista != TEXTO_NENHUM) {
+            saidaTexto(saida, "✅ Pista Encontrada: \"");
+            saidaTexto(saida, textoDoId(&mapa->pistas, pista));
+            saidaTexto(saida, "\"\n");
+        } else {
+            saidaTexto(saida, "  (Nenhuma pista nova neste cômodo.)\n");
+        }
+        
+        // ------------------------------------
+        // Menu de Opções
+        // ------------------------------------
+        saidaTexto(saida, "\nEscolha o próximo caminho:\n");
+        for (uint32_t i = 0; i < totalSaidas; i++) {
+            char tecla[5] = { ' ', ' ', '[', saidas[i].tecla != '\0' ? saidas[i].tecla : '-', ']' };
+            saidaBytes(saida, tecla, sizeof(tecla));
+            saidaTexto(saida, " ");
+            saidaTexto(saida, mapaRotuloSaida(mapa, &saidas[i]));
+            saidaTexto(saida, " (Para ");
+            saidaTexto(saida, mapaNomeSala(mapa, saidas[i].destino));
+            saidaTexto(saida, ")\n");
+        }
+        saidaTexto(saida, "  [s] Sair e Analisar Pistas\n");
+        saidaTexto(saida, "Sua escolha: ");
+        saidaDescarregar(saida);
+        
+        if (scanf(" %c", &escolha) != 1) {
+            escolha = 's'; // Fim da entrada: encerra a exploração
+        }
+        
+        // ------------------------------------
+        // Navegação
+        // ------------------------------------
+        Movimento movimento = sessaoMover(sessao, escolha);
+        if (movimento == MOVIMENTO_BLOQUEADO) {
+            saidaTexto(saida, "Caminho não disponível. Tente novamente.\n");
+        } else if (movimento == MOVIMENTO_INVALIDO) {
+            saidaTexto(saida, "Opção inválida. Use 'e', 'd' ou 's'.\n");
+        }
+    }
+}
+
+/**
+ * @brief Abre a mansão embutida, inicia a exploração e exibe os resultados.
+ */
+int main() {
+    // ------------------------------------------------------------------
+    // 1. Mapa da Mansão: imagem constante embutida na compilação (mapas/mansao_aventureiro.txt)
+    // ------------------------------------------------------------------
+    Mapa mapa;
+    if (abrirMapaEmbutido(&mapa, &mansaoEmbutida) != 0) {
+        printf("Erro ao carregar a mansão embutida!\n");
+        return EXIT_FAILURE;
+    }
+    
+    // ------------------------------------------------------------------
+    // 2. Início da Exploração e Coleta de Pistas
+    // ------------------------------------------------------------------
+    Sessao sessao;
+    iniciarSessao(&sessao, &mapa);
+    Saida saida;
+    iniciarSaida(&saida, STDOUT_FILENO, SAIDA_TEXTO);
+    explorarSalasComPistas(&sessao, &saida);
+    
+    // ------------------------------------------------------------------
+    // 3. Exibição dos Resultados (Pistas em Ordem Alfabética)
+    // ------------------------------------------------------------------
+    saidaTexto(&saida, "\n============================================\n");
+    saidaTexto(&saida, "🔎 ANÁLISE FINAL: PISTAS COLETADAS (Ordem Alfabética)\n");
+    saidaTexto(&saida, "============================================\n");
+    
+    if (sessao.totalPistas == 0) {
+        saidaTexto(&saida, "Nenhuma pista foi coletada durante a exploração.\n");
+    } else {
+        anexarConjuntoPistas(&saida, &sessao.pistas, &mapa.pistas);
+    }
+    saidaDescarregar(&saida);
+
+    // ------------------------------------------------------------------
+    // 4. Limpeza de Memória (pistas saem juntas com a arena da sessão)
+    // ------------------------------------------------------------------
+    liberarSaida(&saida);
+    encerrarSessao(&sessao);
+    fecharMapaArquivo(&mapa);
+    
+    return 0;
+}
@@ -0,0 +1,1250 @@
+/**
+ * @file detective_quest_mestre.c
+ * @brief Sistema completo de exploração da mansão, coleta de pistas (conjunto ordenado) e
+ * associação a suspeitos (Tabela Hash) para a fase de julgamento final.
+ *
+ * Uso: sem argumentos, joga na mansão embutida (mapas/mansao_mestre.txt,
+ * compilada para uma tabela constante do executável); com um arquivo .dqm
+ * (gerado por compilador_mapa), joga no mapa do arquivo.
+ *
+ * Modo em lote: "--lote <roteiros.txt|->" roda, sem interação, uma partida por
+ * linha do arquivo (ou da entrada padrão) no formato "<movimentos> | <acusado>",
+ * ex.: "eds | D. Branca", e escreve uma linha de resultado por partida. As
+ * partidas rodam em paralelo ("--threads N"; padrão: todos os processadores)
+ * sobre o mesmo mapa.
+ *
+ * "--resolver" percorre todos os caminhos simples da raiz até uma saída (solucionador.h)
+ * e mostra, para cada suspeito, em quantos caminhos a acusação seria sustentada.
+ *
+ * "--retrato <arquivo>" grava o estado da partida (retrato.h) a cada sala
+ * nova e, se o arquivo já existir, retoma a partida de onde ela parou. Com
+ * "--retrato", o fim da entrada pausa a partida em vez de levá-la ao
+ * julgamento, e o retrato é apagado quando ela é julgada.
+ *
+ * "--dicas" acrescenta ao menu a opção '?', que mostra a pista mais próxima
+ * ainda não coletada e quantos movimentos faltam para sustentar a acusação de
+ * cada suspeito (dicas.h).
+ *
+ * "--busca" acrescenta ao menu a opção '/', que lê um termo e lista as pistas
+ * coletadas que o contêm, sem diferenciar maiúsculas; um termo terminado em '*'
+ * ("Chave*") lista as que começam com ele (busca.h).
+ *
+ * "--paginas N" abre o mapa .dqm paginado (paginas.h): a abertura não percorre
+ * o arquivo, cada página de salas é validada quando a exploração chega nela, e
+ * no máximo N páginas ficam residentes (0: PAGINAS_RESIDENTES_PADRAO). Não vale
+ * com "--resolver", "--dicas" e "--busca", que leem o mapa inteiro.
+ *
+ * "--diario <arquivo>" registra as partidas (interativa ou em lote) em um
+ * diário binário só de acréscimo (diario.h): movimentos, pistas coletadas e
+ * vereditos, para auditoria e para refazer as partidas com reprodutor_diario.
+ * Não vale com "--resolver", que não joga partidas.
+ *
+ * "--json" troca o texto para o jogador por um objeto JSON por linha (JSON
+ * lines), nos três modos, para ser lido por outros programas.
+ *
+ * "--instrumentos" escreve na saída de erro, ao fim, as contagens dos caminhos
+ * quentes (pistas inseridas e repetidas, sondagens das tabelas, tempo por movimento e por
+ * turno), e "--rastro <arquivo.json>" grava os eventos de cada partida e de
+ * cada turno no formato de rastro do Chrome (instrumentos.h). As duas opções
+ * exigem a compilação com -DDQ_INSTRUMENTOS=ON.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "conjunto.h"
+#include "diario.h"
+#include "dicas.h"
+#include "executor.h"
+#include "instrumentos.h"
+#include "mapa.h"
+#include "mapa_arquivo.h"
+#include "motor.h"
+#include "paginas.h"
+#include "retrato.h"
+#include "saida.h"
+#include "solucionador.h"
+#include "suspeitos.h"
+
+// --- 1. Estruturas para o Mapa (Grafo de Salas) ---
+// O mapa usa a representação plana de mapa.h (Mapa/SalaPlana, com criarSala()).
+// As passagens (SaidaSala) ficam em formato CSR; cada uma tem sua tecla.
+// Pistas e suspeitos são internados no mapa; o conjunto de pistas e a hash trabalham com ids.
+
+// --- 2. Estruturas para as Pistas Coletadas ---
+// As pistas coletadas ficam em um ConjuntoPistas (conjunto.h): um bit por id,
+// sobre o vetor de pistas do mapa, já em ordem alfabética.
+
+// --- 3. Estruturas para a Tabela Hash (Suspeitos) ---
+// SuspeitoHash, inserirNaHash() e encontrarSuspeito() vêm de suspeitos.h
+// (endereçamento aberto, cresce automaticamente), junto com o PlacarSuspeitos,
+// que mantém a pontuação de cada suspeito durante a exploração. Uma pista pode
+// incriminar vários suspeitos, com pesos (AlvoPeso, em mapa.h).
+
+// --- 4. Regras do Jogo ---
+// Sessao, sessaoColetar(), sessaoMover() e sessaoAcusar() vêm de motor.h; as
+// funções abaixo só cuidam da interação com o jogador.
+
+// --- Saída do Jogo ---
+// Cada turno e cada relatório é montado em uma Saida (saida.h) e escrito de
+// uma vez. Com "--json" os mesmos eventos saem como um objeto JSON por linha.
+
+static const char *nomeVeredito(Veredito veredito) {
+    switch (veredito) {
+        case VEREDITO_SUSTENTADO: return "SUSTENTADA";
+        case VEREDITO_FRACO:      return "FRACA";
+        default:                  return "SEM_PISTAS";
+    }
+}
+
+/**
+ * @brief Acrescenta um texto JSON, ou null para texto vazio (sala, pista ou suspeito inexistente).
+ */
+static void anexarJsonOpcional(Saida *saida, const char *texto) {
+    if (texto[0] == '\0') {
+        saidaBytes(saida, "null", 4);
+    } else {
+        saidaJsonTexto(saida, texto);
+    }
+}
+
+/**
+ * @brief Acrescenta o nome de uma sala vizinha, ou null se não houver caminho.
+ */
+static void anexarJsonSala(Saida *saida, const Mapa *mapa, uint32_t sala) {
+    anexarJsonOpcional(saida, sala != MAPA_NENHUM ? mapaNomeSala(mapa, sala) : "");
+}
+
+/**
+ * @brief Acrescenta as pistas da sessão, em ordem alfabética, como um vetor JSON.
+ * @param ordem Vetor com espaço para todas as pistas do mapa.
+ */
+static void anexarJsonPistas(Saida *saida, const Sessao *sessao, uint32_t *ordem) {
+    uint32_t totalPistas = listarConjuntoPistas(&sessao->pistas, ordem);
+    saidaBytes(saida, "[", 1);
+    for (uint32_t i = 0; i < totalPistas; i++) {
+        if (i > 0) {
+            saidaBytes(saida, ",", 1);
+        }
+        saidaJsonTexto(saida, textoDoId(&sessao->mapa->pistas, ordem[i]));
+    }
+    saidaBytes(saida, "]", 1);
+}
+
+/**
+ * @brief Suspeitos incriminados pela pista de uma sala, no formato texto.
+ *
+ * Um único suspeito com peso 1 aparece só pelo nome; nos demais casos cada
+ * nome vem seguido do peso, ex.: "Coronel Mostarda (peso 2), D. Branca (peso 1)".
+ */
+static void anexarAlvosTexto(Saida *saida, const Mapa *mapa, uint32_t sala) {
+    const AlvoPeso *alvos = mapaAlvos(mapa, sala);
+    uint32_t total = mapaTotalAlvos(mapa, sala);
+    saidaTexto(saida, total > 1 ? "   * Pista associada aos suspeitos: " : "   * Pista associada ao suspeito: ");
+    for (uint32_t i = 0; i < total; i++) {
+        if (i > 0) {
+            saidaBytes(saida, ", ", 2);
+        }
+        saidaTexto(saida, textoDoId(&mapa->suspeitos, alvos[i].suspeito));
+        if (total > 1 || alvos[i].peso != 1) {
+            saidaTexto(saida, " (peso ");
+            saidaNumero(saida, alvos[i].peso);
+            saidaBytes(saida, ")", 1);
+        }
+    }
+    saidaBytes(saida, "\n", 1);
+}
+
+/**
+ * @brief Suspeitos incriminados pela pista de uma sala, como vetor JSON [{"nome":..,"peso":..}].
+ */
+static void anexarAlvosJson(Saida *saida, const Mapa *mapa, uint32_t sala) {
+    const AlvoPeso *alvos = mapaAlvos(mapa, sala);
+    uint32_t total = mapaTotalAlvos(mapa, sala);
+    saidaBytes(saida, "[", 1);
+    for (uint32_t i = 0; i < total; i++) {
+        saidaTexto(saida, i > 0 ? ",{\"nome\":" : "{\"nome\":");
+        saidaJsonTexto(saida, textoDoId(&mapa->suspeitos, alvos[i].suspeito));
+        saidaTexto(saida, ",\"peso\":");
+        saidaNumero(saida, alvos[i].peso);
+        saidaBytes(saida, "}", 1);
+    }
+    saidaBytes(saida, "]", 1);
+}
+
+/**
+ * @brief Classificação de todos os suspeitos pelo placar da sessão (classificarSuspeitos()).
+ *
+ * No formato texto, uma linha "   N. Nome: P ponto(s)" por suspeito; no JSON,
+ * o vetor [{"nome":..,"pontos":..}], da maior para a menor pontuação.
+ */
+static void anexarPlacar(Saida *saida, const Sessao *sessao, int json) {
+    const Mapa *mapa = sessao->mapa;
+    uint32_t *ordem = (uint32_t*)malloc(((size_t)sessao->placar.totalSuspeitos + 1) * sizeof(uint32_t));
+    if (ordem == NULL) {
+        printf("Erro de alocação de memória para o placar!\n");
+        exit(EXIT_FAILURE);
+    }
+    classificarSuspeitos(&sessao->placar, ordem);
+    if (json) {
+        saidaBytes(saida, "[", 1);
+    } else {
+        saidaTexto(saida, "\n--- Placar dos Suspeitos ---\n");
+    }
+    for (uint32_t i = 0; i < sessao->placar.totalSuspeitos; i++) {
+        uint32_t pontos = placarContagem(&sessao->placar, ordem[i]);
+        if (json) {
+            saidaTexto(saida, i > 0 ? ",{\"nome\":" : "{\"nome\":");
+            saidaJsonTexto(saida, textoDoId(&mapa->suspeitos, ordem[i]));
+            saidaTexto(saida, ",\"pontos\":");
+            saidaNumero(saida, pontos);
+            saidaBytes(saida, "}", 1);
+        } else {
+            saidaAnexar(saida, "   %u. %s: %u ponto(s)\n", i + 1, textoDoId(&mapa->suspeitos, ordem[i]), pontos);
+        }
+    }
+    if (json) {
+        saidaBytes(saida, "]", 1);
+    }
+    free(ordem);
+}
+
+/**
+ * @brief Indica se todas as saídas da sala usam as teclas 'e' e 'd'.
+ */
+static int salaBinaria(const Mapa *mapa, uint32_t sala) {
+    const SaidaSala *saidas = mapaSaidas(mapa, sala);
+    uint32_t totalSaidas = mapaTotalSaidas(mapa, sala);
+    for (uint32_t i = 0; i < totalSaidas; i++) {
+        if (saidas[i].tecla != 'e' && saidas[i].tecla != 'd') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Turno no formato texto: sala atual, pista coletada e menu de caminhos.
+ */
+static void anexarTurnoTexto(Saida *saida, const Mapa *mapa, uint32_t salaAtual, uint32_t pista, int dicas, int busca) {
+    const SaidaSala *saidas = mapaSaidas(mapa, salaAtual);
+    uint32_t totalSaidas = mapaTotalSaidas(mapa, salaAtual);
+    saidaTexto(saida, "\nVocê está em: **");
+    saidaTexto(saida, mapaNomeSala(mapa, salaAtual));
+    saidaTexto(saida, "**\n");
+
+    if (pista != TEXTO_NENHUM) {
+        saidaTexto(saida, "✅ Pista Encontrada: \"");
+        saidaTexto(saida, textoDoId(&mapa->pistas, pista));
+        saidaTexto(saida, "\"\n");
+        anexarAlvosTexto(saida, mapa, salaAtual);
+    } else {
+        saidaTexto(saida, "  (Nenhuma pista nova neste cômodo.)\n");
+    }
+
+    saidaTexto(saida, "\nCaminhos disponíveis:\n");
+    for (uint32_t i = 0; i < totalSaidas; i++) {
+        char tecla[5] = { ' ', ' ', '[', saidas[i].tecla != '\0' ? saidas[i].tecla : '-', ']' };
+        saidaBytes(saida, tecla, sizeof(tecla));
+        saidaTexto(saida, " ");
+        saidaTexto(saida, mapaRotuloSaida(mapa, &saidas[i]));
+        saidaTexto(saida, " (Para ");
+        saidaTexto(saida, mapaNomeSala(mapa, saidas[i].destino));
+        saidaTexto(saida, ")\n");
+    }
+    if (dicas) {
+        saidaTexto(saida, "  [?] Pedir uma dica\n");
+    }
+    if (busca) {
+        saidaTexto(saida, "  [/] Buscar nas pistas coletadas\n");
+    }
+    saidaTexto(saida, "  [s] SAIR e ACUSAR o Culpado\n");
+    saidaTexto(saida, "Sua escolha: ");
+}
+
+/**
+ * @brief Turno no formato JSON:
+ *   {"evento":"sala","sala":...,"pista":...|null,"suspeito":...|null,"alvos":[...],
+ *    "esquerda":...|null,"direita":...|null,"saidas":[{"tecla":...|null,"rotulo":...,"sala":...},...]}
+ *
+ * "suspeito" é o primeiro dos "alvos" (os suspeitos da pista, com pesos).
+ * "esquerda" e "direita" são os destinos das teclas 'e' e 'd'; "saidas" lista
+ * todas as saídas da sala, em ordem.
+ */
+static void anexarTurnoJson(Saida *saida, const Mapa *mapa, uint32_t salaAtual, uint32_t pista) {
+    const SaidaSala *saidas = mapaSaidas(mapa, salaAtual);
+    uint32_t totalSaidas = mapaTotalSaidas(mapa, salaAtual);
+    uint32_t esquerda = mapaProcurarSaida(mapa, salaAtual, 'e');
+    uint32_t direita = mapaProcurarSaida(mapa, salaAtual, 'd');
+    saidaTexto(saida, "{\"evento\":\"sala\",\"sala\":");
+    saidaJsonTexto(saida, mapaNomeSala(mapa, salaAtual));
+    saidaTexto(saida, ",\"pista\":");
+    anexarJsonOpcional(saida, pista != TEXTO_NENHUM ? textoDoId(&mapa->pistas, pista) : "");
+    saidaTexto(saida, ",\"suspeito\":");
+    anexarJsonOpcional(saida, pista != TEXTO_NENHUM ? mapaAlvoSala(mapa, salaAtual) : "");
+    saidaTexto(saida, ",\"alvos\":");
+    if (pista != TEXTO_NENHUM) {
+        anexarAlvosJson(saida, mapa, salaAtual);
+    } else {
+        saidaBytes(saida, "[]", 2);
+    }
+    saidaTexto(saida, ",\"esquerda\":");
+    anexarJsonSala(saida, mapa, esquerda != MAPA_NENHUM ? saidas[esquerda].destino : MAPA_NENHUM);
+    saidaTexto(saida, ",\"direita\":");
+    anexarJsonSala(saida, mapa, direita != MAPA_NENHUM ? saidas[direita].destino : MAPA_NENHUM);
+    saidaTexto(saida, ",\"saidas\":[");
+    for (uint32_t i = 0; i < totalSaidas; i++) {
+        char tecla[2] = { saidas[i].tecla, '\0' };
+        saidaTexto(saida, i > 0 ? ",{\"tecla\":" : "{\"tecla\":");
+        anexarJsonOpcional(saida, tecla);
+        saidaTexto(saida, ",\"rotulo\":");
+        saidaJsonTexto(saida, mapaRotuloSaida(mapa, &saidas[i]));
+        saidaTexto(saida, ",\"sala\":");
+        anexarJsonSala(saida, mapa, saidas[i].destino);
+        saidaBytes(saida, "}", 1);
+    }
+    saidaTexto(saida, "]}\n");
+}
+
+// --- Dicas ---
+
+/**
+ * @brief Acrescenta " (siga [k] Rótulo)" com a primeira saída até o destino, se houver.
+ */
+static void anexarPassoTexto(Saida *saida, IndiceDicas *dicas, uint32_t origem, uint32_t destino) {
+    uint32_t passo = dicaPrimeiroPasso(dicas, origem, destino);
+    if (passo == MAPA_NENHUM) {
+        return;
+    }
+    const SaidaSala *saidaSala = &mapaSaidas(dicas->mapa, origem)[passo];
+    char tecla[2] = { saidaSala->tecla != '\0' ? saidaSala->tecla : '-', '\0' };
+    saidaTexto(saida, " (siga [");
+    saidaTexto(saida, tecla);
+    saidaTexto(saida, "] ");
+    saidaTexto(saida, mapaRotuloSaida(dicas->mapa, saidaSala));
+    saidaTexto(saida, ")");
+}
+
+/**
+ * @brief Dica no formato texto: a pista mais próxima e o caminho até cada acusação sustentada.
+ */
+static void anexarDicaTexto(Saida *saida, IndiceDicas *dicas, const Sessao *sessao) {
+    const Mapa *mapa = sessao->mapa;
+    uint32_t origem = sessao->salaAtual;
+    uint32_t movimentos;
+    uint32_t sala = dicaPistaMaisProxima(dicas, sessao, &movimentos);
+    if (sala == MAPA_NENHUM) {
+        saidaTexto(saida, "💡 Dica: não há mais pistas alcançáveis a partir daqui.\n");
+    } else {
+        saidaAnexar(saida, "💡 Dica: a pista mais próxima está em **%s**, a %u movimento(s)", mapaNomeSala(mapa, sala), movimentos);
+        anexarPassoTexto(saida, dicas, origem, sala);
+        saidaTexto(saida, ".\n");
+    }
+    for (uint32_t suspeito = 0; suspeito < mapa->suspeitos.total; suspeito++) {
+        uint32_t destino;
+        movimentos = dicaSustentarAcusacao(dicas, sessao, suspeito, &destino);
+        saidaTexto(saida, "   * ");
+        saidaTexto(saida, textoDoId(&mapa->suspeitos, suspeito));
+        if (movimentos == MAPA_NENHUM) {
+            saidaTexto(saida, ": nenhum caminho sustenta a acusação.\n");
+        } else if (movimentos == 0) {
+            saidaTexto(saida, ": a acusação já seria sustentada.\n");
+        } else {
+            saidaAnexar(saida, ": %s%u movimento(s) para sustentar a acusação (até **%s**)",
+                        dicas->arvore ? "" : "pelo menos ", movimentos, mapaNomeSala(mapa, destino));
+            anexarPassoTexto(saida, dicas, origem, destino);
+            saidaTexto(saida, ".\n");
+        }
+    }
+}
+
+/**
+ * @brief Dica no formato JSON:
+ *   {"evento":"dica","pista":{"sala":...,"movimentos":N,"tecla":...|null}|null,"exata":true|false,
+ *    "suspeitos":[{"nome":...,"movimentos":N|null,"sala":...|null,"tecla":...|null},...]}
+ *
+ * "tecla" é a da primeira saída do caminho; "exata" é false quando os
+ * movimentos dos suspeitos são um limite inferior (mapas que não são árvores).
+ */
+static void anexarDicaJson(Saida *saida, IndiceDicas *dicas, const Sessao *sessao) {
+    const Mapa *mapa = sessao->mapa;
+    uint32_t origem = sessao->salaAtual;
+    uint32_t movimentos;
+    uint32_t sala = dicaPistaMaisProxima(dicas, sessao, &movimentos);
+    saidaTexto(saida, "{\"evento\":\"dica\",\"pista\":");
+    if (sala == MAPA_NENHUM) {
+        saidaBytes(saida, "null", 4);
+    } else {
+        uint32_t passo = dicaPrimeiroPasso(dicas, origem, sala);
+        char tecla[2] = { passo != MAPA_NENHUM ? mapaSaidas(mapa, origem)[passo].tecla : '\0', '\0' };
+        saidaTexto(saida, "{\"sala\":");
+        saidaJsonTexto(saida, mapaNomeSala(mapa, sala));
+        saidaTexto(saida, ",\"movimentos\":");
+        saidaNumero(saida, movimentos);
+        saidaTexto(saida, ",\"tecla\":");
+        anexarJsonOpcional(saida, tecla);
+        saidaBytes(saida, "}", 1);
+    }
+    saidaTexto(saida, dicas->arvore ? ",\"exata\":true,\"suspeitos\":[" : ",\"exata\":false,\"suspeitos\":[");
+    for (uint32_t suspeito = 0; suspeito < mapa->suspeitos.total; suspeito++) {
+        uint32_t destino;
+        movimentos = dicaSustentarAcusacao(dicas, sessao, suspeito, &destino);
+        uint32_t passo = movimentos != MAPA_NENHUM ? dicaPrimeiroPasso(dicas, origem, destino) : MAPA_NENHUM;
+        char tecla[2] = { passo != MAPA_NENHUM ? mapaSaidas(mapa, origem)[passo].tecla : '\0', '\0' };
+        saidaTexto(saida, suspeito > 0 ? ",{\"nome\":" : "{\"nome\":");
+        saidaJsonTexto(saida, textoDoId(&mapa->suspeitos, suspeito));
+        saidaTexto(saida, ",\"movimentos\":");
+        if (movimentos == MAPA_NENHUM) {
+            saidaBytes(saida, "null", 4);
+        } else {
+            saidaNumero(saida, movimentos);
+        }
+        saidaTexto(saida, ",\"sala\":");
+        anexarJsonSala(saida, mapa, destino);
+        saidaTexto(saida, ",\"tecla\":");
+        anexarJsonOpcional(saida, tecla);
+        saidaBytes(saida, "}", 1);
+    }
+    saidaTexto(saida, "]}\n");
+}
+
+// --- Busca nas Pistas ---
+
+/**
+ * @brief Lê um termo e mostra as pistas coletadas que o contêm (ou que começam com ele, se terminar em '*').
+ *
+ * No formato JSON: {"evento":"busca","termo":...,"modo":"trecho"|"prefixo","pistas":[...]}.
+ * Se a entrada terminar antes do termo, nada é escrito.
+ */
+static void anexarBusca(Saida *saida, const Sessao *sessao) {
+    char termo[100];
+    if (scanf(" %99[^\n]", termo) != 1) {
+        return;
+    }
+    size_t tamanho = strlen(termo);
+    while (tamanho > 0 && (termo[tamanho - 1] == ' ' || termo[tamanho - 1] == '\r')) {
+        termo[--tamanho] = '\0';
+    }
+    int prefixo = tamanho > 0 && termo[tamanho - 1] == '*';
+    if (prefixo) {
+        termo[--tamanho] = '\0';
+    }
+
+    const Internador *pistas = &sessao->mapa->pistas;
+    uint32_t *encontradas = (uint32_t*)malloc(((size_t)sessao->totalPistas + 1) * sizeof(uint32_t));
+    if (encontradas == NULL) {
+        printf("Erro de alocação de memória para a busca!\n");
+        exit(EXIT_FAILURE);
+    }
+    uint32_t total = prefixo ? buscarPrefixo(&sessao->pistas, pistas, termo, encontradas)
+                             : buscarTrecho(&sessao->busca, &sessao->pistas, pistas, termo, encontradas);
+
+    if (saida->formato == SAIDA_JSON) {
+        saidaTexto(saida, "{\"evento\":\"busca\",\"termo\":");
+        saidaJsonTexto(saida, termo);
+        saidaTexto(saida, prefixo ? ",\"modo\":\"prefixo\",\"pistas\":[" : ",\"modo\":\"trecho\",\"pistas\":[");
+        for (uint32_t i = 0; i < total; i++) {
+            if (i > 0) {
+                saidaBytes(saida, ",", 1);
+            }
+            saidaJsonTexto(saida, textoDoId(pistas, encontradas[i]));
+        }
+        saidaTexto(saida, "]}\n");
+    } else {
+        saidaAnexar(saida, "🔎 Pistas coletadas que %s \"%s\": %u\n",
+                    prefixo ? "começam com" : "contêm", termo, total);
+        for (uint32_t i = 0; i < total; i++) {
+            saidaTexto(saida, "  - ");
+            saidaTexto(saida, textoDoId(pistas, encontradas[i]));
+            saidaBytes(saida, "\n", 1);
+        }
+    }
+    free(encontradas);
+}
+
+// --- Retrato da Partida ---
+
+/**
+ * @brief Grava o retrato da sessão em um arquivo, de forma atômica.
+ *
+ * O retrato vai para "<caminho>.tmp" e só então substitui o arquivo, para que
+ * uma interrupção no meio da gravação não deixe um retrato pela metade. Com o
+ * diário ativo, os eventos da partida são confirmados antes: o retrato nunca
+ * fica à frente do diário, e a retomada (DIARIO_RETOMADA) confere na reprodução.
+ * @return 0 em caso de sucesso, -1 em caso de erro.
+ */
+static int gravarRetrato(Sessao *sessao, const char *caminho) {
+    if (sessao->diario != NULL) {
+        sessaoDescarregarDiario(sessao);
+        diarioConfirmar(sessao->diario->diario); // Uma falha do diário é informada no seu fechamento
+    }
+    size_t tamanho = salvarRetrato(sessao, NULL, 0);
+    unsigned char *dados = (unsigned char*)malloc(tamanho);
+    char *temporario = (char*)malloc(strlen(caminho) + sizeof(".tmp"));
+    if (dados == NULL || temporario == NULL) {
+        printf("Erro de alocação de memória para o retrato!\n");
+        exit(EXIT_FAILURE);
+    }
+    salvarRetrato(sessao, dados, tamanho);
+    strcpy(temporario, caminho);
+    strcat(temporario, ".tmp");
+
+    int resultado = -1;
+    FILE *arquivo = fopen(temporario, "wb");
+    if (arquivo != NULL) {
+        int gravado = fwrite(dados, 1, tamanho, arquivo) == tamanho;
+        if (fclose(arquivo) == 0 && gravado && rename(temporario, caminho) == 0) {
+            resultado = 0;
+        } else {
+            remove(temporario);
+        }
+    }
+    free(temporario);
+    free(dados);
+    return resultado;
+}
+
+/**
+ * @brief Retoma a sessão a partir de um arquivo de retrato, se ele existir.
+ * @return 1 se a partida foi retomada, 0 se o arquivo não existe, -1 se ele for inválido.
+ */
+static int lerRetrato(Sessao *sessao, const char *caminho) {
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+    unsigned char *dados = NULL;
+    size_t tamanho = 0;
+    size_t capacidade = 0;
+    int resultado = -1;
+    for (;;) {
+        if (tamanho == capacidade) {
+            capacidade = capacidade > 0 ? capacidade * 2 : 4096;
+            unsigned char *maior = (unsigned char*)realloc(dados, capacidade);
+            if (maior == NULL) {
+                printf("Erro de alocação de memória para o retrato!\n");
+                exit(EXIT_FAILURE);
+            }
+            dados = maior;
+        }
+        size_t lidos = fread(dados + tamanho, 1, capacidade - tamanho, arquivo);
+        tamanho += lidos;
+        if (lidos == 0) {
+            break;
+        }
+    }
+    if (!ferror(arquivo) && restaurarRetrato(sessao, dados, tamanho) == 0) {
+        resultado = 1;
+    }
+    fclose(arquivo);
+    free(dados);
+    return resultado;
+}
+
+// --- Função Principal de Exploração e Julgamento ---
+
+/**
+ * @brief Navega pelo mapa e ativa o sistema de pistas.
+ *
+ * Controla a navegação do jogador; a coleta de pistas (conjunto, hash e placar)
+ * é feita pelo motor. Cada turno é escrito de uma vez, antes de ler a escolha.
+ * @param sessao A sessão em andamento.
+ * @param saida A saída do jogo (texto ou JSON).
+ * @param arquivoRetrato Onde gravar o retrato a cada sala nova (NULL: não grava); com ele,
+ *                       o fim da entrada pausa a exploração, sem encerrar a sessão.
+ * @param dicas O índice de dicas do mapa, que habilita a opção '?' (NULL: sem dicas).
+ *
+ * Com a busca ativa na sessão (sessaoAtivarBusca()), a opção '/' busca nas pistas coletadas.
+ */
+void explorarSalas(Sessao* sessao, Saida* saida, const char* arquivoRetrato, IndiceDicas* dicas) {
+    const Mapa *mapa = sessao->mapa;
+    int json = saida->formato == SAIDA_JSON;
+    char escolha;
+    uint32_t movimentosGravados = UINT32_MAX; // Movimentos do último retrato gravado
+    
+    if (!json) {
+        saidaTexto(saida, "\n--- EXPLORAÇÃO DA MANSÃO: NÍVEL MESTRE ---\n");
+    }
+    
+    // Um turno vai da escolha lida até o menu seguinte escrito, sem a espera pelo jogador
+    INSTRUMENTAR_RELOGIO(inicioTurno);
+    INSTRUMENTAR_INICIO("turno");
+    while (!sessao->encerrada) {
+        uint32_t salaAtual = sessao->salaAtual;
+        
+        // Coleta de Pista e Menu de Opções
+        uint32_t pista = sessaoColetar(sessao);
+        if (json) {
+            anexarTurnoJson(saida, mapa, salaAtual, pista);
+        } else {
+            anexarTurnoTexto(saida, mapa, salaAtual, pista, dicas != NULL, sessao->buscaAtiva);
+        }
+        saidaDescarregar(saida);
+        sessaoDescarregarDiario(sessao); // O turno vai ao diário antes da espera pelo jogador
+        INSTRUMENTAR_DURACAO(HISTOGRAMA_TURNO_NS, inicioTurno);
+        INSTRUMENTAR_FIM("turno");
+        // Já com a pista da sala: o retrato para no mesmo ponto que o diário
+        if (arquivoRetrato != NULL && sessao->movimentos != movimentosGravados) {
+            if (gravarRetrato(sessao, arquivoRetrato) != 0) {
+                fprintf(stderr, "Não foi possível gravar o retrato em '%s'.\n", arquivoRetrato);
+            }
+            movimentosGravados = sessao->movimentos;
+        }
+        
+        int fimEntrada = scanf(" %c", &escolha) != 1;
+        INSTRUMENTAR_MARCAR(inicioTurno);
+        INSTRUMENTAR_INICIO("turno");
+        if (fimEntrada && arquivoRetrato != NULL) {
+            break; // Pausa: a partida continua aberta no diário e retomável pelo retrato
+        }
+        if (fimEntrada) {
+            escolha = 's'; // Fim da entrada: encerra a exploração
+        }
+        
+        if (dicas != NULL && escolha == '?') {
+            if (json) {
+                anexarDicaJson(saida, dicas, sessao);
+            } else {
+                anexarDicaTexto(saida, dicas, sessao);
+            }
+            continue;
+        }
+        if (sessao->buscaAtiva && escolha == '/') {
+            anexarBusca(saida, sessao); // Sem termo, a próxima leitura encerra a exploração
+            continue;
+        }
+        
+        // Navegação
+        Movimento movimento = sessaoMover(sessao, escolha);
+        if (movimento != MOVIMENTO_BLOQUEADO && movimento != MOVIMENTO_INVALIDO) {
+            continue;
+        }
+        if (json) {
+            char texto[2] = { escolha, '\0' };
+            saidaTexto(saida, "{\"evento\":\"movimento\",\"escolha\":");
+            saidaJsonTexto(saida, texto);
+            saidaTexto(saida, ",\"resultado\":");
+            saidaTexto(saida, movimento == MOVIMENTO_BLOQUEADO ? "\"BLOQUEADO\"}\n" : "\"INVALIDO\"}\n");
+        } else if (movimento == MOVIMENTO_BLOQUEADO) {
+            saidaTexto(saida, "Caminho não disponível ou cômodo inalcançável. Tente outra direção.\n");
+        } else if (salaBinaria(mapa, sessao->salaAtual)) {
+            saidaTexto(saida, "Opção inválida. Use 'e', 'd' ou 's'.\n");
+        } else {
+            saidaTexto(saida, "Opção inválida. Use a tecla de um dos caminhos ou 's'.\n");
+        }
+    }
+    if (arquivoRetrato != NULL && sessao->encerrada && gravarRetrato(sessao, arquivoRetrato) != 0) {
+        fprintf(stderr, "Não foi possível gravar o retrato em '%s'.\n", arquivoRetrato);
+    }
+    saidaDescarregar(saida);
+    INSTRUMENTAR_FIM("turno");
+}
+
+/**
+ * @brief Conduz à fase de julgamento final.
+ *
+ * Solicita a acusação do jogador e exibe o veredito calculado pelo motor. No
+ * formato JSON são escritos os eventos "pistas" (antes de ler o acusado) e
+ * "julgamento". Depois do veredito vem o placar de todos os suspeitos, do
+ * mais ao menos incriminado (o campo "placar" do "julgamento", no JSON).
+ * @param sessao A sessão encerrada.
+ * @param saida A saída do jogo (texto ou JSON).
+ */
+void verificarSuspeitoFinal(Sessao* sessao, Saida* saida) {
+    char acusado[50];
+    int json = saida->formato == SAIDA_JSON;
+
+    if (json) {
+        uint32_t *ordem = (uint32_t*)malloc(((size_t)sessao->mapa->pistas.total + 1) * sizeof(uint32_t));
+        if (ordem == NULL) {
+            printf("Erro de alocação de memória para o julgamento!\n");
+            exit(EXIT_FAILURE);
+        }
+        saidaTexto(saida, "{\"evento\":\"pistas\",\"pistas\":");
+        anexarJsonPistas(saida, sessao, ordem);
+        saidaTexto(saida, "}\n");
+        free(ordem);
+        if (sessao->totalPistas == 0) {
+            saidaTexto(saida, "{\"evento\":\"julgamento\",\"veredito\":\"SEM_PISTAS\"}\n");
+            saidaDescarregar(saida);
+            return;
+        }
+    } else {
+        saidaTexto(saida, "\n============================================\n");
+        saidaTexto(saida, "🕵️‍♂️ FASE DE JULGAMENTO FINAL\n");
+        saidaTexto(saida, "============================================\n");
+        
+        if (sessao->totalPistas == 0) {
+            saidaTexto(saida, "Você não coletou nenhuma pista! A acusação não pode ser feita.\n");
+            saidaDescarregar(saida);
+            return;
+        }
+
+        // Listar pistas para ajudar o jogador
+        saidaTexto(saida, "\nPistas Coletadas (em ordem alfabética):\n");
+        anexarConjuntoPistas(saida, &sessao->pistas, &sessao->mapa->pistas);
+
+        // Solicitar acusação
+        saidaTexto(saida, "\nCom base nas evidências, quem você acusa? ");
+    }
+    saidaDescarregar(saida);
+
+    if (scanf(" %49[^\n]", acusado) != 1) {
+        acusado[0] = '\0';
+    }
+    
+    // Pistas incriminatórias (um nome nunca citado não tem id e não conta pistas)
+    uint32_t contagem;
+    Veredito veredito = sessaoAcusar(sessao, acusado, &contagem);
+
+    // Avaliação
+    if (json) {
+        saidaTexto(saida, "{\"evento\":\"julgamento\",\"acusado\":");
+        saidaJsonTexto(saida, acusado);
+        saidaTexto(saida, ",\"contagem\":");
+        saidaNumero(saida, contagem);
+        saidaTexto(saida, ",\"minimo\":");
+        saidaNumero(saida, PISTAS_MINIMAS_ACUSACAO);
+        saidaTexto(saida, ",\"veredito\":\"");
+        saidaTexto(saida, nomeVeredito(veredito));
+        saidaTexto(saida, "\",\"placar\":");
+        anexarPlacar(saida, sessao, 1);
+        saidaTexto(saida, "}\n");
+    } else {
+        saidaAnexar(saida, "\n--- Avaliação das Evidências ---\n");
+        saidaAnexar(saida, "Acusado: %s\n", acusado);
+        saidaAnexar(saida, "Pistas incriminatórias encontradas: %u\n", contagem);
+
+        if (veredito == VEREDITO_SUSTENTADO) {
+            saidaAnexar(saida, "✅ Acusação de %s é **SUSTENTADA** por %u pistas! O mistério foi resolvido.\n", acusado, contagem);
+        } else {
+            saidaAnexar(saida, "❌ Acusação de %s é **FRACA**. Você precisa de pelo menos %d pistas.\n", acusado, PISTAS_MINIMAS_ACUSACAO);
+            saidaAnexar(saida, "   O verdadeiro culpado pode ter escapado!\n");
+        }
+        anexarPlacar(saida, sessao, 0);
+    }
+    saidaDescarregar(saida);
+}
+
+// --- Modo em Lote ---
+// Os roteiros são lidos em blocos de LOTE_LINHAS linhas e simulados em
+// paralelo pelo executor (executor.h); cada trabalhador formata seus resultados
+// em uma Saida própria, e cada bloco é escrito de uma vez, na ordem das linhas.
+
+#define LOTE_LINHAS 16384
+
+typedef struct SaidaTrabalhador {
+    Saida saida;     // Só acumula; o texto é copiado para a saída do bloco
+    uint32_t *ordem; // Ids das pistas em ordem alfabética (listarConjuntoPistas())
+} SaidaTrabalhador;
+
+typedef struct SaidaLote {
+    const Mapa *mapa;
+    FormatoSaida formato;
+    SaidaTrabalhador *trabalhadores;
+    const unsigned long *linhas; // Número da linha de cada roteiro do bloco
+    const Roteiro *roteiros;
+    unsigned *autor;             // Trabalhador que formatou cada roteiro
+    size_t *inicio;              // Início e tamanho do texto no buffer do autor
+    size_t *tamanho;
+} SaidaLote;
+
+/**
+ * @brief Uma partida em TSV (ver executarLote()).
+ */
+static void formatarPartidaTexto(SaidaTrabalhador *trabalhador, const SaidaLote *lote, size_t indice,
+                                 const Sessao *sessao, const ResultadoSessao *partida) {
+    Saida *saida = &trabalhador->saida;
+    const Mapa *mapa = lote->mapa;
+
+    saidaNumero(saida, lote->linhas[indice]);
+    saidaBytes(saida, "\t", 1);
+    saidaTexto(saida, mapaNomeSala(mapa, partida->salaFinal));
+    saidaBytes(saida, "\t", 1);
+    saidaNumero(saida, partida->movimentos);
+    saidaBytes(saida, "\t", 1);
+    saidaNumero(saida, partida->movimentosRecusados);
+    saidaBytes(saida, "\t", 1);
+    saidaNumero(saida, partida->totalPistas);
+    saidaBytes(saida, "\t", 1);
+    saidaTexto(saida, lote->roteiros[indice].acusado);
+    saidaBytes(saida, "\t", 1);
+    saidaNumero(saida, partida->contagem);
+    saidaBytes(saida, "\t", 1);
+    saidaTexto(saida, nomeVeredito(partida->veredito));
+    saidaBytes(saida, "\t", 1);
+    uint32_t totalPistas = listarConjuntoPistas(&sessao->pistas, trabalhador->ordem);
+    for (uint32_t i = 0; i < totalPistas; i++) {
+        if (i > 0) {
+            saidaBytes(saida, " | ", 3);
+        }
+        saidaTexto(saida, textoDoId(&mapa->pistas, trabalhador->ordem[i]));
+    }
+    saidaBytes(saida, "\n", 1);
+}
+
+/**
+ * @brief Uma partida em JSON, com os mesmos campos do TSV.
+ */
+static void formatarPartidaJson(SaidaTrabalhador *trabalhador, const SaidaLote *lote, size_t indice,
+                                const Sessao *sessao, const ResultadoSessao *partida) {
+    Saida *saida = &trabalhador->saida;
+
+    saidaTexto(saida, "{\"linha\":");
+    saidaNumero(saida, lote->linhas[indice]);
+    saidaTexto(saida, ",\"salaFinal\":");
+    saidaJsonTexto(saida, mapaNomeSala(lote->mapa, partida->salaFinal));
+    saidaTexto(saida, ",\"movimentos\":");
+    saidaNumero(saida, partida->movimentos);
+    saidaTexto(saida, ",\"recusados\":");
+    saidaNumero(saida, partida->movimentosRecusados);
+    saidaTexto(saida, ",\"totalPistas\":");
+    saidaNumero(saida, partida->totalPistas);
+    saidaTexto(saida, ",\"acusado\":");
+    saidaJsonTexto(saida, lote->roteiros[indice].acusado);
+    saidaTexto(saida, ",\"contagem\":");
+    saidaNumero(saida, partida->contagem);
+    saidaTexto(saida, ",\"veredito\":\"");
+    saidaTexto(saida, nomeVeredito(partida->veredito));
+    saidaTexto(saida, "\",\"pistas\":");
+    anexarJsonPistas(saida, sessao, trabalhador->ordem);
+    saidaTexto(saida, "}\n");
+}
+
+/**
+ * @brief Formata o resultado de uma partida (chamada na thread do trabalhador).
+ */
+static void formatarPartida(void *contexto, unsigned trabalhador, size_t indice,
+                            const Sessao *sessao, const ResultadoSessao *partida) {
+    SaidaLote *lote = (SaidaLote*)contexto;
+    SaidaTrabalhador *destino = &lote->trabalhadores[trabalhador];
+    size_t inicio = destino->saida.tamanho;
+
+    if (lote->formato == SAIDA_JSON) {
+        formatarPartidaJson(destino, lote, indice, sessao, partida);
+    } else {
+        formatarPartidaTexto(destino, lote, indice, sessao, partida);
+    }
+
+    lote->autor[indice] = trabalhador;
+    lote->inicio[indice] = inicio;
+    lote->tamanho[indice] = destino->saida.tamanho - inicio;
+}
+
+
+/**
+ * @brief Separa uma linha "<movimentos> | <acusado>" em um roteiro, no próprio buffer.
+ * @return 0 em caso de sucesso, -1 se a linha não tiver o separador.
+ */
+static int lerRoteiro(char *linha, Roteiro *roteiro) {
+    char *separador = strchr(linha, '|');
+    if (separador == NULL) {
+        return -1;
+    }
+    *separador = '\0';
+    char *acusado = separador + 1;
+    acusado += strspn(acusado, " \t");
+    char *fim = acusado + strlen(acusado);
+    while (fim > acusado && (fim[-1] == ' ' || fim[-1] == '\t')) {
+        *--fim = '\0';
+    }
+    roteiro->movimentos = linha;
+    roteiro->acusado = acusado;
+    return 0;
+}
+
+/**
+ * @brief Roda uma partida por linha de roteiro, sem interação, em várias threads.
+ *
+ * Linhas vazias e iniciadas por '#' são ignoradas. Para cada partida é escrita
+ * uma linha separada por tabulações:
+ *   <nº da linha> <sala final> <movimentos> <recusados> <pistas> <acusado> <contagem> <veredito> <pistas em ordem, separadas por " | ">
+ * ou, no formato JSON, um objeto por linha com os mesmos campos:
+ *   {"linha":..,"salaFinal":..,"movimentos":..,"recusados":..,"totalPistas":..,"acusado":..,"contagem":..,"veredito":..,"pistas":[..]}
+ * @param mapa O mapa já carregado (compartilhado, somente leitura).
+ * @param entrada O arquivo de roteiros.
+ * @param saida Onde escrever os resultados (um descarregamento por bloco).
+ * @param totalThreads A quantidade de threads (0 usa os processadores disponíveis).
+ * @param diario O diário em que as partidas são registradas (NULL: sem diário).
+ * @return 0 em caso de sucesso, -1 se alguma linha for inválida.
+ */
+int executarLote(const Mapa* mapa, FILE* entrada, Saida* saida, unsigned totalThreads, Diario* diario) {
+    Executor executor;
+    iniciarExecutor(&executor, mapa, totalThreads);
+    if (diario != NULL) {
+        executorAtivarDiario(&executor, diario);
+    }
+
+    Arena arenaLinhas;
+    arenaInicializar(&arenaLinhas, ARENA_BLOCO_PADRAO);
+    Roteiro *roteiros = (Roteiro*)malloc(LOTE_LINHAS * sizeof(Roteiro));
+    unsigned long *linhas = (unsigned long*)malloc(LOTE_LINHAS * sizeof(unsigned long));
+    unsigned *autor = (unsigned*)malloc(LOTE_LINHAS * sizeof(unsigned));
+    size_t *inicio = (size_t*)malloc(LOTE_LINHAS * sizeof(size_t));
+    size_t *tamanho = (size_t*)malloc(LOTE_LINHAS * sizeof(size_t));
+    SaidaTrabalhador *trabalhadores = (SaidaTrabalhador*)malloc(executor.totalTrabalhadores * sizeof(SaidaTrabalhador));
+    if (roteiros == NULL || linhas == NULL || autor == NULL || inicio == NULL || tamanho == NULL || trabalhadores == NULL) {
+        printf("Erro de alocação de memória para o modo em lote!\n");
+        exit(EXIT_FAILURE);
+    }
+    for (unsigned i = 0; i < executor.totalTrabalhadores; i++) {
+        iniciarSaida(&trabalhadores[i].saida, -1, saida->formato);
+        trabalhadores[i].ordem = (uint32_t*)malloc(((size_t)mapa->pistas.total + 1) * sizeof(uint32_t));
+        if (trabalhadores[i].ordem == NULL) {
+            printf("Erro de alocação de memória para o modo em lote!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    SaidaLote lote = { mapa, saida->formato, trabalhadores, linhas, roteiros, autor, inicio, tamanho };
+
+    char *linha = NULL;
+    size_t capacidadeLinha = 0;
+    unsigned long numeroLinha = 0;
+    int resultado = 0;
+    int fimEntrada = 0;
+    while (!fimEntrada) {
+        // 1. Lê um bloco de roteiros
+        size_t total = 0;
+        arenaReiniciar(&arenaLinhas);
+        while (total < LOTE_LINHAS) {
+            ssize_t lidos = getline(&linha, &capacidadeLinha, entrada);
+            if (lidos == -1) {
+                fimEntrada = 1;
+                break;
+            }
+            numeroLinha++;
+            linha[strcspn(linha, "\r\n")] = '\0';
+            if (linha[0] == '\0' || linha[0] == '#') {
+                continue;
+            }
+            size_t tamanhoLinha = strlen(linha) + 1;
+            char *copia = (char*)arenaAlocar(&arenaLinhas, tamanhoLinha);
+            memcpy(copia, linha, tamanhoLinha);
+            if (lerRoteiro(copia, &roteiros[total]) != 0) {
+                fprintf(stderr, "roteiro %lu: esperado '<movimentos> | <acusado>'\n", numeroLinha);
+                resultado = -1;
+                continue;
+            }
+            linhas[total++] = numeroLinha;
+        }
+
+        // 2. Simula o bloco em paralelo e escreve os resultados na ordem das linhas
+        for (unsigned i = 0; i < executor.totalTrabalhadores; i++) {
+            trabalhadores[i].saida.tamanho = 0;
+        }
+        executorRodar(&executor, roteiros, total, NULL, formatarPartida, &lote);
+        for (size_t i = 0; i < total; i++) {
+            saidaBytes(saida, trabalhadores[autor[i]].saida.texto + inicio[i], tamanho[i]);
+        }
+        saidaDescarregar(saida);
+    }
+
+    for (unsigned i = 0; i < executor.totalTrabalhadores; i++) {
+        liberarSaida(&trabalhadores[i].saida);
+        free(trabalhadores[i].ordem);
+    }
+    free(trabalhadores);
+    free(tamanho);
+    free(inicio);
+    free(autor);
+    free(linhas);
+    free(roteiros);
+    free(linha);
+    arenaLiberar(&arenaLinhas);
+    encerrarExecutor(&executor);
+    return resultado;
+}
+
+// --- Solução Exaustiva ---
+
+/**
+ * @brief Resolve o mapa e exibe a tabela de vereditos por suspeito.
+ *
+ * No formato JSON, escreve um único objeto:
+ *   {"caminhos":..,"semPistas":..,"minimo":..,"suspeitos":[{"nome":..,"sustentada":..,"fraca":..,"maiorContagem":..}]}
+ * @return 0 em caso de sucesso, -1 se a raiz do mapa não for uma sala válida.
+ */
+int exibirSolucao(const Mapa* mapa, unsigned totalThreads, Saida* saida) {
+    ResumoSolucao resumo;
+    if (resolverMapa(mapa, totalThreads, &resumo) != 0) {
+        printf("A raiz do mapa não é uma sala válida; não é possível enumerar os caminhos.\n");
+        liberarResumoSolucao(&resumo);
+        return -1;
+    }
+
+    if (saida->formato == SAIDA_JSON) {
+        saidaTexto(saida, "{\"caminhos\":");
+        saidaNumero(saida, resumo.totalCaminhos);
+        saidaTexto(saida, ",\"semPistas\":");
+        saidaNumero(saida, resumo.caminhosSemPistas);
+        saidaTexto(saida, ",\"minimo\":");
+        saidaNumero(saida, PISTAS_MINIMAS_ACUSACAO);
+        saidaTexto(saida, ",\"suspeitos\":[");
+        for (uint32_t suspeito = 0; suspeito < resumo.totalSuspeitos; suspeito++) {
+            saidaTexto(saida, suspeito > 0 ? ",{\"nome\":" : "{\"nome\":");
+            saidaJsonTexto(saida, textoDoId(&mapa->suspeitos, suspeito));
+            saidaTexto(saida, ",\"sustentada\":");
+            saidaNumero(saida, resumo.sustentados[suspeito]);
+            saidaTexto(saida, ",\"fraca\":");
+            saidaNumero(saida, resumo.fracos[suspeito]);
+            saidaTexto(saida, ",\"maiorContagem\":");
+            saidaNumero(saida, resumo.maximoPistas[suspeito]);
+            saidaTexto(saida, "}");
+        }
+        saidaTexto(saida, "]}\n");
+    } else {
+        saidaAnexar(saida, "Caminhos até uma saída: %llu (sem pistas: %llu)\n",
+                    (unsigned long long)resumo.totalCaminhos, (unsigned long long)resumo.caminhosSemPistas);
+        saidaAnexar(saida, "Acusação sustentada com pelo menos %d pistas.\n\n", PISTAS_MINIMAS_ACUSACAO);
+        saidaAnexar(saida, "%-30s %12s %12s %14s\n", "Suspeito", "Sustentada", "Fraca", "Maior contagem");
+        for (uint32_t suspeito = 0; suspeito < resumo.totalSuspeitos; suspeito++) {
+            saidaAnexar(saida, "%-30s %12llu %12llu %14u\n", textoDoId(&mapa->suspeitos, suspeito),
+                        (unsigned long long)resumo.sustentados[suspeito], (unsigned long long)resumo.fracos[suspeito],
+                        resumo.maximoPistas[suspeito]);
+        }
+    }
+    saidaDescarregar(saida);
+    liberarResumoSolucao(&resumo);
+    return 0;
+}
+
+/**
+ * @brief Escreve o resumo dos instrumentos na saída de erro e grava o rastro, se pedidos.
+ * @param comResumo Se deve escrever o resumo ("--instrumentos").
+ * @param arquivoRastro O arquivo do rastro ("--rastro"), ou NULL.
+ * @param json Se o resumo sai em JSON lines.
+ */
+static void concluirInstrumentos(int comResumo, const char *arquivoRastro, int json) {
+    if (comResumo) {
+        Instrumentos instrumentos;
+        instrumentosSomar(&instrumentos);
+        Saida erro;
+        iniciarSaida(&erro, STDERR_FILENO, json ? SAIDA_JSON : SAIDA_TEXTO);
+        anexarResumoInstrumentos(&erro, &instrumentos);
+        saidaDescarregar(&erro);
+        liberarSaida(&erro);
+    }
+    if (arquivoRastro != NULL && instrumentosGravarRastro(arquivoRastro) != 0) {
+        fprintf(stderr, "Erro ao gravar o rastro '%s'!\n", arquivoRastro);
+    }
+}
+
+/**
+ * @brief Fecha o diário, se aberto, avisando se alguma escrita falhou.
+ * @return 0, ou -1 se o diário ficou incompleto.
+ */
+static int concluirDiario(Diario *diario, const char *arquivoDiario) {
+    if (diario != NULL && fecharDiario(diario) != 0) {
+        fprintf(stderr, "Erro ao gravar o diário '%s': %s\n", arquivoDiario, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+// --- Main ---
+
+int main(int argc, char *argv[]) {
+    // ------------------------------------------------------------------
+    // 1. Argumentos: [--lote <roteiros|-> | --resolver | --retrato <arquivo>] [--threads N] [--json] [--dicas] [--busca]
+    //                [--instrumentos] [--rastro <arquivo.json>] [--paginas N] [--diario <arquivo>] [mapa.dqm]
+    // ------------------------------------------------------------------
+    const char *roteiros = NULL;
+    const char *arquivoMapa = NULL;
+    const char *arquivoRetrato = NULL;
+    const char *arquivoRastro = NULL;
+    const char *arquivoDiario = NULL;
+    unsigned totalThreads = 0;
+    int resolver = 0;
+    int json = 0;
+    int comDicas = 0;
+    int comBusca = 0;
+    int comInstrumentos = 0;
+    int paginado = 0;
+    uint32_t paginasResidentes = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            roteiros = argv[++i];
+        } else if (strcmp(argv[i], "--retrato") == 0 && i + 1 < argc) {
+            arquivoRetrato = argv[++i];
+        } else if (strcmp(argv[i], "--resolver") == 0) {
+            resolver = 1;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else if (strcmp(argv[i], "--dicas") == 0) {
+            comDicas = 1;
+        } else if (strcmp(argv[i], "--busca") == 0) {
+            comBusca = 1;
+        } else if (strcmp(argv[i], "--instrumentos") == 0) {
+            comInstrumentos = 1;
+        } else if (strcmp(argv[i], "--rastro") == 0 && i + 1 < argc) {
+            arquivoRastro = argv[++i];
+        } else if (strcmp(argv[i], "--diario") == 0 && i + 1 < argc) {
+            arquivoDiario = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            totalThreads = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--paginas") == 0 && i + 1 < argc) {
+            paginado = 1;
+            paginasResidentes = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (arquivoMapa == NULL && argv[i][0] != '-') {
+            arquivoMapa = argv[i];
+        } else {
+            printf("Uso: %s [--lote <roteiros.txt|-> | --resolver | --retrato <arquivo>] [--threads N] [--json] [--dicas] [--busca]\n"
+                   "       [--instrumentos] [--rastro <arquivo.json>] [--paginas N] [--diario <arquivo>] [mapa.dqm]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if ((comInstrumentos || arquivoRastro != NULL) && !INSTRUMENTOS_LIGADOS) {
+        fprintf(stderr, "Aviso: instrumentos desligados nesta compilação (use -DDQ_INSTRUMENTOS=ON).\n");
+        comInstrumentos = 0;
+        arquivoRastro = NULL;
+    }
+    if (paginado && (resolver || comDicas || comBusca)) {
+        fprintf(stderr, "Aviso: --paginas ignorado com --resolver, --dicas ou --busca, que leem o mapa inteiro.\n");
+        paginado = 0;
+    }
+    if (arquivoDiario != NULL && resolver) {
+        fprintf(stderr, "Aviso: --diario ignorado com --resolver, que não joga partidas.\n");
+        arquivoDiario = NULL;
+    }
+    if (arquivoRastro != NULL) {
+        instrumentosIniciarRastro();
+    }
+
+    // ------------------------------------------------------------------
+    // 2. Mapa da Mansão: arquivo .dqm mapeado em memória ou mansão embutida (mapas/mansao_mestre.txt)
+    // ------------------------------------------------------------------
+    Mapa mapa;
+    mapaInicializar(&mapa);
+
+    if (arquivoMapa != NULL) {
+        if (abrirMapaArquivo(&mapa, arquivoMapa, !paginado) != 0 || mapa.totalSalas == 0 ||
+            (paginado && mapaAtivarPaginas(&mapa, paginasResidentes) != 0)) {
+            printf("Erro ao carregar o mapa '%s'!\n", arquivoMapa);
+            fecharMapaArquivo(&mapa);
+            return EXIT_FAILURE;
+        }
+    } else if (abrirMapaEmbutido(&mapa, &mansaoEmbutida) != 0) {
+        printf("Erro ao carregar a mansão embutida!\n");
+        return EXIT_FAILURE;
+    }
+
+    Diario diario;
+    Diario *comDiario = NULL;
+    if (arquivoDiario != NULL) {
+        if (abrirDiario(&diario, &mapa, arquivoDiario) != 0) {
+            printf("Erro ao abrir o diário '%s': %s\n", arquivoDiario, strerror(errno));
+            fecharMapaArquivo(&mapa);
+            return EXIT_FAILURE;
+        }
+        comDiario = &diario;
+    }
+
+    Saida saida;
+    iniciarSaida(&saida, STDOUT_FILENO, json ? SAIDA_JSON : SAIDA_TEXTO);
+
+    // ------------------------------------------------------------------
+    // 3. Solução exaustiva ou modo em lote: sem interação
+    // ------------------------------------------------------------------
+    if (resolver) {
+        int resultado = exibirSolucao(&mapa, totalThreads, &saida);
+        liberarSaida(&saida);
+        concluirInstrumentos(comInstrumentos, arquivoRastro, json);
+        fecharMapaArquivo(&mapa);
+        return resultado == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (roteiros != NULL) {
+        FILE *entrada = strcmp(roteiros, "-") == 0 ? stdin : fopen(roteiros, "r");
+        if (entrada == NULL) {
+            perror(roteiros);
+            concluirDiario(comDiario, arquivoDiario);
+            liberarSaida(&saida);
+            fecharMapaArquivo(&mapa);
+            return EXIT_FAILURE;
+        }
+        int resultado = executarLote(&mapa, entrada, &saida, totalThreads, comDiario);
+        if (entrada != stdin) {
+            fclose(entrada);
+        }
+        if (concluirDiario(comDiario, arquivoDiario) != 0) {
+            resultado = -1;
+        }
+        liberarSaida(&saida);
+        concluirInstrumentos(comInstrumentos, arquivoRastro, json);
+        fecharMapaArquivo(&mapa);
+        return resultado == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // ------------------------------------------------------------------
+    // 4. Exploração e Julgamento Final (o motor guarda conjunto de pistas, hash e placar)
+    // ------------------------------------------------------------------
+    Sessao sessao;
+    iniciarSessao(&sessao, &mapa);
+    if (comBusca) {
+        sessaoAtivarBusca(&sessao);
+    }
+    if (comDiario != NULL) {
+        sessaoAtivarDiario(&sessao, comDiario); // Antes do retrato: a retomada também fica no diário
+    }
+
+    if (arquivoRetrato != NULL) {
+        int retomada = lerRetrato(&sessao, arquivoRetrato);
+        if (retomada < 0) {
+            printf("Retrato '%s' inválido ou de outro mapa!\n", arquivoRetrato);
+            encerrarSessao(&sessao);
+            concluirDiario(comDiario, arquivoDiario);
+            liberarSaida(&saida);
+            fecharMapaArquivo(&mapa);
+            return EXIT_FAILURE;
+        }
+        if (retomada > 0 && json) {
+            saidaTexto(&saida, "{\"evento\":\"retomada\",\"sala\":");
+            saidaJsonTexto(&saida, mapaNomeSala(&mapa, sessao.salaAtual));
+            saidaTexto(&saida, ",\"movimentos\":");
+            saidaNumero(&saida, sessao.movimentos);
+            saidaTexto(&saida, ",\"pistas\":");
+            saidaNumero(&saida, sessao.totalPistas);
+            saidaTexto(&saida, "}\n");
+        } else if (retomada > 0) {
+            saidaAnexar(&saida, "\n(Partida retomada de '%s': %u movimentos, %u pistas coletadas.)\n",
+                        arquivoRetrato, sessao.movimentos, sessao.totalPistas);
+        }
+    }
+
+    IndiceDicas dicas;
+    if (comDicas) {
+        construirIndiceDicas(&dicas, &mapa);
+    }
+    explorarSalas(&sessao, &saida, arquivoRetrato, comDicas ? &dicas : NULL);
+    if (!sessao.encerrada && json) {
+        saidaTexto(&saida, "{\"evento\":\"pausa\",\"retrato\":");
+        saidaJsonTexto(&saida, arquivoRetrato);
+        saidaTexto(&saida, "}\n");
+    } else if (!sessao.encerrada) {
+        saidaAnexar(&saida, "\n(Partida pausada: '%s' a retoma de onde parou.)\n", arquivoRetrato);
+    } else {
+        verificarSuspeitoFinal(&sessao, &saida);
+        if (arquivoRetrato != NULL) {
+            remove(arquivoRetrato); // Partida julgada: não há mais o que retomar
+        }
+    }
+    if (comDicas) {
+        liberarIndiceDicas(&dicas);
+    }
+    
+    // ------------------------------------------------------------------
+    // 5. Limpeza de Memória (pistas, hash e placar saem juntos com a arena)
+    // ------------------------------------------------------------------
+    encerrarSessao(&sessao); // Entrega ao diário os últimos eventos
+    int resultado = concluirDiario(comDiario, arquivoDiario);
+    liberarSaida(&saida);
+    concluirInstrumentos(comInstrumentos, arquivoRastro, json);
+    fecharMapaArquivo(&mapa);
+    
+    return resultado == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
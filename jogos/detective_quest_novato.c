@@ -0,0 +1,114 @@
+/**
+ * @file detective_quest_novato.c
+ * @brief Simula a exploração de uma mansão (mapa em árvore binária) para o jogo Detective Quest.
+ *
+ * Implementa uma árvore binária de salas e permite a navegação interativa do jogador
+ * até que um cômodo sem saída (nó-folha) seja alcançado. As salas usam o mapa
+ * plano da biblioteca (mapa.h), sem pistas nem suspeitos; a mansão vem de
+ * mapas/mansao_novato.txt, embutida no executável como tabela constante.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "mapa.h"
+#include "mapa_arquivo.h"
+#include "saida.h"
+
+/**
+ * @brief Permite a navegação do jogador pela árvore.
+ *
+ * O jogador escolhe uma saída pela tecla ('e' para esquerda, 'd' para direita
+ * nas salas binárias), ou 's' para sair.
+ * A exploração termina ao alcançar um nó-folha. Cada turno é escrito de uma
+ * vez, antes de ler a escolha.
+ * * @param mapa O mapa da mansão; a exploração começa na sala raiz (Hall de entrada).
+ * @param saida A saída do jogo.
+ */
+void explorarSalas(const Mapa* mapa, Saida* saida) {
+    uint32_t salaAtual = mapa->raiz;
+    char escolha;
+    
+    saidaTexto(saida, "\n--- Explorando a Mansão: Detective Quest ---\n");
+    
+    while (salaAtual != MAPA_NENHUM) {
+        const SaidaSala *saidas = mapaSaidas(mapa, salaAtual);
+        uint32_t totalSaidas = mapaTotalSaidas(mapa, salaAtual);
+        saidaTexto(saida, "\nVocê está em: **");
+        saidaTexto(saida, mapaNomeSala(mapa, salaAtual));
+        saidaTexto(saida, "**\n");
+        
+        // Verifica se é um nó-folha (sala sem caminhos)
+        if (totalSaidas == 0) {
+            saidaTexto(saida, "\nEsta é uma sala sem caminhos adicionais. A exploração termina aqui.\n");
+            break;
+        }
+        
+        // Exibe opções de caminhos disponíveis
+        saidaTexto(saida, "Escolha o próximo caminho:\n");
+        for (uint32_t i = 0; i < totalSaidas; i++) {
+            char tecla[5] = { ' ', ' ', '[', saidas[i].tecla != '\0' ? saidas[i].tecla : '-', ']' };
+            saidaBytes(saida, tecla, sizeof(tecla));
+            saidaTexto(saida, " ");
+            saidaTexto(saida, mapaRotuloSaida(mapa, &saidas[i]));
+            saidaTexto(saida, " (Ir para ");
+            saidaTexto(saida, mapaNomeSala(mapa, saidas[i].destino));
+            saidaTexto(saida, ")\n");
+        }
+        saidaTexto(saida, "  [s] Sair da Mansão\n");
+        saidaTexto(saida, "Sua escolha: ");
+        saidaDescarregar(saida);
+        
+        // Captura a escolha do jogador
+        if (scanf(" %c", &escolha) != 1) {
+            escolha = 's'; // Fim da entrada: encerra a exploração
+        }
+        
+        uint32_t escolhida = mapaProcurarSaida(mapa, salaAtual, escolha);
+        if (escolha == 's' || escolha == 'S') {
+            saidaTexto(saida, "\nExploração encerrada. Você saiu da mansão.\n");
+            break;
+        } 
+        else if (escolhida != MAPA_NENHUM) {
+            salaAtual = saidas[escolhida].destino;
+        } 
+        else if (mapaTeclaDirecao(escolha)) {
+            saidaTexto(saida, "Caminho não disponível. Tente novamente.\n");
+        } 
+        else {
+            saidaTexto(saida, "Opção inválida. Use 'e', 'd' ou 's'.\n");
+        }
+    }
+    saidaDescarregar(saida);
+}
+
+/**
+ * @brief Abre a mansão embutida e dá início à exploração.
+ * * @return 0 se o programa for executado com sucesso.
+ */
+int main() {
+    // ------------------------------------------------------------------
+    // 1. Mapa da Mansão: imagem constante embutida na compilação (mapas/mansao_novato.txt)
+    // ------------------------------------------------------------------
+    Mapa mapa;
+    if (abrirMapaEmbutido(&mapa, &mansaoEmbutida) != 0) {
+        printf("Erro ao carregar a mansão embutida!\n");
+        return EXIT_FAILURE;
+    }
+
+    // ------------------------------------------------------------------
+    // 2. Início da Exploração
+    // ------------------------------------------------------------------
+    Saida saida;
+    iniciarSaida(&saida, STDOUT_FILENO, SAIDA_TEXTO);
+    explorarSalas(&mapa, &saida);
+    liberarSaida(&saida);
+    
+    // ------------------------------------------------------------------
+    // 3. Limpeza (a mansão embutida não tem nada a liberar)
+    // ------------------------------------------------------------------
+    fecharMapaArquivo(&mapa);
+    
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file arena.c
+ * @brief Implementação da arena e do pool de nós.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+
+// --- Implementação da Arena ---
+
+void arenaInicializar(Arena *arena, size_t tamanhoBloco) {
+    arena->atual = NULL;
+    arena->tamanhoBloco = tamanhoBloco > 0 ? tamanhoBloco : ARENA_BLOCO_PADRAO;
+    arena->totalBlocos = 0;
+}
+
+void arenaNovoBloco(Arena *arena, size_t minimo) {
+    size_t capacidade = arena->tamanhoBloco;
+    if (capacidade < minimo) {
+        capacidade = minimo;
+    }
+
+    ArenaBloco *bloco = (ArenaBloco*)malloc(sizeof(ArenaBloco) + capacidade);
+    if (bloco == NULL) {
+        printf("Erro de alocação de memória para a Arena!\n");
+        exit(EXIT_FAILURE);
+    }
+    bloco->anterior = arena->atual;
+    bloco->usado = 0;
+    bloco->capacidade = capacidade;
+
+    arena->atual = bloco;
+    arena->totalBlocos++;
+    if (arena->tamanhoBloco < ARENA_BLOCO_MAXIMO) {
+        arena->tamanhoBloco *= 2;
+    }
+}
+
+void arenaReiniciar(Arena *arena) {
+    if (arena->atual == NULL) {
+        return;
+    }
+    ArenaBloco *bloco = arena->atual->anterior;
+    while (bloco != NULL) {
+        ArenaBloco *temp = bloco;
+        bloco = bloco->anterior;
+        free(temp);
+    }
+    arena->atual->anterior = NULL;
+    arena->atual->usado = 0;
+    arena->totalBlocos = 1;
+}
+
+void arenaLiberar(Arena *arena) {
+    ArenaBloco *bloco = arena->atual;
+    while (bloco != NULL) {
+        ArenaBloco *temp = bloco;
+        bloco = bloco->anterior;
+        free(temp);
+    }
+    arena->atual = NULL;
+    arena->totalBlocos = 0;
+}
+
+size_t arenaCapacidade(const Arena *arena) {
+    size_t total = 0;
+    for (const ArenaBloco *bloco = arena->atual; bloco != NULL; bloco = bloco->anterior) {
+        total += sizeof(ArenaBloco) + bloco->capacidade;
+    }
+    return total;
+}
+
+// --- Implementação do Pool de Nós ---
+
+void poolInicializar(PoolNos *pool, Arena *arena, size_t tamanhoNo) {
+    pool->arena = arena;
+    pool->tamanhoNo = tamanhoNo < sizeof(void*) ? sizeof(void*) : tamanhoNo;
+    pool->livres = NULL;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file arena.h
+ * @brief Alocador por região (arena) usado pelos nós de uma sessão do Detective Quest.
+ *
+ * A arena reserva memória em blocos grandes e entrega fatias sequenciais deles.
+ * Salas, pistas e entradas da tabela hash de uma sessão saem da mesma arena e são
+ * liberadas de uma só vez com arenaLiberar(), sem percorrer nó a nó.
+ * O PoolNos acrescenta uma lista livre opcional para nós de tamanho fixo
+ * (ex.: PistaNode), permitindo reaproveitá-los entre uma exploração e outra.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// --- Constantes da Arena ---
+#define ARENA_BLOCO_PADRAO (64 * 1024)        // Tamanho do primeiro bloco
+#define ARENA_BLOCO_MAXIMO (16 * 1024 * 1024) // Limite do crescimento geométrico
+#define ARENA_ALINHAMENTO  _Alignof(max_align_t)
+
+// --- Estruturas ---
+
+// Bloco de memória da arena; os blocos formam uma lista do mais novo ao mais antigo
+typedef struct ArenaBloco {
+    struct ArenaBloco *anterior;
+    size_t usado;
+    size_t capacidade;
+    _Alignas(max_align_t) unsigned char dados[];
+} ArenaBloco;
+
+typedef struct Arena {
+    ArenaBloco *atual;    // Bloco onde ocorrem as próximas alocações
+    size_t tamanhoBloco;  // Capacidade do próximo bloco a ser criado
+    size_t totalBlocos;   // Quantidade de blocos (chamadas a malloc) em uso
+} Arena;
+
+// Pool de nós de tamanho fixo sobre uma arena, com lista livre intrusiva
+typedef struct PoolNos {
+    Arena *arena;
+    size_t tamanhoNo;
+    void *livres; // Cada nó livre guarda, no início, o ponteiro para o próximo
+} PoolNos;
+
+// --- Funções da Arena ---
+
+/**
+ * @brief Inicializa uma arena vazia. Nenhuma memória é reservada até a primeira alocação.
+ * @param arena O ponteiro para a arena.
+ * @param tamanhoBloco Capacidade do primeiro bloco (0 usa ARENA_BLOCO_PADRAO).
+ */
+void arenaInicializar(Arena *arena, size_t tamanhoBloco);
+
+/**
+ * @brief Reserva um novo bloco capaz de atender ao pedido e o torna o bloco atual.
+ *
+ * A capacidade dobra a cada bloco (até ARENA_BLOCO_MAXIMO), então o número de
+ * chamadas a malloc cresce de forma logarítmica com o tamanho da sessão.
+ */
+void arenaNovoBloco(Arena *arena, size_t minimo);
+
+/**
+ * @brief Aloca uma fatia alinhada da arena.
+ *
+ * Encerra o programa em caso de falta de memória, como criarSala() fazia.
+ * @param arena O ponteiro para a arena.
+ * @param tamanho Quantidade de bytes pedida.
+ * @return Ponteiro para a memória (não inicializada).
+ */
+static inline void *arenaAlocar(Arena *arena, size_t tamanho) {
+    // Arredonda para manter o alinhamento da próxima fatia
+    tamanho = (tamanho + ARENA_ALINHAMENTO - 1) & ~(size_t)(ARENA_ALINHAMENTO - 1);
+
+    ArenaBloco *bloco = arena->atual;
+    if (bloco == NULL || bloco->capacidade - bloco->usado < tamanho) {
+        arenaNovoBloco(arena, tamanho);
+        bloco = arena->atual;
+    }
+
+    void *fatia = bloco->dados + bloco->usado;
+    bloco->usado += tamanho;
+    return fatia;
+}
+
+/**
+ * @brief Descarta todo o conteúdo da arena, mantendo apenas o bloco mais recente para reuso.
+ * @param arena O ponteiro para a arena.
+ */
+void arenaReiniciar(Arena *arena);
+
+/**
+ * @brief Libera todos os blocos da arena de uma só vez.
+ *
+ * O custo depende apenas da quantidade de blocos, e não da quantidade de nós alocados.
+ * @param arena O ponteiro para a arena.
+ */
+void arenaLiberar(Arena *arena);
+
+/**
+ * @brief Memória reservada do sistema pela arena: a soma dos blocos, usados ou não.
+ */
+size_t arenaCapacidade(const Arena *arena);
+
+// --- Funções do Pool de Nós ---
+
+/**
+ * @brief Inicializa um pool de nós de tamanho fixo que aloca da arena informada.
+ * @param pool O ponteiro para o pool.
+ * @param arena A arena que fornece a memória dos nós.
+ * @param tamanhoNo O tamanho de cada nó (ex.: sizeof(PistaNode)).
+ */
+void poolInicializar(PoolNos *pool, Arena *arena, size_t tamanhoNo);
+
+/**
+ * @brief Obtém um nó do pool, reaproveitando um nó devolvido quando houver.
+ * @param pool O ponteiro para o pool.
+ * @return Ponteiro para o nó (não inicializado).
+ */
+static inline void *poolAlocar(PoolNos *pool) {
+    if (pool->livres != NULL) {
+        void *no = pool->livres;
+        pool->livres = *(void**)no;
+        return no;
+    }
+    return arenaAlocar(pool->arena, pool->tamanhoNo);
+}
+
+/**
+ * @brief Devolve um nó à lista livre do pool para uso futuro.
+ * @param pool O ponteiro para o pool.
+ * @param no O nó a ser devolvido (deve ter vindo deste pool).
+ */
+static inline void poolDevolver(PoolNos *pool, void *no) {
+    *(void**)no = pool->livres;
+    pool->livres = no;
+}
+
+#endif // ARENA_H
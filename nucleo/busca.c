@@ -0,0 +1,199 @@
+/**
+ * @file busca.c
+ * @brief Implementação da busca por prefixo e por trecho nas pistas coletadas.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "busca.h"
+
+// --- Trigramas ---
+
+/**
+ * @brief Minúscula ASCII de um byte (bytes de UTF-8 ficam como estão).
+ */
+static inline unsigned char buscaMinuscula(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Código do trigrama que começa em `texto` (que deve ter ao menos 3 bytes).
+ */
+static inline uint32_t buscaTrigrama(const char *texto) {
+    return (((uint32_t)buscaMinuscula((unsigned char)texto[0]) << 16) |
+            ((uint32_t)buscaMinuscula((unsigned char)texto[1]) << 8) |
+            (uint32_t)buscaMinuscula((unsigned char)texto[2])) + 1;
+}
+
+/**
+ * @brief Espalha os bits do código de um trigrama (finalizador do MurmurHash3).
+ */
+static inline uint32_t buscaEspalhar(uint32_t trigrama) {
+    trigrama ^= trigrama >> 16;
+    trigrama *= 0x85ebca6bu;
+    trigrama ^= trigrama >> 13;
+    trigrama *= 0xc2b2ae35u;
+    trigrama ^= trigrama >> 16;
+    return trigrama;
+}
+
+/**
+ * @brief Índice do trigrama na tabela (sondagem linear), ou da posição livre onde ele entraria.
+ */
+static uint32_t buscaSondar(const TrigramaPosicao *posicoes, uint32_t capacidade, uint32_t trigrama) {
+    uint32_t mascara = capacidade - 1;
+    for (uint32_t indice = buscaEspalhar(trigrama) & mascara;; indice = (indice + 1) & mascara) {
+        if (posicoes[indice].trigrama == trigrama || posicoes[indice].trigrama == 0) {
+            return indice;
+        }
+    }
+}
+
+/**
+ * @brief Aloca (na arena) uma tabela vazia e recoloca nela os trigramas da anterior.
+ */
+static void buscaReservarPosicoes(IndiceBusca *indice, uint32_t capacidade) {
+    TrigramaPosicao *posicoes = (TrigramaPosicao*)arenaAlocar(indice->arena, capacidade * sizeof(TrigramaPosicao));
+    memset(posicoes, 0, capacidade * sizeof(TrigramaPosicao));
+    for (uint32_t i = 0; i < indice->capacidade; i++) {
+        if (indice->posicoes[i].trigrama != 0) {
+            posicoes[buscaSondar(posicoes, capacidade, indice->posicoes[i].trigrama)] = indice->posicoes[i];
+        }
+    }
+    indice->posicoes = posicoes;
+    indice->capacidade = capacidade;
+}
+
+void inicializarIndiceBusca(IndiceBusca *indice, Arena *arena) {
+    indice->arena = arena;
+    indice->posicoes = NULL;
+    indice->capacidade = 0;
+    indice->totalTrigramas = 0;
+    indice->ocorrencias = NULL;
+    indice->totalOcorrencias = 0;
+    indice->capacidadeOcorrencias = 0;
+    buscaReservarPosicoes(indice, BUSCA_CAPACIDADE_INICIAL);
+}
+
+/**
+ * @brief Acrescenta uma pista à lista de um trigrama, se ela ainda não estiver lá.
+ */
+static void buscaAcrescentar(IndiceBusca *indice, uint32_t trigrama, uint32_t pista) {
+    TrigramaPosicao *posicao = &indice->posicoes[buscaSondar(indice->posicoes, indice->capacidade, trigrama)];
+    if (posicao->trigrama == 0) {
+        if ((indice->totalTrigramas + 1) * 2 > indice->capacidade) {
+            buscaReservarPosicoes(indice, indice->capacidade * 2);
+            posicao = &indice->posicoes[buscaSondar(indice->posicoes, indice->capacidade, trigrama)];
+        }
+        posicao->trigrama = trigrama;
+        posicao->ultima = UINT32_MAX;
+        posicao->total = 0;
+        indice->totalTrigramas++;
+    } else if (indice->ocorrencias[posicao->ultima].pista == pista) {
+        return; // O trigrama se repete no texto: os trigramas de uma pista entram todos seguidos
+    }
+
+    if (indice->totalOcorrencias == indice->capacidadeOcorrencias) {
+        uint32_t capacidade = indice->capacidadeOcorrencias > 0 ? indice->capacidadeOcorrencias * 2 : 64;
+        OcorrenciaTrigrama *ocorrencias = (OcorrenciaTrigrama*)arenaAlocar(indice->arena, capacidade * sizeof(OcorrenciaTrigrama));
+        if (indice->totalOcorrencias > 0) {
+            memcpy(ocorrencias, indice->ocorrencias, indice->totalOcorrencias * sizeof(OcorrenciaTrigrama));
+        }
+        indice->ocorrencias = ocorrencias;
+        indice->capacidadeOcorrencias = capacidade;
+    }
+    OcorrenciaTrigrama *ocorrencia = &indice->ocorrencias[indice->totalOcorrencias];
+    ocorrencia->pista = pista;
+    ocorrencia->anterior = posicao->ultima;
+    posicao->ultima = indice->totalOcorrencias++;
+    posicao->total++;
+}
+
+void indexarPista(IndiceBusca *indice, const Internador *pistas, uint32_t pista) {
+    const char *texto = textoDoId(pistas, pista);
+    size_t tamanho = tamanhoDoId(pistas, pista);
+    for (size_t i = 0; i + BUSCA_TAMANHO_TRIGRAMA <= tamanho; i++) {
+        buscaAcrescentar(indice, buscaTrigrama(texto + i), pista);
+    }
+}
+
+// --- Consultas ---
+
+uint32_t buscarPrefixo(const ConjuntoPistas *coletadas, const Internador *pistas, const char *prefixo, uint32_t *destino) {
+    uint32_t inicio, fim;
+    internadorIntervaloPrefixo(pistas, prefixo, &inicio, &fim);
+    uint32_t total = 0;
+    if (inicio == fim) {
+        return 0;
+    }
+    IteradorConjunto iterador;
+    iniciarIteradorConjuntoDesde(&iterador, coletadas, inicio);
+    for (uint32_t pista = proximaPistaConjunto(&iterador); pista != TEXTO_NENHUM && pista < fim;
+         pista = proximaPistaConjunto(&iterador)) {
+        destino[total++] = pista;
+    }
+    return total;
+}
+
+/**
+ * @brief Indica se `texto` contém `trecho` (de `tamanho` bytes), sem diferenciar maiúsculas ASCII.
+ */
+static int buscaContem(const char *texto, const char *trecho, size_t tamanho) {
+    for (; *texto != '\0'; texto++) {
+        size_t i = 0;
+        while (i < tamanho && texto[i] != '\0' &&
+               buscaMinuscula((unsigned char)texto[i]) == buscaMinuscula((unsigned char)trecho[i])) {
+            i++;
+        }
+        if (i == tamanho) {
+            return 1;
+        }
+    }
+    return tamanho == 0;
+}
+
+static int compararIds(const void *a, const void *b) {
+    uint32_t idA = *(const uint32_t*)a;
+    uint32_t idB = *(const uint32_t*)b;
+    return (idA > idB) - (idA < idB);
+}
+
+uint32_t buscarTrecho(const IndiceBusca *indice, const ConjuntoPistas *coletadas, const Internador *pistas,
+                      const char *trecho, uint32_t *destino) {
+    size_t tamanho = strlen(trecho);
+    uint32_t total = 0;
+
+    if (tamanho < BUSCA_TAMANHO_TRIGRAMA) {
+        // Sem trigrama para filtrar: confere as pistas coletadas, já em ordem
+        IteradorConjunto iterador;
+        iniciarIteradorConjunto(&iterador, coletadas);
+        for (uint32_t pista = proximaPistaConjunto(&iterador); pista != TEXTO_NENHUM; pista = proximaPistaConjunto(&iterador)) {
+            if (buscaContem(textoDoId(pistas, pista), trecho, tamanho)) {
+                destino[total++] = pista;
+            }
+        }
+        return total;
+    }
+
+    // A menor lista entre os trigramas do trecho; um trigrama ausente descarta a busca
+    const TrigramaPosicao *menor = NULL;
+    for (size_t i = 0; i + BUSCA_TAMANHO_TRIGRAMA <= tamanho; i++) {
+        const TrigramaPosicao *posicao = &indice->posicoes[buscaSondar(indice->posicoes, indice->capacidade, buscaTrigrama(trecho + i))];
+        if (posicao->trigrama == 0) {
+            return 0;
+        }
+        if (menor == NULL || posicao->total < menor->total) {
+            menor = posicao;
+        }
+    }
+
+    for (uint32_t o = menor->ultima; o != UINT32_MAX; o = indice->ocorrencias[o].anterior) {
+        uint32_t pista = indice->ocorrencias[o].pista;
+        if (buscaContem(textoDoId(pistas, pista), trecho, tamanho)) {
+            destino[total++] = pista;
+        }
+    }
+    qsort(destino, total, sizeof(uint32_t), compararIds); // A lista está em ordem de coleta
+    return total;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file busca.h
+ * @brief Busca nas pistas coletadas: por prefixo e por trecho ("todas as pistas que falam de chave").
+ *
+ * - Prefixo: como os ids das pistas seguem a ordem alfabética (mapaFinalizar()),
+ *   as pistas com um prefixo formam um intervalo de ids
+ *   (internadorIntervaloPrefixo()); o conjunto de pistas coletadas é
+ *   percorrido a partir do início do intervalo com iniciarIteradorConjuntoDesde()
+ *   e para no fim dele. O custo é O(log n) para achar o intervalo, mais as
+ *   palavras de bits dentro dele, e a comparação diferencia maiúsculas.
+ *   Não há iterador de limite inferior na árvore de pistas (pistas.h): as
+ *   sessões guardam as coletadas no ConjuntoPistas, e nele o limite inferior
+ *   do prefixo é o primeiro id do intervalo.
+ * - Trecho: um índice de trigramas (trechos de 3 bytes, sem diferenciar
+ *   maiúsculas ASCII) construído aos poucos, uma pista por vez, conforme elas
+ *   são coletadas. Cada trigrama aponta para a lista das pistas coletadas que
+ *   o contêm; a consulta percorre só a menor lista entre os trigramas do
+ *   trecho e confirma cada candidata no texto. Trechos com menos de 3 bytes
+ *   não têm trigrama e são procurados em todas as pistas coletadas.
+ *
+ * Tudo sai da arena da sessão: o índice é descartado junto com ela, e
+ * o crescimento das tabelas deixa para trás os vetores antigos, como na
+ * SuspeitoHash. Letras acentuadas (UTF-8) são comparadas byte a byte.
+ */
+
+#ifndef BUSCA_H
+#define BUSCA_H
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "conjunto.h"
+#include "internador.h"
+
+// --- Constantes da Busca ---
+#define BUSCA_TAMANHO_TRIGRAMA 3
+#define BUSCA_CAPACIDADE_INICIAL 64 // Posições da tabela de trigramas (sempre potência de 2)
+
+// --- Estruturas ---
+
+// Ocorrência de um trigrama: uma pista e a ocorrência anterior do mesmo trigrama
+typedef struct OcorrenciaTrigrama {
+    uint32_t pista;
+    uint32_t anterior; // Índice em IndiceBusca.ocorrencias (UINT32_MAX: primeira da lista)
+} OcorrenciaTrigrama;
+
+// Posição da tabela de trigramas (posição livre: trigrama == 0)
+typedef struct TrigramaPosicao {
+    uint32_t trigrama; // Os 3 bytes em minúsculas, mais 1 (nunca 0)
+    uint32_t ultima;   // Ocorrência mais recente
+    uint32_t total;    // Pistas na lista
+} TrigramaPosicao;
+
+typedef struct IndiceBusca {
+    Arena *arena;
+    TrigramaPosicao *posicoes;
+    uint32_t capacidade;      // Tamanho da tabela (potência de 2, carga <= 1/2)
+    uint32_t totalTrigramas;
+    OcorrenciaTrigrama *ocorrencias;
+    uint32_t totalOcorrencias;
+    uint32_t capacidadeOcorrencias;
+} IndiceBusca;
+
+// --- Funções da Busca ---
+
+/**
+ * @brief Inicializa um índice de trigramas vazio.
+ * @param indice O ponteiro para o índice.
+ * @param arena A arena de onde saem a tabela e as listas.
+ */
+void inicializarIndiceBusca(IndiceBusca *indice, Arena *arena);
+
+/**
+ * @brief Acrescenta ao índice os trigramas de uma pista recém-coletada.
+ *
+ * Cada pista deve ser indexada uma única vez (quando entra na BST).
+ * @param indice O índice.
+ * @param pistas O internador de pistas do mapa.
+ * @param pista O id da pista.
+ */
+void indexarPista(IndiceBusca *indice, const Internador *pistas, uint32_t pista);
+
+/**
+ * @brief Pistas coletadas cujo texto começa com um prefixo, em ordem alfabética.
+ * @param coletadas O conjunto das pistas coletadas.
+ * @param pistas O internador de pistas do mapa (em ordem alfabética).
+ * @param prefixo O prefixo, com maiúsculas e minúsculas como no texto.
+ * @param destino Vetor com espaço para todas as pistas coletadas.
+ * @return A quantidade de ids copiados.
+ */
+uint32_t buscarPrefixo(const ConjuntoPistas *coletadas, const Internador *pistas, const char *prefixo, uint32_t *destino);
+
+/**
+ * @brief Pistas coletadas que contêm um trecho, sem diferenciar maiúsculas, em ordem alfabética.
+ * @param indice O índice com todas as pistas coletadas.
+ * @param coletadas O conjunto das pistas coletadas (usado para trechos menores que um trigrama).
+ * @param pistas O internador de pistas do mapa.
+ * @param trecho O trecho procurado ("" devolve todas as pistas).
+ * @param destino Vetor com espaço para todas as pistas coletadas.
+ * @return A quantidade de ids copiados.
+ */
+uint32_t buscarTrecho(const IndiceBusca *indice, const ConjuntoPistas *coletadas, const Internador *pistas,
+                      const char *trecho, uint32_t *destino);
+
+#endif // BUSCA_H
@@ -0,0 +1,89 @@
+/**
+ * @file conjunto.c
+ * @brief Implementação do conjunto de pistas coletadas (bits por id).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "conjunto.h"
+
+void iniciarConjuntoPistas(ConjuntoPistas *conjunto, uint32_t totalPistas) {
+    // Uma palavra a mais, como em Sessao.coletadas: nunca há vetor vazio
+    conjunto->totalPalavras = totalPistas / 64 + 1;
+    conjunto->bits = (uint64_t*)calloc(conjunto->totalPalavras, sizeof(uint64_t));
+    conjunto->resumo = (uint64_t*)calloc((conjunto->totalPalavras + 63) / 64, sizeof(uint64_t));
+    if (conjunto->bits == NULL || conjunto->resumo == NULL) {
+        printf("Erro de alocação de memória para o Conjunto de Pistas!\n");
+        exit(EXIT_FAILURE);
+    }
+    conjunto->total = 0;
+}
+
+void esvaziarConjuntoPistas(ConjuntoPistas *conjunto) {
+    if (conjunto->total == 0) {
+        return;
+    }
+    uint32_t totalGrupos = (conjunto->totalPalavras + 63) / 64;
+    for (uint32_t grupo = 0; grupo < totalGrupos; grupo++) {
+        for (uint64_t palavras = conjunto->resumo[grupo]; palavras != 0; palavras &= palavras - 1) {
+            conjunto->bits[grupo * 64 + (uint32_t)__builtin_ctzll(palavras)] = 0;
+        }
+        conjunto->resumo[grupo] = 0;
+    }
+    conjunto->total = 0;
+}
+
+void liberarConjuntoPistas(ConjuntoPistas *conjunto) {
+    free(conjunto->bits);
+    free(conjunto->resumo);
+    conjunto->bits = NULL;
+    conjunto->resumo = NULL;
+    conjunto->totalPalavras = 0;
+    conjunto->total = 0;
+}
+
+void conjuntoInserirLote(ConjuntoPistas *conjunto, const uint32_t *ids, uint32_t total) {
+    for (uint32_t i = 0; i < total; i++) {
+        conjuntoInserir(conjunto, ids[i]);
+    }
+}
+
+void conjuntoUnir(ConjuntoPistas *destino, const ConjuntoPistas *origem) {
+    uint32_t totalGrupos = (origem->totalPalavras + 63) / 64;
+    for (uint32_t grupo = 0; grupo < totalGrupos; grupo++) {
+        uint64_t marcadas = origem->resumo[grupo];
+        for (uint64_t palavras = marcadas; palavras != 0; palavras &= palavras - 1) {
+            uint32_t palavra = grupo * 64 + (uint32_t)__builtin_ctzll(palavras);
+            uint64_t novas = origem->bits[palavra] & ~destino->bits[palavra];
+            destino->bits[palavra] |= novas;
+            destino->total += (uint32_t)__builtin_popcountll(novas);
+        }
+        destino->resumo[grupo] |= marcadas;
+    }
+}
+
+uint32_t listarConjuntoPistas(const ConjuntoPistas *conjunto, uint32_t *destino) {
+    // O mesmo percurso do IteradorConjunto, sem guardar a posição entre uma pista e outra
+    uint32_t total = 0;
+    uint32_t totalGrupos = (conjunto->totalPalavras + 63) / 64;
+    for (uint32_t grupo = 0; grupo < totalGrupos && total < conjunto->total; grupo++) {
+        for (uint64_t palavras = conjunto->resumo[grupo]; palavras != 0; palavras &= palavras - 1) {
+            uint32_t palavra = grupo * 64 + (uint32_t)__builtin_ctzll(palavras);
+            for (uint64_t bits = conjunto->bits[palavra]; bits != 0; bits &= bits - 1) {
+                destino[total++] = palavra * 64 + (uint32_t)__builtin_ctzll(bits);
+            }
+        }
+    }
+    return total;
+}
+
+void anexarConjuntoPistas(Saida *saida, const ConjuntoPistas *conjunto, const Internador *pistas) {
+    IteradorConjunto iterador;
+    iniciarIteradorConjunto(&iterador, conjunto);
+    for (uint32_t pista = proximaPistaConjunto(&iterador); pista != TEXTO_NENHUM; pista = proximaPistaConjunto(&iterador)) {
+        saidaBytes(saida, "  - ", 4);
+        saidaBytes(saida, textoDoId(pistas, pista), tamanhoDoId(pistas, pista));
+        saidaBytes(saida, "\n", 1);
+    }
+}
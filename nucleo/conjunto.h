@@ -0,0 +1,197 @@
+/**
+ * @file conjunto.h
+ * @brief Conjunto de pistas coletadas: um bit por id do internador de pistas do mapa.
+ *
+ * O internador de pistas do mapa já é um vetor ordenado compartilhado:
+ * mapaFinalizar() numera as pistas em ordem alfabética, e o mapa não muda
+ * durante o jogo. Uma sessão não precisa então de uma árvore própria para
+ * guardar as pistas coletadas em ordem; basta marcar quais ids ela tem. O
+ * conjunto ocupa totalPistas / 8 bytes (mais 1/64 disso no resumo), em vez de
+ * um nó de BST por pista coletada, e a inserção é um OR em uma palavra.
+ *
+ * Os bits ficam em dois níveis: `bits` tem um bit por pista, e `resumo` um bit
+ * por palavra de `bits` que não é zero. O percurso em ordem salta as palavras
+ * vazias olhando só o resumo, e esvaziarConjuntoPistas() zera apenas as
+ * palavras marcadas: em um mapa grande, uma partida curta não paga pelo
+ * tamanho do mapa nem para listar, nem para recomeçar.
+ */
+
+#ifndef CONJUNTO_H
+#define CONJUNTO_H
+
+#include <stdint.h>
+
+#include "internador.h"
+#include "saida.h"
+
+// --- Estruturas ---
+
+typedef struct ConjuntoPistas {
+    uint64_t *bits;          // Bit i ligado: a pista de id i está no conjunto
+    uint64_t *resumo;        // Bit j ligado: bits[j] tem algum bit ligado
+    uint32_t totalPalavras;  // Palavras em `bits`
+    uint32_t total;          // Pistas no conjunto
+} ConjuntoPistas;
+
+// Percurso em ordem crescente de id (ordem alfabética das pistas)
+typedef struct IteradorConjunto {
+    const ConjuntoPistas *conjunto;
+    uint64_t restante;       // Bits ainda não visitados da palavra atual
+    uint64_t resumoRestante; // Palavras ainda não visitadas do grupo atual de 64
+    uint32_t palavra;        // Índice da palavra atual em `bits`
+    uint32_t grupo;          // Índice da palavra atual em `resumo`
+} IteradorConjunto;
+
+// --- Funções do Conjunto de Pistas ---
+
+/**
+ * @brief Cria um conjunto vazio com espaço para os ids de 0 a totalPistas - 1.
+ * @param conjunto O ponteiro para o conjunto.
+ * @param totalPistas O total de pistas do internador (ex.: mapa->pistas.total).
+ */
+void iniciarConjuntoPistas(ConjuntoPistas *conjunto, uint32_t totalPistas);
+
+/**
+ * @brief Tira todas as pistas do conjunto, zerando só as palavras usadas.
+ */
+void esvaziarConjuntoPistas(ConjuntoPistas *conjunto);
+
+/**
+ * @brief Libera os vetores de bits do conjunto.
+ */
+void liberarConjuntoPistas(ConjuntoPistas *conjunto);
+
+/**
+ * @brief Indica se a pista está no conjunto.
+ */
+static inline int conjuntoContem(const ConjuntoPistas *conjunto, uint32_t pista) {
+    return (conjunto->bits[pista / 64] >> (pista % 64)) & 1;
+}
+
+/**
+ * @brief Acrescenta uma pista ao conjunto, como inserirPista() na BST.
+ * @return 1 se a pista entrou agora, 0 se ela já estava no conjunto.
+ */
+static inline int conjuntoInserir(ConjuntoPistas *conjunto, uint32_t pista) {
+    uint64_t *palavra = &conjunto->bits[pista / 64];
+    uint64_t bit = UINT64_C(1) << (pista % 64);
+    if (*palavra & bit) {
+        return 0;
+    }
+    *palavra |= bit;
+    conjunto->resumo[pista / 4096] |= UINT64_C(1) << (pista / 64 % 64);
+    conjunto->total++;
+    return 1;
+}
+
+// --- Operações em Lote ---
+
+/**
+ * @brief Acrescenta de uma vez as pistas de uma palavra de `bits`, como gravada por um retrato (retrato.h).
+ * @param conjunto O conjunto de pistas.
+ * @param indice A posição da palavra (menor que totalPalavras).
+ * @param palavra Os bits das pistas indice * 64 .. indice * 64 + 63.
+ */
+static inline void conjuntoCarregarPalavra(ConjuntoPistas *conjunto, uint32_t indice, uint64_t palavra) {
+    uint64_t novas = palavra & ~conjunto->bits[indice];
+    if (novas == 0) {
+        return;
+    }
+    conjunto->bits[indice] |= novas;
+    conjunto->resumo[indice / 64] |= UINT64_C(1) << (indice % 64);
+    conjunto->total += (uint32_t)__builtin_popcountll(novas);
+}
+
+/**
+ * @brief Acrescenta um lote de ids, em qualquer ordem e com repetições.
+ *
+ * Cada id custa um OR, sem ordenação: o conjunto já é indexado pelo id.
+ * @param conjunto O conjunto de pistas.
+ * @param ids Os ids das pistas (menores que o total do internador).
+ * @param total A quantidade de ids.
+ */
+void conjuntoInserirLote(ConjuntoPistas *conjunto, const uint32_t *ids, uint32_t total);
+
+/**
+ * @brief Acrescenta a `destino` todas as pistas de `origem` (a união das coletas de duas sessões).
+ *
+ * Só as palavras marcadas no resumo de `origem` são lidas, então o custo
+ * acompanha as pistas de `origem`, e não o tamanho do mapa.
+ * @param destino O conjunto que recebe as pistas.
+ * @param origem Um conjunto do mesmo internador (criado com o mesmo total de pistas).
+ */
+void conjuntoUnir(ConjuntoPistas *destino, const ConjuntoPistas *origem);
+
+// --- Iterador em Ordem ---
+
+/**
+ * @brief Posiciona o iterador antes da menor pista do conjunto maior ou igual a `menor`.
+ * @param iterador O iterador (sem alocação; pode ficar na pilha do chamador).
+ * @param conjunto O conjunto, que não pode ser alterado durante o percurso.
+ * @param menor O id a partir do qual o percurso começa (0: todas as pistas).
+ */
+static inline void iniciarIteradorConjuntoDesde(IteradorConjunto *iterador, const ConjuntoPistas *conjunto,
+                                                uint32_t menor) {
+    iterador->conjunto = conjunto;
+    iterador->palavra = menor / 64;
+    iterador->grupo = menor / 4096;
+    if (iterador->palavra >= conjunto->totalPalavras) {
+        iterador->restante = 0;
+        iterador->resumoRestante = 0;
+        return;
+    }
+    iterador->restante = conjunto->bits[iterador->palavra] & (~UINT64_C(0) << (menor % 64));
+    // Só as palavras do grupo depois da atual; a atual já está em `restante`
+    unsigned posicao = iterador->palavra % 64;
+    iterador->resumoRestante = posicao == 63 ? 0 : conjunto->resumo[iterador->grupo] & (~UINT64_C(0) << (posicao + 1));
+}
+
+/**
+ * @brief Posiciona o iterador antes da menor pista do conjunto.
+ */
+static inline void iniciarIteradorConjunto(IteradorConjunto *iterador, const ConjuntoPistas *conjunto) {
+    iniciarIteradorConjuntoDesde(iterador, conjunto, 0);
+}
+
+/**
+ * @brief Avança para a próxima pista em ordem alfabética.
+ * @return O id da pista, ou TEXTO_NENHUM ao final do conjunto.
+ */
+static inline uint32_t proximaPistaConjunto(IteradorConjunto *iterador) {
+    while (iterador->restante == 0) {
+        while (iterador->resumoRestante == 0) {
+            uint32_t totalGrupos = (iterador->conjunto->totalPalavras + 63) / 64;
+            if (++iterador->grupo >= totalGrupos) {
+                iterador->grupo = totalGrupos;
+                return TEXTO_NENHUM;
+            }
+            iterador->resumoRestante = iterador->conjunto->resumo[iterador->grupo];
+        }
+        iterador->palavra = iterador->grupo * 64 + (uint32_t)__builtin_ctzll(iterador->resumoRestante);
+        iterador->resumoRestante &= iterador->resumoRestante - 1;
+        iterador->restante = iterador->conjunto->bits[iterador->palavra];
+    }
+    uint32_t pista = iterador->palavra * 64 + (uint32_t)__builtin_ctzll(iterador->restante);
+    iterador->restante &= iterador->restante - 1;
+    return pista;
+}
+
+// --- Listagem e Exibição ---
+
+/**
+ * @brief Copia os ids do conjunto, em ordem alfabética.
+ * @param conjunto O conjunto de pistas.
+ * @param destino Vetor com espaço para conjunto->total ids.
+ * @return A quantidade de ids copiados (conjunto->total).
+ */
+uint32_t listarConjuntoPistas(const ConjuntoPistas *conjunto, uint32_t *destino);
+
+/**
+ * @brief Acrescenta as pistas do conjunto a uma saída, uma linha "  - <pista>" por pista, como anexarPistas().
+ * @param saida A saída que recebe as linhas.
+ * @param conjunto O conjunto de pistas.
+ * @param pistas O internador que contém os textos das pistas.
+ */
+void anexarConjuntoPistas(Saida *saida, const ConjuntoPistas *conjunto, const Internador *pistas);
+
+#endif // CONJUNTO_H
@@ -0,0 +1,635 @@
+/**
+ * @file diario.c
+ * @brief Implementação do diário de partidas: escrita em grupo e reprodução no motor.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "diario.h"
+#include "instrumentos.h"
+#include "paginas.h"
+
+// --- Constantes Internas ---
+#define DIARIO_BLOCO_SESSAO 4096 // Primeiro bloco da arena de cada sessão reproduzida
+
+// --- Cabeçalho ---
+
+static void preencherCabecalho(DiarioCabecalho *cabecalho, const Mapa *mapa) {
+    memset(cabecalho, 0, sizeof(DiarioCabecalho));
+    memcpy(cabecalho->magico, DIARIO_MAGICO, sizeof(cabecalho->magico));
+    cabecalho->ordemBytes = DIARIO_ORDEM_BYTES;
+    cabecalho->totalSalas = mapa->totalSalas;
+    cabecalho->totalPistas = mapa->pistas.total;
+    cabecalho->totalSuspeitos = mapa->suspeitos.total;
+}
+
+/**
+ * @brief Confere se o cabeçalho gravado é de um diário deste mapa.
+ */
+static int cabecalhoValido(const DiarioCabecalho *cabecalho, const Mapa *mapa) {
+    DiarioCabecalho esperado;
+    preencherCabecalho(&esperado, mapa);
+    return memcmp(cabecalho, &esperado, sizeof(DiarioCabecalho)) == 0;
+}
+
+// --- Escrita ---
+
+/**
+ * @brief Escreve todos os bytes, repetindo as escritas parciais.
+ * @return 0, ou -1 em caso de erro (errno indica o motivo).
+ */
+static int escreverTudo(int descritor, const void *dados, size_t tamanho) {
+    const unsigned char *bytes = (const unsigned char*)dados;
+    while (tamanho > 0) {
+        ssize_t escritos = write(descritor, bytes, tamanho);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        bytes += escritos;
+        tamanho -= (size_t)escritos;
+    }
+    return 0;
+}
+
+/**
+ * @brief Laço da thread de escrita: junta os eventos de um intervalo e grava o lote de uma vez.
+ */
+static void *diarioEscritor(void *argumento) {
+    Diario *diario = (Diario*)argumento;
+    pthread_mutex_lock(&diario->trava);
+    for (;;) {
+        while (diario->totalPendentes == 0 && !diario->encerrar) {
+            pthread_cond_wait(&diario->haEventos, &diario->trava);
+        }
+        if (diario->totalPendentes == 0) {
+            break; // Encerramento, com tudo gravado
+        }
+        // Confirmação em grupo: os eventos que chegarem no intervalo vão no mesmo lote
+        if (diario->totalPendentes < DIARIO_LOTE_EVENTOS && !diario->encerrar && diario->confirmacoes == 0) {
+            struct timespec limite;
+            clock_gettime(CLOCK_REALTIME, &limite);
+            limite.tv_nsec += DIARIO_INTERVALO_MS * 1000000L;
+            if (limite.tv_nsec >= 1000000000L) {
+                limite.tv_sec++;
+                limite.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&diario->haEventos, &diario->trava, &limite);
+        }
+
+        EventoDiario *lote = diario->pendentes;
+        uint32_t total = diario->totalPendentes;
+        uint64_t alvo = diario->registrados;
+        // O lote acaba no próximo id: os ids do lote já foram todos distribuídos
+        EventoDiario marca = { DIARIO_SEM_SESSAO, DIARIO_LOTE, 0, atomic_load(&diario->proximaSessao), total };
+        lote[total] = marca;
+        diario->pendentes = diario->gravando;
+        diario->gravando = lote;
+        diario->totalPendentes = 0;
+        pthread_cond_broadcast(&diario->gravado); // Há espaço de novo
+        pthread_mutex_unlock(&diario->trava);
+
+        int erro = 0;
+        if (diario->erro == 0 && (escreverTudo(diario->descritor, lote, ((size_t)total + 1) * sizeof(EventoDiario)) != 0 ||
+                                  fdatasync(diario->descritor) != 0)) {
+            erro = errno;
+        }
+        INSTRUMENTAR_CONTAR(CONTADOR_LOTES_DIARIO, 1);
+
+        pthread_mutex_lock(&diario->trava);
+        if (erro != 0 && diario->erro == 0) {
+            diario->erro = erro; // Os lotes seguintes são descartados: o arquivo ficaria com um buraco
+        }
+        diario->gravados = alvo;
+        pthread_cond_broadcast(&diario->gravado);
+    }
+    pthread_mutex_unlock(&diario->trava);
+    return NULL;
+}
+
+/**
+ * @brief Prepara um arquivo existente para acréscimo: corta o evento incompleto e acha o próximo id.
+ *
+ * Só lê o fim do arquivo: cada lote termina com um DIARIO_LOTE que guarda o
+ * próximo id, e depois do último deles há no máximo um lote interrompido, com
+ * menos de DIARIO_LOTE_EVENTOS + 1 eventos. O custo não cresce com o diário.
+ * @return 0, ou -1 se o arquivo não for um diário deste mapa.
+ */
+static int retomarArquivo(Diario *diario, const Mapa *mapa, off_t tamanho) {
+    DiarioCabecalho cabecalho;
+    if ((size_t)tamanho < sizeof(cabecalho) ||
+        pread(diario->descritor, &cabecalho, sizeof(cabecalho), 0) != (ssize_t)sizeof(cabecalho) ||
+        !cabecalhoValido(&cabecalho, mapa)) {
+        errno = EINVAL;
+        return -1;
+    }
+    size_t totalEventos = ((size_t)tamanho - sizeof(cabecalho)) / sizeof(EventoDiario);
+    off_t completo = (off_t)(sizeof(cabecalho) + totalEventos * sizeof(EventoDiario));
+    if (completo != tamanho && ftruncate(diario->descritor, completo) != 0) {
+        return -1;
+    }
+
+    // O último lote inteiro termina em um DIARIO_LOTE dentro da cauda
+    size_t totalCauda = totalEventos < DIARIO_LOTE_EVENTOS + 1 ? totalEventos : DIARIO_LOTE_EVENTOS + 1;
+    if (totalCauda == 0) {
+        return 0;
+    }
+    size_t bytesCauda = totalCauda * sizeof(EventoDiario);
+    EventoDiario *cauda = (EventoDiario*)malloc(bytesCauda);
+    if (cauda == NULL) {
+        printf("Erro de alocação de memória para o Diário!\n");
+        exit(EXIT_FAILURE);
+    }
+    if (pread(diario->descritor, cauda, bytesCauda, completo - (off_t)bytesCauda) != (ssize_t)bytesCauda) {
+        int erro = errno;
+        free(cauda);
+        errno = erro != 0 ? erro : EIO;
+        return -1;
+    }
+    uint32_t proxima = 0;
+    size_t i = totalCauda;
+    while (i > 0 && cauda[i - 1].tipo != DIARIO_LOTE) {
+        // Lote interrompido: os seus ids podem ir além do último DIARIO_LOTE
+        uint32_t sessao = cauda[i - 1].sessao;
+        if (sessao != DIARIO_SEM_SESSAO && sessao >= proxima) {
+            proxima = sessao + 1;
+        }
+        i--;
+    }
+    if (i > 0 && cauda[i - 1].argumento > proxima) {
+        proxima = cauda[i - 1].argumento;
+    }
+    free(cauda);
+    if (i == 0 && totalEventos > totalCauda) {
+        errno = EINVAL; // Eventos demais sem um DIARIO_LOTE: não foi gravado por um Diario
+        return -1;
+    }
+    atomic_store(&diario->proximaSessao, proxima);
+    return 0;
+}
+
+int abrirDiario(Diario *diario, const Mapa *mapa, const char *caminho) {
+    memset(diario, 0, sizeof(Diario));
+    diario->descritor = open(caminho, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (diario->descritor < 0) {
+        return -1;
+    }
+    struct stat informacoes;
+    int resultado = fstat(diario->descritor, &informacoes);
+    atomic_init(&diario->proximaSessao, 0);
+    if (resultado == 0 && informacoes.st_size == 0) {
+        DiarioCabecalho cabecalho;
+        preencherCabecalho(&cabecalho, mapa);
+        resultado = escreverTudo(diario->descritor, &cabecalho, sizeof(cabecalho));
+    } else if (resultado == 0) {
+        resultado = retomarArquivo(diario, mapa, informacoes.st_size);
+    }
+    if (resultado != 0) {
+        int erro = errno;
+        close(diario->descritor);
+        errno = erro;
+        return -1;
+    }
+
+    // Uma posição a mais em cada lote para o DIARIO_LOTE do escritor
+    diario->pendentes = (EventoDiario*)malloc((DIARIO_LOTE_EVENTOS + 1) * sizeof(EventoDiario));
+    diario->gravando = (EventoDiario*)malloc((DIARIO_LOTE_EVENTOS + 1) * sizeof(EventoDiario));
+    if (diario->pendentes == NULL || diario->gravando == NULL) {
+        printf("Erro de alocação de memória para o Diário!\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&diario->trava, NULL);
+    pthread_cond_init(&diario->haEventos, NULL);
+    pthread_cond_init(&diario->gravado, NULL);
+    if (pthread_create(&diario->escritor, NULL, diarioEscritor, diario) != 0) {
+        printf("Erro ao criar a thread do Diário!\n");
+        exit(EXIT_FAILURE);
+    }
+    return 0;
+}
+
+void diarioAnexar(Diario *diario, const EventoDiario *eventos, uint32_t total) {
+    INSTRUMENTAR_CONTAR(CONTADOR_EVENTOS_DIARIO, total);
+    pthread_mutex_lock(&diario->trava);
+    while (total > 0) {
+        uint32_t espaco = DIARIO_LOTE_EVENTOS - diario->totalPendentes;
+        if (espaco == 0) {
+            pthread_cond_signal(&diario->haEventos);
+            pthread_cond_wait(&diario->gravado, &diario->trava); // O escritor ainda grava o lote anterior
+            continue;
+        }
+        uint32_t copiar = total < espaco ? total : espaco;
+        memcpy(diario->pendentes + diario->totalPendentes, eventos, copiar * sizeof(EventoDiario));
+        diario->totalPendentes += copiar;
+        diario->registrados += copiar;
+        eventos += copiar;
+        total -= copiar;
+        if (diario->totalPendentes == DIARIO_LOTE_EVENTOS) {
+            pthread_cond_signal(&diario->haEventos);
+        }
+    }
+    pthread_mutex_unlock(&diario->trava);
+}
+
+int diarioConfirmar(Diario *diario) {
+    pthread_mutex_lock(&diario->trava);
+    uint64_t alvo = diario->registrados;
+    diario->confirmacoes++;
+    pthread_cond_signal(&diario->haEventos);
+    while (diario->gravados < alvo) {
+        pthread_cond_wait(&diario->gravado, &diario->trava);
+    }
+    diario->confirmacoes--;
+    int erro = diario->erro;
+    pthread_mutex_unlock(&diario->trava);
+    if (erro != 0) {
+        errno = erro;
+        return -1;
+    }
+    return 0;
+}
+
+int fecharDiario(Diario *diario) {
+    pthread_mutex_lock(&diario->trava);
+    diario->encerrar = 1;
+    pthread_cond_signal(&diario->haEventos);
+    pthread_mutex_unlock(&diario->trava);
+    pthread_join(diario->escritor, NULL);
+
+    int erro = diario->erro;
+    if (close(diario->descritor) != 0 && erro == 0) {
+        erro = errno;
+    }
+    free(diario->pendentes);
+    free(diario->gravando);
+    pthread_mutex_destroy(&diario->trava);
+    pthread_cond_destroy(&diario->haEventos);
+    pthread_cond_destroy(&diario->gravado);
+    if (erro != 0) {
+        errno = erro;
+        return -1;
+    }
+    return 0;
+}
+
+// --- Registro das Sessões ---
+
+/**
+ * @brief Passa ao diário os eventos guardados no bloco.
+ */
+static void registroEntregar(RegistroDiario *registro) {
+    if (registro->total > 0) {
+        diarioAnexar(registro->diario, registro->eventos, registro->total);
+        registro->total = 0;
+    }
+}
+
+void registroNovaPartida(RegistroDiario *registro, const Mapa *mapa) {
+    if (registro->total + 2 > DIARIO_EVENTOS_SESSAO) {
+        registroEntregar(registro); // Cabem o início e o evento que o pediu
+    }
+    registro->sessao = atomic_fetch_add_explicit(&registro->diario->proximaSessao, 1, memory_order_relaxed);
+    EventoDiario *evento = &registro->eventos[registro->total++];
+    evento->sessao = registro->sessao;
+    evento->tipo = DIARIO_INICIO;
+    evento->detalhe = 0;
+    evento->argumento = mapa->raiz;
+    evento->resultado = 0;
+}
+
+void registroRetomarPartida(RegistroDiario *registro, uint32_t id) {
+    atomic_uint *proxima = &registro->diario->proximaSessao;
+    if (id == DIARIO_SEM_SESSAO) {
+        id = atomic_fetch_add_explicit(proxima, 1, memory_order_relaxed);
+    } else {
+        // O retrato pode ser de uma execução anterior: os ids novos não podem repetir o dele
+        unsigned atual = atomic_load_explicit(proxima, memory_order_relaxed);
+        while (atual <= id && !atomic_compare_exchange_weak_explicit(proxima, &atual, id + 1, memory_order_relaxed,
+                                                                     memory_order_relaxed)) {
+            // A falha recarrega `atual`; outra thread pode já ter passado de id
+        }
+    }
+    registro->sessao = id;
+}
+
+void sessaoAtivarDiario(Sessao *sessao, Diario *diario) {
+    sessaoDesativarDiario(sessao);
+    RegistroDiario *registro = (RegistroDiario*)malloc(sizeof(RegistroDiario));
+    if (registro == NULL) {
+        printf("Erro de alocação de memória para o Diário!\n");
+        exit(EXIT_FAILURE);
+    }
+    registro->diario = diario;
+    registro->sessao = DIARIO_SEM_SESSAO;
+    registro->total = 0;
+    sessao->diario = registro;
+}
+
+void sessaoDescarregarDiario(Sessao *sessao) {
+    if (sessao->diario != NULL) {
+        registroEntregar(sessao->diario);
+    }
+}
+
+void sessaoDesativarDiario(Sessao *sessao) {
+    if (sessao->diario == NULL) {
+        return;
+    }
+    registroEntregar(sessao->diario);
+    free(sessao->diario);
+    sessao->diario = NULL;
+}
+
+// --- Tabela de Sessões da Reprodução ---
+
+// Partidas abertas por id, com endereçamento aberto (as partidas terminam em qualquer ordem)
+typedef struct TabelaSessoes {
+    uint32_t *ids;
+    Sessao **sessoes;   // NULL: posição vazia
+    uint32_t capacidade; // Potência de 2
+    uint32_t total;
+} TabelaSessoes;
+
+static uint32_t tabelaPosicao(const TabelaSessoes *tabela, uint32_t id) {
+    return (uint32_t)(((uint64_t)id * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (tabela->capacidade - 1);
+}
+
+static void tabelaIniciar(TabelaSessoes *tabela, uint32_t capacidade) {
+    tabela->ids = (uint32_t*)malloc(capacidade * sizeof(uint32_t));
+    tabela->sessoes = (Sessao**)calloc(capacidade, sizeof(Sessao*));
+    if (tabela->ids == NULL || tabela->sessoes == NULL) {
+        printf("Erro de alocação de memória para a reprodução do Diário!\n");
+        exit(EXIT_FAILURE);
+    }
+    tabela->capacidade = capacidade;
+    tabela->total = 0;
+}
+
+static Sessao *tabelaProcurar(const TabelaSessoes *tabela, uint32_t id) {
+    for (uint32_t i = tabelaPosicao(tabela, id); tabela->sessoes[i] != NULL; i = (i + 1) & (tabela->capacidade - 1)) {
+        if (tabela->ids[i] == id) {
+            return tabela->sessoes[i];
+        }
+    }
+    return NULL;
+}
+
+static void tabelaInserir(TabelaSessoes *tabela, uint32_t id, Sessao *sessao) {
+    if ((tabela->total + 1) * 2 > tabela->capacidade) {
+        TabelaSessoes maior;
+        tabelaIniciar(&maior, tabela->capacidade * 2);
+        for (uint32_t i = 0; i < tabela->capacidade; i++) {
+            if (tabela->sessoes[i] != NULL) {
+                tabelaInserir(&maior, tabela->ids[i], tabela->sessoes[i]);
+            }
+        }
+        free(tabela->ids);
+        free(tabela->sessoes);
+        *tabela = maior;
+    }
+    uint32_t i = tabelaPosicao(tabela, id);
+    while (tabela->sessoes[i] != NULL) {
+        i = (i + 1) & (tabela->capacidade - 1);
+    }
+    tabela->ids[i] = id;
+    tabela->sessoes[i] = sessao;
+    tabela->total++;
+}
+
+/**
+ * @brief Remove um id, puxando para trás os da mesma sequência de sondagem (sem marcas de remoção).
+ */
+static void tabelaRemover(TabelaSessoes *tabela, uint32_t id) {
+    uint32_t mascara = tabela->capacidade - 1;
+    uint32_t vazia = tabelaPosicao(tabela, id);
+    while (tabela->ids[vazia] != id || tabela->sessoes[vazia] == NULL) {
+        vazia = (vazia + 1) & mascara;
+    }
+    tabela->sessoes[vazia] = NULL;
+    tabela->total--;
+    for (uint32_t i = (vazia + 1) & mascara; tabela->sessoes[i] != NULL; i = (i + 1) & mascara) {
+        uint32_t desejada = tabelaPosicao(tabela, tabela->ids[i]);
+        // A entrada pode ocupar a posição vazia se ela estiver entre a desejada e a atual (com a volta)
+        if (((i - desejada) & mascara) >= ((i - vazia) & mascara)) {
+            tabela->ids[vazia] = tabela->ids[i];
+            tabela->sessoes[vazia] = tabela->sessoes[i];
+            tabela->sessoes[i] = NULL;
+            vazia = i;
+        }
+    }
+}
+
+// --- Reprodução ---
+
+// Estado de reproduzirDiario(): as partidas abertas e as sessões livres para reaproveitar
+typedef struct Reproducao {
+    const Mapa *mapa;
+    TabelaSessoes abertas;
+    Sessao **livres;
+    uint32_t totalLivres;
+    uint32_t capacidadeLivres;
+    uint32_t ultimoId;     // Os eventos de uma partida chegam em blocos: a última consulta costuma se repetir
+    Sessao *ultimaSessao;  // NULL: sem consulta guardada
+} Reproducao;
+
+static Sessao *reproducaoNovaSessao(Reproducao *reproducao) {
+    if (reproducao->totalLivres > 0) {
+        Sessao *sessao = reproducao->livres[--reproducao->totalLivres];
+        reiniciarSessao(sessao);
+        return sessao;
+    }
+    Sessao *sessao = (Sessao*)malloc(sizeof(Sessao));
+    if (sessao == NULL) {
+        printf("Erro de alocação de memória para a reprodução do Diário!\n");
+        exit(EXIT_FAILURE);
+    }
+    iniciarSessaoComBloco(sessao, reproducao->mapa, DIARIO_BLOCO_SESSAO);
+    return sessao;
+}
+
+static void reproducaoLiberarSessao(Reproducao *reproducao, uint32_t id, Sessao *sessao) {
+    tabelaRemover(&reproducao->abertas, id);
+    if (reproducao->ultimaSessao == sessao) {
+        reproducao->ultimaSessao = NULL;
+    }
+    if (reproducao->totalLivres == reproducao->capacidadeLivres) {
+        reproducao->capacidadeLivres = reproducao->capacidadeLivres > 0 ? reproducao->capacidadeLivres * 2 : 16;
+        reproducao->livres = (Sessao**)realloc(reproducao->livres, reproducao->capacidadeLivres * sizeof(Sessao*));
+        if (reproducao->livres == NULL) {
+            printf("Erro de alocação de memória para a reprodução do Diário!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    reproducao->livres[reproducao->totalLivres++] = sessao;
+}
+
+static Sessao *reproducaoProcurar(Reproducao *reproducao, uint32_t id) {
+    if (reproducao->ultimaSessao != NULL && reproducao->ultimoId == id) {
+        return reproducao->ultimaSessao;
+    }
+    Sessao *sessao = tabelaProcurar(&reproducao->abertas, id);
+    if (sessao != NULL) {
+        reproducao->ultimoId = id;
+        reproducao->ultimaSessao = sessao;
+    }
+    return sessao;
+}
+
+/**
+ * @brief Indica se a sala existe e pode ser lida (no mapa paginado, se a sua página é válida).
+ */
+static int salaValida(const Mapa *mapa, uint32_t sala) {
+    return sala < mapa->totalSalas && mapaGarantirSala(mapa, sala);
+}
+
+/**
+ * @brief Aplica um evento à sua partida.
+ * @return 1 se o motor reproduziu o resultado gravado, 0 se divergiu.
+ */
+static int reproduzirEvento(Reproducao *reproducao, const EventoDiario *evento, PartidaReproduzida aoConcluir,
+                            void *contexto, ResumoReproducao *resumo) {
+    const Mapa *mapa = reproducao->mapa;
+    Sessao *sessao = reproducaoProcurar(reproducao, evento->sessao);
+    if (evento->tipo == DIARIO_INICIO) {
+        int reproduzido = sessao == NULL && evento->argumento == mapa->raiz;
+        if (sessao == NULL) {
+            sessao = reproducaoNovaSessao(reproducao);
+            tabelaInserir(&reproducao->abertas, evento->sessao, sessao);
+            resumo->sessoes++;
+        } else {
+            reiniciarSessao(sessao); // Id repetido: a partida recomeça
+        }
+        return reproduzido;
+    }
+    if (sessao == NULL) {
+        return 0; // Partida sem início no diário
+    }
+
+    switch (evento->tipo) {
+        case DIARIO_MOVIMENTO:
+            if (sessaoSeguir(sessao, evento->argumento) == MOVIMENTO_OK && sessao->salaAtual == evento->resultado) {
+                return 1;
+            }
+            if (salaValida(mapa, evento->resultado)) {
+                sessao->salaAtual = evento->resultado; // Segue o diário
+            }
+            return 0;
+        case DIARIO_PISTA:
+            if (!salaValida(mapa, evento->argumento)) {
+                return 0;
+            }
+            sessao->salaAtual = evento->argumento; // Um movimento divergente já foi contado; a coleta segue o diário
+            return sessaoColetar(sessao) == evento->resultado;
+        case DIARIO_SAIDA: {
+            int reproduzido = sessao->salaAtual == evento->argumento && sessao->movimentos == evento->resultado;
+            sessaoSair(sessao);
+            return reproduzido;
+        }
+        case DIARIO_RETOMADA: {
+            // O retrato foi tirado da própria partida: ela precisa estar onde ele parou
+            int reproduzido = sessao->salaAtual == evento->argumento && sessao->movimentos == evento->resultado &&
+                              (sessao->encerrada != 0) == (evento->detalhe != 0);
+            if (salaValida(mapa, evento->argumento)) {
+                sessao->salaAtual = evento->argumento; // Segue o diário
+                sessao->movimentos = evento->resultado;
+                sessao->encerrada = evento->detalhe != 0;
+            }
+            return reproduzido;
+        }
+        case DIARIO_VEREDITO: {
+            uint32_t contagem;
+            Veredito veredito = sessaoJulgar(sessao, evento->argumento, &contagem);
+            resumo->julgadas++;
+            if (aoConcluir != NULL) {
+                aoConcluir(contexto, evento->sessao, sessao, evento);
+            }
+            reproducaoLiberarSessao(reproducao, evento->sessao, sessao);
+            return contagem == evento->resultado && (uint16_t)veredito == evento->detalhe;
+        }
+        default:
+            return 0;
+    }
+}
+
+static int compararIds(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+int reproduzirDiario(const Mapa *mapa, const unsigned char *dados, size_t tamanho,
+                     PartidaReproduzida aoConcluir, void *contexto, ResumoReproducao *resumo) {
+    memset(resumo, 0, sizeof(ResumoReproducao));
+    DiarioCabecalho cabecalho;
+    if (tamanho < sizeof(cabecalho)) {
+        return -1;
+    }
+    memcpy(&cabecalho, dados, sizeof(cabecalho));
+    if (!cabecalhoValido(&cabecalho, mapa)) {
+        return -1;
+    }
+    size_t totalEventos = (tamanho - sizeof(cabecalho)) / sizeof(EventoDiario);
+    resumo->bytesIgnorados = (tamanho - sizeof(cabecalho)) % sizeof(EventoDiario);
+
+    Reproducao reproducao;
+    memset(&reproducao, 0, sizeof(reproducao));
+    reproducao.mapa = mapa;
+    tabelaIniciar(&reproducao.abertas, 64);
+
+    const unsigned char *eventos = dados + sizeof(cabecalho);
+    for (size_t i = 0; i < totalEventos; i++) {
+        EventoDiario evento;
+        memcpy(&evento, eventos + i * sizeof(EventoDiario), sizeof(evento));
+        if (evento.tipo == DIARIO_LOTE) {
+            continue; // Fim de um lote, sem partida
+        }
+        resumo->eventos++;
+        if (!reproduzirEvento(&reproducao, &evento, aoConcluir, contexto, resumo)) {
+            resumo->divergencias++;
+        }
+    }
+
+    // Partidas sem veredito: entregues em ordem de id, para uma saída estável
+    TabelaSessoes *abertas = &reproducao.abertas;
+    uint32_t *ids = (uint32_t*)malloc(((size_t)abertas->total + 1) * sizeof(uint32_t));
+    if (ids == NULL) {
+        printf("Erro de alocação de memória para a reprodução do Diário!\n");
+        exit(EXIT_FAILURE);
+    }
+    uint32_t totalAbertas = 0;
+    for (uint32_t i = 0; i < abertas->capacidade; i++) {
+        if (abertas->sessoes[i] != NULL) {
+            ids[totalAbertas++] = abertas->ids[i];
+        }
+    }
+    qsort(ids, totalAbertas, sizeof(uint32_t), compararIds);
+    resumo->abertas = totalAbertas;
+    for (uint32_t i = 0; i < totalAbertas; i++) {
+        Sessao *sessao = tabelaProcurar(abertas, ids[i]);
+        if (aoConcluir != NULL) {
+            aoConcluir(contexto, ids[i], sessao, NULL);
+        }
+        reproducaoLiberarSessao(&reproducao, ids[i], sessao);
+    }
+    free(ids);
+
+    for (uint32_t i = 0; i < reproducao.totalLivres; i++) {
+        encerrarSessao(reproducao.livres[i]);
+        free(reproducao.livres[i]);
+    }
+    free(reproducao.livres);
+    free(abertas->ids);
+    free(abertas->sessoes);
+    return 0;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file diario.h
+ * @brief Diário (journal) binário das partidas: movimentos, coletas e vereditos, só acrescentados.
+ *
+ * Um Diario é um arquivo aberto para acréscimo em que as sessões registram,
+ * em ordem, tudo o que muda o seu estado: a sala para a qual cada movimento
+ * levou, cada pista coletada (a mesma inserção no conjunto de pistas que
+ * sessaoColetar() faz) e o veredito da acusação. Serve de trilha de auditoria
+ * para contestar um julgamento e para refazer as partidas depois de uma queda:
+ * reproduzirDiario() repete os eventos no motor, sem terminal, e confere cada
+ * resultado com o que foi gravado.
+ *
+ * Formato (inteiros na ordem de bytes da máquina, como no .dqm):
+ *
+ *   [DiarioCabecalho][EventoDiario][EventoDiario]...   (16 bytes cada evento)
+ *
+ * Cada lote gravado termina com um evento DIARIO_LOTE, sem partida, com o
+ * próximo id de partida naquele momento.
+ *
+ * O custo de um movimento é o de copiar 16 bytes. Os eventos ficam primeiro em
+ * um bloco da própria sessão (DIARIO_EVENTOS_SESSAO), que passa ao diário de
+ * uma vez, sob a trava, quando enche, no veredito ou em
+ * sessaoDescarregarDiario(). A escrita é de uma thread própria, com
+ * confirmação em grupo (group commit): ela espera até DIARIO_INTERVALO_MS ou
+ * até juntar DIARIO_LOTE_EVENTOS eventos, de todas as sessões, e faz um único
+ * write() e um único fdatasync() pelo lote. Quem precisa saber que os seus
+ * eventos estão no disco chama diarioConfirmar().
+ *
+ * Uma queda no meio de uma escrita deixa no máximo um evento incompleto no fim
+ * do arquivo: abrirDiario() o corta antes de continuar, e reproduzirDiario()
+ * o ignora. Os ids de sessão continuam a numeração já gravada, então o mesmo
+ * arquivo pode acumular as partidas de várias execuções; para achar o próximo
+ * id, abrirDiario() lê só o último lote, a partir do seu DIARIO_LOTE, e não o
+ * diário inteiro.
+ */
+
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mapa.h"
+#include "motor.h"
+
+// --- Constantes do Formato ---
+#define DIARIO_MAGICO      "DQDIAR2" // Assinatura (8 bytes com o '\0')
+#define DIARIO_ORDEM_BYTES 0x01020304u // Detecta diários de outra arquitetura
+
+// --- Constantes da Escrita ---
+#define DIARIO_EVENTOS_SESSAO 64   // Eventos guardados na sessão antes de passar ao diário
+#define DIARIO_LOTE_EVENTOS 8192   // Eventos por escrita no arquivo (128 KiB)
+#define DIARIO_INTERVALO_MS 5      // Espera máxima de um evento pela escrita
+#define DIARIO_SEM_SESSAO UINT32_MAX // Sessão ainda sem id: a partida não registrou nada
+
+// Tipos de evento; os campos de EventoDiario dependem do tipo
+typedef enum TipoEvento {
+    DIARIO_INICIO = 1, // argumento: sala raiz
+    DIARIO_MOVIMENTO,  // argumento: posição da saída seguida; resultado: sala de destino
+    DIARIO_PISTA,      // argumento: sala; resultado: id da pista coletada
+    DIARIO_SAIDA,      // argumento: sala atual; resultado: movimentos
+    DIARIO_RETOMADA,   // argumento: sala atual; resultado: movimentos; detalhe: encerrada (restaurarRetrato(), na partida do retrato)
+    DIARIO_VEREDITO,   // argumento: suspeito (TEXTO_NENHUM se desconhecido); resultado: contagem; detalhe: Veredito
+    DIARIO_LOTE        // Fim de um lote (sessao: DIARIO_SEM_SESSAO); argumento: próximo id; resultado: eventos do lote
+} TipoEvento;
+
+// --- Estruturas ---
+
+typedef struct DiarioCabecalho {
+    char magico[8];
+    uint32_t ordemBytes;
+    uint32_t totalSalas;     // Identificam o mapa das partidas, como no retrato
+    uint32_t totalPistas;
+    uint32_t totalSuspeitos;
+} DiarioCabecalho;
+
+typedef struct EventoDiario {
+    uint32_t sessao;    // Id da partida no diário
+    uint16_t tipo;      // TipoEvento
+    uint16_t detalhe;
+    uint32_t argumento;
+    uint32_t resultado;
+} EventoDiario;
+
+typedef struct Diario {
+    int descritor;
+    atomic_uint proximaSessao;   // Próximo id de partida
+    pthread_t escritor;
+    pthread_mutex_t trava;
+    pthread_cond_t haEventos;    // Sinalizada com o lote cheio, um pedido de confirmação ou o encerramento
+    pthread_cond_t gravado;      // Sinalizada quando um lote sai do buffer e quando chega ao disco
+    EventoDiario *pendentes;     // Eventos ainda não entregues ao escritor
+    EventoDiario *gravando;      // Lote que o escritor está gravando
+    uint32_t totalPendentes;
+    uint64_t registrados;        // Eventos recebidos desde a abertura
+    uint64_t gravados;           // ... já escritos (e sincronizados) no arquivo
+    unsigned confirmacoes;       // Threads esperando em diarioConfirmar()
+    int encerrar;
+    int erro;                    // errno da primeira escrita que falhou (0: nenhuma)
+} Diario;
+
+// Bloco de eventos de uma sessão (Sessao.diario), entregue ao diário de uma vez
+typedef struct RegistroDiario {
+    Diario *diario;
+    uint32_t sessao;   // Id da partida atual (DIARIO_SEM_SESSAO até o primeiro evento)
+    uint32_t total;
+    EventoDiario eventos[DIARIO_EVENTOS_SESSAO];
+} RegistroDiario;
+
+// Resumo de reproduzirDiario()
+typedef struct ResumoReproducao {
+    uint64_t eventos;       // Eventos das partidas (sem os DIARIO_LOTE)
+    uint64_t sessoes;       // Partidas encontradas (eventos DIARIO_INICIO)
+    uint64_t julgadas;      // ... terminadas com um veredito
+    uint64_t abertas;       // ... sem veredito no fim do diário
+    uint64_t divergencias;  // Eventos cujo resultado o motor não reproduziu, ou de sessão inexistente
+    size_t bytesIgnorados;  // Evento incompleto no fim do arquivo
+} ResumoReproducao;
+
+/**
+ * @brief Chamada por reproduzirDiario() ao fim de cada partida refeita.
+ *
+ * A sessão tem o estado da partida só durante a chamada.
+ * @param contexto O contexto informado a reproduzirDiario().
+ * @param id O id da partida no diário.
+ * @param veredito O evento do veredito, ou NULL para uma partida ainda aberta no fim do diário.
+ */
+typedef void (*PartidaReproduzida)(void *contexto, uint32_t id, const Sessao *sessao,
+                                   const EventoDiario *veredito);
+
+// --- Escrita do Diário ---
+
+/**
+ * @brief Abre (ou cria) o diário de um mapa e inicia a thread de escrita.
+ *
+ * Um arquivo existente precisa ser de um mapa com as mesmas contagens; um
+ * evento incompleto no fim é cortado.
+ * @param diario O ponteiro para o diário.
+ * @param mapa O mapa das partidas.
+ * @param caminho O caminho do arquivo.
+ * @return 0 em caso de sucesso, -1 em caso de erro de E/S ou de arquivo de outro mapa (errno indica o motivo).
+ */
+int abrirDiario(Diario *diario, const Mapa *mapa, const char *caminho);
+
+/**
+ * @brief Acrescenta eventos ao lote em preparação; só espera se o buffer estiver cheio.
+ */
+void diarioAnexar(Diario *diario, const EventoDiario *eventos, uint32_t total);
+
+/**
+ * @brief Espera que todos os eventos já anexados estejam gravados e sincronizados.
+ * @return 0, ou -1 se alguma escrita do diário falhou.
+ */
+int diarioConfirmar(Diario *diario);
+
+/**
+ * @brief Grava o que falta, encerra a thread de escrita e fecha o arquivo.
+ *
+ * As sessões registradas devem ter sido encerradas (ou descarregadas) antes.
+ * @return 0, ou -1 se alguma escrita do diário falhou.
+ */
+int fecharDiario(Diario *diario);
+
+// --- Registro das Sessões ---
+
+/**
+ * @brief Passa a registrar no diário as partidas da sessão.
+ *
+ * Deve ser chamada com a sessão recém-iniciada ou reiniciada, antes da
+ * primeira coleta. Cada partida (até o próximo reiniciarSessao()) recebe um id
+ * novo ao registrar o seu primeiro evento. encerrarSessao() entrega os
+ * eventos restantes e desliga o registro.
+ */
+void sessaoAtivarDiario(Sessao *sessao, Diario *diario);
+
+/**
+ * @brief Entrega ao diário os eventos guardados na sessão.
+ *
+ * O motor já o faz no veredito; os laços interativos e o servidor chamam esta
+ * função ao fim de cada turno ou leitura, para que uma queda perca no máximo
+ * DIARIO_INTERVALO_MS de jogo.
+ */
+void sessaoDescarregarDiario(Sessao *sessao);
+
+/**
+ * @brief Desliga o registro da sessão, entregando antes os eventos restantes.
+ */
+void sessaoDesativarDiario(Sessao *sessao);
+
+/**
+ * @brief Começa a partida no diário: novo id e o evento DIARIO_INICIO. Usada por sessaoRegistrar().
+ */
+void registroNovaPartida(RegistroDiario *registro, const Mapa *mapa);
+
+/**
+ * @brief Continua no diário uma partida retomada de um retrato, sem DIARIO_INICIO.
+ *
+ * Os eventos seguintes levam o id que a partida tinha quando o retrato foi
+ * tirado, e os ids novos passam a começar depois dele. Um retrato sem id (de
+ * uma sessão sem diário) recebe um id novo: a reprodução não terá o estado
+ * dessa partida, e a conta como divergente.
+ * @param registro O bloco da sessão (Sessao.diario).
+ * @param id O id gravado no retrato, ou DIARIO_SEM_SESSAO.
+ */
+void registroRetomarPartida(RegistroDiario *registro, uint32_t id);
+
+/**
+ * @brief Guarda um evento da partida atual da sessão, se ela tiver diário.
+ *
+ * O bloco pertence à sessão, que não é compartilhada entre threads: o evento
+ * entra nele sem trava, e o bloco cheio é entregue ao diário.
+ */
+static inline void sessaoRegistrar(Sessao *sessao, TipoEvento tipo, uint32_t argumento,
+                             uint32_t resultado, uint16_t detalhe) {
+    RegistroDiario *registro = sessao->diario;
+    if (registro == NULL) {
+        return;
+    }
+    if (registro->sessao == DIARIO_SEM_SESSAO) {
+        registroNovaPartida(registro, sessao->mapa);
+    }
+    EventoDiario *evento = &registro->eventos[registro->total++];
+    evento->sessao = registro->sessao;
+    evento->tipo = (uint16_t)tipo;
+    evento->detalhe = detalhe;
+    evento->argumento = argumento;
+    evento->resultado = resultado;
+    if (registro->total == DIARIO_EVENTOS_SESSAO) {
+        sessaoDescarregarDiario(sessao);
+    }
+}
+
+// --- Reprodução ---
+
+/**
+ * @brief Refaz no motor as partidas de um diário, sem entrada e saída.
+ *
+ * Cada partida ganha uma sessão sobre o mapa; os movimentos são seguidos pela
+ * posição da saída, as coletas repetidas por sessaoColetar() e o veredito
+ * recalculado por sessaoJulgar(). Uma retomada (restaurarRetrato()) continua
+ * a partida do retrato e confere que ela estava na mesma sala, com os mesmos
+ * movimentos. Um resultado diferente do gravado conta como divergência, e a
+ * sessão segue o que foi gravado. As sessões são reaproveitadas entre as
+ * partidas, como no modo em lote.
+ * @param mapa O mapa em que o diário foi gravado.
+ * @param dados O conteúdo do arquivo do diário.
+ * @param tamanho O tamanho do conteúdo, em bytes.
+ * @param aoConcluir Chamada ao fim de cada partida (ou NULL).
+ * @param contexto Repassado a aoConcluir.
+ * @param resumo Recebe as contagens da reprodução.
+ * @return 0 em caso de sucesso, -1 se o cabeçalho for inválido ou de outro mapa.
+ */
+int reproduzirDiario(const Mapa *mapa, const unsigned char *dados, size_t tamanho,
+                     PartidaReproduzida aoConcluir, void *contexto, ResumoReproducao *resumo);
+
+#endif // DIARIO_H
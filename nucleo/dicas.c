@@ -0,0 +1,408 @@
+/**
+ * @file dicas.c
+ * @brief Implementação do índice de dicas.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dicas.h"
+
+// --- Funções Auxiliares ---
+
+static void *dicasAlocar(size_t tamanho) {
+    void *memoria = malloc(tamanho > 0 ? tamanho : 1);
+    if (memoria == NULL) {
+        printf("Erro de alocação de memória para as Dicas!\n");
+        exit(EXIT_FAILURE);
+    }
+    return memoria;
+}
+
+/**
+ * @brief Peso com que a pista de uma sala incrimina um suspeito (0 se não o incrimina).
+ */
+static uint32_t dicasPeso(const Mapa *mapa, uint32_t sala, uint32_t suspeito) {
+    const AlvoPeso *alvos = mapaAlvos(mapa, sala);
+    uint32_t total = mapaTotalAlvos(mapa, sala);
+    for (uint32_t i = 0; i < total; i++) {
+        if (alvos[i].suspeito == suspeito) {
+            return alvos[i].peso;
+        }
+    }
+    return 0;
+}
+
+// --- Árvore: Passeio de Euler ---
+
+/**
+ * @brief Percorre o mapa em pré-ordem a partir da raiz, preenchendo pais, profundidades e intervalos.
+ * @param ordem Recebe as salas alcançáveis em pré-ordem.
+ * @return A quantidade de salas alcançáveis, ou MAPA_NENHUM se alguma sala for
+ *         alcançada por dois caminhos (o mapa não é uma árvore).
+ */
+static uint32_t dicasPasseioEuler(IndiceDicas *indice, uint32_t *ordem) {
+    const Mapa *mapa = indice->mapa;
+    uint32_t *pilha = indice->fila; // Salas abertas; a próxima saída de cada uma fica em fim[] até fechá-la
+    uint32_t topo = 0, total = 0;
+
+    for (uint32_t i = 0; i < mapa->totalSalas; i++) {
+        indice->pais[i] = MAPA_NENHUM;
+        indice->profundidade[i] = MAPA_NENHUM;
+        indice->entrada[i] = MAPA_NENHUM;
+        indice->fim[i] = MAPA_NENHUM;
+    }
+    indice->profundidade[mapa->raiz] = 0;
+    indice->entrada[mapa->raiz] = total;
+    indice->fim[mapa->raiz] = 0;
+    ordem[total++] = mapa->raiz;
+    pilha[topo++] = mapa->raiz;
+
+    while (topo > 0) {
+        uint32_t sala = pilha[topo - 1];
+        if (indice->fim[sala] < mapaTotalSaidas(mapa, sala)) {
+            uint32_t filho = mapaSaidas(mapa, sala)[indice->fim[sala]++].destino;
+            if (indice->entrada[filho] != MAPA_NENHUM) {
+                return MAPA_NENHUM; // Segunda entrada na mesma sala (ou ciclo)
+            }
+            indice->pais[filho] = sala;
+            indice->profundidade[filho] = indice->profundidade[sala] + 1;
+            indice->entrada[filho] = total;
+            indice->fim[filho] = 0;
+            ordem[total++] = filho;
+            pilha[topo++] = filho;
+            continue;
+        }
+        indice->fim[sala] = total;
+        topo--;
+    }
+    return total;
+}
+
+/**
+ * @brief Calcula, em pré-ordem reversa, a sala com pista mais próxima abaixo de cada sala.
+ *
+ * Em caso de empate na profundidade, fica a que vem primeiro na pré-ordem.
+ */
+static void dicasPistasAbaixo(IndiceDicas *indice, const uint32_t *ordem, uint32_t total) {
+    const Mapa *mapa = indice->mapa;
+    for (uint32_t i = 0; i < mapa->totalSalas; i++) {
+        indice->pistaAbaixo[i] = MAPA_NENHUM;
+    }
+    for (uint32_t i = total; i-- > 1;) {
+        uint32_t sala = ordem[i];
+        uint32_t pai = indice->pais[sala];
+        uint32_t candidata = mapa->salas[sala].pista != TEXTO_NENHUM ? sala : indice->pistaAbaixo[sala];
+        if (candidata == MAPA_NENHUM) {
+            continue;
+        }
+        uint32_t atual = indice->pistaAbaixo[pai];
+        if (atual == MAPA_NENHUM || indice->profundidade[candidata] <= indice->profundidade[atual]) {
+            indice->pistaAbaixo[pai] = candidata;
+        }
+    }
+}
+
+/**
+ * @brief Calcula, para um suspeito, a sala mais rasa de cada subárvore com a acusação sustentada.
+ *
+ * Percorre a árvore mantendo a pontuação do suspeito com as regras do motor
+ * (a associação mais recente de uma pista prevalece, e voltar desfaz).
+ */
+static uint32_t *dicasCalcularSustentada(IndiceDicas *indice, uint32_t suspeito) {
+    const Mapa *mapa = indice->mapa;
+    size_t totalPistas = (size_t)mapa->pistas.total + 1;
+    uint32_t *sustentada = (uint32_t*)dicasAlocar((size_t)mapa->totalSalas * sizeof(uint32_t));
+    uint32_t *ocorrencias = (uint32_t*)calloc(totalPistas, sizeof(uint32_t));
+    uint32_t *origem = (uint32_t*)dicasAlocar(totalPistas * sizeof(uint32_t));
+    uint32_t *anterior = (uint32_t*)dicasAlocar((size_t)mapa->totalSalas * sizeof(uint32_t));
+    uint32_t *proximo = (uint32_t*)dicasAlocar((size_t)mapa->totalSalas * sizeof(uint32_t));
+    if (ocorrencias == NULL) {
+        printf("Erro de alocação de memória para as Dicas!\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t i = 0; i < mapa->totalSalas; i++) {
+        sustentada[i] = MAPA_NENHUM;
+    }
+
+    uint32_t *pilha = indice->fila;
+    uint32_t topo = 0;
+    uint32_t pontuacao = 0;
+    pilha[topo++] = mapa->raiz;
+    proximo[mapa->raiz] = 0;
+    int entrando = 1;
+    while (topo > 0) {
+        uint32_t sala = pilha[topo - 1];
+        uint32_t pista = mapa->salas[sala].pista;
+        if (entrando) {
+            // Entra na sala: sua pista passa a valer, no lugar da associação anterior
+            anterior[sala] = MAPA_NENHUM;
+            if (pista != TEXTO_NENHUM) {
+                if (ocorrencias[pista]++ > 0) {
+                    anterior[sala] = origem[pista];
+                    pontuacao -= dicasPeso(mapa, origem[pista], suspeito);
+                }
+                origem[pista] = sala;
+                pontuacao += dicasPeso(mapa, sala, suspeito);
+            }
+            if (pontuacao >= PISTAS_MINIMAS_ACUSACAO) {
+                sustentada[sala] = sala;
+            }
+            entrando = 0;
+        }
+        if (proximo[sala] < mapaTotalSaidas(mapa, sala)) {
+            uint32_t filho = mapaSaidas(mapa, sala)[proximo[sala]++].destino;
+            proximo[filho] = 0;
+            pilha[topo++] = filho;
+            entrando = 1;
+            continue;
+        }
+        // Sai da sala: desfaz a pista e leva a melhor resposta para o pai
+        if (pista != TEXTO_NENHUM) {
+            pontuacao -= dicasPeso(mapa, sala, suspeito);
+            if (--ocorrencias[pista] > 0) {
+                origem[pista] = anterior[sala];
+                pontuacao += dicasPeso(mapa, anterior[sala], suspeito);
+            }
+        }
+        topo--;
+        if (topo > 0) {
+            uint32_t pai = pilha[topo - 1];
+            uint32_t melhor = sustentada[sala];
+            if (melhor != MAPA_NENHUM && sustentada[pai] != pai &&
+                (sustentada[pai] == MAPA_NENHUM || indice->profundidade[melhor] < indice->profundidade[sustentada[pai]])) {
+                sustentada[pai] = melhor;
+            }
+        }
+    }
+
+    free(proximo);
+    free(anterior);
+    free(origem);
+    free(ocorrencias);
+    return sustentada;
+}
+
+// --- Grafo: Buscas em Largura ---
+
+/**
+ * @brief Devolve a busca em largura a partir de uma sala, calculando-a se não estiver no cache.
+ */
+static const BuscaLargura *dicasBusca(IndiceDicas *indice, uint32_t origem) {
+    const Mapa *mapa = indice->mapa;
+    BuscaLargura *busca = &indice->cache[0];
+    for (int i = 0; i < DICAS_CACHE_ORIGENS; i++) {
+        if (indice->cache[i].origem == origem) {
+            indice->cache[i].ultimoUso = ++indice->usos;
+            return &indice->cache[i];
+        }
+        if (indice->cache[i].ultimoUso < busca->ultimoUso) {
+            busca = &indice->cache[i];
+        }
+    }
+
+    if (busca->distancia == NULL) {
+        busca->distancia = (uint32_t*)dicasAlocar((size_t)mapa->totalSalas * sizeof(uint32_t));
+        busca->passo = (uint32_t*)dicasAlocar((size_t)mapa->totalSalas * sizeof(uint32_t));
+        busca->pistas = (uint32_t*)dicasAlocar((size_t)mapa->totalSalas * sizeof(uint32_t));
+    }
+    busca->origem = origem;
+    busca->ultimoUso = ++indice->usos;
+    busca->totalPistas = 0;
+    for (uint32_t i = 0; i < mapa->totalSalas; i++) {
+        busca->distancia[i] = MAPA_NENHUM;
+    }
+
+    uint32_t *fila = indice->fila;
+    uint32_t inicio = 0, fim = 0;
+    busca->distancia[origem] = 0;
+    busca->passo[origem] = MAPA_NENHUM;
+    fila[fim++] = origem;
+    while (inicio < fim) {
+        uint32_t sala = fila[inicio++];
+        if (mapa->salas[sala].pista != TEXTO_NENHUM) {
+            busca->pistas[busca->totalPistas++] = sala; // A fila já está em ordem de distância
+        }
+        const SaidaSala *saidas = mapaSaidas(mapa, sala);
+        uint32_t total = mapaTotalSaidas(mapa, sala);
+        for (uint32_t i = 0; i < total; i++) {
+            uint32_t destino = saidas[i].destino;
+            if (busca->distancia[destino] != MAPA_NENHUM) {
+                continue;
+            }
+            busca->distancia[destino] = busca->distancia[sala] + 1;
+            busca->passo[destino] = sala == origem ? i : busca->passo[sala];
+            fila[fim++] = destino;
+        }
+    }
+    return busca;
+}
+
+// --- Implementação das Dicas ---
+
+void construirIndiceDicas(IndiceDicas *indice, const Mapa *mapa) {
+    memset(indice, 0, sizeof(IndiceDicas));
+    indice->mapa = mapa;
+    for (int i = 0; i < DICAS_CACHE_ORIGENS; i++) {
+        indice->cache[i].origem = MAPA_NENHUM;
+    }
+    if (mapa->totalSalas == 0) {
+        return;
+    }
+
+    size_t tamanho = (size_t)mapa->totalSalas * sizeof(uint32_t);
+    indice->fila = (uint32_t*)dicasAlocar(tamanho);
+    indice->pais = (uint32_t*)dicasAlocar(tamanho);
+    indice->profundidade = (uint32_t*)dicasAlocar(tamanho);
+    indice->entrada = (uint32_t*)dicasAlocar(tamanho);
+    indice->fim = (uint32_t*)dicasAlocar(tamanho);
+    uint32_t *ordem = (uint32_t*)dicasAlocar(tamanho);
+
+    uint32_t alcancaveis = dicasPasseioEuler(indice, ordem);
+    indice->arvore = alcancaveis != MAPA_NENHUM;
+    if (indice->arvore) {
+        indice->pistaAbaixo = (uint32_t*)dicasAlocar(tamanho);
+        dicasPistasAbaixo(indice, ordem, alcancaveis);
+        indice->sustentada = (uint32_t**)calloc((size_t)mapa->suspeitos.total + 1, sizeof(uint32_t*));
+        if (indice->sustentada == NULL) {
+            printf("Erro de alocação de memória para as Dicas!\n");
+            exit(EXIT_FAILURE);
+        }
+    } else {
+        // Sem árvore, as tabelas do passeio não servem: as consultas usam as buscas em largura
+        free(indice->pais);
+        free(indice->profundidade);
+        free(indice->entrada);
+        free(indice->fim);
+        indice->pais = indice->profundidade = indice->entrada = indice->fim = NULL;
+    }
+    free(ordem);
+}
+
+void liberarIndiceDicas(IndiceDicas *indice) {
+    if (indice->sustentada != NULL) {
+        for (uint32_t i = 0; i < indice->mapa->suspeitos.total; i++) {
+            free(indice->sustentada[i]);
+        }
+    }
+    for (int i = 0; i < DICAS_CACHE_ORIGENS; i++) {
+        free(indice->cache[i].distancia);
+        free(indice->cache[i].passo);
+        free(indice->cache[i].pistas);
+    }
+    free(indice->sustentada);
+    free(indice->pistaAbaixo);
+    free(indice->pais);
+    free(indice->profundidade);
+    free(indice->entrada);
+    free(indice->fim);
+    free(indice->fila);
+    memset(indice, 0, sizeof(IndiceDicas));
+}
+
+uint32_t dicaDistancia(IndiceDicas *indice, uint32_t origem, uint32_t destino) {
+    if (!indice->arvore) {
+        return dicasBusca(indice, origem)->distancia[destino];
+    }
+    if (indice->entrada[origem] == MAPA_NENHUM || indice->entrada[destino] < indice->entrada[origem] ||
+        indice->entrada[destino] >= indice->fim[origem]) {
+        return MAPA_NENHUM; // Fora da subárvore: as passagens só descem
+    }
+    return indice->profundidade[destino] - indice->profundidade[origem];
+}
+
+uint32_t dicaPrimeiroPasso(IndiceDicas *indice, uint32_t origem, uint32_t destino) {
+    if (origem == destino) {
+        return MAPA_NENHUM;
+    }
+    if (!indice->arvore) {
+        const BuscaLargura *busca = dicasBusca(indice, origem);
+        return busca->distancia[destino] != MAPA_NENHUM ? busca->passo[destino] : MAPA_NENHUM;
+    }
+    if (dicaDistancia(indice, origem, destino) == MAPA_NENHUM) {
+        return MAPA_NENHUM;
+    }
+    // Os filhos entram na pré-ordem na ordem das saídas: o passo é o último filho que começa antes do destino
+    const SaidaSala *saidas = mapaSaidas(indice->mapa, origem);
+    uint32_t baixo = 0, alto = mapaTotalSaidas(indice->mapa, origem);
+    while (alto - baixo > 1) {
+        uint32_t meio = baixo + (alto - baixo) / 2;
+        if (indice->entrada[saidas[meio].destino] <= indice->entrada[destino]) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+    return baixo;
+}
+
+uint32_t dicaPistaMaisProxima(IndiceDicas *indice, const Sessao *sessao, uint32_t *movimentos) {
+    uint32_t origem = sessao->salaAtual;
+    uint32_t sala = MAPA_NENHUM;
+    if (sessao->encerrada) {
+        // Sem movimentos possíveis
+    } else if (sessaoPistaDisponivel(sessao, origem) != TEXTO_NENHUM) {
+        sala = origem;
+    } else if (indice->arvore) {
+        sala = indice->pistaAbaixo[origem]; // Nada abaixo da sala atual foi visitado ainda
+    } else {
+        const BuscaLargura *busca = dicasBusca(indice, origem);
+        for (uint32_t i = 0; i < busca->totalPistas && sala == MAPA_NENHUM; i++) {
+            if (!sessaoPistaColetada(sessao, busca->pistas[i])) {
+                sala = busca->pistas[i];
+            }
+        }
+    }
+    if (movimentos != NULL) {
+        *movimentos = sala != MAPA_NENHUM ? dicaDistancia(indice, origem, sala) : MAPA_NENHUM;
+    }
+    return sala;
+}
+
+uint32_t dicaSustentarAcusacao(IndiceDicas *indice, const Sessao *sessao, uint32_t suspeito, uint32_t *destino) {
+    const Mapa *mapa = indice->mapa;
+    uint32_t origem = sessao->salaAtual;
+    uint32_t sala = MAPA_NENHUM;
+    uint32_t movimentos = MAPA_NENHUM;
+
+    if (suspeito >= mapa->suspeitos.total) {
+        // Suspeito desconhecido: nenhum caminho o incrimina
+    } else if (indice->arvore) {
+        if (indice->sustentada[suspeito] == NULL) {
+            indice->sustentada[suspeito] = dicasCalcularSustentada(indice, suspeito);
+        }
+        sala = indice->sustentada[suspeito][origem];
+        if (sala != MAPA_NENHUM) {
+            movimentos = indice->profundidade[sala] - indice->profundidade[origem];
+        }
+    } else {
+        // Estimativa: soma os ganhos das pistas na ordem da busca até alcançar o mínimo
+        uint32_t pontuacao = placarContagem(&sessao->placar, suspeito);
+        if (pontuacao >= PISTAS_MINIMAS_ACUSACAO) {
+            sala = origem;
+            movimentos = 0;
+        }
+        const BuscaLargura *busca = dicasBusca(indice, origem);
+        for (uint32_t i = 0; i < busca->totalPistas && sala == MAPA_NENHUM; i++) {
+            uint32_t candidata = busca->pistas[i];
+            if (sessaoPistaColetada(sessao, candidata)) {
+                continue;
+            }
+            uint32_t ganho = dicasPeso(mapa, candidata, suspeito);
+            uint32_t associada = encontrarSuspeito(&sessao->hashSuspeitos, mapa->salas[candidata].pista);
+            uint32_t perda = associada != TEXTO_NENHUM ? dicasPeso(mapa, associada, suspeito) : 0;
+            if (ganho > perda) {
+                pontuacao += ganho - perda;
+            }
+            if (pontuacao >= PISTAS_MINIMAS_ACUSACAO) {
+                sala = candidata;
+                movimentos = busca->distancia[candidata];
+            }
+        }
+    }
+    if (destino != NULL) {
+        *destino = sala;
+    }
+    return movimentos;
+}
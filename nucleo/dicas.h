@@ -0,0 +1,123 @@
+/**
+ * @file dicas.h
+ * @brief Dicas para o jogador: a pista mais próxima e o caminho mais curto até uma acusação sustentada.
+ *
+ * O IndiceDicas é calculado uma vez sobre o mapa, em O(salas + saídas), e
+ * responde às consultas de qualquer sala sem percorrer o mapa de novo:
+ *
+ * - Mapas em árvore (cada sala alcançável da raiz tem um único caminho de
+ *   entrada): como as passagens só descem, a partida que chegou a uma sala
+ *   passou exatamente pelas salas entre a raiz e ela. O índice guarda o pai e
+ *   a profundidade de cada sala e o passeio de Euler (posição de entrada e fim
+ *   da subárvore na pré-ordem): "v é alcançável de u" é uma comparação de
+ *   intervalos e a distância é a diferença de profundidades, em O(1). A pista
+ *   mais próxima abaixo de cada sala é pré-calculada, e a primeira saída até
+ *   um destino sai de uma busca binária entre as saídas da sala. Para a
+ *   acusação, a pontuação de cada suspeito ao fim do caminho até cada sala é
+ *   fixa; na primeira consulta sobre um suspeito o índice calcula, para cada
+ *   sala, a sala mais rasa da subárvore em que a acusação já é sustentada, e
+ *   as consultas seguintes são O(1). O resultado é exato.
+ * - Mapas com ciclos ou salas com várias entradas: buscas em largura a partir
+ *   da sala atual, guardadas em um cache das DICAS_CACHE_ORIGENS origens mais
+ *   recentes. A primeira consulta de uma sala custa O(salas + saídas); as
+ *   seguintes percorrem só as salas com pista já coletadas mais próximas que a
+ *   resposta. Para a acusação, a resposta é uma estimativa otimista (um limite
+ *   inferior): a distância da sala mais distante entre as necessárias, na
+ *   ordem da busca, sem somar as idas e voltas entre elas.
+ *
+ * As consultas preenchem caches do índice: um mesmo IndiceDicas não deve ser
+ * consultado por várias threads ao mesmo tempo.
+ */
+
+#ifndef DICAS_H
+#define DICAS_H
+
+#include <stdint.h>
+
+#include "mapa.h"
+#include "motor.h"
+
+// --- Constantes das Dicas ---
+#define DICAS_CACHE_ORIGENS 8 // Buscas em largura guardadas nos mapas que não são árvores
+
+// --- Estruturas ---
+
+// Resultado de uma busca em largura a partir de uma sala (mapas que não são árvores)
+typedef struct BuscaLargura {
+    uint32_t origem;     // MAPA_NENHUM: posição livre no cache
+    uint64_t ultimoUso;  // Para descartar a busca usada há mais tempo
+    uint32_t *distancia; // Por sala: movimentos desde a origem (MAPA_NENHUM: inalcançável)
+    uint32_t *passo;     // Por sala: posição, entre as saídas da origem, do primeiro passo do caminho mínimo
+    uint32_t *pistas;    // Salas alcançáveis com pista, em ordem de distância
+    uint32_t totalPistas;
+} BuscaLargura;
+
+typedef struct IndiceDicas {
+    const Mapa *mapa;
+    int arvore;              // Diferente de 0 se o mapa é uma árvore a partir da raiz
+
+    // Árvore: ligações com o pai e passeio de Euler (MAPA_NENHUM nas salas inalcançáveis)
+    uint32_t *pais;
+    uint32_t *profundidade;
+    uint32_t *entrada;       // Posição da sala na pré-ordem
+    uint32_t *fim;           // Uma após a última posição da subárvore na pré-ordem
+    uint32_t *pistaAbaixo;   // Sala com pista mais próxima estritamente abaixo (MAPA_NENHUM se não houver)
+    uint32_t **sustentada;   // Por suspeito (calculado na primeira consulta): sala mais rasa da
+                             // subárvore com a acusação sustentada (MAPA_NENHUM se não houver)
+
+    // Grafo: buscas em largura recentes
+    BuscaLargura cache[DICAS_CACHE_ORIGENS];
+    uint32_t *fila;          // Rascunho das buscas
+    uint64_t usos;
+} IndiceDicas;
+
+// --- Funções das Dicas ---
+
+/**
+ * @brief Calcula o índice de dicas de um mapa finalizado.
+ * @param indice O ponteiro para o índice.
+ * @param mapa O mapa (somente leitura; deve continuar aberto enquanto o índice for usado).
+ */
+void construirIndiceDicas(IndiceDicas *indice, const Mapa *mapa);
+
+/**
+ * @brief Libera os vetores e os caches do índice.
+ */
+void liberarIndiceDicas(IndiceDicas *indice);
+
+/**
+ * @brief Menor quantidade de movimentos de uma sala até outra.
+ * @return Os movimentos, ou MAPA_NENHUM se o destino não for alcançável.
+ */
+uint32_t dicaDistancia(IndiceDicas *indice, uint32_t origem, uint32_t destino);
+
+/**
+ * @brief Primeira saída a seguir em um caminho mínimo de uma sala até outra.
+ * @return A posição da saída entre as da origem (para sessaoSeguir()), ou
+ *         MAPA_NENHUM se o destino for a própria origem ou não for alcançável.
+ */
+uint32_t dicaPrimeiroPasso(IndiceDicas *indice, uint32_t origem, uint32_t destino);
+
+/**
+ * @brief Sala mais próxima da sala atual que ainda guarda uma pista não coletada pela sessão.
+ * @param indice O índice do mapa da sessão.
+ * @param sessao A sessão em andamento.
+ * @param movimentos Recebe a distância até a sala (pode ser NULL).
+ * @return A sala, ou MAPA_NENHUM se nenhuma pista alcançável restar.
+ */
+uint32_t dicaPistaMaisProxima(IndiceDicas *indice, const Sessao *sessao, uint32_t *movimentos);
+
+/**
+ * @brief Movimentos necessários, a partir da sala atual, para sustentar a acusação de um suspeito.
+ *
+ * Considera coletada a pista da sala atual, como fazem os jogos ao entrar em
+ * uma sala. Exato nos mapas em árvore; nos demais, um limite inferior.
+ * @param indice O índice do mapa da sessão.
+ * @param sessao A sessão em andamento.
+ * @param suspeito O id do suspeito.
+ * @param destino Recebe a sala em que a acusação passa a ser sustentada (pode ser NULL).
+ * @return Os movimentos (0 se a acusação já é sustentada), ou MAPA_NENHUM se não houver caminho que a sustente.
+ */
+uint32_t dicaSustentarAcusacao(IndiceDicas *indice, const Sessao *sessao, uint32_t suspeito, uint32_t *destino);
+
+#endif // DICAS_H
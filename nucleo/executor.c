@@ -0,0 +1,146 @@
+/**
+ * @file executor.c
+ * @brief Implementação do pool de threads de partidas roteirizadas.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "executor.h"
+
+// --- Implementação do Executor ---
+
+/**
+ * @brief Roda os blocos do lote atual até que não reste nenhum roteiro.
+ */
+static void executorProcessarLote(Trabalhador *trabalhador) {
+    Executor *executor = trabalhador->executor;
+    for (;;) {
+        size_t inicio = atomic_fetch_add_explicit(&executor->proximo, EXECUTOR_BLOCO, memory_order_relaxed);
+        if (inicio >= executor->totalRoteiros) {
+            return;
+        }
+        size_t fim = inicio + EXECUTOR_BLOCO < executor->totalRoteiros ? inicio + EXECUTOR_BLOCO : executor->totalRoteiros;
+        for (size_t i = inicio; i < fim; i++) {
+            ResultadoSessao resultado;
+            const Roteiro *roteiro = &executor->roteiros[i];
+            simularSessao(&trabalhador->sessao, roteiro->movimentos, roteiro->acusado, &resultado);
+            if (executor->resultados != NULL) {
+                executor->resultados[i] = resultado;
+            }
+            if (executor->aoConcluir != NULL) {
+                executor->aoConcluir(executor->contexto, trabalhador->indice, i, &trabalhador->sessao, &resultado);
+            }
+        }
+    }
+}
+
+static void *executorLaco(void *argumento) {
+    Trabalhador *trabalhador = (Trabalhador*)argumento;
+    Executor *executor = trabalhador->executor;
+    unsigned geracaoVista = 0;
+
+    pthread_mutex_lock(&executor->trava);
+    for (;;) {
+        while (executor->geracao == geracaoVista && !executor->encerrar) {
+            pthread_cond_wait(&executor->haLote, &executor->trava);
+        }
+        if (executor->encerrar) {
+            break;
+        }
+        geracaoVista = executor->geracao;
+        pthread_mutex_unlock(&executor->trava);
+
+        executorProcessarLote(trabalhador);
+
+        pthread_mutex_lock(&executor->trava);
+        if (--executor->ativos == 0) {
+            pthread_cond_signal(&executor->loteConcluido);
+        }
+    }
+    pthread_mutex_unlock(&executor->trava);
+    return NULL;
+}
+
+void iniciarExecutor(Executor *executor, const Mapa *mapa, unsigned totalTrabalhadores) {
+    if (totalTrabalhadores == 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        totalTrabalhadores = processadores > 0 ? (unsigned)processadores : 1;
+    }
+    executor->mapa = mapa;
+    executor->totalTrabalhadores = totalTrabalhadores;
+    executor->geracao = 0;
+    executor->ativos = 0;
+    executor->encerrar = 0;
+    executor->roteiros = NULL;
+    executor->totalRoteiros = 0;
+    executor->resultados = NULL;
+    executor->aoConcluir = NULL;
+    executor->contexto = NULL;
+    atomic_init(&executor->proximo, 0);
+    pthread_mutex_init(&executor->trava, NULL);
+    pthread_cond_init(&executor->haLote, NULL);
+    pthread_cond_init(&executor->loteConcluido, NULL);
+
+    executor->trabalhadores = (Trabalhador*)calloc(totalTrabalhadores, sizeof(Trabalhador));
+    if (executor->trabalhadores == NULL) {
+        printf("Erro de alocação de memória para o Executor!\n");
+        exit(EXIT_FAILURE);
+    }
+    for (unsigned i = 0; i < totalTrabalhadores; i++) {
+        Trabalhador *trabalhador = &executor->trabalhadores[i];
+        trabalhador->executor = executor;
+        trabalhador->indice = i;
+        iniciarSessao(&trabalhador->sessao, mapa);
+        if (pthread_create(&trabalhador->thread, NULL, executorLaco, trabalhador) != 0) {
+            printf("Erro ao criar as threads do Executor!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void executorAtivarDiario(Executor *executor, Diario *diario) {
+    // Os trabalhadores esperam o próximo lote: a trava publica os registros para eles
+    pthread_mutex_lock(&executor->trava);
+    for (unsigned i = 0; i < executor->totalTrabalhadores; i++) {
+        sessaoAtivarDiario(&executor->trabalhadores[i].sessao, diario);
+    }
+    pthread_mutex_unlock(&executor->trava);
+}
+
+void executorRodar(Executor *executor, const Roteiro *roteiros, size_t totalRoteiros,
+                   ResultadoSessao *resultados, TarefaConcluida aoConcluir, void *contexto) {
+    pthread_mutex_lock(&executor->trava);
+    executor->roteiros = roteiros;
+    executor->totalRoteiros = totalRoteiros;
+    executor->resultados = resultados;
+    executor->aoConcluir = aoConcluir;
+    executor->contexto = contexto;
+    atomic_store_explicit(&executor->proximo, 0, memory_order_relaxed);
+    executor->ativos = executor->totalTrabalhadores;
+    executor->geracao++;
+    pthread_cond_broadcast(&executor->haLote);
+    while (executor->ativos > 0) {
+        pthread_cond_wait(&executor->loteConcluido, &executor->trava);
+    }
+    pthread_mutex_unlock(&executor->trava);
+}
+
+void encerrarExecutor(Executor *executor) {
+    pthread_mutex_lock(&executor->trava);
+    executor->encerrar = 1;
+    pthread_cond_broadcast(&executor->haLote);
+    pthread_mutex_unlock(&executor->trava);
+
+    for (unsigned i = 0; i < executor->totalTrabalhadores; i++) {
+        pthread_join(executor->trabalhadores[i].thread, NULL);
+        encerrarSessao(&executor->trabalhadores[i].sessao);
+    }
+    free(executor->trabalhadores);
+    pthread_mutex_destroy(&executor->trava);
+    pthread_cond_destroy(&executor->haLote);
+    pthread_cond_destroy(&executor->loteConcluido);
+}
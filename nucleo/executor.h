@@ -0,0 +1,110 @@
+/**
+ * @file executor.h
+ * @brief Pool de threads que roda muitas partidas roteirizadas sobre um mapa compartilhado.
+ *
+ * Cada trabalhador tem a sua própria Sessao (motor.h) e todos leem o mesmo
+ * Mapa, que não é alterado durante o jogo. executorRodar() entrega um lote de
+ * roteiros: os trabalhadores retiram blocos de EXECUTOR_BLOCO roteiros de um
+ * contador atômico, de modo que o lote se equilibra sozinho mesmo quando as
+ * partidas têm durações diferentes. As threads são criadas uma única vez e
+ * esperam o próximo lote em uma variável de condição.
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "diario.h"
+#include "mapa.h"
+#include "motor.h"
+
+// --- Constantes do Executor ---
+#define EXECUTOR_BLOCO 64 // Roteiros retirados de cada vez por um trabalhador
+
+// --- Estruturas ---
+
+// Uma partida a simular: escolhas do jogador e nome do acusado
+typedef struct Roteiro {
+    const char *movimentos;
+    const char *acusado;
+} Roteiro;
+
+/**
+ * @brief Chamada na thread do trabalhador ao fim de cada partida.
+ *
+ * A sessão continua com o estado final da partida só durante a chamada.
+ * @param contexto O contexto informado a executorRodar().
+ * @param trabalhador O índice do trabalhador (0..totalTrabalhadores-1).
+ * @param indice O índice do roteiro no lote.
+ */
+typedef void (*TarefaConcluida)(void *contexto, unsigned trabalhador, size_t indice,
+                                const Sessao *sessao, const ResultadoSessao *resultado);
+
+typedef struct Executor Executor;
+
+typedef struct Trabalhador {
+    Executor *executor;
+    unsigned indice;
+    pthread_t thread;
+    Sessao sessao;
+} Trabalhador;
+
+struct Executor {
+    const Mapa *mapa;
+    Trabalhador *trabalhadores;
+    unsigned totalTrabalhadores;
+    pthread_mutex_t trava;
+    pthread_cond_t haLote;       // Sinalizada quando um lote novo é publicado
+    pthread_cond_t loteConcluido;
+    unsigned geracao;            // Incrementada a cada lote publicado
+    unsigned ativos;             // Trabalhadores que ainda não terminaram o lote
+    int encerrar;
+
+    // Lote atual (válido enquanto ativos > 0)
+    const Roteiro *roteiros;
+    size_t totalRoteiros;
+    ResultadoSessao *resultados; // Pode ser NULL
+    TarefaConcluida aoConcluir;  // Pode ser NULL
+    void *contexto;
+    atomic_size_t proximo;       // Próximo roteiro ainda não retirado
+};
+
+// --- Funções do Executor ---
+
+/**
+ * @brief Cria o pool de threads, cada uma com a sua sessão sobre o mapa.
+ * @param executor O ponteiro para o executor.
+ * @param mapa O mapa compartilhado (somente leitura durante o uso do executor).
+ * @param totalTrabalhadores A quantidade de threads (0 usa os processadores disponíveis).
+ */
+void iniciarExecutor(Executor *executor, const Mapa *mapa, unsigned totalTrabalhadores);
+
+/**
+ * @brief Registra no diário as partidas de todos os trabalhadores.
+ *
+ * Deve ser chamada entre os lotes (fora de executorRodar()). Cada partida
+ * entrega os seus eventos ao diário de uma vez, no veredito.
+ */
+void executorAtivarDiario(Executor *executor, Diario *diario);
+
+/**
+ * @brief Simula um lote de roteiros em paralelo e espera todos terminarem.
+ * @param executor O executor iniciado.
+ * @param roteiros Os roteiros do lote.
+ * @param totalRoteiros A quantidade de roteiros.
+ * @param resultados Vetor com totalRoteiros posições para os resumos (ou NULL).
+ * @param aoConcluir Chamada ao fim de cada partida, na thread do trabalhador (ou NULL).
+ * @param contexto Repassado a aoConcluir.
+ */
+void executorRodar(Executor *executor, const Roteiro *roteiros, size_t totalRoteiros,
+                   ResultadoSessao *resultados, TarefaConcluida aoConcluir, void *contexto);
+
+/**
+ * @brief Encerra as threads e libera as sessões do executor.
+ */
+void encerrarExecutor(Executor *executor);
+
+#endif // EXECUTOR_H
@@ -0,0 +1,61 @@
+/**
+ * @file filtro.c
+ * @brief Implementação do conjunto esparso (filtro de Bloom e tabela exata).
+ */
+
+#include <string.h>
+
+#include "filtro.h"
+
+/**
+ * @brief Reserva (na arena) uma tabela livre e um filtro vazio para `capacidade` posições.
+ */
+static void esparsoReservar(ConjuntoEsparso *conjunto, uint32_t capacidade) {
+    // Uma palavra do filtro para cada 8 posições: com a tabela no limite, 4 ids por palavra
+    uint32_t palavras = capacidade / 8;
+    conjunto->posicoes = (uint32_t*)arenaAlocar(conjunto->arena, capacidade * sizeof(uint32_t));
+    memset(conjunto->posicoes, 0xFF, capacidade * sizeof(uint32_t)); // ESPARSO_LIVRE
+    conjunto->filtro.palavras = (uint64_t*)arenaAlocar(conjunto->arena, palavras * sizeof(uint64_t));
+    memset(conjunto->filtro.palavras, 0, palavras * sizeof(uint64_t));
+    conjunto->filtro.mascara = palavras - 1;
+    conjunto->capacidade = capacidade;
+}
+
+/**
+ * @brief Põe um id que não está no conjunto na tabela e no filtro.
+ */
+static void esparsoColocar(ConjuntoEsparso *conjunto, uint32_t id, uint64_t hash) {
+    uint32_t mascara = conjunto->capacidade - 1;
+    uint32_t i = (uint32_t)(hash >> 32) & mascara;
+    while (conjunto->posicoes[i] != ESPARSO_LIVRE) {
+        i = (i + 1) & mascara;
+    }
+    conjunto->posicoes[i] = id;
+    *filtroPalavra(&conjunto->filtro, hash) |= filtroBits(hash);
+}
+
+void iniciarConjuntoEsparso(ConjuntoEsparso *conjunto, Arena *arena) {
+    conjunto->arena = arena;
+    conjunto->total = 0;
+    esparsoReservar(conjunto, ESPARSO_CAPACIDADE_INICIAL);
+}
+
+int esparsoInserir(ConjuntoEsparso *conjunto, uint32_t id) {
+    if (esparsoContem(conjunto, id)) {
+        return 0;
+    }
+    if (((uint64_t)conjunto->total + 1) * 2 > conjunto->capacidade) {
+        // Os vetores antigos ficam na arena até o próximo arenaReiniciar()
+        uint32_t *antigas = conjunto->posicoes;
+        uint32_t capacidadeAntiga = conjunto->capacidade;
+        esparsoReservar(conjunto, capacidadeAntiga * 2);
+        for (uint32_t i = 0; i < capacidadeAntiga; i++) {
+            if (antigas[i] != ESPARSO_LIVRE) {
+                esparsoColocar(conjunto, antigas[i], esparsoMisturar(antigas[i]));
+            }
+        }
+    }
+    esparsoColocar(conjunto, id, esparsoMisturar(id));
+    conjunto->total++;
+    return 1;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file filtro.h
+ * @brief Conjunto esparso de ids: um filtro de Bloom na frente de uma tabela exata.
+ *
+ * Um vetor de bits por id (como Sessao.coletadas e o ConjuntoPistas) custa um
+ * bit por id possível, mesmo que a sessão use poucos: em um mapa de dez
+ * milhões de salas, mais de 1 MiB por sessão, cada consulta a uma sala nova em
+ * uma linha de cache diferente. O ConjuntoEsparso ocupa só o que recebeu e
+ * fica na arena da sessão.
+ *
+ * A tabela exata usa endereçamento aberto com sondagem linear. À frente dela, o
+ * filtro de Bloom tem 3 bits por id, todos na mesma palavra de 64 bits (filtro
+ * "blocado": uma única leitura por consulta), e um quarto do tamanho da tabela:
+ * uma palavra para cada 8 posições, 16 bits por id com a tabela no limite de
+ * carga. Um id que nunca entrou quase sempre é recusado pelo filtro sem sondar
+ * a tabela (falso positivo abaixo de 1% nesse limite); um id que entrou sempre
+ * passa pelo filtro e é confirmado na tabela.
+ *
+ * O filtro e a tabela usam metades diferentes do hash do id: a tabela, os 32
+ * bits altos; o filtro, os 32 baixos, que escolhem a palavra e, multiplicados,
+ * os 3 bits dela. Assim, ids na mesma palavra do filtro não caem por isso nas
+ * mesmas posições da tabela, em qualquer tamanho. O preço fica nos conjuntos
+ * muito grandes: com 2^22 palavras, os ids de uma palavra só diferem em 10
+ * desses 32 bits, e o falso positivo sobe para cerca de 1,2% (16 milhões de ids).
+ * Não há remoção: o conjunto é esvaziado junto com a arena.
+ */
+
+#ifndef FILTRO_H
+#define FILTRO_H
+
+#include <stdint.h>
+
+#include "arena.h"
+
+// --- Constantes do Conjunto Esparso ---
+#define ESPARSO_CAPACIDADE_INICIAL 64 // Posições da tabela; sempre potência de 2
+#define ESPARSO_LIVRE UINT32_MAX      // Posição livre (não pode ser inserido)
+
+// --- Estruturas ---
+
+typedef struct FiltroBloom {
+    uint64_t *palavras;
+    uint32_t mascara;       // Total de palavras - 1 (potência de 2)
+} FiltroBloom;
+
+typedef struct ConjuntoEsparso {
+    FiltroBloom filtro;
+    uint32_t *posicoes;     // Ids, ou ESPARSO_LIVRE
+    uint32_t capacidade;    // Sempre potência de 2; a tabela dobra com metade ocupada
+    uint32_t total;
+    Arena *arena;
+} ConjuntoEsparso;
+
+// --- Funções do Conjunto Esparso ---
+
+/**
+ * @brief Espalha os bits de um id; o filtro usa os 32 bits baixos e a tabela, os 32 altos.
+ */
+static inline uint64_t esparsoMisturar(uint32_t id) {
+    uint64_t hash = (uint64_t)id * UINT64_C(0x9E3779B97F4A7C15);
+    return hash ^ (hash >> 29);
+}
+
+/**
+ * @brief Os 3 bits do id na sua palavra do filtro.
+ *
+ * Saem dos bits mais altos do produto dos 32 bits baixos do hash por uma
+ * constante de 64 bits, que dependem de todos eles, e não só dos bits que
+ * escolheram a palavra; a metade alta, da tabela, não entra.
+ */
+static inline uint64_t filtroBits(uint64_t hash) {
+    uint64_t bits = (uint64_t)(uint32_t)hash * UINT64_C(0xFF51AFD7ED558CCD);
+    return (UINT64_C(1) << (bits >> 58)) | (UINT64_C(1) << ((bits >> 52) & 63)) |
+           (UINT64_C(1) << ((bits >> 46) & 63));
+}
+
+static inline uint64_t *filtroPalavra(const FiltroBloom *filtro, uint64_t hash) {
+    return &filtro->palavras[(uint32_t)hash & filtro->mascara];
+}
+
+/**
+ * @brief Indica se o id pode estar no filtro (0: com certeza não está).
+ */
+static inline int filtroPodeConter(const FiltroBloom *filtro, uint64_t hash) {
+    uint64_t bits = filtroBits(hash);
+    return (*filtroPalavra(filtro, hash) & bits) == bits;
+}
+
+/**
+ * @brief Cria um conjunto vazio, com a tabela e o filtro na arena.
+ * @param conjunto O ponteiro para o conjunto.
+ * @param arena A arena de onde saem os vetores (o conjunto some com arenaReiniciar()).
+ */
+void iniciarConjuntoEsparso(ConjuntoEsparso *conjunto, Arena *arena);
+
+/**
+ * @brief Acrescenta um id ao conjunto.
+ * @param conjunto O conjunto.
+ * @param id O id (diferente de ESPARSO_LIVRE).
+ * @return 1 se o id entrou agora, 0 se ele já estava no conjunto.
+ */
+int esparsoInserir(ConjuntoEsparso *conjunto, uint32_t id);
+
+/**
+ * @brief Indica se o id está no conjunto; o filtro responde sozinho pela maioria dos ausentes.
+ *
+ * Um id presente lê duas linhas de cache: a palavra do filtro e a posição da tabela.
+ */
+static inline int esparsoContem(const ConjuntoEsparso *conjunto, uint32_t id) {
+    uint64_t hash = esparsoMisturar(id);
+    if (!filtroPodeConter(&conjunto->filtro, hash)) {
+        return 0;
+    }
+    uint32_t mascara = conjunto->capacidade - 1;
+    for (uint32_t i = (uint32_t)(hash >> 32) & mascara;; i = (i + 1) & mascara) {
+        uint32_t atual = conjunto->posicoes[i];
+        if (atual == id) {
+            return 1;
+        }
+        if (atual == ESPARSO_LIVRE) {
+            return 0;
+        }
+    }
+}
+
+#endif // FILTRO_H
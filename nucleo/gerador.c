@@ -0,0 +1,390 @@
+/**
+ * @file gerador.c
+ * @brief Implementação do gerador determinístico de mansões.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gerador.h"
+
+// --- Sorteios ---
+
+// Fluxos independentes de sorteio: mudar um parâmetro não desloca os sorteios dos demais
+enum {
+    GERADOR_FLUXO_ESTRUTURA = 1,
+    GERADOR_FLUXO_PISTA,
+    GERADOR_FLUXO_TAMANHO,
+    GERADOR_FLUXO_PALAVRA,
+    GERADOR_FLUXO_ALVOS,
+    GERADOR_FLUXO_PESOS
+};
+
+/**
+ * @brief Sorteio de 64 bits em função da semente, do fluxo e do índice (finalizador do SplitMix64).
+ */
+static inline uint64_t geradorSortear(uint64_t semente, uint64_t fluxo, uint64_t indice) {
+    uint64_t z = (semente ^ (fluxo * 0xd1b54a32d192ed03ull)) + (indice + 1) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// --- Textos ---
+
+static const char *const geradorPalavras[] = {
+    "chave", "carta", "pegada", "luva", "faca", "veneno", "vela", "corda",
+    "bilhete", "cinza", "perfume", "botao", "janela", "mancha", "recibo", "anel",
+    "copo", "lama", "relogio", "lenco", "mapa", "frasco", "diario", "cadeado"
+};
+#define GERADOR_TOTAL_PALAVRAS (sizeof(geradorPalavras) / sizeof(geradorPalavras[0]))
+
+static const char *const geradorTitulos[] = {
+    "Coronel", "Dona", "Professor", "Senhora", "Doutor", "Reverendo", "Madame", "Capitao"
+};
+static const char *const geradorSobrenomes[] = {
+    "Mostarda", "Branca", "Black", "Rosa", "Marinho", "Violeta", "Pavao", "Ameixa",
+    "Esmeralda", "Carmim", "Oliva", "Anil", "Cobalto", "Ambar", "Grafite", "Salvia"
+};
+#define GERADOR_TOTAL_TITULOS (sizeof(geradorTitulos) / sizeof(geradorTitulos[0]))
+#define GERADOR_TOTAL_SOBRENOMES (sizeof(geradorSobrenomes) / sizeof(geradorSobrenomes[0]))
+
+#define GERADOR_NOME_RAIZ "Hall de Entrada"
+#define GERADOR_PREFIXO_SALA "Sala "
+#define GERADOR_PREFIXO_PISTA "Pista "
+#define GERADOR_BYTES_LOTE (32u << 20) // Textos de pistas entregues de uma vez a internarLote()
+
+/**
+ * @brief Quantidade de algarismos decimais de um número.
+ */
+static uint32_t geradorAlgarismos(uint32_t valor) {
+    uint32_t total = 1;
+    while (valor >= 10) {
+        valor /= 10;
+        total++;
+    }
+    return total;
+}
+
+/**
+ * @brief Escreve um número em decimal, com zeros à esquerda até `largura` algarismos.
+ * @return A quantidade de bytes escritos (sem '\0').
+ */
+static uint32_t geradorEscreverNumero(char *destino, uint32_t valor, uint32_t largura) {
+    uint32_t total = geradorAlgarismos(valor);
+    if (total < largura) {
+        total = largura;
+    }
+    for (uint32_t i = total; i > 0; i--) {
+        destino[i - 1] = (char)('0' + valor % 10);
+        valor /= 10;
+    }
+    return total;
+}
+
+/**
+ * @brief Bytes do nome de uma sala, com o '\0'.
+ */
+static uint32_t geradorTamanhoNome(uint32_t sala) {
+    if (sala == 0) {
+        return (uint32_t)sizeof(GERADOR_NOME_RAIZ);
+    }
+    return (uint32_t)sizeof(GERADOR_PREFIXO_SALA) + geradorAlgarismos(sala);
+}
+
+/**
+ * @brief Escreve o nome de uma sala, com o '\0'.
+ * @return A quantidade de bytes escritos (com '\0').
+ */
+static uint32_t geradorEscreverNome(char *destino, uint32_t sala) {
+    if (sala == 0) {
+        memcpy(destino, GERADOR_NOME_RAIZ, sizeof(GERADOR_NOME_RAIZ));
+        return (uint32_t)sizeof(GERADOR_NOME_RAIZ);
+    }
+    memcpy(destino, GERADOR_PREFIXO_SALA, sizeof(GERADOR_PREFIXO_SALA) - 1);
+    uint32_t tamanho = (uint32_t)sizeof(GERADOR_PREFIXO_SALA) - 1;
+    tamanho += geradorEscreverNumero(destino + tamanho, sala, 0);
+    destino[tamanho++] = '\0';
+    return tamanho;
+}
+
+/**
+ * @brief Bytes do texto de uma pista, sem o '\0' (nunca menos que "Pista <número>").
+ */
+static uint32_t geradorTamanhoPista(const ParametrosGerador *parametros, uint32_t pista, uint32_t largura) {
+    uint32_t faixa = parametros->tamanhoPistaMaximo - parametros->tamanhoPistaMinimo + 1;
+    uint32_t tamanho = parametros->tamanhoPistaMinimo +
+                       (uint32_t)(geradorSortear(parametros->semente, GERADOR_FLUXO_TAMANHO, pista) % faixa);
+    uint32_t minimo = (uint32_t)sizeof(GERADOR_PREFIXO_PISTA) - 1 + largura;
+    return tamanho < minimo ? minimo : tamanho;
+}
+
+/**
+ * @brief Escreve o texto de uma pista: "Pista <número>: " e palavras sorteadas, cortado em `tamanho` bytes.
+ */
+static void geradorEscreverPista(char *destino, const ParametrosGerador *parametros, uint32_t pista,
+                                 uint32_t largura, uint32_t tamanho) {
+    uint32_t escrito = (uint32_t)sizeof(GERADOR_PREFIXO_PISTA) - 1;
+    memcpy(destino, GERADOR_PREFIXO_PISTA, escrito);
+    escrito += geradorEscreverNumero(destino + escrito, pista, largura);
+    if (escrito < tamanho) {
+        destino[escrito++] = ':';
+    }
+    uint64_t sorteio = 0;
+    for (uint64_t palavra = 0; escrito < tamanho; palavra++) {
+        destino[escrito++] = ' ';
+        if (palavra % 8 == 0) {
+            // Um sorteio serve a 8 palavras, um byte para cada
+            sorteio = geradorSortear(parametros->semente, GERADOR_FLUXO_PALAVRA, ((uint64_t)pista << 16) | palavra);
+        }
+        const char *texto = geradorPalavras[(sorteio & 0xFF) % GERADOR_TOTAL_PALAVRAS];
+        sorteio >>= 8;
+        while (*texto != '\0' && escrito < tamanho) {
+            destino[escrito++] = *texto++;
+        }
+    }
+    if (destino[escrito - 1] == ' ') {
+        destino[escrito - 1] = '.'; // Sem espaço no fim do texto
+    }
+    destino[escrito] = '\0';
+}
+
+// --- Sorteios por sala e por pista ---
+
+/**
+ * @brief Pista de uma sala, ou TEXTO_NENHUM. `proxima` é o id da próxima pista nova (pistas distintas = 0).
+ */
+static uint32_t geradorPistaDaSala(const ParametrosGerador *parametros, uint64_t limiar, uint32_t sala,
+                                   uint32_t proxima) {
+    uint64_t sorteio = geradorSortear(parametros->semente, GERADOR_FLUXO_PISTA, sala);
+    if ((sorteio >> 32) >= limiar) {
+        return TEXTO_NENHUM;
+    }
+    return parametros->pistasDistintas > 0 ? (uint32_t)(sorteio % parametros->pistasDistintas) : proxima;
+}
+
+/**
+ * @brief Quantidade de suspeitos incriminados por uma pista, e o primeiro deles.
+ */
+static uint32_t geradorAlvosDaPista(const ParametrosGerador *parametros, uint32_t pista, uint32_t *primeiro) {
+    uint64_t sorteio = geradorSortear(parametros->semente, GERADOR_FLUXO_ALVOS, pista);
+    *primeiro = (uint32_t)((sorteio >> 32) % parametros->suspeitos);
+    return 1 + (uint32_t)(sorteio % parametros->alvosMaximos);
+}
+
+// --- Estrutura ---
+
+// Subárvore ainda por numerar na forma desequilibrada
+typedef struct SubarvorePendente {
+    uint32_t sala;
+    uint32_t tamanho;
+} SubarvorePendente;
+
+/**
+ * @brief Acrescenta as saídas 'e' e 'd' de uma sala (MAPA_NENHUM: sem saída) direto no vetor do mapa.
+ */
+static void geradorLigar(Mapa *mapa, uint32_t sala, uint32_t esquerda, uint32_t direita) {
+    if (esquerda != MAPA_NENHUM) {
+        SaidaSala saida = { esquerda, MAPA_NENHUM, 'e', { 0, 0, 0 } };
+        mapa->origemSaidas[mapa->totalSaidas] = sala;
+        mapa->saidas[mapa->totalSaidas++] = saida;
+    }
+    if (direita != MAPA_NENHUM) {
+        SaidaSala saida = { direita, MAPA_NENHUM, 'd', { 0, 0, 0 } };
+        mapa->origemSaidas[mapa->totalSaidas] = sala;
+        mapa->saidas[mapa->totalSaidas++] = saida;
+    }
+}
+
+// --- Implementação do Gerador ---
+
+void parametrosGeradorPadrao(ParametrosGerador *parametros) {
+    parametros->salas = 1000;
+    parametros->forma = GERADOR_EQUILIBRADA;
+    parametros->vies = 0.8;
+    parametros->densidade = 0.5;
+    parametros->pistasDistintas = 0;
+    parametros->suspeitos = 6;
+    parametros->alvosMaximos = 2;
+    parametros->tamanhoPistaMinimo = 16;
+    parametros->tamanhoPistaMaximo = 48;
+    parametros->nomesDistintos = 0;
+    parametros->semente = 1;
+}
+
+int gerarMansao(Mapa *mapa, const ParametrosGerador *parametros) {
+    const ParametrosGerador *p = parametros;
+    if (p->salas == 0 || p->salas == MAPA_NENHUM || p->suspeitos == 0 || p->suspeitos == TEXTO_NENHUM ||
+        p->alvosMaximos == 0 || p->alvosMaximos > p->suspeitos ||
+        p->tamanhoPistaMinimo > p->tamanhoPistaMaximo || p->tamanhoPistaMaximo > GERADOR_TAMANHO_PISTA_MAXIMO ||
+        !(p->densidade >= 0.0 && p->densidade <= 1.0) || !(p->vies >= 0.0 && p->vies <= 1.0) ||
+        (p->forma != GERADOR_EQUILIBRADA && p->forma != GERADOR_DESEQUILIBRADA && p->forma != GERADOR_CORRENTE)) {
+        return -1;
+    }
+    uint64_t limiar = (uint64_t)(p->densidade * 4294967296.0); // densidade 1: todas as salas
+    uint32_t nomes = (p->nomesDistintos > 0 && p->nomesDistintos < p->salas) ? p->nomesDistintos : p->salas;
+
+    // Primeira passada: conta pistas, alvos e bytes de texto para reservar tudo de uma vez
+    uint64_t bytesNomes = 0;
+    uint64_t totalAlvos = 0;
+    uint32_t pistasNovas = 0;
+    for (uint32_t sala = 0; sala < p->salas; sala++) {
+        if (sala < nomes) {
+            bytesNomes += geradorTamanhoNome(sala);
+        }
+        uint32_t pista = geradorPistaDaSala(p, limiar, sala, pistasNovas);
+        if (pista != TEXTO_NENHUM) {
+            uint32_t primeiro;
+            totalAlvos += geradorAlvosDaPista(p, pista, &primeiro);
+            if (pista == pistasNovas && p->pistasDistintas == 0) {
+                pistasNovas++;
+            }
+        }
+    }
+    uint32_t totalPistas = p->pistasDistintas > 0 ? p->pistasDistintas : pistasNovas;
+    uint32_t largura = geradorAlgarismos(totalPistas > 0 ? totalPistas - 1 : 0);
+    uint64_t bytesPistas = 0;
+    for (uint32_t pista = 0; pista < totalPistas; pista++) {
+        bytesPistas += internadorTamanhoGuardado(geradorTamanhoPista(p, pista, largura));
+    }
+    if (bytesNomes >= UINT32_MAX || bytesPistas >= UINT32_MAX || totalAlvos >= UINT32_MAX) {
+        return -1;
+    }
+
+    mapaReservar(mapa, p->salas, p->salas - 1, (uint32_t)totalAlvos, (uint32_t)bytesNomes);
+    reservarInternador(&mapa->pistas, totalPistas, (uint32_t)bytesPistas);
+
+    // Suspeitos: título e sobrenome, com um número quando as combinações acabam
+    char texto[GERADOR_TAMANHO_PISTA_MAXIMO + 1];
+    const uint32_t combinacoes = GERADOR_TOTAL_TITULOS * GERADOR_TOTAL_SOBRENOMES;
+    for (uint32_t suspeito = 0; suspeito < p->suspeitos; suspeito++) {
+        const char *titulo = geradorTitulos[suspeito % GERADOR_TOTAL_TITULOS];
+        // 9 é inversível módulo 16: as 128 primeiras combinações são distintas e os vizinhos variam nos dois
+        uint32_t rodada = suspeito / GERADOR_TOTAL_TITULOS;
+        const char *sobrenome = geradorSobrenomes[(rodada * (GERADOR_TOTAL_TITULOS + 1) + suspeito % GERADOR_TOTAL_TITULOS) %
+                                                  GERADOR_TOTAL_SOBRENOMES];
+        size_t tamanho = strlen(titulo);
+        memcpy(texto, titulo, tamanho);
+        texto[tamanho++] = ' ';
+        memcpy(texto + tamanho, sobrenome, strlen(sobrenome));
+        tamanho += strlen(sobrenome);
+        if (suspeito >= combinacoes) {
+            texto[tamanho++] = ' ';
+            tamanho += geradorEscreverNumero(texto + tamanho, suspeito / combinacoes + 1, 0);
+        }
+        texto[tamanho] = '\0';
+        internar(&mapa->suspeitos, texto);
+    }
+
+    // Pistas em ordem de número, que já é a ordem alfabética; todas distintas, vão em lotes
+    char *lote = (char*)malloc(GERADOR_BYTES_LOTE);
+    if (lote == NULL) {
+        printf("Erro de alocação de memória para o Mapa!\n");
+        exit(EXIT_FAILURE);
+    }
+    uint32_t usados = 0;
+    uint32_t noLote = 0;
+    for (uint32_t pista = 0; pista < totalPistas; pista++) {
+        if (usados + GERADOR_TAMANHO_PISTA_MAXIMO + 1 > GERADOR_BYTES_LOTE) {
+            internarLote(&mapa->pistas, lote, noLote);
+            usados = 0;
+            noLote = 0;
+        }
+        uint32_t tamanho = geradorTamanhoPista(p, pista, largura);
+        geradorEscreverPista(lote + usados, p, pista, largura, tamanho);
+        usados += tamanho + 1;
+        noLote++;
+    }
+    internarLote(&mapa->pistas, lote, noLote);
+    free(lote);
+
+    // Segunda passada: salas, alvos e saídas, em ordem de sala
+    SubarvorePendente *pendentes = NULL;
+    uint32_t totalPendentes = 0;
+    uint32_t capacidadePendentes = 0;
+    if (p->forma == GERADOR_DESEQUILIBRADA) {
+        capacidadePendentes = 64;
+        pendentes = (SubarvorePendente*)malloc(capacidadePendentes * sizeof(SubarvorePendente));
+        if (pendentes == NULL) {
+            printf("Erro de alocação de memória para o Mapa!\n");
+            exit(EXIT_FAILURE);
+        }
+        SubarvorePendente raiz = { 0, p->salas };
+        pendentes[totalPendentes++] = raiz;
+    }
+
+    pistasNovas = 0;
+    mapa->inicioAlvos[0] = 0;
+    for (uint32_t sala = 0; sala < p->salas; sala++) {
+        SalaPlana *plana = &mapa->salas[sala];
+        if (sala < nomes) {
+            plana->nome = mapa->tamanhoTextos;
+            mapa->tamanhoTextos += geradorEscreverNome(mapa->textos + mapa->tamanhoTextos, sala);
+        } else {
+            plana->nome = mapa->salas[sala % nomes].nome;
+        }
+
+        plana->pista = geradorPistaDaSala(p, limiar, sala, pistasNovas);
+        if (plana->pista != TEXTO_NENHUM) {
+            if (plana->pista == pistasNovas && p->pistasDistintas == 0) {
+                pistasNovas++;
+            }
+            uint32_t primeiro;
+            uint32_t alvos = geradorAlvosDaPista(p, plana->pista, &primeiro);
+            for (uint32_t i = 0; i < alvos; i++) {
+                uint64_t sorteio = geradorSortear(p->semente, GERADOR_FLUXO_PESOS,
+                                                  (uint64_t)plana->pista * p->alvosMaximos + i);
+                AlvoPeso alvo = { (primeiro + i) % p->suspeitos, 1 + (uint32_t)(sorteio % 3) };
+                mapa->alvos[mapa->totalAlvos++] = alvo;
+            }
+        }
+        mapa->inicioAlvos[sala + 1] = mapa->totalAlvos;
+
+        if (p->forma == GERADOR_EQUILIBRADA) {
+            uint64_t esquerda = 2 * (uint64_t)sala + 1;
+            uint64_t direita = esquerda + 1;
+            geradorLigar(mapa, sala, esquerda < p->salas ? (uint32_t)esquerda : MAPA_NENHUM,
+                         direita < p->salas ? (uint32_t)direita : MAPA_NENHUM);
+        } else if (p->forma == GERADOR_CORRENTE) {
+            if (sala + 1 < p->salas) {
+                int paraDireita = (int)(geradorSortear(p->semente, GERADOR_FLUXO_ESTRUTURA, sala) & 1);
+                geradorLigar(mapa, sala, paraDireita ? MAPA_NENHUM : sala + 1, paraDireita ? sala + 1 : MAPA_NENHUM);
+            }
+        } else {
+            // Pré-ordem: a subárvore do topo da pilha é sempre a desta sala
+            SubarvorePendente atual = pendentes[--totalPendentes];
+            uint32_t abaixo = atual.tamanho - 1;
+            double acaso = (double)(geradorSortear(p->semente, GERADOR_FLUXO_ESTRUTURA, sala) >> 11) * 0x1.0p-53;
+            uint32_t esquerda = (uint32_t)(abaixo * p->vies + acaso);
+            if (esquerda > abaixo) {
+                esquerda = abaixo;
+            }
+            uint32_t direita = abaixo - esquerda;
+            if (totalPendentes + 2 > capacidadePendentes) {
+                capacidadePendentes *= 2;
+                SubarvorePendente *maior = (SubarvorePendente*)realloc(pendentes, capacidadePendentes * sizeof(SubarvorePendente));
+                if (maior == NULL) {
+                    printf("Erro de alocação de memória para o Mapa!\n");
+                    exit(EXIT_FAILURE);
+                }
+                pendentes = maior;
+            }
+            if (direita > 0) {
+                SubarvorePendente subarvore = { sala + 1 + esquerda, direita };
+                pendentes[totalPendentes++] = subarvore;
+            }
+            if (esquerda > 0) {
+                SubarvorePendente subarvore = { sala + 1, esquerda };
+                pendentes[totalPendentes++] = subarvore;
+            }
+            geradorLigar(mapa, sala, esquerda > 0 ? sala + 1 : MAPA_NENHUM,
+                         direita > 0 ? sala + 1 + esquerda : MAPA_NENHUM);
+        }
+    }
+    mapa->totalSalas = p->salas;
+    free(pendentes);
+
+    mapaFinalizar(mapa);
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file gerador.h
+ * @brief Gerador determinístico de mansões para testes de carga e de escala.
+ *
+ * A mesma semente e os mesmos parâmetros produzem sempre o mesmo mapa, byte a
+ * byte. Cada sorteio sai de uma função da semente, de um fluxo (estrutura,
+ * pistas, tamanhos, palavras, alvos) e de um índice (sala, pista, palavra), e
+ * não de um estado que avança: a primeira passada conta exatamente quantas
+ * salas, saídas, alvos e bytes de texto o mapa terá, os vetores do Mapa são
+ * reservados uma única vez, e a segunda passada escreve direto neles, sem
+ * alocação por sala e sem passar por criarSala().
+ *
+ * Formas:
+ * - GERADOR_EQUILIBRADA: a sala i tem as saídas 'e' -> 2i + 1 e 'd' -> 2i + 2
+ *   (profundidade log2 n).
+ * - GERADOR_DESEQUILIBRADA: numeração em pré-ordem; das s - 1 salas abaixo de
+ *   uma sala, uma fração `vies` (arredondada ao acaso) fica à esquerda e o
+ *   resto à direita. vies = 0,5 dá uma árvore quase equilibrada; perto de 0 ou
+ *   de 1, caminhos longos.
+ * - GERADOR_CORRENTE: a sala i leva só à sala i + 1, por 'e' ou por 'd'
+ *   (profundidade n - 1).
+ *
+ * Os textos das pistas são "Pista <número>: " seguido de palavras de um
+ * vocabulário fixo, cortado no tamanho sorteado (uniforme entre o mínimo e o
+ * máximo). O número tem largura fixa, por isso as pistas já nascem em ordem
+ * alfabética e mapaFinalizar() não precisa reordená-las.
+ */
+
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include <stdint.h>
+
+#include "mapa.h"
+
+// --- Constantes do Gerador ---
+#define GERADOR_TAMANHO_PISTA_MAXIMO 1024 // Bytes de uma pista gerada, sem o '\0'
+
+// --- Estruturas ---
+
+typedef enum FormaMansao {
+    GERADOR_EQUILIBRADA,
+    GERADOR_DESEQUILIBRADA,
+    GERADOR_CORRENTE
+} FormaMansao;
+
+typedef struct ParametrosGerador {
+    uint32_t salas;              // Total de salas (>= 1); a sala 0 é o Hall de Entrada
+    FormaMansao forma;
+    double vies;                 // GERADOR_DESEQUILIBRADA: fração das salas que vai para a esquerda (0 a 1)
+    double densidade;            // Probabilidade de uma sala ter pista (0 a 1)
+    uint32_t pistasDistintas;    // 0: uma pista diferente por sala com pista; senão, sorteada entre estas
+    uint32_t suspeitos;          // Suspeitos distintos (>= 1)
+    uint32_t alvosMaximos;       // Suspeitos incriminados por pista: sorteado entre 1 e este valor
+    uint32_t tamanhoPistaMinimo; // Bytes do texto de cada pista (o número da pista sempre cabe)
+    uint32_t tamanhoPistaMaximo;
+    uint32_t nomesDistintos;     // 0: cada sala tem nome próprio; senão, os nomes se repetem a cada tantas salas
+    uint64_t semente;
+} ParametrosGerador;
+
+// --- Funções do Gerador ---
+
+/**
+ * @brief Preenche os parâmetros padrão: 1000 salas equilibradas, metade com pista, 6 suspeitos.
+ * @param parametros O ponteiro para os parâmetros.
+ */
+void parametrosGeradorPadrao(ParametrosGerador *parametros);
+
+/**
+ * @brief Gera uma mansão em um mapa vazio e o finaliza (mapaFinalizar()).
+ * @param mapa O mapa, recém-inicializado com mapaInicializar().
+ * @param parametros Os parâmetros da geração.
+ * @return 0 em caso de sucesso; -1 se os parâmetros forem inválidos ou se os
+ *         textos não couberem nos deslocamentos de 32 bits (o mapa fica vazio).
+ */
+int gerarMansao(Mapa *mapa, const ParametrosGerador *parametros);
+
+#endif // GERADOR_H
@@ -0,0 +1,284 @@
+/**
+ * @file instrumentos.c
+ * @brief Implementação dos contadores, histogramas e rastro de eventos.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "instrumentos.h"
+
+uint64_t instrumentosAgoraNs(void) {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (uint64_t)agora.tv_sec * 1000000000ull + (uint64_t)agora.tv_nsec;
+}
+
+// --- Resumo ---
+
+static const char *const nomesContadores[INSTRUMENTOS_TOTAL_CONTADORES] = {
+    "pistasInseridas", "pistasRepetidas", "comparacoesPista", "rotacoesPista", "consultasHash",
+    "crescimentosHash", "consultasTexto", "movimentos", "partidas", "conexoes", "conexoesRecusadas",
+    "requisicoes", "paginasCarregadas", "paginasDescartadas", "eventosDiario", "lotesDiario",
+    "eventosDescartados"
+};
+
+static const char *const nomesHistogramas[INSTRUMENTOS_TOTAL_HISTOGRAMAS] = {
+    "descidaPista", "sondagemHash", "sondagemTexto", "movimentoNs", "turnoNs", "requisicaoNs",
+    "memoriaSessao"
+};
+
+/**
+ * @brief Acrescenta os baldes não vazios de um histograma ("2-3:7 4-7:2", ou pares JSON).
+ */
+static void anexarBaldes(Saida *saida, const HistogramaPotencias *histograma, int json) {
+    int primeiro = 1;
+    for (unsigned balde = 0; balde < INSTRUMENTOS_BALDES; balde++) {
+        if (histograma->baldes[balde] == 0) {
+            continue;
+        }
+        uint64_t menor = balde == 0 ? 0 : 1ull << (balde - 1);
+        uint64_t maior = balde == 0 ? 0 : (1ull << (balde - 1)) * 2 - 1;
+        if (json) {
+            saidaTexto(saida, primeiro ? "[" : ",[");
+            saidaNumero(saida, menor);
+            saidaTexto(saida, ",");
+            saidaNumero(saida, histograma->baldes[balde]);
+            saidaTexto(saida, "]");
+        } else if (menor == maior) {
+            saidaAnexar(saida, " %llu:%llu", (unsigned long long)menor, (unsigned long long)histograma->baldes[balde]);
+        } else {
+            saidaAnexar(saida, " %llu-%llu:%llu", (unsigned long long)menor, (unsigned long long)maior,
+                        (unsigned long long)histograma->baldes[balde]);
+        }
+        primeiro = 0;
+    }
+}
+
+void anexarResumoInstrumentos(Saida *saida, const Instrumentos *instrumentos) {
+    uint64_t minimoBalde = UINT64_MAX, maximoBalde = 0, somaBaldes = 0;
+    for (unsigned balde = 0; balde < INSTRUMENTOS_BALDES_HASH; balde++) {
+        uint64_t quantidade = instrumentos->baldesHash[balde];
+        minimoBalde = quantidade < minimoBalde ? quantidade : minimoBalde;
+        maximoBalde = quantidade > maximoBalde ? quantidade : maximoBalde;
+        somaBaldes += quantidade;
+    }
+
+    if (saida->formato == SAIDA_JSON) {
+        saidaAnexar(saida, "{\"evento\":\"instrumentos\",\"ligados\":%d,\"threads\":", INSTRUMENTOS_LIGADOS);
+        saidaNumero(saida, instrumentos->totalThreads);
+        for (unsigned contador = 0; contador < INSTRUMENTOS_TOTAL_CONTADORES; contador++) {
+            saidaAnexar(saida, ",\"%s\":", nomesContadores[contador]);
+            saidaNumero(saida, instrumentos->contadores[contador]);
+        }
+        for (unsigned h = 0; h < INSTRUMENTOS_TOTAL_HISTOGRAMAS; h++) {
+            const HistogramaPotencias *histograma = &instrumentos->histogramas[h];
+            saidaAnexar(saida, ",\"%s\":{\"total\":", nomesHistogramas[h]);
+            saidaNumero(saida, histograma->total);
+            saidaTexto(saida, ",\"soma\":");
+            saidaNumero(saida, histograma->soma);
+            saidaTexto(saida, ",\"maximo\":");
+            saidaNumero(saida, histograma->maximo);
+            saidaTexto(saida, ",\"baldes\":[");
+            anexarBaldes(saida, histograma, 1);
+            saidaTexto(saida, "]}");
+        }
+        saidaTexto(saida, ",\"baldesHash\":[");
+        for (unsigned balde = 0; balde < INSTRUMENTOS_BALDES_HASH; balde++) {
+            if (balde > 0) {
+                saidaTexto(saida, ",");
+            }
+            saidaNumero(saida, instrumentos->baldesHash[balde]);
+        }
+        saidaTexto(saida, "]}\n");
+        return;
+    }
+
+    if (!INSTRUMENTOS_LIGADOS) {
+        saidaTexto(saida, "Instrumentos desligados nesta compilação (use -DDQ_INSTRUMENTOS=ON).\n");
+        return;
+    }
+    saidaAnexar(saida, "\n--- Instrumentos (%u threads) ---\n", instrumentos->totalThreads);
+    for (unsigned contador = 0; contador < INSTRUMENTOS_TOTAL_CONTADORES; contador++) {
+        saidaAnexar(saida, "%-22s %14llu\n", nomesContadores[contador],
+                    (unsigned long long)instrumentos->contadores[contador]);
+    }
+    for (unsigned h = 0; h < INSTRUMENTOS_TOTAL_HISTOGRAMAS; h++) {
+        const HistogramaPotencias *histograma = &instrumentos->histogramas[h];
+        if (histograma->total == 0) {
+            saidaAnexar(saida, "%-22s sem amostras\n", nomesHistogramas[h]);
+            continue;
+        }
+        saidaAnexar(saida, "%-22s %llu amostras, média %.2f, máximo %llu |", nomesHistogramas[h],
+                    (unsigned long long)histograma->total, (double)histograma->soma / (double)histograma->total,
+                    (unsigned long long)histograma->maximo);
+        anexarBaldes(saida, histograma, 0);
+        saidaTexto(saida, "\n");
+    }
+    if (somaBaldes > 0) {
+        saidaAnexar(saida, "%-22s %llu hashes em %d baldes: mínimo %llu, máximo %llu (esperado %.1f)\n", "baldesHash",
+                    (unsigned long long)somaBaldes, INSTRUMENTOS_BALDES_HASH, (unsigned long long)minimoBalde,
+                    (unsigned long long)maximoBalde, (double)somaBaldes / INSTRUMENTOS_BALDES_HASH);
+    }
+}
+
+#ifdef DQ_INSTRUMENTAR
+
+// Evento de rastro: instante relativo ao início do rastro
+typedef struct EventoRastro {
+    const char *nome;
+    uint64_t instante;
+    char fase;
+} EventoRastro;
+
+_Thread_local BlocoInstrumentos *instrumentosDaThread;
+atomic_int instrumentosRastreando;
+
+static pthread_mutex_t travaBlocos = PTHREAD_MUTEX_INITIALIZER;
+static BlocoInstrumentos *blocos;      // Lista de todas as threads (os blocos nunca são liberados)
+static uint32_t totalBlocos;
+static uint64_t inicioRastro;
+
+BlocoInstrumentos *instrumentosRegistrarThread(void) {
+    BlocoInstrumentos *bloco = (BlocoInstrumentos*)calloc(1, sizeof(BlocoInstrumentos));
+    if (bloco == NULL) {
+        printf("Erro de alocação de memória para os Instrumentos!\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_lock(&travaBlocos);
+    bloco->thread = ++totalBlocos;
+    bloco->proximo = blocos;
+    blocos = bloco;
+    pthread_mutex_unlock(&travaBlocos);
+    instrumentosDaThread = bloco;
+    return bloco;
+}
+
+void instrumentosEvento(const char *nome, char fase) {
+    uint64_t agora = instrumentosAgoraNs();
+    BlocoInstrumentos *bloco = instrumentosDaThread != NULL ? instrumentosDaThread : instrumentosRegistrarThread();
+    if (bloco->totalEventos == bloco->capacidadeEventos) {
+        if (bloco->capacidadeEventos >= INSTRUMENTOS_EVENTOS_MAXIMOS) {
+            bloco->contagens.contadores[CONTADOR_EVENTOS_DESCARTADOS]++;
+            return;
+        }
+        uint32_t capacidade = bloco->capacidadeEventos > 0 ? bloco->capacidadeEventos * 2 : 1024;
+        EventoRastro *eventos = (EventoRastro*)realloc(bloco->eventos, capacidade * sizeof(EventoRastro));
+        if (eventos == NULL) {
+            bloco->contagens.contadores[CONTADOR_EVENTOS_DESCARTADOS]++;
+            return;
+        }
+        bloco->eventos = eventos;
+        bloco->capacidadeEventos = capacidade;
+    }
+    EventoRastro evento = { nome, agora - inicioRastro, fase };
+    bloco->eventos[bloco->totalEventos++] = evento;
+}
+
+void instrumentosSomar(Instrumentos *destino) {
+    memset(destino, 0, sizeof(Instrumentos));
+    pthread_mutex_lock(&travaBlocos);
+    for (const BlocoInstrumentos *bloco = blocos; bloco != NULL; bloco = bloco->proximo) {
+        const Instrumentos *origem = &bloco->contagens;
+        for (unsigned contador = 0; contador < INSTRUMENTOS_TOTAL_CONTADORES; contador++) {
+            destino->contadores[contador] += origem->contadores[contador];
+        }
+        for (unsigned h = 0; h < INSTRUMENTOS_TOTAL_HISTOGRAMAS; h++) {
+            HistogramaPotencias *soma = &destino->histogramas[h];
+            const HistogramaPotencias *parcela = &origem->histogramas[h];
+            for (unsigned balde = 0; balde < INSTRUMENTOS_BALDES; balde++) {
+                soma->baldes[balde] += parcela->baldes[balde];
+            }
+            soma->total += parcela->total;
+            soma->soma += parcela->soma;
+            soma->maximo = parcela->maximo > soma->maximo ? parcela->maximo : soma->maximo;
+        }
+        for (unsigned balde = 0; balde < INSTRUMENTOS_BALDES_HASH; balde++) {
+            destino->baldesHash[balde] += origem->baldesHash[balde];
+        }
+        destino->totalThreads++;
+    }
+    pthread_mutex_unlock(&travaBlocos);
+}
+
+void instrumentosZerar(void) {
+    pthread_mutex_lock(&travaBlocos);
+    for (BlocoInstrumentos *bloco = blocos; bloco != NULL; bloco = bloco->proximo) {
+        memset(&bloco->contagens, 0, sizeof(Instrumentos));
+    }
+    pthread_mutex_unlock(&travaBlocos);
+}
+
+int instrumentosIniciarRastro(void) {
+    inicioRastro = instrumentosAgoraNs();
+    atomic_store_explicit(&instrumentosRastreando, 1, memory_order_release);
+    return 0;
+}
+
+int instrumentosGravarRastro(const char *caminho) {
+    atomic_store_explicit(&instrumentosRastreando, 0, memory_order_release);
+    int descritor = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descritor < 0) {
+        return -1;
+    }
+
+    // Um evento por linha, descarregando a cada bloco de eventos para não crescer o buffer
+    Saida saida;
+    iniciarSaida(&saida, descritor, SAIDA_JSON);
+    saidaTexto(&saida, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    int resultado = 0;
+    int primeiro = 1;
+    pthread_mutex_lock(&travaBlocos);
+    for (const BlocoInstrumentos *bloco = blocos; bloco != NULL; bloco = bloco->proximo) {
+        saidaAnexar(&saida, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                    primeiro ? "" : ",\n", bloco->thread, bloco->thread);
+        primeiro = 0;
+        for (uint32_t i = 0; i < bloco->totalEventos; i++) {
+            const EventoRastro *evento = &bloco->eventos[i];
+            saidaTexto(&saida, ",\n{\"name\":");
+            saidaJsonTexto(&saida, evento->nome);
+            saidaAnexar(&saida, ",\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03u}", evento->fase, bloco->thread,
+                        (unsigned long long)(evento->instante / 1000), (unsigned)(evento->instante % 1000));
+            if (saida.tamanho >= 1 << 20 && saidaDescarregar(&saida) != 0) {
+                resultado = -1;
+            }
+        }
+    }
+    pthread_mutex_unlock(&travaBlocos);
+    saidaTexto(&saida, "\n]}\n");
+    if (saidaDescarregar(&saida) != 0) {
+        resultado = -1;
+    }
+    liberarSaida(&saida);
+    if (close(descritor) != 0) {
+        resultado = -1;
+    }
+    return resultado;
+}
+
+#else
+
+void instrumentosSomar(Instrumentos *destino) {
+    memset(destino, 0, sizeof(Instrumentos));
+}
+
+void instrumentosZerar(void) {
+}
+
+int instrumentosIniciarRastro(void) {
+    return -1;
+}
+
+int instrumentosGravarRastro(const char *caminho) {
+    (void)caminho;
+    return -1;
+}
+
+#endif // DQ_INSTRUMENTAR
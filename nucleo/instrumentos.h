@@ -0,0 +1,215 @@
+/**
+ * @file instrumentos.h
+ * @brief Contadores, histogramas e rastro de eventos dos caminhos quentes do motor.
+ *
+ * Compilado com -DDQ_INSTRUMENTOS=ON (que define DQ_INSTRUMENTAR), cada thread
+ * ganha um bloco próprio de contadores e histogramas, criado no primeiro uso
+ * e registrado em uma lista global: a contagem é um incremento sem trava nem
+ * operação atômica, e instrumentosSomar() junta os blocos de todas as threads
+ * no fim. Sem a opção, as macros INSTRUMENTAR_* não geram código nenhum e as
+ * funções abaixo viram versões vazias.
+ *
+ * O que é medido:
+ * - inserirPista(): comparações na descida (na BST original, um strcmp cada),
+ *   rotações e pistas repetidas; sessaoColetar() conta as inserções e
+ *   repetições no conjunto de pistas da sessão;
+ * - SuspeitoHash (encontrarSuspeito() e inserirNaHash()): posições
+ *   visitadas por consulta e crescimentos;
+ * - internador (internar() e internadorProcurar()): posições visitadas e a
+ *   distribuição dos hashes de calcularHash() pelos INSTRUMENTOS_BALDES_HASH
+ *   baldes dos bits baixos, que são os que escolhem a posição no índice;
+ * - sessaoMover() e os turnos de explorarSalas(): tempo por movimento, em ns;
+ * - servidor (servidor.h): conexões aceitas, requisições atendidas com o
+ *   tempo de cada uma, em ns, e a memória de cada sessão, em bytes, medida
+ *   quando a conexão é fechada;
+ * - mapa paginado (paginas.h): páginas carregadas no anel e descartadas;
+ * - diário (diario.h): eventos registrados e lotes gravados, cuja razão é o
+ *   tamanho médio da confirmação em grupo.
+ *
+ * Os histogramas têm baldes em potências de 2 (o balde k conta os valores de
+ * 2^(k-1) a 2^k - 1). O rastro, ligado em tempo de execução com
+ * instrumentosIniciarRastro(), guarda eventos de início e fim
+ * (INSTRUMENTAR_INICIO()/INSTRUMENTAR_FIM()) por thread e os grava no formato
+ * JSON de rastro do Chrome, que o chrome://tracing e o Perfetto abrem. Com o
+ * rastro desligado, cada evento custa a leitura de uma variável.
+ */
+
+#ifndef INSTRUMENTOS_H
+#define INSTRUMENTOS_H
+
+#include <stdint.h>
+
+#include "saida.h"
+
+// --- Constantes dos Instrumentos ---
+#define INSTRUMENTOS_BALDES 48            // Baldes de cada histograma (potências de 2)
+#define INSTRUMENTOS_BALDES_HASH 64       // Baldes da distribuição de calcularHash() (hash & 63)
+#define INSTRUMENTOS_EVENTOS_MAXIMOS (1u << 22) // Eventos de rastro guardados por thread
+
+// --- Estruturas ---
+
+typedef enum Contador {
+    CONTADOR_PISTAS_INSERIDAS,   // Chamadas a inserirPista() e pistas coletadas pelas sessões
+    CONTADOR_PISTAS_REPETIDAS,   // ... que encontraram a pista já na árvore ou no conjunto
+    CONTADOR_COMPARACOES_PISTA,  // Comparações de pistas nas descidas
+    CONTADOR_ROTACOES_PISTA,     // Rebalanceamentos (rotação simples ou dupla)
+    CONTADOR_CONSULTAS_HASH,     // Procuras na SuspeitoHash
+    CONTADOR_CRESCIMENTOS_HASH,
+    CONTADOR_CONSULTAS_TEXTO,    // Procuras no internador
+    CONTADOR_MOVIMENTOS,         // Chamadas a sessaoMover()
+    CONTADOR_PARTIDAS,           // Chamadas a simularSessao()
+    CONTADOR_CONEXOES,           // Conexões aceitas pelo servidor
+    CONTADOR_CONEXOES_RECUSADAS, // ... e fechadas logo ao aceitar, por falta de descritores
+    CONTADOR_REQUISICOES,        // Linhas atendidas por atenderRequisicao()
+    CONTADOR_PAGINAS_CARREGADAS, // Páginas do mapa paginado postas no anel (validadas na primeira vez)
+    CONTADOR_PAGINAS_DESCARTADAS, // ... e tiradas dele pelo relógio
+    CONTADOR_EVENTOS_DIARIO,     // Eventos entregues ao diário de partidas (diario.h)
+    CONTADOR_LOTES_DIARIO,       // ... e escritas em grupo que os gravaram
+    CONTADOR_EVENTOS_DESCARTADOS, // Eventos de rastro além de INSTRUMENTOS_EVENTOS_MAXIMOS
+    INSTRUMENTOS_TOTAL_CONTADORES
+} Contador;
+
+typedef enum Histograma {
+    HISTOGRAMA_DESCIDA_PISTA,    // Nós visitados por inserirPista()
+    HISTOGRAMA_SONDAGEM_HASH,    // Posições visitadas por consulta na SuspeitoHash
+    HISTOGRAMA_SONDAGEM_TEXTO,   // Posições visitadas por consulta no internador
+    HISTOGRAMA_MOVIMENTO_NS,     // Duração de sessaoMover()
+    HISTOGRAMA_TURNO_NS,         // Duração de um turno dos jogos, sem a espera pela escolha
+    HISTOGRAMA_REQUISICAO_NS,    // Duração de atenderRequisicao(), sem a rede
+    HISTOGRAMA_MEMORIA_SESSAO,   // Bytes de uma conexão do servidor ao fechá-la (partidaMemoria())
+    INSTRUMENTOS_TOTAL_HISTOGRAMAS
+} Histograma;
+
+typedef struct HistogramaPotencias {
+    uint64_t baldes[INSTRUMENTOS_BALDES];
+    uint64_t total;
+    uint64_t soma;
+    uint64_t maximo;
+} HistogramaPotencias;
+
+// Contagens de uma thread, ou a soma de várias (instrumentosSomar())
+typedef struct Instrumentos {
+    uint64_t contadores[INSTRUMENTOS_TOTAL_CONTADORES];
+    HistogramaPotencias histogramas[INSTRUMENTOS_TOTAL_HISTOGRAMAS];
+    uint64_t baldesHash[INSTRUMENTOS_BALDES_HASH];
+    uint32_t totalThreads;       // Blocos somados
+} Instrumentos;
+
+// --- Funções dos Instrumentos ---
+
+/**
+ * @brief Soma as contagens de todas as threads que já usaram os instrumentos.
+ *
+ * As threads podem continuar contando durante a soma; para um resultado
+ * exato, chame depois que o trabalho terminar (ex.: ao fim de executorRodar()).
+ * @param destino Recebe a soma (tudo zero se os instrumentos estiverem desligados).
+ */
+void instrumentosSomar(Instrumentos *destino);
+
+/**
+ * @brief Zera as contagens de todas as threads (os eventos de rastro ficam).
+ */
+void instrumentosZerar(void);
+
+/**
+ * @brief Acrescenta um resumo das contagens: texto alinhado ou, em SAIDA_JSON, um objeto por linha.
+ */
+void anexarResumoInstrumentos(Saida *saida, const Instrumentos *instrumentos);
+
+/**
+ * @brief Liga o rastro de eventos; os instantes passam a contar a partir daqui.
+ * @return 0, ou -1 se os instrumentos estiverem desligados na compilação.
+ */
+int instrumentosIniciarRastro(void);
+
+/**
+ * @brief Desliga o rastro e grava os eventos de todas as threads em JSON de rastro do Chrome.
+ *
+ * Deve ser chamado quando as outras threads já não registram eventos.
+ * @param caminho O arquivo de destino.
+ * @return 0 em caso de sucesso, -1 se o arquivo não puder ser gravado ou os instrumentos estiverem desligados.
+ */
+int instrumentosGravarRastro(const char *caminho);
+
+/**
+ * @brief Instante atual em nanossegundos (CLOCK_MONOTONIC).
+ */
+uint64_t instrumentosAgoraNs(void);
+
+#ifdef DQ_INSTRUMENTAR
+
+#include <stdatomic.h>
+
+#define INSTRUMENTOS_LIGADOS 1
+
+// Bloco da thread: a soma e o rastro leem os blocos de todas pela lista global
+typedef struct BlocoInstrumentos {
+    Instrumentos contagens;
+    struct EventoRastro *eventos;
+    uint32_t totalEventos;
+    uint32_t capacidadeEventos;
+    uint32_t thread;             // Número da thread no rastro (1, 2, ...)
+    struct BlocoInstrumentos *proximo;
+} BlocoInstrumentos;
+
+extern _Thread_local BlocoInstrumentos *instrumentosDaThread;
+extern atomic_int instrumentosRastreando;
+
+/**
+ * @brief Cria e registra o bloco da thread atual (primeiro uso).
+ */
+BlocoInstrumentos *instrumentosRegistrarThread(void);
+
+/**
+ * @brief Guarda um evento de rastro ('B': início, 'E': fim) da thread atual.
+ */
+void instrumentosEvento(const char *nome, char fase);
+
+static inline Instrumentos *instrumentosAtuais(void) {
+    BlocoInstrumentos *bloco = instrumentosDaThread;
+    return bloco != NULL ? &bloco->contagens : &instrumentosRegistrarThread()->contagens;
+}
+
+static inline void instrumentosContar(Contador contador, uint64_t quantidade) {
+    instrumentosAtuais()->contadores[contador] += quantidade;
+}
+
+static inline void instrumentosRegistrar(Histograma histograma, uint64_t valor) {
+    HistogramaPotencias *h = &instrumentosAtuais()->histogramas[histograma];
+    unsigned balde = valor == 0 ? 0 : 64 - (unsigned)__builtin_clzll(valor);
+    h->baldes[balde < INSTRUMENTOS_BALDES ? balde : INSTRUMENTOS_BALDES - 1]++;
+    h->total++;
+    h->soma += valor;
+    if (valor > h->maximo) {
+        h->maximo = valor;
+    }
+}
+
+#define INSTRUMENTAR_CONTAR(contador, quantidade) instrumentosContar((contador), (quantidade))
+#define INSTRUMENTAR_HISTOGRAMA(histograma, valor) instrumentosRegistrar((histograma), (valor))
+#define INSTRUMENTAR_BALDE_HASH(hash) (instrumentosAtuais()->baldesHash[(hash) % INSTRUMENTOS_BALDES_HASH]++)
+#define INSTRUMENTAR_RELOGIO(variavel) uint64_t variavel = instrumentosAgoraNs()
+#define INSTRUMENTAR_MARCAR(variavel) ((variavel) = instrumentosAgoraNs())
+#define INSTRUMENTAR_DURACAO(histograma, variavel) \
+    instrumentosRegistrar((histograma), instrumentosAgoraNs() - (variavel))
+#define INSTRUMENTAR_INICIO(nome) \
+    (atomic_load_explicit(&instrumentosRastreando, memory_order_relaxed) ? instrumentosEvento((nome), 'B') : (void)0)
+#define INSTRUMENTAR_FIM(nome) \
+    (atomic_load_explicit(&instrumentosRastreando, memory_order_relaxed) ? instrumentosEvento((nome), 'E') : (void)0)
+
+#else
+
+#define INSTRUMENTOS_LIGADOS 0
+
+#define INSTRUMENTAR_CONTAR(contador, quantidade) ((void)0)
+#define INSTRUMENTAR_HISTOGRAMA(histograma, valor) ((void)0)
+#define INSTRUMENTAR_BALDE_HASH(hash) ((void)0)
+#define INSTRUMENTAR_RELOGIO(variavel) ((void)0)
+#define INSTRUMENTAR_MARCAR(variavel) ((void)0)
+#define INSTRUMENTAR_DURACAO(histograma, variavel) ((void)0)
+#define INSTRUMENTAR_INICIO(nome) ((void)0)
+#define INSTRUMENTAR_FIM(nome) ((void)0)
+
+#endif // DQ_INSTRUMENTAR
+
+#endif // INSTRUMENTOS_H
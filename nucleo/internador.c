@@ -0,0 +1,672 @@
+/**
+ * @file internador.c
+ * @brief Implementação da internação de strings.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "instrumentos.h"
+#include "internador.h"
+
+// Sem DQ_SEM_SIMD (opção DQ_SIMD do CMake), o hash e a comparação usam SSE2 ou NEON quando disponíveis
+#if !defined(DQ_SEM_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define INTERNADOR_SSE2 1
+#elif !defined(DQ_SEM_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define INTERNADOR_NEON 1
+#endif
+
+// --- Hash e Comparação sem Diferenciar Maiúsculas ---
+//
+// O djb2 (hash * 33 + c) é sequencial, mas um bloco de 16 bytes pode ser
+// somado de uma vez: hash' = hash * 33^16 + soma(c[i] * 33^(15 - i)), em
+// aritmética módulo 2^32. Com SSE2 (toda CPU x86-64) ou NEON, as minúsculas
+// de 16 bytes saem de uma comparação e uma soma, e os produtos pelas potências
+// de 33 são feitos em paralelo. O resultado é o mesmo hash do laço byte a
+// byte, então os índices gravados nos arquivos .dqm continuam válidos. Só as
+// letras ASCII são convertidas, como o tolower() do locale "C".
+//
+// Os primeiros 16 bytes seguem byte a byte: a maioria dos textos acaba antes
+// disso e não paga um strlen(). Nos mais longos, o resto vai em blocos, e o
+// último bloco é lido terminando no fim do texto, com os bytes já somados
+// zerados por uma máscara. Nenhuma leitura passa do '\0'.
+
+#define INTERNADOR_BLOCO 16
+
+// Minúscula ASCII de cada byte; os demais (inclusive UTF-8) ficam como estão.
+// A tabela é mais rápida que comparar a faixa 'A'..'Z' no laço byte a byte.
+static const unsigned char minusculas[256] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+    0x40, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f,
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+    0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf,
+    0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf,
+    0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+    0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf,
+    0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef,
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff,
+};
+
+static inline uint32_t internadorMinuscula(unsigned char c) {
+    return minusculas[c];
+}
+
+#if defined(INTERNADOR_SSE2) || defined(INTERNADOR_NEON)
+
+// 33^k módulo 2^32, para juntar um bloco (ou o fim de k bytes) ao hash
+static const uint32_t potencias[INTERNADOR_BLOCO + 1] = {
+    0x00000001u, 0x00000021u, 0x00000441u, 0x00008c61u, 0x00121881u, 0x025528a1u,
+    0x4cfa3cc1u, 0xec41d4e1u, 0x747c7101u, 0x040a9121u, 0x855cb541u, 0x30f35d61u,
+    0x4f5f0981u, 0x3b4039a1u, 0xa3476dc1u, 0x0c3525e1u, 0x92d9e201u,
+};
+
+// A partir da posição k: máscara que mantém só os k últimos bytes de um bloco
+static const unsigned char mascaras[2 * INTERNADOR_BLOCO] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+#endif
+
+#if defined(INTERNADOR_SSE2)
+
+// Potências 33^(15 - i) de cada byte do bloco, separadas em metades de 16 bits para _mm_mullo/_mm_mulhi
+static const uint16_t pesosBaixos[INTERNADOR_BLOCO] = {
+    0x25e1, 0x6dc1, 0x39a1, 0x0981, 0x5d61, 0xb541, 0x9121, 0x7101,
+    0xd4e1, 0x3cc1, 0x28a1, 0x1881, 0x8c61, 0x0441, 0x0021, 0x0001,
+};
+static const uint16_t pesosAltos[INTERNADOR_BLOCO] = {
+    0x0c35, 0xa347, 0x3b40, 0x4f5f, 0x30f3, 0x855c, 0x040a, 0x747c,
+    0xec41, 0x4cfa, 0x0255, 0x0012, 0x0000, 0x0000, 0x0000, 0x0000,
+};
+
+/**
+ * @brief Minúsculas ASCII de 16 bytes: 'A'..'Z' são levados para o início da faixa com sinal e comparados de uma vez.
+ */
+static inline __m128i internadorMinusculas(__m128i bytes) {
+    __m128i deslocados = _mm_add_epi8(bytes, _mm_set1_epi8((char)(0x80 - 'A')));
+    __m128i maiusculas = _mm_cmplt_epi8(deslocados, _mm_set1_epi8((char)(0x80 + 26)));
+    return _mm_add_epi8(bytes, _mm_and_si128(maiusculas, _mm_set1_epi8('a' - 'A')));
+}
+
+/**
+ * @brief Soma de 8 bytes (já em 16 bits) vezes os pesos, em 32 bits: c * p = c * p_baixo + (c * p_alto << 16).
+ */
+static inline __m128i internadorSomarPesos(__m128i acumulado, __m128i bytes, const uint16_t *baixos, const uint16_t *altos) {
+    __m128i pesoBaixo = _mm_loadu_si128((const __m128i*)baixos);
+    __m128i pesoAlto = _mm_loadu_si128((const __m128i*)altos);
+    __m128i parteBaixa = _mm_mullo_epi16(bytes, pesoBaixo);
+    __m128i parteAlta = _mm_add_epi16(_mm_mulhi_epu16(bytes, pesoBaixo), _mm_mullo_epi16(bytes, pesoAlto));
+    acumulado = _mm_add_epi32(acumulado, _mm_unpacklo_epi16(parteBaixa, parteAlta));
+    return _mm_add_epi32(acumulado, _mm_unpackhi_epi16(parteBaixa, parteAlta));
+}
+
+/**
+ * @brief soma(c[i] * 33^(15 - i)) dos bytes de um bloco mantidos pela máscara.
+ */
+static inline uint32_t internadorSomarBloco(const char *bloco, const unsigned char *mascara) {
+    __m128i bytes = _mm_and_si128(_mm_loadu_si128((const __m128i*)bloco), _mm_loadu_si128((const __m128i*)mascara));
+    bytes = internadorMinusculas(bytes);
+    __m128i zero = _mm_setzero_si128();
+    __m128i soma = internadorSomarPesos(zero, _mm_unpacklo_epi8(bytes, zero), pesosBaixos, pesosAltos);
+    soma = internadorSomarPesos(soma, _mm_unpackhi_epi8(bytes, zero), pesosBaixos + 8, pesosAltos + 8);
+    soma = _mm_add_epi32(soma, _mm_shuffle_epi32(soma, _MM_SHUFFLE(1, 0, 3, 2)));
+    soma = _mm_add_epi32(soma, _mm_shuffle_epi32(soma, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (uint32_t)_mm_cvtsi128_si32(soma);
+}
+
+static inline int internadorBlocosIguais(const char *a, const char *b) {
+    __m128i x = internadorMinusculas(_mm_loadu_si128((const __m128i*)a));
+    __m128i y = internadorMinusculas(_mm_loadu_si128((const __m128i*)b));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xFFFF;
+}
+
+#elif defined(INTERNADOR_NEON)
+
+// Potências 33^(15 - i) de cada byte do bloco
+static const uint32_t pesos[INTERNADOR_BLOCO] = {
+    0x0c3525e1u, 0xa3476dc1u, 0x3b4039a1u, 0x4f5f0981u,
+    0x30f35d61u, 0x855cb541u, 0x040a9121u, 0x747c7101u,
+    0xec41d4e1u, 0x4cfa3cc1u, 0x025528a1u, 0x00121881u,
+    0x00008c61u, 0x00000441u, 0x00000021u, 0x00000001u,
+};
+
+static inline uint8x16_t internadorMinusculas(uint8x16_t bytes) {
+    uint8x16_t maiusculas = vcltq_u8(vsubq_u8(bytes, vdupq_n_u8('A')), vdupq_n_u8(26));
+    return vaddq_u8(bytes, vandq_u8(maiusculas, vdupq_n_u8('a' - 'A')));
+}
+
+static inline uint32_t internadorSomarBloco(const char *bloco, const unsigned char *mascara) {
+    uint8x16_t bytes = vandq_u8(vld1q_u8((const uint8_t*)bloco), vld1q_u8(mascara));
+    bytes = internadorMinusculas(bytes);
+    uint16x8_t baixos = vmovl_u8(vget_low_u8(bytes));
+    uint16x8_t altos = vmovl_u8(vget_high_u8(bytes));
+    uint32x4_t soma = vmulq_u32(vmovl_u16(vget_low_u16(baixos)), vld1q_u32(pesos));
+    soma = vmlaq_u32(soma, vmovl_u16(vget_high_u16(baixos)), vld1q_u32(pesos + 4));
+    soma = vmlaq_u32(soma, vmovl_u16(vget_low_u16(altos)), vld1q_u32(pesos + 8));
+    soma = vmlaq_u32(soma, vmovl_u16(vget_high_u16(altos)), vld1q_u32(pesos + 12));
+    uint32x2_t metade = vadd_u32(vget_low_u32(soma), vget_high_u32(soma));
+    return vget_lane_u32(vpadd_u32(metade, metade), 0);
+}
+
+static inline int internadorBlocosIguais(const char *a, const char *b) {
+    uint8x16_t x = internadorMinusculas(vld1q_u8((const uint8_t*)a));
+    uint8x16_t y = internadorMinusculas(vld1q_u8((const uint8_t*)b));
+    uint64x2_t iguais = vreinterpretq_u64_u8(vceqq_u8(x, y));
+    return (vgetq_lane_u64(iguais, 0) & vgetq_lane_u64(iguais, 1)) == UINT64_MAX;
+}
+
+#endif
+
+/**
+ * @brief djb2 sem diferenciar maiúsculas.
+ * @param tamanho Recebe o tamanho do texto, usado depois na comparação.
+ */
+static uint32_t internadorHash(const char *texto, size_t *tamanho) {
+    uint32_t hash = 5381;
+    size_t i = 0;
+#if defined(INTERNADOR_SSE2) || defined(INTERNADOR_NEON)
+    for (; i < INTERNADOR_BLOCO; i++) {
+        unsigned char c = (unsigned char)texto[i];
+        if (c == '\0') {
+            *tamanho = i;
+            return hash;
+        }
+        hash = ((hash << 5) + hash) + internadorMinuscula(c); // hash * 33 + c
+    }
+    size_t total = i + strlen(texto + i);
+    for (; i + INTERNADOR_BLOCO <= total; i += INTERNADOR_BLOCO) {
+        hash = hash * potencias[INTERNADOR_BLOCO] + internadorSomarBloco(texto + i, mascaras + INTERNADOR_BLOCO);
+    }
+    size_t restantes = total - i;
+    if (restantes > 0) {
+        hash = hash * potencias[restantes] +
+               internadorSomarBloco(texto + total - INTERNADOR_BLOCO, mascaras + restantes);
+    }
+    *tamanho = total;
+#else
+    for (; texto[i] != '\0'; i++) {
+        hash = ((hash << 5) + hash) + internadorMinuscula((unsigned char)texto[i]); // hash * 33 + c
+    }
+    *tamanho = i;
+#endif
+    return hash;
+}
+
+/**
+ * @brief Compara sem diferenciar maiúsculas dois textos de tamanhos conhecidos.
+ *
+ * Tamanhos diferentes saem sem ler os textos. Com o mesmo tamanho, a mesma
+ * grafia (o caso comum depois de um hash igual) sai do memcmp; senão, os
+ * blocos de 16 bytes são comparados em minúsculas, e o último bloco termina
+ * no fim dos dois textos (repetir bytes já comparados não muda o resultado).
+ */
+static int internadorIguais(const char *texto, size_t tamanho, const char *outro, size_t tamanhoOutro) {
+    if (tamanho != tamanhoOutro) {
+        return 0;
+    }
+    if (memcmp(texto, outro, tamanho) == 0) {
+        return 1;
+    }
+    size_t i = 0;
+#if defined(INTERNADOR_SSE2) || defined(INTERNADOR_NEON)
+    if (tamanho >= INTERNADOR_BLOCO) {
+        for (; i + INTERNADOR_BLOCO <= tamanho; i += INTERNADOR_BLOCO) {
+            if (!internadorBlocosIguais(texto + i, outro + i)) {
+                return 0;
+            }
+        }
+        return i == tamanho ||
+               internadorBlocosIguais(texto + tamanho - INTERNADOR_BLOCO, outro + tamanho - INTERNADOR_BLOCO);
+    }
+#endif
+    for (; i < tamanho; i++) {
+        unsigned char a = (unsigned char)texto[i];
+        unsigned char b = (unsigned char)outro[i];
+        if (a != b && internadorMinuscula(a) != internadorMinuscula(b)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Compara dois textos de tamanhos conhecidos na ordem do strcmp.
+ */
+static int internadorCompararTextos(const char *a, size_t tamanhoA, const char *b, size_t tamanhoB) {
+    int comparacao = memcmp(a, b, tamanhoA < tamanhoB ? tamanhoA : tamanhoB);
+    if (comparacao != 0) {
+        return comparacao;
+    }
+    return (tamanhoA > tamanhoB) - (tamanhoA < tamanhoB);
+}
+
+// --- Implementação do Internador ---
+
+uint32_t calcularHash(const char *chave) {
+    size_t tamanho;
+    return internadorHash(chave, &tamanho);
+}
+
+static void internadorFalhaMemoria(void) {
+    printf("Erro de alocação de memória para o Internador!\n");
+    exit(EXIT_FAILURE);
+}
+
+void inicializarInternador(Internador *internador) {
+    memset(internador, 0, sizeof(Internador));
+}
+
+/**
+ * @brief Procura a posição do índice que contém o texto, ou a posição livre onde ele entraria.
+ */
+static uint32_t internadorSondar(const Internador *internador, const char *texto, size_t tamanho, uint32_t hash) {
+    uint32_t mascara = internador->capacidade - 1;
+    uint32_t indice = hash & mascara;
+    INSTRUMENTAR_CONTAR(CONTADOR_CONSULTAS_TEXTO, 1);
+    INSTRUMENTAR_BALDE_HASH(hash);
+    for (uint32_t distancia = 0;; distancia++) {
+        const InternadorPosicao *atual = &internador->posicoes[indice];
+        if (atual->id == TEXTO_NENHUM) {
+            INSTRUMENTAR_HISTOGRAMA(HISTOGRAMA_SONDAGEM_TEXTO, distancia + 1);
+            return indice;
+        }
+        // Robin Hood: uma entrada mais perto de casa indica que o texto não está no índice
+        uint32_t distanciaAtual = (indice - (atual->hash & mascara)) & mascara;
+        if (distanciaAtual < distancia) {
+            INSTRUMENTAR_HISTOGRAMA(HISTOGRAMA_SONDAGEM_TEXTO, distancia + 1);
+            return indice;
+        }
+        if (atual->hash == hash &&
+            internadorIguais(texto, tamanho, textoDoId(internador, atual->id), tamanhoDoId(internador, atual->id))) {
+            INSTRUMENTAR_HISTOGRAMA(HISTOGRAMA_SONDAGEM_TEXTO, distancia + 1);
+            return indice;
+        }
+        indice = (indice + 1) & mascara;
+    }
+}
+
+/**
+ * @brief Coloca um identificador no índice, deslocando entradas pelo critério Robin Hood.
+ */
+static void internadorColocar(Internador *internador, InternadorPosicao nova) {
+    uint32_t mascara = internador->capacidade - 1;
+    uint32_t indice = nova.hash & mascara;
+    uint32_t distancia = 0;
+    while (internador->posicoes[indice].id != TEXTO_NENHUM) {
+        InternadorPosicao *atual = &internador->posicoes[indice];
+        uint32_t distanciaAtual = (indice - (atual->hash & mascara)) & mascara;
+        if (distanciaAtual < distancia) {
+            InternadorPosicao temp = *atual;
+            *atual = nova;
+            nova = temp;
+            distancia = distanciaAtual;
+        }
+        indice = (indice + 1) & mascara;
+        distancia++;
+    }
+    internador->posicoes[indice] = nova;
+}
+
+/**
+ * @brief Coloca no índice os ids [primeiro, primeiro + total), em lotes ordenados pela posição de origem.
+ *
+ * Com o índice maior que a cache, colocar os ids na ordem em que foram
+ * internados salta para uma posição ao acaso a cada texto. Ordenados pela
+ * posição de origem (radix de 16 bits), os de um lote avançam pelo índice
+ * quase em sequência. O resultado é um índice Robin Hood válido como o de
+ * internadorColocar() um a um.
+ */
+static void internadorColocarEmOrdem(Internador *internador, uint32_t primeiro, uint32_t total) {
+    if (total < INTERNADOR_LOTE_MINIMO) {
+        for (uint32_t id = primeiro; id < primeiro + total; id++) {
+            InternadorPosicao posicao = { calcularHash(textoDoId(internador, id)), id };
+            internadorColocar(internador, posicao);
+        }
+        return;
+    }
+
+    uint32_t mascara = internador->capacidade - 1;
+    uint32_t maximoLote = total < INTERNADOR_LOTE ? total : INTERNADOR_LOTE;
+    InternadorPosicao *bloco = (InternadorPosicao*)malloc(2 * (size_t)maximoLote * sizeof(InternadorPosicao));
+    uint32_t *contagem = (uint32_t*)malloc(65536 * sizeof(uint32_t));
+    if (bloco == NULL || contagem == NULL) {
+        internadorFalhaMemoria();
+    }
+    InternadorPosicao *lote = bloco;
+    InternadorPosicao *auxiliar = bloco + maximoLote;
+
+    for (uint32_t inicio = 0; inicio < total; inicio += maximoLote) {
+        uint32_t tamanho = total - inicio < maximoLote ? total - inicio : maximoLote;
+        for (uint32_t i = 0; i < tamanho; i++) {
+            uint32_t id = primeiro + inicio + i;
+            InternadorPosicao posicao = { calcularHash(textoDoId(internador, id)), id };
+            lote[i] = posicao;
+        }
+        // Radix estável pela posição de origem, 16 bits por passada
+        for (uint32_t deslocamento = 0; deslocamento < 32 && (mascara >> deslocamento) != 0; deslocamento += 16) {
+            memset(contagem, 0, 65536 * sizeof(uint32_t));
+            for (uint32_t i = 0; i < tamanho; i++) {
+                contagem[((lote[i].hash & mascara) >> deslocamento) & 0xFFFF]++;
+            }
+            uint32_t soma = 0;
+            for (uint32_t digito = 0; digito < 65536; digito++) {
+                uint32_t quantidade = contagem[digito];
+                contagem[digito] = soma;
+                soma += quantidade;
+            }
+            for (uint32_t i = 0; i < tamanho; i++) {
+                auxiliar[contagem[((lote[i].hash & mascara) >> deslocamento) & 0xFFFF]++] = lote[i];
+            }
+            InternadorPosicao *troca = lote;
+            lote = auxiliar;
+            auxiliar = troca;
+        }
+        for (uint32_t i = 0; i < tamanho; i++) {
+            internadorColocar(internador, lote[i]);
+        }
+    }
+    free(bloco);
+    free(contagem);
+}
+
+/**
+ * @brief Recria o índice com a capacidade pedida, a partir dos textos já internados.
+ */
+static void internadorReindexar(Internador *internador, uint32_t capacidade) {
+    free(internador->posicoes);
+    internador->posicoes = (InternadorPosicao*)malloc(capacidade * sizeof(InternadorPosicao));
+    if (internador->posicoes == NULL) {
+        internadorFalhaMemoria();
+    }
+    memset(internador->posicoes, 0xFF, capacidade * sizeof(InternadorPosicao));
+    internador->capacidade = capacidade;
+    internadorColocarEmOrdem(internador, 0, internador->total);
+}
+
+/**
+ * @brief Indica se a posição devolvida por internadorSondar() guarda o texto procurado.
+ */
+static int internadorPosicaoContem(const Internador *internador, uint32_t indice, const char *texto, size_t tamanho, uint32_t hash) {
+    const InternadorPosicao *posicao = &internador->posicoes[indice];
+    return posicao->id != TEXTO_NENHUM && posicao->hash == hash &&
+           internadorIguais(texto, tamanho, textoDoId(internador, posicao->id), tamanhoDoId(internador, posicao->id));
+}
+
+uint32_t internadorProcurar(const Internador *internador, const char *texto) {
+    if (internador->capacidade == 0 || texto == NULL) {
+        return TEXTO_NENHUM;
+    }
+    size_t tamanho;
+    uint32_t hash = internadorHash(texto, &tamanho);
+    uint32_t indice = internadorSondar(internador, texto, tamanho, hash);
+    return internadorPosicaoContem(internador, indice, texto, tamanho, hash) ? internador->posicoes[indice].id : TEXTO_NENHUM;
+}
+
+/**
+ * @brief Acrescenta um texto novo ao bloco, com o cabeçalho de tamanho, e lhe dá o próximo id.
+ *
+ * Não mexe no índice: quem chama coloca o id nele (ou o refaz).
+ * @return O id do texto.
+ */
+static uint32_t internadorAcrescentar(Internador *internador, const char *texto, uint32_t comprimento) {
+    uint32_t tamanho = internadorTamanhoGuardado(comprimento);
+    if (internador->tamanhoTextos + tamanho > internador->capacidadeTextos) {
+        uint32_t capacidade = internador->capacidadeTextos > 0 ? internador->capacidadeTextos : 256;
+        while (internador->tamanhoTextos + tamanho > capacidade) {
+            capacidade *= 2;
+        }
+        char *textos = (char*)realloc(internador->textos, capacidade);
+        if (textos == NULL) {
+            internadorFalhaMemoria();
+        }
+        internador->textos = textos;
+        internador->capacidadeTextos = capacidade;
+    }
+    if (internador->total == internador->capacidadeIds) {
+        uint32_t capacidade = internador->capacidadeIds > 0 ? internador->capacidadeIds * 2 : 16;
+        uint32_t *deslocamentos = (uint32_t*)realloc(internador->deslocamentos, capacidade * sizeof(uint32_t));
+        if (deslocamentos == NULL) {
+            internadorFalhaMemoria();
+        }
+        internador->deslocamentos = deslocamentos;
+        internador->capacidadeIds = capacidade;
+    }
+
+    char *destino = internador->textos + internador->tamanhoTextos;
+    if (comprimento < INTERNADOR_TAMANHO_LONGO) {
+        *destino++ = (char)comprimento;
+    } else {
+        memcpy(destino, &comprimento, sizeof(uint32_t));
+        destino += sizeof(uint32_t);
+        *destino++ = (char)INTERNADOR_TAMANHO_LONGO;
+    }
+    memcpy(destino, texto, comprimento);
+    destino[comprimento] = '\0';
+
+    uint32_t id = internador->total++;
+    internador->deslocamentos[id] = (uint32_t)(destino - internador->textos);
+    internador->tamanhoTextos += tamanho;
+    return id;
+}
+
+void reservarInternador(Internador *internador, uint32_t total, uint32_t tamanhoTextos) {
+    if (tamanhoTextos > internador->capacidadeTextos) {
+        char *textos = (char*)realloc(internador->textos, tamanhoTextos);
+        if (textos == NULL) {
+            internadorFalhaMemoria();
+        }
+        internador->textos = textos;
+        internador->capacidadeTextos = tamanhoTextos;
+    }
+    if (total > internador->capacidadeIds) {
+        uint32_t *deslocamentos = (uint32_t*)realloc(internador->deslocamentos, (size_t)total * sizeof(uint32_t));
+        if (deslocamentos == NULL) {
+            internadorFalhaMemoria();
+        }
+        internador->deslocamentos = deslocamentos;
+        internador->capacidadeIds = total;
+    }
+    uint32_t capacidade = internador->capacidade > 0 ? internador->capacidade : INTERNADOR_CAPACIDADE_INICIAL;
+    while (capacidade / 2 < total) {
+        capacidade *= 2;
+    }
+    if (capacidade != internador->capacidade) {
+        internadorReindexar(internador, capacidade);
+    }
+}
+
+void internarLote(Internador *internador, const char *textos, uint32_t total) {
+    uint32_t primeiro = internador->total;
+    for (uint32_t i = 0; i < total; i++) {
+        uint32_t comprimento = (uint32_t)strlen(textos);
+        if (comprimento > 0) {
+            internadorAcrescentar(internador, textos, comprimento);
+        }
+        textos += comprimento + 1;
+    }
+
+    uint32_t capacidade = internador->capacidade > 0 ? internador->capacidade : INTERNADOR_CAPACIDADE_INICIAL;
+    while (capacidade / 2 < internador->total) {
+        capacidade *= 2;
+    }
+    if (capacidade != internador->capacidade) {
+        internadorReindexar(internador, capacidade);
+    } else {
+        internadorColocarEmOrdem(internador, primeiro, internador->total - primeiro);
+    }
+}
+
+uint32_t internar(Internador *internador, const char *texto) {
+    if (texto == NULL || texto[0] == '\0') {
+        return TEXTO_NENHUM;
+    }
+    if (internador->capacidade == 0) {
+        internadorReindexar(internador, INTERNADOR_CAPACIDADE_INICIAL);
+    }
+
+    size_t comprimento;
+    uint32_t hash = internadorHash(texto, &comprimento);
+    uint32_t indice = internadorSondar(internador, texto, comprimento, hash);
+    if (internadorPosicaoContem(internador, indice, texto, comprimento, hash)) {
+        return internador->posicoes[indice].id;
+    }
+
+    // Texto novo: copia para o bloco de textos
+    uint32_t id = internadorAcrescentar(internador, texto, (uint32_t)comprimento);
+
+    if (internador->total * 2 > internador->capacidade) {
+        internadorReindexar(internador, internador->capacidade * 2);
+    } else {
+        InternadorPosicao nova = { hash, id };
+        internadorColocar(internador, nova);
+    }
+    return id;
+}
+
+/**
+ * @brief Contexto de qsort para ordenar identificadores pelo texto.
+ *
+ * qsort não recebe contexto, então o internador em ordenação fica em uma
+ * variável de arquivo (local à thread) durante a chamada.
+ */
+static _Thread_local const Internador *internadorEmOrdenacao;
+
+static int compararIdsPorTexto(const void *a, const void *b) {
+    uint32_t idA = *(const uint32_t*)a;
+    uint32_t idB = *(const uint32_t*)b;
+    return internadorCompararTextos(textoDoId(internadorEmOrdenacao, idA), tamanhoDoId(internadorEmOrdenacao, idA),
+                                    textoDoId(internadorEmOrdenacao, idB), tamanhoDoId(internadorEmOrdenacao, idB));
+}
+
+void ordenarInternador(Internador *internador, uint32_t *novoId) {
+    // Textos internados já em ordem (mapas gerados, listas ordenadas): nada muda
+    uint32_t id = 1;
+    while (id < internador->total &&
+           internadorCompararTextos(textoDoId(internador, id - 1), tamanhoDoId(internador, id - 1),
+                                    textoDoId(internador, id), tamanhoDoId(internador, id)) < 0) {
+        id++;
+    }
+    if (id >= internador->total) {
+        for (id = 0; id < internador->total; id++) {
+            novoId[id] = id;
+        }
+        return;
+    }
+
+    uint32_t *ordem = (uint32_t*)malloc((internador->total + 1) * sizeof(uint32_t));
+    uint32_t *deslocamentos = (uint32_t*)malloc((internador->total + 1) * sizeof(uint32_t));
+    if (ordem == NULL || deslocamentos == NULL) {
+        internadorFalhaMemoria();
+    }
+    for (uint32_t i = 0; i < internador->total; i++) {
+        ordem[i] = i;
+    }
+    internadorEmOrdenacao = internador;
+    qsort(ordem, internador->total, sizeof(uint32_t), compararIdsPorTexto);
+    internadorEmOrdenacao = NULL;
+
+    for (uint32_t posicao = 0; posicao < internador->total; posicao++) {
+        novoId[ordem[posicao]] = posicao;
+        deslocamentos[posicao] = internador->deslocamentos[ordem[posicao]];
+    }
+    free(internador->deslocamentos);
+    free(ordem);
+    internador->deslocamentos = deslocamentos;
+    internador->capacidadeIds = internador->total + 1;
+    internadorReindexar(internador, internador->capacidade > 0 ? internador->capacidade : INTERNADOR_CAPACIDADE_INICIAL);
+}
+
+/**
+ * @brief Primeiro id cujo texto, comparado nos primeiros `tamanho` bytes, não vem antes do prefixo
+ * (ou, com `incluirIguais`, vem depois dele).
+ */
+static uint32_t internadorLimitePrefixo(const Internador *internador, const char *prefixo, size_t tamanho, int incluirIguais) {
+    uint32_t baixo = 0;
+    uint32_t alto = internador->total;
+    while (baixo < alto) {
+        uint32_t meio = baixo + (alto - baixo) / 2;
+        // O strncmp de `tamanho` bytes: um texto mais curto que o prefixo vem antes dele
+        uint32_t tamanhoTexto = tamanhoDoId(internador, meio);
+        int comparacao = memcmp(textoDoId(internador, meio), prefixo, tamanhoTexto < tamanho ? tamanhoTexto : tamanho);
+        if (comparacao == 0 && tamanhoTexto < tamanho) {
+            comparacao = -1;
+        }
+        if (comparacao < 0 || (incluirIguais && comparacao == 0)) {
+            baixo = meio + 1;
+        } else {
+            alto = meio;
+        }
+    }
+    return baixo;
+}
+
+void internadorIntervaloPrefixo(const Internador *internador, const char *prefixo, uint32_t *inicio, uint32_t *fim) {
+    size_t tamanho = strlen(prefixo);
+    *inicio = internadorLimitePrefixo(internador, prefixo, tamanho, 0);
+    *fim = internadorLimitePrefixo(internador, prefixo, tamanho, 1);
+}
+
+int validarTextoInternador(const Internador *internador, uint32_t id) {
+    if (id >= internador->total) {
+        return 0;
+    }
+    // O cabeçalho cabe antes do texto, e o tamanho dele termina no '\0' dentro do bloco
+    uint32_t deslocamento = internador->deslocamentos[id];
+    if (deslocamento == 0 || deslocamento >= internador->tamanhoTextos) {
+        return 0;
+    }
+    if ((unsigned char)internador->textos[deslocamento - 1] == INTERNADOR_TAMANHO_LONGO &&
+        deslocamento < 1 + sizeof(uint32_t)) {
+        return 0;
+    }
+    uint32_t tamanho = tamanhoDoId(internador, id);
+    return tamanho < internador->tamanhoTextos - deslocamento && internador->textos[deslocamento + tamanho] == '\0';
+}
+
+int validarInternador(const Internador *internador) {
+    if (internador->tamanhoTextos > 0 && internador->textos[internador->tamanhoTextos - 1] != '\0') {
+        return 0;
+    }
+    if (internador->total > 0 && internador->tamanhoTextos == 0) {
+        return 0;
+    }
+    if (internador->capacidade & (internador->capacidade - 1)) {
+        return 0;
+    }
+    if (internador->total > 0 && internador->capacidade < internador->total) {
+        return 0;
+    }
+    for (uint32_t id = 0; id < internador->total; id++) {
+        if (!validarTextoInternador(internador, id)) {
+            return 0;
+        }
+    }
+    uint32_t livres = 0;
+    for (uint32_t i = 0; i < internador->capacidade; i++) {
+        if (internador->posicoes[i].id == TEXTO_NENHUM) {
+            livres++;
+        } else if (internador->posicoes[i].id >= internador->total) {
+            return 0;
+        }
+    }
+    // A sondagem precisa de ao menos uma posição livre para terminar
+    return internador->capacidade == 0 || livres > 0;
+}
+
+void liberarInternador(Internador *internador) {
+    free(internador->textos);
+    free(internador->deslocamentos);
+    free(internador->posicoes);
+    inicializarInternador(internador);
+}
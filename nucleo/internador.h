@@ -0,0 +1,195 @@
+/**
+ * @file internador.h
+ * @brief Internação de strings: cada texto distinto recebe um identificador inteiro.
+ *
+ * Pistas e suspeitos são guardados uma única vez em um bloco contíguo de textos;
+ * salas, árvore de pistas e tabela de suspeitos passam a guardar apenas o
+ * identificador (uint32_t), e a igualdade vira uma comparação de inteiros.
+ * A busca texto -> identificador usa endereçamento aberto (Robin Hood) com o
+ * hash guardado ao lado do identificador.
+ *
+ * Hash e igualdade não diferenciam maiúsculas ASCII ("d. branca" é o mesmo
+ * texto que "D. Branca"), e ambos processam 16 bytes por vez com SSE2 ou NEON;
+ * o texto guardado é o da primeira internação. A ordem alfabética de
+ * ordenarInternador() continua sendo a do strcmp.
+ *
+ * Cada texto do bloco é precedido pelo seu tamanho, e o deslocamento de um id
+ * aponta para o primeiro caractere (o texto continua terminado em '\0', e
+ * textoDoId() não muda). Textos de até 254 bytes, quase todas as pistas e
+ * nomes, têm um cabeçalho de 1 byte; os maiores guardam 0xFF nesse byte e o
+ * tamanho em 4 bytes logo antes dele:
+ *
+ *   curto: [tamanho (1)][texto]['\0']
+ *   longo: [tamanho (4)][0xFF][texto]['\0']
+ *
+ * Com o tamanho à mão, textos de tamanhos diferentes são descartados sem ler
+ * nenhum caractere, e tamanhoDoId() substitui o strlen de quem escreve o texto.
+ */
+
+#ifndef INTERNADOR_H
+#define INTERNADOR_H
+
+#include <stdint.h>
+#include <string.h>
+
+// --- Constantes do Internador ---
+#define TEXTO_NENHUM UINT32_MAX          // Identificador inexistente
+#define INTERNADOR_CAPACIDADE_INICIAL 16 // Sempre potência de 2
+#define INTERNADOR_LOTE (1u << 20)       // Ids ordenados por vez ao refazer o índice
+#define INTERNADOR_LOTE_MINIMO 4096      // Abaixo disso, o índice é refeito sem ordenar
+#define INTERNADOR_TAMANHO_LONGO 0xFF    // Cabeçalho de 1 byte com este valor: tamanho nos 4 bytes anteriores
+
+// --- Estruturas ---
+
+// Posição do índice: identificador e hash do texto (posição livre: id == TEXTO_NENHUM)
+typedef struct InternadorPosicao {
+    uint32_t hash;
+    uint32_t id;
+} InternadorPosicao;
+
+typedef struct Internador {
+    char *textos;             // Textos com cabeçalho de tamanho e terminados em '\0', um após o outro
+    uint32_t tamanhoTextos;
+    uint32_t capacidadeTextos;
+    uint32_t *deslocamentos;  // id -> deslocamento do texto
+    uint32_t total;
+    uint32_t capacidadeIds;
+    InternadorPosicao *posicoes;
+    uint32_t capacidade;      // Tamanho do índice (potência de 2, carga <= 1/2)
+} Internador;
+
+// --- Funções do Internador ---
+
+/**
+ * @brief Calcula o hash (djb2, sem diferenciar maiúsculas) de um texto.
+ *
+ * Blocos de 16 bytes são somados com SSE2 ou NEON; o valor é o mesmo do djb2
+ * byte a byte com tolower() no locale "C".
+ * @param chave O texto.
+ * @return O hash completo; o índice é obtido aplicando a máscara da tabela.
+ */
+uint32_t calcularHash(const char *chave);
+
+/**
+ * @brief Inicializa um internador vazio.
+ * @param internador O ponteiro para o internador.
+ */
+void inicializarInternador(Internador *internador);
+
+/**
+ * @brief Texto correspondente a um identificador.
+ * @return O texto, ou "" para TEXTO_NENHUM.
+ */
+static inline const char *textoDoId(const Internador *internador, uint32_t id) {
+    return id == TEXTO_NENHUM ? "" : internador->textos + internador->deslocamentos[id];
+}
+
+/**
+ * @brief Tamanho em bytes do texto de um identificador, sem o '\0' (o mesmo do strlen).
+ * @return O tamanho, ou 0 para TEXTO_NENHUM.
+ */
+static inline uint32_t tamanhoDoId(const Internador *internador, uint32_t id) {
+    if (id == TEXTO_NENHUM) {
+        return 0;
+    }
+    const unsigned char *texto = (const unsigned char*)internador->textos + internador->deslocamentos[id];
+    if (texto[-1] != INTERNADOR_TAMANHO_LONGO) {
+        return texto[-1];
+    }
+    uint32_t tamanho;
+    memcpy(&tamanho, texto - 1 - sizeof(uint32_t), sizeof(uint32_t));
+    return tamanho;
+}
+
+/**
+ * @brief Bytes que um texto de `comprimento` caracteres ocupa no bloco: cabeçalho, texto e '\0'.
+ */
+static inline uint32_t internadorTamanhoGuardado(uint32_t comprimento) {
+    uint32_t cabecalho = comprimento < INTERNADOR_TAMANHO_LONGO ? 1 : 1 + (uint32_t)sizeof(uint32_t);
+    return cabecalho + comprimento + 1;
+}
+
+/**
+ * @brief Procura o identificador de um texto sem interná-lo (sem diferenciar maiúsculas).
+ * @return O identificador, ou TEXTO_NENHUM se o texto nunca foi internado.
+ */
+uint32_t internadorProcurar(const Internador *internador, const char *texto);
+
+/**
+ * @brief Devolve o identificador de um texto, internando-o se ainda não existir.
+ * @param internador O ponteiro para o internador.
+ * @param texto O texto (NULL ou "" resultam em TEXTO_NENHUM).
+ * @return O identificador do texto.
+ */
+uint32_t internar(Internador *internador, const char *texto);
+
+/**
+ * @brief Interna de uma vez uma sequência de textos que ainda não estão no internador.
+ *
+ * Os textos recebem ids consecutivos, na ordem da sequência, e entram no
+ * índice ordenados pela posição, como ao refazê-lo. Bem mais rápido que
+ * internar() um a um quando o índice não cabe na cache (mapas gerados).
+ * @param internador O ponteiro para o internador.
+ * @param textos `total` textos terminados em '\0', um após o outro; devem ser
+ *               distintos entre si e dos já internados (vazios são ignorados).
+ * @param total A quantidade de textos da sequência.
+ */
+void internarLote(Internador *internador, const char *textos, uint32_t total);
+
+/**
+ * @brief Reserva espaço para `total` textos somando `tamanhoTextos` bytes no bloco
+ *        (a soma de internadorTamanhoGuardado() de cada um).
+ *
+ * Com a reserva, internar textos até esses limites não realoca nem refaz o
+ * índice; útil quando a quantidade é conhecida antes (mapas gerados).
+ */
+void reservarInternador(Internador *internador, uint32_t total, uint32_t tamanhoTextos);
+
+/**
+ * @brief Renumera os identificadores para que sigam a ordem alfabética dos textos.
+ *
+ * Depois disso, comparar dois identificadores equivale a comparar os textos com
+ * strcmp. Os textos não mudam de lugar; apenas a tabela id -> deslocamento é
+ * reordenada e o índice é refeito. Se os textos já estiverem em ordem, a
+ * conferência é linear e nada é alterado.
+ * @param internador O ponteiro para o internador.
+ * @param novoId Vetor com internador->total posições: recebe, para cada id antigo, o novo id.
+ */
+void ordenarInternador(Internador *internador, uint32_t *novoId);
+
+/**
+ * @brief Intervalo de identificadores cujos textos começam com um prefixo.
+ *
+ * Exige um internador em ordem alfabética (ordenarInternador()): os textos com
+ * o mesmo prefixo têm ids consecutivos, e o intervalo sai de duas buscas
+ * binárias, em O(|prefixo| · log n). A comparação é a do strcmp e diferencia
+ * maiúsculas de minúsculas.
+ * @param internador O internador ordenado.
+ * @param prefixo O prefixo ("" abrange todos os textos).
+ * @param inicio Recebe o primeiro id do intervalo.
+ * @param fim Recebe o id seguinte ao último (igual a *inicio se nenhum texto tiver o prefixo).
+ */
+void internadorIntervaloPrefixo(const Internador *internador, const char *prefixo, uint32_t *inicio, uint32_t *fim);
+
+/**
+ * @brief Confere os deslocamentos e o índice de um internador lido de arquivo.
+ * @return 1 se for consistente, 0 caso contrário.
+ */
+int validarInternador(const Internador *internador);
+
+/**
+ * @brief Confere só o texto de um id: o cabeçalho de tamanho e o '\0' dentro do bloco.
+ *
+ * É a parte de validarInternador() que lê o texto; o mapa paginado
+ * (paginas.h) confere assim apenas as pistas das salas que carrega.
+ * @return 1 se o texto for consistente, 0 caso contrário (inclusive id fora do internador).
+ */
+int validarTextoInternador(const Internador *internador, uint32_t id);
+
+/**
+ * @brief Libera a memória do internador.
+ * @param internador O ponteiro para o internador.
+ */
+void liberarInternador(Internador *internador);
+
+#endif // INTERNADOR_H
@@ -0,0 +1,430 @@
+/**
+ * @file mapa.c
+ * @brief Implementação do mapa plano da mansão.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mapa.h"
+
+// --- Implementação do Mapa ---
+
+void mapaInicializar(Mapa *mapa) {
+    memset(mapa, 0, sizeof(Mapa));
+}
+
+/**
+ * @brief Garante espaço para mais uma sala, dobrando a capacidade quando necessário.
+ */
+static void mapaReservarSala(Mapa *mapa) {
+    if (mapa->totalSalas < mapa->capacidadeSalas) {
+        return;
+    }
+    uint32_t capacidade = mapa->capacidadeSalas > 0 ? mapa->capacidadeSalas * 2 : 16;
+    SalaPlana *salas = (SalaPlana*)realloc(mapa->salas, capacidade * sizeof(SalaPlana));
+    uint32_t *inicioAlvos = (uint32_t*)realloc(mapa->inicioAlvos, ((size_t)capacidade + 1) * sizeof(uint32_t));
+    uint32_t *inicioSaidas = (uint32_t*)realloc(mapa->inicioSaidas, ((size_t)capacidade + 1) * sizeof(uint32_t));
+    if (salas == NULL || inicioAlvos == NULL || inicioSaidas == NULL) {
+        printf("Erro de alocação de memória para o Mapa!\n");
+        exit(EXIT_FAILURE);
+    }
+    if (mapa->capacidadeSalas == 0) {
+        inicioAlvos[0] = 0;
+    }
+    mapa->salas = salas;
+    mapa->inicioAlvos = inicioAlvos;
+    mapa->inicioSaidas = inicioSaidas;
+    mapa->capacidadeSalas = capacidade;
+}
+
+void mapaReservar(Mapa *mapa, uint32_t salas, uint32_t saidas, uint32_t alvos, uint32_t tamanhoTextos) {
+    if (salas > mapa->capacidadeSalas) {
+        SalaPlana *vetorSalas = (SalaPlana*)realloc(mapa->salas, (size_t)salas * sizeof(SalaPlana));
+        uint32_t *inicioAlvos = (uint32_t*)realloc(mapa->inicioAlvos, ((size_t)salas + 1) * sizeof(uint32_t));
+        uint32_t *inicioSaidas = (uint32_t*)realloc(mapa->inicioSaidas, ((size_t)salas + 1) * sizeof(uint32_t));
+        if (vetorSalas == NULL || inicioAlvos == NULL || inicioSaidas == NULL) {
+            printf("Erro de alocação de memória para o Mapa!\n");
+            exit(EXIT_FAILURE);
+        }
+        if (mapa->capacidadeSalas == 0) {
+            inicioAlvos[0] = 0;
+        }
+        mapa->salas = vetorSalas;
+        mapa->inicioAlvos = inicioAlvos;
+        mapa->inicioSaidas = inicioSaidas;
+        mapa->capacidadeSalas = salas;
+    }
+    if (saidas > mapa->capacidadeSaidas) {
+        SaidaSala *vetorSaidas = (SaidaSala*)realloc(mapa->saidas, (size_t)saidas * sizeof(SaidaSala));
+        uint32_t *origens = (uint32_t*)realloc(mapa->origemSaidas, (size_t)saidas * sizeof(uint32_t));
+        if (vetorSaidas == NULL || origens == NULL) {
+            printf("Erro de alocação de memória para o Mapa!\n");
+            exit(EXIT_FAILURE);
+        }
+        mapa->saidas = vetorSaidas;
+        mapa->origemSaidas = origens;
+        mapa->capacidadeSaidas = saidas;
+    }
+    if (alvos > mapa->capacidadeAlvos) {
+        AlvoPeso *vetorAlvos = (AlvoPeso*)realloc(mapa->alvos, (size_t)alvos * sizeof(AlvoPeso));
+        if (vetorAlvos == NULL) {
+            printf("Erro de alocação de memória para o Mapa!\n");
+            exit(EXIT_FAILURE);
+        }
+        mapa->alvos = vetorAlvos;
+        mapa->capacidadeAlvos = alvos;
+    }
+    if (tamanhoTextos > mapa->capacidadeTextos) {
+        char *textos = (char*)realloc(mapa->textos, tamanhoTextos);
+        if (textos == NULL) {
+            printf("Erro de alocação de memória para o Mapa!\n");
+            exit(EXIT_FAILURE);
+        }
+        mapa->textos = textos;
+        mapa->capacidadeTextos = tamanhoTextos;
+    }
+}
+
+/**
+ * @brief Copia um texto para a tabela de strings do mapa.
+ * @param mapa O ponteiro para o mapa.
+ * @param texto O texto a copiar (NULL ou "" não ocupam espaço).
+ * @return O deslocamento do texto, ou MAPA_NENHUM para texto vazio.
+ */
+static uint32_t mapaAdicionarTexto(Mapa *mapa, const char *texto) {
+    if (texto == NULL || texto[0] == '\0') {
+        return MAPA_NENHUM;
+    }
+    uint32_t tamanho = (uint32_t)strlen(texto) + 1;
+    if (mapa->tamanhoTextos + tamanho > mapa->capacidadeTextos) {
+        uint32_t capacidade = mapa->capacidadeTextos > 0 ? mapa->capacidadeTextos : 256;
+        while (mapa->tamanhoTextos + tamanho > capacidade) {
+            capacidade *= 2;
+        }
+        char *textos = (char*)realloc(mapa->textos, capacidade);
+        if (textos == NULL) {
+            printf("Erro de alocação de memória para o Mapa!\n");
+            exit(EXIT_FAILURE);
+        }
+        mapa->textos = textos;
+        mapa->capacidadeTextos = capacidade;
+    }
+    uint32_t deslocamento = mapa->tamanhoTextos;
+    memcpy(mapa->textos + deslocamento, texto, tamanho);
+    mapa->tamanhoTextos += tamanho;
+    return deslocamento;
+}
+
+uint32_t criarSala(Mapa *mapa, const char *nomeSala, const char *conteudoPista, const char *alvo) {
+    mapaReservarSala(mapa);
+
+    uint32_t indice = mapa->totalSalas++;
+    SalaPlana *sala = &mapa->salas[indice];
+    sala->nome = mapaAdicionarTexto(mapa, nomeSala);
+    sala->pista = internar(&mapa->pistas, conteudoPista);
+    mapa->inicioAlvos[indice + 1] = mapa->totalAlvos;
+    mapaAdicionarAlvo(mapa, alvo, 1);
+    return indice;
+}
+
+void mapaAdicionarAlvo(Mapa *mapa, const char *alvo, uint32_t peso) {
+    uint32_t suspeito = internar(&mapa->suspeitos, alvo);
+    if (suspeito == TEXTO_NENHUM || peso == 0 || mapa->totalSalas == 0) {
+        return;
+    }
+    // Suspeito repetido na mesma sala: soma os pesos
+    uint32_t sala = mapa->totalSalas - 1;
+    for (uint32_t i = mapa->inicioAlvos[sala]; i < mapa->totalAlvos; i++) {
+        if (mapa->alvos[i].suspeito == suspeito) {
+            mapa->alvos[i].peso += peso;
+            return;
+        }
+    }
+    if (mapa->totalAlvos == mapa->capacidadeAlvos) {
+        uint32_t capacidade = mapa->capacidadeAlvos > 0 ? mapa->capacidadeAlvos * 2 : 16;
+        AlvoPeso *alvos = (AlvoPeso*)realloc(mapa->alvos, capacidade * sizeof(AlvoPeso));
+        if (alvos == NULL) {
+            printf("Erro de alocação de memória para o Mapa!\n");
+            exit(EXIT_FAILURE);
+        }
+        mapa->alvos = alvos;
+        mapa->capacidadeAlvos = capacidade;
+    }
+    AlvoPeso novo = { suspeito, peso };
+    mapa->alvos[mapa->totalAlvos++] = novo;
+    mapa->inicioAlvos[sala + 1] = mapa->totalAlvos;
+}
+
+void mapaAdicionarSaida(Mapa *mapa, uint32_t origem, uint32_t destino, const char *rotulo, char tecla) {
+    if (mapa->totalSaidas == mapa->capacidadeSaidas) {
+        uint32_t capacidade = mapa->capacidadeSaidas > 0 ? mapa->capacidadeSaidas * 2 : 16;
+        SaidaSala *saidas = (SaidaSala*)realloc(mapa->saidas, capacidade * sizeof(SaidaSala));
+        uint32_t *origens = (uint32_t*)realloc(mapa->origemSaidas, capacidade * sizeof(uint32_t));
+        if (saidas == NULL || origens == NULL) {
+            printf("Erro de alocação de memória para o Mapa!\n");
+            exit(EXIT_FAILURE);
+        }
+        mapa->saidas = saidas;
+        mapa->origemSaidas = origens;
+        mapa->capacidadeSaidas = capacidade;
+    }
+    SaidaSala nova = { destino, mapaAdicionarTexto(mapa, rotulo), (char)tolower((unsigned char)tecla), { 0, 0, 0 } };
+    mapa->origemSaidas[mapa->totalSaidas] = origem;
+    mapa->saidas[mapa->totalSaidas++] = nova;
+}
+
+void ligarSalas(Mapa *mapa, uint32_t sala, uint32_t esquerda, uint32_t direita) {
+    if (esquerda != MAPA_NENHUM) {
+        mapaAdicionarSaida(mapa, sala, esquerda, NULL, 'e');
+    }
+    if (direita != MAPA_NENHUM) {
+        mapaAdicionarSaida(mapa, sala, direita, NULL, 'd');
+    }
+}
+
+/**
+ * @brief Dá às saídas sem tecla o primeiro algarismo ainda livre na sala.
+ */
+static void mapaNumerarSaidas(Mapa *mapa) {
+    for (uint32_t sala = 0; sala < mapa->totalSalas; sala++) {
+        SaidaSala *saidas = mapa->saidas + mapa->inicioSaidas[sala];
+        uint32_t total = mapa->inicioSaidas[sala + 1] - mapa->inicioSaidas[sala];
+        const char *algarismo = "123456789";
+        for (uint32_t i = 0; i < total; i++) {
+            if (saidas[i].tecla != '\0') {
+                continue;
+            }
+            while (*algarismo != '\0' && mapaProcurarSaida(mapa, sala, *algarismo) != MAPA_NENHUM) {
+                algarismo++;
+            }
+            if (*algarismo != '\0') {
+                saidas[i].tecla = *algarismo++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Ordena as saídas por sala de origem (contagem estável) e preenche inicioSaidas.
+ *
+ * As saídas sem tecla recebem o primeiro algarismo ainda livre na sala.
+ */
+static void mapaOrdenarSaidas(Mapa *mapa) {
+    if (mapa->totalSalas == 0) {
+        return;
+    }
+    uint32_t *inicio = mapa->inicioSaidas;
+    memset(inicio, 0, ((size_t)mapa->totalSalas + 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < mapa->totalSaidas; i++) {
+        inicio[mapa->origemSaidas[i] + 1]++;
+    }
+    for (uint32_t sala = 0; sala < mapa->totalSalas; sala++) {
+        inicio[sala + 1] += inicio[sala];
+    }
+
+    // Saídas criadas em ordem de sala (mapas gerados) já estão no lugar
+    uint32_t emOrdem = 1;
+    while (emOrdem < mapa->totalSaidas && mapa->origemSaidas[emOrdem - 1] <= mapa->origemSaidas[emOrdem]) {
+        emOrdem++;
+    }
+    if (mapa->totalSaidas == 0 || emOrdem >= mapa->totalSaidas) {
+        free(mapa->origemSaidas);
+        mapa->origemSaidas = NULL;
+        mapaNumerarSaidas(mapa);
+        return;
+    }
+
+    SaidaSala *ordenadas = (SaidaSala*)malloc(((size_t)mapa->totalSaidas + 1) * sizeof(SaidaSala));
+    uint32_t *proxima = (uint32_t*)malloc((size_t)mapa->totalSalas * sizeof(uint32_t));
+    if (ordenadas == NULL || proxima == NULL) {
+        printf("Erro de alocação de memória para o Mapa!\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(proxima, inicio, (size_t)mapa->totalSalas * sizeof(uint32_t));
+    for (uint32_t i = 0; i < mapa->totalSaidas; i++) {
+        ordenadas[proxima[mapa->origemSaidas[i]]++] = mapa->saidas[i];
+    }
+    free(proxima);
+    free(mapa->saidas);
+    free(mapa->origemSaidas);
+    mapa->saidas = ordenadas;
+    mapa->origemSaidas = NULL;
+    mapa->capacidadeSaidas = mapa->totalSaidas;
+    mapaNumerarSaidas(mapa);
+}
+
+void mapaFinalizar(Mapa *mapa) {
+    uint32_t *novoId = (uint32_t*)malloc((mapa->pistas.total + 1) * sizeof(uint32_t));
+    if (novoId == NULL) {
+        printf("Erro de alocação de memória para o Mapa!\n");
+        exit(EXIT_FAILURE);
+    }
+    ordenarInternador(&mapa->pistas, novoId);
+    for (uint32_t i = 0; i < mapa->totalSalas; i++) {
+        SalaPlana *sala = &mapa->salas[i];
+        if (sala->pista != TEXTO_NENHUM) {
+            sala->pista = novoId[sala->pista];
+        }
+    }
+    free(novoId);
+    mapaOrdenarSaidas(mapa);
+    mapa->somaVerificacao = mapaCalcularSoma(mapa);
+}
+
+uint32_t mapaProcurarSaida(const Mapa *mapa, uint32_t sala, char tecla) {
+    char minuscula = (char)tolower((unsigned char)tecla);
+    if (minuscula == '\0') {
+        return MAPA_NENHUM;
+    }
+    const SaidaSala *saidas = mapaSaidas(mapa, sala);
+    uint32_t total = mapaTotalSaidas(mapa, sala);
+    for (uint32_t i = 0; i < total; i++) {
+        if (saidas[i].tecla == minuscula) {
+            return i;
+        }
+    }
+    return MAPA_NENHUM;
+}
+
+void liberarMapa(Mapa *mapa) {
+    if (mapa->mapeamento != NULL) {
+        return;
+    }
+    free(mapa->salas);
+    free(mapa->inicioAlvos);
+    free(mapa->alvos);
+    free(mapa->inicioSaidas);
+    free(mapa->saidas);
+    free(mapa->origemSaidas);
+    free(mapa->textos);
+    liberarInternador(&mapa->pistas);
+    liberarInternador(&mapa->suspeitos);
+    mapaInicializar(mapa);
+}
+
+// --- Validação ---
+
+/**
+ * @brief Acrescenta um vetor à soma, em quatro faixas de 8 bytes independentes, terminando com o seu tamanho.
+ *
+ * Cada passo de faixa é um XOR, uma multiplicação e um deslocamento, como em
+ * esparsoMisturar() (filtro.h); as faixas não dependem uma da outra e o
+ * processador as adianta juntas. Não é uma soma criptográfica: só distingue
+ * conteúdos diferentes sem custar muito mais que a leitura da memória.
+ */
+static uint64_t mapaMisturarBytes(uint64_t soma, const void *dados, uint64_t tamanho) {
+    const unsigned char *bytes = (const unsigned char*)dados;
+    uint64_t faixas[4] = { soma, soma ^ 1, soma ^ 2, soma ^ 3 };
+    uint64_t palavras[4];
+    uint64_t i = 0;
+    for (; i + sizeof(palavras) <= tamanho; i += sizeof(palavras)) {
+        memcpy(palavras, bytes + i, sizeof(palavras));
+        for (int f = 0; f < 4; f++) {
+            faixas[f] = (faixas[f] ^ palavras[f]) * UINT64_C(0x9E3779B97F4A7C15);
+            faixas[f] ^= faixas[f] >> 29;
+        }
+    }
+    // O resto (menos de 32 bytes) completa as faixas com zeros
+    memset(palavras, 0, sizeof(palavras));
+    if (i < tamanho) {
+        memcpy(palavras, bytes + i, (size_t)(tamanho - i));
+    }
+    soma = tamanho;
+    for (int f = 0; f < 4; f++) {
+        soma = (soma ^ faixas[f] ^ palavras[f]) * UINT64_C(0x9E3779B97F4A7C15);
+        soma ^= soma >> 29;
+    }
+    return soma;
+}
+
+uint64_t mapaCalcularSoma(const Mapa *mapa) {
+    uint64_t limites = mapa->totalSalas > 0 ? ((uint64_t)mapa->totalSalas + 1) * sizeof(uint32_t) : 0;
+    uint64_t soma = mapaMisturarBytes(0, &mapa->raiz, sizeof(mapa->raiz));
+    soma = mapaMisturarBytes(soma, mapa->salas, (uint64_t)mapa->totalSalas * sizeof(SalaPlana));
+    soma = mapaMisturarBytes(soma, mapa->inicioAlvos, limites);
+    soma = mapaMisturarBytes(soma, mapa->alvos, (uint64_t)mapa->totalAlvos * sizeof(AlvoPeso));
+    soma = mapaMisturarBytes(soma, mapa->inicioSaidas, limites);
+    soma = mapaMisturarBytes(soma, mapa->saidas, (uint64_t)mapa->totalSaidas * sizeof(SaidaSala));
+    soma = mapaMisturarBytes(soma, mapa->textos, mapa->tamanhoTextos);
+    soma = mapaMisturarBytes(soma, mapa->pistas.textos, mapa->pistas.tamanhoTextos);
+    soma = mapaMisturarBytes(soma, mapa->suspeitos.textos, mapa->suspeitos.tamanhoTextos);
+    // Finalizador do MurmurHash3: os últimos bytes também alcançam os bits baixos
+    soma ^= soma >> 33;
+    soma *= UINT64_C(0xff51afd7ed558ccd);
+    soma ^= soma >> 33;
+    return soma;
+}
+
+int mapaValidarEstrutura(const Mapa *mapa) {
+    if (mapa->tamanhoTextos > 0 && mapa->textos[mapa->tamanhoTextos - 1] != '\0') {
+        return 0;
+    }
+    if (!validarInternador(&mapa->suspeitos)) {
+        return 0;
+    }
+    if (mapa->pistas.tamanhoTextos > 0 && mapa->pistas.textos[mapa->pistas.tamanhoTextos - 1] != '\0') {
+        return 0;
+    }
+    if (mapa->totalSalas > 0 && mapa->raiz >= mapa->totalSalas) {
+        return 0;
+    }
+    if (mapa->totalSalas > 0 &&
+        (mapa->inicioAlvos[0] != 0 || mapa->inicioAlvos[mapa->totalSalas] != mapa->totalAlvos ||
+         mapa->inicioSaidas[0] != 0 || mapa->inicioSaidas[mapa->totalSalas] != mapa->totalSaidas)) {
+        return 0;
+    }
+    return 1;
+}
+
+int mapaValidarSalas(const Mapa *mapa, uint32_t inicio, uint32_t fim) {
+    for (uint32_t i = inicio; i < fim; i++) {
+        const SalaPlana *sala = &mapa->salas[i];
+        if ((sala->nome != MAPA_NENHUM && sala->nome >= mapa->tamanhoTextos) ||
+            (sala->pista != TEXTO_NENHUM && sala->pista >= mapa->pistas.total) ||
+            mapa->inicioAlvos[i] > mapa->inicioAlvos[i + 1] || mapa->inicioAlvos[i + 1] > mapa->totalAlvos ||
+            mapa->inicioSaidas[i] > mapa->inicioSaidas[i + 1] || mapa->inicioSaidas[i + 1] > mapa->totalSaidas) {
+            return 0;
+        }
+    }
+    for (uint32_t i = inicio; i < fim; i++) {
+        // Teclas distintas dentro da sala; 's' fica reservada para sair
+        const SaidaSala *saidas = mapa->saidas + mapa->inicioSaidas[i];
+        uint32_t total = mapa->inicioSaidas[i + 1] - mapa->inicioSaidas[i];
+        uint64_t usadas[4] = { 0, 0, 0, 0 };
+        for (uint32_t j = 0; j < total; j++) {
+            unsigned char tecla = (unsigned char)saidas[j].tecla;
+            if (saidas[j].destino >= mapa->totalSalas ||
+                (saidas[j].rotulo != MAPA_NENHUM && saidas[j].rotulo >= mapa->tamanhoTextos) ||
+                tecla == 's' || tecla != (unsigned char)tolower(tecla) ||
+                (usadas[tecla / 64] >> (tecla % 64)) & 1) {
+                return 0;
+            }
+            if (tecla != '\0') {
+                usadas[tecla / 64] |= UINT64_C(1) << (tecla % 64);
+            }
+        }
+    }
+    if (fim > inicio) {
+        for (uint32_t i = mapa->inicioAlvos[inicio]; i < mapa->inicioAlvos[fim]; i++) {
+            if (mapa->alvos[i].suspeito >= mapa->suspeitos.total) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int mapaValidar(const Mapa *mapa) {
+    if (!mapaValidarEstrutura(mapa) || !validarInternador(&mapa->pistas)) {
+        return 0;
+    }
+    for (uint32_t id = 1; id < mapa->pistas.total; id++) {
+        if (strcmp(textoDoId(&mapa->pistas, id - 1), textoDoId(&mapa->pistas, id)) >= 0) {
+            return 0;
+        }
+    }
+    return mapaValidarSalas(mapa, 0, mapa->totalSalas);
+}
@@ -0,0 +1,289 @@
+/**
+ * @file mapa.h
+ * @brief Representação plana (baseada em índices) do mapa da mansão.
+ *
+ * As salas ficam em um vetor contíguo de SalaPlana. Os nomes das salas ficam em
+ * uma tabela de strings separada; pistas e suspeitos são internados
+ * (internador.h), de modo que cada texto distinto é guardado uma vez e as salas
+ * carregam apenas identificadores.
+ * As passagens entre salas formam um grafo dirigido em formato CSR: as saídas
+ * de todas as salas ficam em um único vetor, em ordem de sala, e
+ * inicioSaidas[sala] .. inicioSaidas[sala + 1] delimita as da sala. Uma sala
+ * pode ter qualquer número de saídas, e o grafo pode ter ciclos (uma porta de
+ * volta para o hall). Cada saída tem uma tecla; ligarSalas() cria as saídas
+ * 'e' (esquerda) e 'd' (direita) das mansões binárias, e as saídas sem tecla
+ * recebem os algarismos livres da sala em mapaFinalizar().
+ * Uma pista pode incriminar vários suspeitos, cada um com um peso: os pares
+ * (suspeito, peso) de todas as salas ficam em um único vetor esparso, em ordem
+ * de sala, e inicioAlvos[sala] .. inicioAlvos[sala + 1] delimita os da sala.
+ * criarSala(), ligarSalas() e mapaAdicionarSaida() servem de construtor
+ * incremental sobre os vetores, e mapaFinalizar() deve ser chamado depois da
+ * última sala: é ele que ordena as saídas por sala (de graça, se já foram
+ * criadas em ordem de sala, como faz o gerador de gerador.h), e que fixa a
+ * soma de verificação do conteúdo (mapaCalcularSoma()).
+ * A gravação e a leitura em arquivo ficam em mapa_arquivo.h.
+ */
+
+#ifndef MAPA_H
+#define MAPA_H
+
+#include <stdint.h>
+
+#include "internador.h"
+
+// --- Constantes do Mapa ---
+#define MAPA_NENHUM UINT32_MAX // Índice de sala ou de texto inexistente
+
+// --- Estruturas ---
+
+// Um suspeito incriminado pela pista de uma sala, com o peso da acusação
+typedef struct AlvoPeso {
+    uint32_t suspeito; // Id do suspeito no internador de suspeitos
+    uint32_t peso;     // Pontos somados ao suspeito quando a pista é coletada
+} AlvoPeso;
+
+// Uma passagem de uma sala para outra
+typedef struct SaidaSala {
+    uint32_t destino;    // Índice da sala de destino
+    uint32_t rotulo;     // Deslocamento do rótulo na tabela de strings (MAPA_NENHUM: rótulo da tecla)
+    char tecla;          // Tecla minúscula que escolhe a saída ('\0': só pelo índice)
+    char reservado[3];   // Sempre zero, para que o arquivo gravado seja determinístico
+} SaidaSala;
+
+typedef struct SalaPlana {
+    uint32_t nome;     // Deslocamento do nome na tabela de strings
+    uint32_t pista;    // Id da pista (TEXTO_NENHUM se não houver)
+} SalaPlana;
+
+typedef struct Mapa {
+    SalaPlana *salas;
+    uint32_t *inicioAlvos;     // Por sala: início dos seus pares em alvos (totalSalas + 1 posições)
+    AlvoPeso *alvos;           // Suspeitos incriminados pela pista de cada sala (campo frio)
+    uint32_t totalAlvos;
+    uint32_t capacidadeAlvos;
+    uint32_t *inicioSaidas;    // Por sala: início das suas saídas em saidas (totalSalas + 1 posições)
+    SaidaSala *saidas;         // Saídas de todas as salas, em ordem de sala após mapaFinalizar()
+    uint32_t *origemSaidas;    // Só durante a construção: sala de origem de cada saída
+    uint32_t totalSaidas;
+    uint32_t capacidadeSaidas;
+    uint32_t totalSalas;
+    uint32_t capacidadeSalas;
+    char *textos;              // Nomes das salas, terminados em '\0'
+    uint32_t tamanhoTextos;
+    uint32_t capacidadeTextos;
+    Internador pistas;         // Ids em ordem alfabética após mapaFinalizar()
+    Internador suspeitos;
+    uint32_t raiz;             // Sala inicial (a primeira criada, por padrão)
+    uint64_t somaVerificacao;  // mapaCalcularSoma() do conteúdo, fixada em mapaFinalizar(); identifica o mapa nos retratos
+    void *mapeamento;          // Não NULL quando os vetores apontam para um arquivo mapeado (ou imagem embutida)
+    size_t tamanhoMapeamento;  // 0 para uma imagem embutida, que não é desfeita
+    struct PaginasMapa *paginas; // Não NULL: salas validadas e mantidas residentes por página (paginas.h)
+} Mapa;
+
+// --- Funções do Mapa ---
+
+/**
+ * @brief Inicializa um mapa vazio.
+ * @param mapa O ponteiro para o mapa.
+ */
+void mapaInicializar(Mapa *mapa);
+
+/**
+ * @brief Reserva de uma vez o espaço dos vetores, quando os totais são conhecidos antes.
+ *
+ * Criar até essa quantidade de salas, saídas, alvos e bytes de nomes e rótulos
+ * (com os '\0') não realoca. Os internadores de pistas e de suspeitos são
+ * reservados à parte, com reservarInternador().
+ * @param mapa O ponteiro para o mapa.
+ */
+void mapaReservar(Mapa *mapa, uint32_t salas, uint32_t saidas, uint32_t alvos, uint32_t tamanhoTextos);
+
+/**
+ * @brief Obtém um texto da tabela de strings.
+ * @param mapa O ponteiro para o mapa.
+ * @param deslocamento O deslocamento retornado por mapaAdicionarTexto().
+ * @return O texto, ou "" quando o deslocamento é MAPA_NENHUM.
+ */
+static inline const char *mapaTexto(const Mapa *mapa, uint32_t deslocamento) {
+    return deslocamento == MAPA_NENHUM ? "" : mapa->textos + deslocamento;
+}
+
+/**
+ * @brief Cria um cômodo no mapa, ainda sem caminhos.
+ * @param mapa O ponteiro para o mapa.
+ * @param nomeSala O nome do cômodo.
+ * @param conteudoPista O texto da pista associada ("" se não houver).
+ * @param alvo O nome do suspeito incriminado pela pista, com peso 1 ("" se não houver).
+ *             Pista e suspeito repetidos reaproveitam o mesmo identificador.
+ * @return O índice da nova sala.
+ */
+uint32_t criarSala(Mapa *mapa, const char *nomeSala, const char *conteudoPista, const char *alvo);
+
+/**
+ * @brief Acrescenta um suspeito incriminado pela pista da última sala criada.
+ *
+ * Os pares de cada sala ficam contíguos, por isso só a sala mais recente pode
+ * receber novos alvos. Um suspeito repetido na mesma sala tem os pesos somados.
+ * @param mapa O ponteiro para o mapa.
+ * @param alvo O nome do suspeito ("" é ignorado).
+ * @param peso O peso da acusação (0 é ignorado).
+ */
+void mapaAdicionarAlvo(Mapa *mapa, const char *alvo, uint32_t peso);
+
+/**
+ * @brief Acrescenta uma saída de uma sala para outra.
+ *
+ * As saídas podem ser criadas em qualquer ordem e apontar para qualquer sala,
+ * inclusive para trás; as de uma mesma sala mantêm a ordem de criação.
+ * @param mapa O ponteiro para o mapa.
+ * @param origem O índice da sala de origem.
+ * @param destino O índice da sala de destino.
+ * @param rotulo O texto mostrado ao jogador ("" ou NULL: rótulo da tecla).
+ * @param tecla A tecla que escolhe a saída (maiúsculas viram minúsculas; '\0':
+ *              o primeiro algarismo livre da sala, atribuído em mapaFinalizar()).
+ */
+void mapaAdicionarSaida(Mapa *mapa, uint32_t origem, uint32_t destino, const char *rotulo, char tecla);
+
+/**
+ * @brief Define os caminhos binários de uma sala: as saídas 'e' e 'd'.
+ * @param mapa O ponteiro para o mapa.
+ * @param sala O índice da sala de origem.
+ * @param esquerda O índice da sala à esquerda (MAPA_NENHUM para nenhuma).
+ * @param direita O índice da sala à direita (MAPA_NENHUM para nenhuma).
+ */
+void ligarSalas(Mapa *mapa, uint32_t sala, uint32_t esquerda, uint32_t direita);
+
+/**
+ * @brief Renumera as pistas em ordem alfabética e monta o vetor de saídas por sala.
+ *
+ * Com isso, a árvore de pistas (pistas.h) ordena comparando ids. Deve ser
+ * chamado uma vez, depois de criada a última sala e antes de explorar ou gravar;
+ * por último, guarda mapaCalcularSoma() em mapa->somaVerificacao.
+ * @param mapa O ponteiro para o mapa.
+ */
+void mapaFinalizar(Mapa *mapa);
+
+/**
+ * @brief Nome de uma sala.
+ */
+static inline const char *mapaNomeSala(const Mapa *mapa, uint32_t sala) {
+    return mapaTexto(mapa, mapa->salas[sala].nome);
+}
+
+/**
+ * @brief Texto da pista de uma sala ("" se não houver).
+ */
+static inline const char *mapaPistaSala(const Mapa *mapa, uint32_t sala) {
+    return textoDoId(&mapa->pistas, mapa->salas[sala].pista);
+}
+
+/**
+ * @brief Quantidade de suspeitos incriminados pela pista de uma sala.
+ */
+static inline uint32_t mapaTotalAlvos(const Mapa *mapa, uint32_t sala) {
+    return mapa->inicioAlvos[sala + 1] - mapa->inicioAlvos[sala];
+}
+
+/**
+ * @brief Pares (suspeito, peso) da pista de uma sala; são mapaTotalAlvos() pares.
+ */
+static inline const AlvoPeso *mapaAlvos(const Mapa *mapa, uint32_t sala) {
+    return mapa->alvos + mapa->inicioAlvos[sala];
+}
+
+/**
+ * @brief Nome do primeiro suspeito incriminado pela pista de uma sala ("" se não houver).
+ */
+static inline const char *mapaAlvoSala(const Mapa *mapa, uint32_t sala) {
+    return mapaTotalAlvos(mapa, sala) > 0 ? textoDoId(&mapa->suspeitos, mapaAlvos(mapa, sala)->suspeito) : "";
+}
+
+/**
+ * @brief Quantidade de saídas de uma sala.
+ */
+static inline uint32_t mapaTotalSaidas(const Mapa *mapa, uint32_t sala) {
+    return mapa->inicioSaidas[sala + 1] - mapa->inicioSaidas[sala];
+}
+
+/**
+ * @brief Saídas de uma sala, na ordem de criação; são mapaTotalSaidas() saídas.
+ */
+static inline const SaidaSala *mapaSaidas(const Mapa *mapa, uint32_t sala) {
+    return mapa->saidas + mapa->inicioSaidas[sala];
+}
+
+/**
+ * @brief Texto de uma saída: o rótulo próprio ou, sem ele, o da tecla.
+ */
+static inline const char *mapaRotuloSaida(const Mapa *mapa, const SaidaSala *saida) {
+    if (saida->rotulo != MAPA_NENHUM) {
+        return mapa->textos + saida->rotulo;
+    }
+    return saida->tecla == 'e' ? "Esquerda" : saida->tecla == 'd' ? "Direita" : "Passagem";
+}
+
+/**
+ * @brief Indica se a tecla é uma das direções de ligarSalas() ('e' ou 'd', maiúsculas aceitas).
+ *
+ * Sem saída, essas teclas indicam um caminho bloqueado, e não uma opção inválida.
+ */
+static inline int mapaTeclaDirecao(char tecla) {
+    return tecla == 'e' || tecla == 'E' || tecla == 'd' || tecla == 'D';
+}
+
+/**
+ * @brief Procura a saída de uma sala escolhida por uma tecla (maiúsculas aceitas).
+ * @return A posição da saída entre as da sala, ou MAPA_NENHUM se nenhuma usar a tecla.
+ */
+uint32_t mapaProcurarSaida(const Mapa *mapa, uint32_t sala, char tecla);
+
+/**
+ * @brief Libera os vetores do mapa e os internadores. Não há percurso pelas salas.
+ *
+ * Mapas abertos com abrirMapaArquivo() devem ser fechados com fecharMapaArquivo().
+ * @param mapa O ponteiro para o mapa.
+ */
+void liberarMapa(Mapa *mapa);
+
+// --- Validação ---
+
+/**
+ * @brief Soma de verificação (64 bits) das salas, dos alvos, das saídas, da raiz e das tabelas de texto.
+ *
+ * Dois mapas com o mesmo conteúdo têm a mesma soma, calculada sobre os mesmos
+ * bytes que mapaSalvar() grava; um retrato (retrato.h) a guarda para recusar
+ * outro mapa com as mesmas contagens. Percorre todos os vetores, a alguns GB/s.
+ * @param mapa O ponteiro para o mapa (finalizado).
+ * @return A soma.
+ */
+uint64_t mapaCalcularSoma(const Mapa *mapa);
+
+/**
+ * @brief Confere se todos os índices, deslocamentos e ids do mapa apontam para dentro dos vetores.
+ *
+ * Também exige que os ids das pistas estejam em ordem alfabética e que as
+ * teclas das saídas de cada sala sejam distintas (mapaFinalizar()).
+ * @param mapa O ponteiro para o mapa.
+ * @return 1 se o mapa for consistente, 0 caso contrário.
+ */
+int mapaValidar(const Mapa *mapa);
+
+/**
+ * @brief A parte de mapaValidar() de custo constante: sentinelas, raiz, textos e o internador de suspeitos.
+ *
+ * Não lê salas nem pistas; o mapa paginado (paginas.h) confere cada página de
+ * salas com mapaValidarSalas() quando ela é carregada.
+ * @return 1 se o mapa for consistente, 0 caso contrário.
+ */
+int mapaValidarEstrutura(const Mapa *mapa);
+
+/**
+ * @brief Confere as salas de `inicio` a `fim` - 1, com as suas saídas e os seus alvos.
+ *
+ * Os textos das pistas e os nomes das salas vizinhas não são lidos (ver validarTextoInternador()).
+ * Pressupõe mapaValidarEstrutura().
+ * @return 1 se as salas forem consistentes, 0 caso contrário.
+ */
+int mapaValidarSalas(const Mapa *mapa, uint32_t inicio, uint32_t fim);
+
+#endif // MAPA_H
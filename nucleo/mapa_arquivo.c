@@ -0,0 +1,215 @@
+/**
+ * @file mapa_arquivo.c
+ * @brief Gravação e carregamento (mmap) de mapas .dqm.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapa_arquivo.h"
+#include "paginas.h"
+
+// --- Gravação ---
+
+/**
+ * @brief Arredonda um deslocamento para o próximo múltiplo de MAPA_ARQUIVO_ALINHAMENTO.
+ */
+static uint64_t mapaArquivoAlinhar(uint64_t deslocamento) {
+    return (deslocamento + MAPA_ARQUIVO_ALINHAMENTO - 1) & ~(uint64_t)(MAPA_ARQUIVO_ALINHAMENTO - 1);
+}
+
+/**
+ * @brief Escreve bytes nulos até que o arquivo alcance o deslocamento pedido.
+ */
+static int mapaArquivoPreencher(FILE *arquivo, uint64_t *posicao, uint64_t destino) {
+    static const char zeros[MAPA_ARQUIVO_ALINHAMENTO];
+    size_t faltam = (size_t)(destino - *posicao);
+    if (faltam > 0 && fwrite(zeros, 1, faltam, arquivo) != faltam) {
+        return -1;
+    }
+    *posicao = destino;
+    return 0;
+}
+
+int mapaSalvar(const Mapa *mapa, FILE *arquivo) {
+    const void *dados[MAPA_TOTAL_SECOES] = {
+        mapa->salas, mapa->inicioAlvos, mapa->alvos, mapa->inicioSaidas, mapa->saidas, mapa->textos,
+        mapa->pistas.textos, mapa->pistas.deslocamentos, mapa->pistas.posicoes,
+        mapa->suspeitos.textos, mapa->suspeitos.deslocamentos, mapa->suspeitos.posicoes,
+    };
+    const uint64_t tamanhos[MAPA_TOTAL_SECOES] = {
+        (uint64_t)mapa->totalSalas * sizeof(SalaPlana),
+        mapa->totalSalas > 0 ? ((uint64_t)mapa->totalSalas + 1) * sizeof(uint32_t) : 0,
+        (uint64_t)mapa->totalAlvos * sizeof(AlvoPeso),
+        mapa->totalSalas > 0 ? ((uint64_t)mapa->totalSalas + 1) * sizeof(uint32_t) : 0,
+        (uint64_t)mapa->totalSaidas * sizeof(SaidaSala),
+        mapa->tamanhoTextos,
+        mapa->pistas.tamanhoTextos,
+        (uint64_t)mapa->pistas.total * sizeof(uint32_t),
+        (uint64_t)mapa->pistas.capacidade * sizeof(InternadorPosicao),
+        mapa->suspeitos.tamanhoTextos,
+        (uint64_t)mapa->suspeitos.total * sizeof(uint32_t),
+        (uint64_t)mapa->suspeitos.capacidade * sizeof(InternadorPosicao),
+    };
+
+    MapaCabecalho cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magico, MAPA_ARQUIVO_MAGICO, sizeof(cabecalho.magico));
+    cabecalho.ordemBytes = MAPA_ARQUIVO_ORDEM_BYTES;
+    cabecalho.raiz = mapa->raiz;
+    cabecalho.somaVerificacao = mapa->somaVerificacao;
+    uint64_t fim = sizeof(MapaCabecalho);
+    for (int i = 0; i < MAPA_TOTAL_SECOES; i++) {
+        cabecalho.secoes[i].inicio = mapaArquivoAlinhar(fim);
+        cabecalho.secoes[i].tamanho = tamanhos[i];
+        fim = cabecalho.secoes[i].inicio + tamanhos[i];
+    }
+
+    uint64_t posicao = sizeof(cabecalho);
+    if (fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1) {
+        return -1;
+    }
+    for (int i = 0; i < MAPA_TOTAL_SECOES; i++) {
+        size_t tamanho = (size_t)tamanhos[i];
+        if (mapaArquivoPreencher(arquivo, &posicao, cabecalho.secoes[i].inicio) != 0 ||
+            (tamanho > 0 && fwrite(dados[i], 1, tamanho, arquivo) != tamanho)) {
+            return -1;
+        }
+        posicao += tamanho;
+    }
+    return 0;
+}
+
+// --- Carregamento ---
+
+/**
+ * @brief Aponta um internador para as três seções que o compõem no arquivo.
+ * @return 0 se os tamanhos forem coerentes, -1 caso contrário.
+ */
+static int mapaArquivoInternador(Internador *internador, unsigned char *bytes, const MapaSecao *secoes) {
+    const MapaSecao *textos = &secoes[0];
+    const MapaSecao *deslocamentos = &secoes[1];
+    const MapaSecao *posicoes = &secoes[2];
+    if (textos->tamanho > UINT32_MAX ||
+        deslocamentos->tamanho % sizeof(uint32_t) != 0 ||
+        deslocamentos->tamanho / sizeof(uint32_t) >= TEXTO_NENHUM ||
+        posicoes->tamanho % sizeof(InternadorPosicao) != 0 ||
+        posicoes->tamanho / sizeof(InternadorPosicao) > UINT32_MAX) {
+        return -1;
+    }
+    internador->textos = (char*)(bytes + textos->inicio);
+    internador->tamanhoTextos = internador->capacidadeTextos = (uint32_t)textos->tamanho;
+    internador->deslocamentos = (uint32_t*)(bytes + deslocamentos->inicio);
+    internador->total = internador->capacidadeIds = (uint32_t)(deslocamentos->tamanho / sizeof(uint32_t));
+    internador->posicoes = (InternadorPosicao*)(bytes + posicoes->inicio);
+    internador->capacidade = (uint32_t)(posicoes->tamanho / sizeof(InternadorPosicao));
+    return 0;
+}
+
+/**
+ * @brief Confere o cabeçalho e os limites de cada seção de uma imagem .dqm (custo constante)
+ *        e aponta os vetores do Mapa para ela.
+ * @return 0 em caso de sucesso, -1 se a imagem for inválida (o mapa fica vazio).
+ */
+static int mapaArquivoApontar(Mapa *mapa, unsigned char *bytes, size_t tamanho) {
+    if (tamanho < sizeof(MapaCabecalho)) {
+        return -1;
+    }
+    const MapaCabecalho *cabecalho = (const MapaCabecalho*)bytes;
+    const MapaSecao *secoes = cabecalho->secoes;
+    int valido = memcmp(cabecalho->magico, MAPA_ARQUIVO_MAGICO, sizeof(cabecalho->magico)) == 0 &&
+                 cabecalho->ordemBytes == MAPA_ARQUIVO_ORDEM_BYTES;
+    for (int i = 0; valido && i < MAPA_TOTAL_SECOES; i++) {
+        valido = secoes[i].inicio % MAPA_ARQUIVO_ALINHAMENTO == 0 &&
+                 secoes[i].inicio <= tamanho && secoes[i].tamanho <= tamanho - secoes[i].inicio;
+    }
+    uint64_t totalSalas = valido ? secoes[MAPA_SECAO_SALAS].tamanho / sizeof(SalaPlana) : 0;
+    valido = valido &&
+             secoes[MAPA_SECAO_SALAS].tamanho % sizeof(SalaPlana) == 0 && totalSalas <= UINT32_MAX &&
+             secoes[MAPA_SECAO_INICIO_ALVOS].tamanho == (totalSalas > 0 ? (totalSalas + 1) * sizeof(uint32_t) : 0) &&
+             secoes[MAPA_SECAO_ALVOS].tamanho % sizeof(AlvoPeso) == 0 &&
+             secoes[MAPA_SECAO_ALVOS].tamanho / sizeof(AlvoPeso) <= UINT32_MAX &&
+             secoes[MAPA_SECAO_INICIO_SAIDAS].tamanho == secoes[MAPA_SECAO_INICIO_ALVOS].tamanho &&
+             secoes[MAPA_SECAO_SAIDAS].tamanho % sizeof(SaidaSala) == 0 &&
+             secoes[MAPA_SECAO_SAIDAS].tamanho / sizeof(SaidaSala) <= UINT32_MAX &&
+             secoes[MAPA_SECAO_NOMES].tamanho <= UINT32_MAX &&
+             mapaArquivoInternador(&mapa->pistas, bytes, &secoes[MAPA_SECAO_PISTAS_TEXTOS]) == 0 &&
+             mapaArquivoInternador(&mapa->suspeitos, bytes, &secoes[MAPA_SECAO_SUSPEITOS_TEXTOS]) == 0;
+    // Os textos precisam terminar em '\0' para que nenhuma leitura saia da seção
+    static const int secoesTexto[] = { MAPA_SECAO_NOMES, MAPA_SECAO_PISTAS_TEXTOS, MAPA_SECAO_SUSPEITOS_TEXTOS };
+    for (int i = 0; valido && i < 3; i++) {
+        const MapaSecao *secao = &secoes[secoesTexto[i]];
+        valido = secao->tamanho == 0 || bytes[secao->inicio + secao->tamanho - 1] == '\0';
+    }
+    if (!valido) {
+        mapaInicializar(mapa);
+        return -1;
+    }
+
+    mapa->salas = (SalaPlana*)(bytes + secoes[MAPA_SECAO_SALAS].inicio);
+    mapa->inicioAlvos = (uint32_t*)(bytes + secoes[MAPA_SECAO_INICIO_ALVOS].inicio);
+    mapa->alvos = (AlvoPeso*)(bytes + secoes[MAPA_SECAO_ALVOS].inicio);
+    mapa->totalAlvos = mapa->capacidadeAlvos = (uint32_t)(secoes[MAPA_SECAO_ALVOS].tamanho / sizeof(AlvoPeso));
+    mapa->inicioSaidas = (uint32_t*)(bytes + secoes[MAPA_SECAO_INICIO_SAIDAS].inicio);
+    mapa->saidas = (SaidaSala*)(bytes + secoes[MAPA_SECAO_SAIDAS].inicio);
+    mapa->totalSaidas = mapa->capacidadeSaidas = (uint32_t)(secoes[MAPA_SECAO_SAIDAS].tamanho / sizeof(SaidaSala));
+    mapa->textos = (char*)(bytes + secoes[MAPA_SECAO_NOMES].inicio);
+    mapa->totalSalas = mapa->capacidadeSalas = (uint32_t)totalSalas;
+    mapa->tamanhoTextos = mapa->capacidadeTextos = (uint32_t)secoes[MAPA_SECAO_NOMES].tamanho;
+    mapa->raiz = cabecalho->raiz;
+    mapa->somaVerificacao = cabecalho->somaVerificacao;
+    mapa->mapeamento = bytes;
+    return 0;
+}
+
+int abrirMapaArquivo(Mapa *mapa, const char *caminho, int validar) {
+    mapaInicializar(mapa);
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(MapaCabecalho)) {
+        close(fd);
+        return -1;
+    }
+    size_t tamanho = (size_t)info.st_size;
+    void *base = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // O mapeamento continua válido após fechar o descritor
+    if (base == MAP_FAILED) {
+        return -1;
+    }
+
+    if (mapaArquivoApontar(mapa, (unsigned char*)base, tamanho) != 0 ||
+        (validar && (!mapaValidar(mapa) || mapaCalcularSoma(mapa) != mapa->somaVerificacao))) {
+        munmap(base, tamanho);
+        mapaInicializar(mapa);
+        return -1;
+    }
+    mapa->tamanhoMapeamento = tamanho;
+    return 0;
+}
+
+int abrirMapaEmbutido(Mapa *mapa, const MapaEmbutido *embutido) {
+    mapaInicializar(mapa);
+    // A imagem é constante; o Mapa só a lê, como ao mapeamento somente leitura de um arquivo
+    return mapaArquivoApontar(mapa, (unsigned char*)(uintptr_t)embutido->dados, embutido->tamanho);
+}
+
+void fecharMapaArquivo(Mapa *mapa) {
+    mapaDesativarPaginas(mapa);
+    if (mapa->mapeamento == NULL) {
+        liberarMapa(mapa);
+        return;
+    }
+    if (mapa->tamanhoMapeamento > 0) {
+        munmap(mapa->mapeamento, mapa->tamanhoMapeamento);
+    }
+    mapaInicializar(mapa);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file mapa_arquivo.h
+ * @brief Formato binário de mapas (.dqm) e carregamento via mmap.
+ *
+ * O arquivo guarda os vetores do Mapa e dos dois internadores exatamente como
+ * ficam em memória, cada um alinhado a 64 bytes, após um cabeçalho com uma
+ * tabela de seções (início e tamanho em bytes):
+ *
+ *   [MapaCabecalho][salas][início dos alvos][alvos (suspeito, peso)]
+ *   [início das saídas][saídas (destino, rótulo, tecla)][nomes e rótulos]
+ *   [pistas: textos, deslocamentos, índice][suspeitos: textos, deslocamentos, índice]
+ *
+ * Os textos das pistas e dos suspeitos levam o cabeçalho de tamanho do
+ * internador (internador.h), conferido por validarInternador() quando a
+ * abertura valida o mapa. O cabeçalho leva também a soma de verificação do
+ * conteúdo (mapaCalcularSoma()), lida sem percorrer o arquivo: é ela que
+ * identifica o mapa nos retratos de sessão (retrato.h).
+ *
+ * abrirMapaArquivo() apenas mapeia o arquivo e aponta os vetores do Mapa para o
+ * mapeamento: nenhuma sala é copiada, e as páginas só são lidas do disco quando
+ * a exploração passa por elas. Com validar = 0 seguido de mapaAtivarPaginas()
+ * (paginas.h), também a validação passa a ser feita página a página. Os
+ * arquivos são gerados por compilador_mapa.c a partir do formato texto.
+ *
+ * "compilador_mapa --c" grava a mesma imagem como um vetor constante em C: as
+ * mansões padrão dos jogos (mapas/mansao_<nível>.txt) são compiladas assim e
+ * ficam no .rodata do executável, abertas por abrirMapaEmbutido() sem nenhuma
+ * alocação nem construção, e com as páginas compartilhadas entre os processos.
+ */
+
+#ifndef MAPA_ARQUIVO_H
+#define MAPA_ARQUIVO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "mapa.h"
+
+// --- Constantes do Formato ---
+#define MAPA_ARQUIVO_MAGICO      "DQMAPA7" // Assinatura (8 bytes com o '\0')
+#define MAPA_ARQUIVO_ORDEM_BYTES 0x01020304u // Detecta arquivos de outra arquitetura
+#define MAPA_ARQUIVO_ALINHAMENTO 64
+
+// Seções do arquivo, na ordem em que são gravadas
+enum {
+    MAPA_SECAO_SALAS,
+    MAPA_SECAO_INICIO_ALVOS,
+    MAPA_SECAO_ALVOS,
+    MAPA_SECAO_INICIO_SAIDAS,
+    MAPA_SECAO_SAIDAS,
+    MAPA_SECAO_NOMES,
+    MAPA_SECAO_PISTAS_TEXTOS,
+    MAPA_SECAO_PISTAS_DESLOCAMENTOS,
+    MAPA_SECAO_PISTAS_POSICOES,
+    MAPA_SECAO_SUSPEITOS_TEXTOS,
+    MAPA_SECAO_SUSPEITOS_DESLOCAMENTOS,
+    MAPA_SECAO_SUSPEITOS_POSICOES,
+    MAPA_TOTAL_SECOES
+};
+
+// --- Estruturas ---
+
+typedef struct MapaSecao {
+    uint64_t inicio;  // Deslocamento a partir do início do arquivo
+    uint64_t tamanho; // Em bytes
+} MapaSecao;
+
+typedef struct MapaCabecalho {
+    char magico[8];
+    uint32_t ordemBytes;
+    uint32_t raiz;
+    uint64_t somaVerificacao; // mapa->somaVerificacao (mapaCalcularSoma())
+    MapaSecao secoes[MAPA_TOTAL_SECOES];
+} MapaCabecalho;
+
+// Imagem .dqm constante, embutida no executável (gerada por "compilador_mapa --c")
+typedef struct MapaEmbutido {
+    const unsigned char *dados; // Alinhados a MAPA_ARQUIVO_ALINHAMENTO
+    size_t tamanho;
+} MapaEmbutido;
+
+// Mansão padrão do jogo, gerada de mapas/mansao_<nível>.txt (definida no executável de cada nível)
+extern const MapaEmbutido mansaoEmbutida;
+
+// --- Gravação ---
+
+/**
+ * @brief Grava o mapa no formato binário mapeável.
+ *
+ * O mapa deve ter passado por mapaFinalizar().
+ * @param mapa O ponteiro para o mapa.
+ * @param arquivo O arquivo aberto para escrita binária.
+ * @return 0 em caso de sucesso, -1 em caso de erro de escrita.
+ */
+int mapaSalvar(const Mapa *mapa, FILE *arquivo);
+
+// --- Carregamento ---
+
+/**
+ * @brief Abre um arquivo .dqm e expõe seu conteúdo como um Mapa, sem copiar as salas.
+ *
+ * O mapeamento é somente leitura: o estado de cada partida fica na Sessao
+ * (motor.h), e várias sessões podem compartilhar o mesmo mapa aberto. Os
+ * internadores também apontam para o mapeamento; mapas abertos assim não
+ * podem receber novas salas.
+ * @param mapa O ponteiro para o mapa a preencher.
+ * @param caminho O caminho do arquivo .dqm.
+ * @param validar Se diferente de 0, confere todos os índices com mapaValidar()
+ *                e recalcula a soma de verificação (percorre o arquivo todo;
+ *                dispensável para arquivos confiáveis).
+ * @return 0 em caso de sucesso, -1 se o arquivo não puder ser aberto ou for inválido.
+ */
+int abrirMapaArquivo(Mapa *mapa, const char *caminho, int validar);
+
+/**
+ * @brief Expõe uma imagem embutida no executável como um Mapa, sem alocar nem copiar nada.
+ *
+ * Confere só o cabeçalho e as seções (custo constante): a imagem foi gerada
+ * pelo compilador_mapa na compilação. Como um arquivo mapeado, o mapa é
+ * somente leitura e fecharMapaArquivo() o descarta sem liberar a imagem.
+ * @param mapa O ponteiro para o mapa a preencher.
+ * @param embutido A imagem, ex.: &mansaoEmbutida.
+ * @return 0 em caso de sucesso, -1 se a imagem for inválida (ex.: de outra arquitetura).
+ */
+int abrirMapaEmbutido(Mapa *mapa, const MapaEmbutido *embutido);
+
+/**
+ * @brief Desfaz o mapeamento de um mapa aberto com abrirMapaArquivo() ou abrirMapaEmbutido().
+ *
+ * Para mapas construídos em memória, equivale a liberarMapa(). As páginas
+ * (mapaAtivarPaginas()), se ativas, são liberadas antes.
+ * @param mapa O ponteiro para o mapa.
+ */
+void fecharMapaArquivo(Mapa *mapa);
+
+#endif // MAPA_ARQUIVO_H
@@ -0,0 +1,290 @@
+/**
+ * @file motor.c
+ * @brief Implementação do motor do jogo.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "diario.h"
+#include "instrumentos.h"
+#include "motor.h"
+#include "paginas.h"
+
+// --- Ciclo de Vida da Sessão ---
+
+/**
+ * @brief Prepara as estruturas de uma partida que ainda não começou.
+ */
+static void sessaoPrepararEstruturas(Sessao *sessao) {
+    inicializarHash(&sessao->hashSuspeitos, &sessao->arena, HASH_FATOR_CARGA_PADRAO);
+    inicializarPlacar(&sessao->placar, &sessao->arena, sessao->mapa->suspeitos.total);
+    sessao->totalPistas = 0;
+    sessao->salaAtual = sessao->mapa->raiz;
+    if (sessao->mapa->totalSalas > 0) {
+        mapaGarantirSala(sessao->mapa, sessao->salaAtual); // Validada na ativação; só marca o uso
+    }
+    sessao->movimentos = 0;
+    sessao->encerrada = sessao->mapa->totalSalas == 0;
+    sessao->salasColetadas = NULL;
+    sessao->totalColetadas = 0;
+    sessao->capacidadeColetadas = 0;
+    if (sessao->coletadas == NULL) {
+        iniciarConjuntoEsparso(&sessao->coletadasEsparsas, &sessao->arena);
+    }
+    if (sessao->buscaAtiva) {
+        inicializarIndiceBusca(&sessao->busca, &sessao->arena);
+    }
+}
+
+void iniciarSessao(Sessao *sessao, const Mapa *mapa) {
+    iniciarSessaoComBloco(sessao, mapa, ARENA_BLOCO_PADRAO);
+}
+
+void iniciarSessaoComBloco(Sessao *sessao, const Mapa *mapa, size_t tamanhoBloco) {
+    sessao->mapa = mapa;
+    sessao->coletadas = NULL;
+    if (mapa->totalSalas <= SESSAO_SALAS_DENSAS) {
+        size_t palavras = ((size_t)mapa->totalSalas + 63) / 64 + 1;
+        sessao->coletadas = (uint64_t*)calloc(palavras, sizeof(uint64_t));
+        if (sessao->coletadas == NULL) {
+            printf("Erro de alocação de memória para a Sessão!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    iniciarConjuntoPistas(&sessao->pistas, mapa->pistas.total);
+    arenaInicializar(&sessao->arena, tamanhoBloco);
+    sessao->buscaAtiva = 0;
+    sessao->diario = NULL;
+    sessaoPrepararEstruturas(sessao);
+}
+
+void reiniciarSessao(Sessao *sessao) {
+    // O conjunto esparso está na arena e é recriado com ela
+    for (uint32_t i = 0; sessao->coletadas != NULL && i < sessao->totalColetadas; i++) {
+        uint32_t sala = sessao->salasColetadas[i];
+        sessao->coletadas[sala / 64] &= ~(UINT64_C(1) << (sala % 64));
+    }
+    esvaziarConjuntoPistas(&sessao->pistas);
+    arenaReiniciar(&sessao->arena);
+    if (sessao->diario != NULL) {
+        sessao->diario->sessao = DIARIO_SEM_SESSAO; // A próxima partida ganha outro id
+    }
+    sessaoPrepararEstruturas(sessao);
+}
+
+void sessaoAtivarBusca(Sessao *sessao) {
+    if (sessao->buscaAtiva) {
+        return;
+    }
+    sessao->buscaAtiva = 1;
+    inicializarIndiceBusca(&sessao->busca, &sessao->arena);
+    IteradorConjunto iterador;
+    iniciarIteradorConjunto(&iterador, &sessao->pistas);
+    for (uint32_t pista = proximaPistaConjunto(&iterador); pista != TEXTO_NENHUM; pista = proximaPistaConjunto(&iterador)) {
+        indexarPista(&sessao->busca, &sessao->mapa->pistas, pista);
+    }
+}
+
+void encerrarSessao(Sessao *sessao) {
+    sessaoDesativarDiario(sessao);
+    free(sessao->coletadas);
+    sessao->coletadas = NULL;
+    liberarConjuntoPistas(&sessao->pistas);
+    arenaLiberar(&sessao->arena);
+}
+
+size_t sessaoMemoria(const Sessao *sessao) {
+    size_t palavrasSalas = sessao->coletadas != NULL ? ((size_t)sessao->mapa->totalSalas + 63) / 64 + 1 : 0;
+    size_t palavrasPistas = (size_t)sessao->pistas.totalPalavras + (sessao->pistas.totalPalavras + 63) / 64;
+    return (palavrasSalas + palavrasPistas) * sizeof(uint64_t) + arenaCapacidade(&sessao->arena);
+}
+
+// --- Jogadas ---
+
+void sessaoMarcarColetada(Sessao *sessao, uint32_t sala) {
+    if (sessao->totalColetadas == sessao->capacidadeColetadas) {
+        uint32_t capacidade = sessao->capacidadeColetadas > 0 ? sessao->capacidadeColetadas * 2 : 16;
+        uint32_t *salas = (uint32_t*)arenaAlocar(&sessao->arena, capacidade * sizeof(uint32_t));
+        if (sessao->totalColetadas > 0) {
+            memcpy(salas, sessao->salasColetadas, sessao->totalColetadas * sizeof(uint32_t));
+        }
+        sessao->salasColetadas = salas;
+        sessao->capacidadeColetadas = capacidade;
+    }
+    sessao->salasColetadas[sessao->totalColetadas++] = sala;
+    if (sessao->coletadas == NULL) {
+        esparsoInserir(&sessao->coletadasEsparsas, sala);
+    } else {
+        sessao->coletadas[sala / 64] |= UINT64_C(1) << (sala % 64);
+    }
+}
+
+/**
+ * @brief Soma (ou retira) do placar os pesos dos suspeitos incriminados pela pista de uma sala.
+ */
+static void sessaoAplicarAlvos(Sessao *sessao, uint32_t sala, int somar) {
+    const AlvoPeso *alvos = mapaAlvos(sessao->mapa, sala);
+    uint32_t total = mapaTotalAlvos(sessao->mapa, sala);
+    for (uint32_t i = 0; i < total; i++) {
+        if (somar) {
+            placarSomar(&sessao->placar, alvos[i].suspeito, alvos[i].peso);
+        } else {
+            placarSubtrair(&sessao->placar, alvos[i].suspeito, alvos[i].peso);
+        }
+    }
+}
+
+uint32_t sessaoColetar(Sessao *sessao) {
+    if (sessao->encerrada) {
+        return TEXTO_NENHUM;
+    }
+    uint32_t salaAtual = sessao->salaAtual;
+    uint32_t pista = sessaoPistaDisponivel(sessao, salaAtual);
+    if (pista == TEXTO_NENHUM) {
+        return TEXTO_NENHUM;
+    }
+
+    INSTRUMENTAR_CONTAR(CONTADOR_PISTAS_INSERIDAS, 1);
+    if (!conjuntoInserir(&sessao->pistas, pista)) {
+        INSTRUMENTAR_CONTAR(CONTADOR_PISTAS_REPETIDAS, 1); // A mesma pista, vinda de outra sala
+    }
+    // A hash guarda a sala de origem: a associação mais recente prevalece
+    uint32_t anterior = inserirNaHash(&sessao->hashSuspeitos, pista, salaAtual);
+    if (anterior != TEXTO_NENHUM) {
+        sessaoAplicarAlvos(sessao, anterior, 0);
+    } else if (sessao->buscaAtiva) {
+        indexarPista(&sessao->busca, &sessao->mapa->pistas, pista); // Pista nova no conjunto
+    }
+    sessaoAplicarAlvos(sessao, salaAtual, 1);
+    sessao->totalPistas = sessao->pistas.total;
+
+    sessaoMarcarColetada(sessao, salaAtual);
+    sessaoRegistrar(sessao, DIARIO_PISTA, salaAtual, pista, 0);
+    return pista;
+}
+
+Movimento sessaoSeguir(Sessao *sessao, uint32_t saida) {
+    if (sessao->encerrada) {
+        return MOVIMENTO_SAIR;
+    }
+    if (saida >= mapaTotalSaidas(sessao->mapa, sessao->salaAtual)) {
+        return MOVIMENTO_BLOQUEADO;
+    }
+    uint32_t destino = mapaSaidas(sessao->mapa, sessao->salaAtual)[saida].destino;
+    if (!mapaGarantirSala(sessao->mapa, destino)) {
+        return MOVIMENTO_BLOQUEADO; // Página inválida no mapa paginado (paginas.h)
+    }
+    sessao->salaAtual = destino;
+    sessao->movimentos++;
+    sessaoRegistrar(sessao, DIARIO_MOVIMENTO, saida, destino, 0);
+    return MOVIMENTO_OK;
+}
+
+Movimento sessaoSair(Sessao *sessao) {
+    if (!sessao->encerrada) {
+        sessaoRegistrar(sessao, DIARIO_SAIDA, sessao->salaAtual, sessao->movimentos, 0);
+    }
+    sessao->encerrada = 1;
+    return MOVIMENTO_SAIR;
+}
+
+/**
+ * @brief Aplica a tecla sem instrumentos; sessaoMover() mede a duração em volta dela.
+ */
+static Movimento sessaoAplicarTecla(Sessao *sessao, char escolha) {
+    if (sessao->encerrada) {
+        return MOVIMENTO_SAIR;
+    }
+    if (escolha == 's' || escolha == 'S') {
+        return sessaoSair(sessao);
+    }
+    uint32_t saida = mapaProcurarSaida(sessao->mapa, sessao->salaAtual, escolha);
+    if (saida != MAPA_NENHUM) {
+        return sessaoSeguir(sessao, saida);
+    }
+    return mapaTeclaDirecao(escolha) ? MOVIMENTO_BLOQUEADO : MOVIMENTO_INVALIDO;
+}
+
+Movimento sessaoMover(Sessao *sessao, char escolha) {
+    INSTRUMENTAR_RELOGIO(inicio);
+    Movimento movimento = sessaoAplicarTecla(sessao, escolha);
+    INSTRUMENTAR_CONTAR(CONTADOR_MOVIMENTOS, 1);
+    INSTRUMENTAR_DURACAO(HISTOGRAMA_MOVIMENTO_NS, inicio);
+    return movimento;
+}
+
+Veredito sessaoJulgar(const Sessao *sessao, uint32_t suspeito, uint32_t *contagem) {
+    uint32_t pistas = placarContagem(&sessao->placar, suspeito);
+    if (contagem != NULL) {
+        *contagem = pistas;
+    }
+    if (sessao->totalPistas == 0) {
+        return VEREDITO_SEM_PISTAS;
+    }
+    return pistas >= PISTAS_MINIMAS_ACUSACAO ? VEREDITO_SUSTENTADO : VEREDITO_FRACO;
+}
+
+Veredito sessaoAcusar(Sessao *sessao, const char *acusado, uint32_t *contagem) {
+    uint32_t suspeito = internadorProcurar(&sessao->mapa->suspeitos, acusado);
+    uint32_t pistas;
+    Veredito veredito = sessaoJulgar(sessao, suspeito, &pistas);
+    if (contagem != NULL) {
+        *contagem = pistas;
+    }
+    if (sessao->diario != NULL) {
+        sessaoRegistrar(sessao, DIARIO_VEREDITO, suspeito, pistas, (uint16_t)veredito);
+        sessaoDescarregarDiario(sessao);
+    }
+    return veredito;
+}
+
+uint32_t listarPistas(const PistaNode *raiz, uint32_t *destino) {
+    // O mesmo percurso do IteradorPistas, com a pilha local e sem o teste de fim por pista
+    const PistaNode *pilha[PISTAS_ALTURA_MAXIMA];
+    int topo = 0;
+    uint32_t total = 0;
+    const PistaNode *no = raiz;
+    for (;;) {
+        while (no != NULL) {
+            pilha[topo++] = no;
+            no = no->esquerda;
+        }
+        if (topo == 0) {
+            return total;
+        }
+        no = pilha[--topo];
+        destino[total++] = no->pista;
+        no = no->direita;
+    }
+}
+
+// --- Simulação ---
+
+void simularSessao(Sessao *sessao, const char *roteiro, const char *acusado, ResultadoSessao *resultado) {
+    INSTRUMENTAR_INICIO("partida");
+    INSTRUMENTAR_CONTAR(CONTADOR_PARTIDAS, 1);
+    reiniciarSessao(sessao);
+    memset(resultado, 0, sizeof(ResultadoSessao));
+
+    sessaoColetar(sessao);
+    for (const char *c = roteiro; *c != '\0' && !sessao->encerrada; c++) {
+        if (*c == ' ' || *c == '\t') {
+            continue;
+        }
+        Movimento movimento = sessaoMover(sessao, *c);
+        if (movimento == MOVIMENTO_OK) {
+            sessaoColetar(sessao);
+        } else if (movimento != MOVIMENTO_SAIR) {
+            resultado->movimentosRecusados++;
+        }
+    }
+
+    resultado->salaFinal = sessao->salaAtual;
+    resultado->movimentos = sessao->movimentos;
+    resultado->totalPistas = sessao->totalPistas;
+    resultado->acusado = internadorProcurar(&sessao->mapa->suspeitos, acusado);
+    resultado->veredito = sessaoAcusar(sessao, acusado, &resultado->contagem);
+    INSTRUMENTAR_FIM("partida");
+}
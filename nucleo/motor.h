@@ -0,0 +1,275 @@
+/**
+ * @file motor.h
+ * @brief Motor do jogo sem entrada e saída: sessões, movimentos, coleta e julgamento.
+ *
+ * Toda a regra do Detective Quest fica aqui, sem nenhum scanf ou printf. Os
+ * laços interativos dos jogos (jogos/) apenas leem a escolha do
+ * jogador, chamam o motor e imprimem o resultado; o modo em lote usa
+ * simularSessao() para rodar roteiros de movimentos ("eed...s") sem terminal.
+ *
+ * Uma sessão guarda tudo o que é alocado durante o jogo em uma arena própria.
+ * O mapa nunca é alterado: as salas cuja pista já foi coletada ficam marcadas
+ * em um conjunto de bits da sessão. Assim várias sessões (inclusive em threads
+ * diferentes, ver executor.h) compartilham o mesmo mapa somente leitura, e
+ * reiniciarSessao() prepara uma nova partida desmarcando apenas as salas usadas.
+ *
+ * Pelo mesmo motivo, as pistas coletadas não formam uma BST por sessão: o
+ * internador de pistas do mapa já é o vetor ordenado e compartilhado de todas
+ * as pistas, e a sessão guarda só um ConjuntoPistas (conjunto.h), com um bit por
+ * id. Sessões simultâneas no mesmo mapa pagam totalPistas / 8 bytes cada pelas
+ * pistas, mais a hash e o placar do que de fato coletaram.
+ *
+ * Entrar em uma sala já visitada só consulta as salas marcadas: a pista não
+ * volta ao conjunto, à hash nem ao índice de busca. Em mapas com mais de
+ * SESSAO_SALAS_DENSAS salas, as marcas ficam em um ConjuntoEsparso (filtro.h)
+ * na arena, em vez de um bit por sala do mapa: o filtro de Bloom descarta sem
+ * consultar a tabela quase todas as salas novas, e a sessão não reserva nada
+ * proporcional ao número de salas.
+ *
+ * As marcas são por sala, e não por pista, porque duas salas podem ter a mesma
+ * pista: é a sala que não devolve mais nada, e o ConjuntoPistas já responde
+ * pela pista. O limite é de memória, não de tempo: a consulta ao vetor de bits
+ * fica em ~2 ns em qualquer tamanho, e a do conjunto esparso em ~3 ns (uma
+ * linha de cache a mais nas salas já coletadas, a da tabela depois da do
+ * filtro). O conjunto esparso custa de 10 a 20 bytes por sala coletada
+ * (conforme a carga da tabela); com 2^20 salas, o vetor de bits (128 KiB) só
+ * sai mais barato depois de 7 a 13 mil salas coletadas, mais do que uma
+ * partida percorre.
+ */
+
+#ifndef MOTOR_H
+#define MOTOR_H
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "busca.h"
+#include "conjunto.h"
+#include "filtro.h"
+#include "internador.h"
+#include "mapa.h"
+#include "pistas.h"
+#include "suspeitos.h"
+
+// --- Constantes do Motor ---
+#define PISTAS_MINIMAS_ACUSACAO 2 // Pontuação necessária para sustentar uma acusação (pistas, com peso 1)
+#ifndef SESSAO_SALAS_DENSAS
+#define SESSAO_SALAS_DENSAS (1u << 20) // Até aqui, um bit por sala (128 KiB); acima, ConjuntoEsparso
+#endif
+
+// Resultado de sessaoMover()
+typedef enum Movimento {
+    MOVIMENTO_OK,        // O jogador entrou em outra sala
+    MOVIMENTO_BLOQUEADO, // Não há caminho nessa direção ('e' ou 'd' sem saída)
+    MOVIMENTO_INVALIDO,  // Tecla que não é de saída, nem padrão, nem 's'
+    MOVIMENTO_SAIR       // O jogador encerrou a exploração
+} Movimento;
+
+// Resultado de sessaoAcusar()
+typedef enum Veredito {
+    VEREDITO_SEM_PISTAS,  // Nenhuma pista coletada: a acusação não pode ser feita
+    VEREDITO_FRACO,       // Pontuação do acusado abaixo de PISTAS_MINIMAS_ACUSACAO
+    VEREDITO_SUSTENTADO
+} Veredito;
+
+// --- Estruturas ---
+
+struct RegistroDiario;
+
+typedef struct Sessao {
+    const Mapa *mapa;         // Compartilhado entre sessões; nunca é alterado
+    Arena arena;              // Posições da hash, placar, lista de coletas e índice de busca
+    ConjuntoPistas pistas;    // Pistas coletadas, em ordem alfabética de id
+    uint32_t totalPistas;     // Pistas distintas coletadas (pistas.total)
+    SuspeitoHash hashSuspeitos; // Pista -> sala de origem da associação que prevalece
+    PlacarSuspeitos placar;
+    uint32_t salaAtual;
+    uint32_t movimentos;      // Movimentos aceitos (MOVIMENTO_OK)
+    int encerrada;            // Diferente de 0 depois de MOVIMENTO_SAIR
+    uint64_t *coletadas;      // Bit i ligado: a pista da sala i já foi coletada (NULL nos mapas grandes)
+    ConjuntoEsparso coletadasEsparsas; // ... as mesmas marcas, na arena, quando coletadas é NULL
+    uint32_t *salasColetadas; // Salas marcadas, em ordem de coleta (retrato.h), e desmarcadas no reinício
+    uint32_t totalColetadas;
+    uint32_t capacidadeColetadas;
+    int buscaAtiva;           // Diferente de 0 depois de sessaoAtivarBusca()
+    IndiceBusca busca;        // Trigramas das pistas da BST (só com buscaAtiva)
+    struct RegistroDiario *diario; // Eventos ainda não entregues ao diário (diario.h); NULL: sem diário
+} Sessao;
+
+// Resumo de uma partida simulada por simularSessao()
+typedef struct ResultadoSessao {
+    uint32_t salaFinal;
+    uint32_t movimentos;
+    uint32_t movimentosRecusados; // Bloqueados ou inválidos
+    uint32_t totalPistas;
+    uint32_t acusado;             // Id do suspeito (TEXTO_NENHUM se desconhecido)
+    uint32_t contagem;            // Pontuação do acusado (soma dos pesos)
+    Veredito veredito;
+} ResultadoSessao;
+
+// --- Ciclo de Vida da Sessão ---
+
+/**
+ * @brief Inicia uma sessão na sala raiz do mapa.
+ *
+ * A pista da sala inicial só é coletada na primeira chamada a sessaoColetar().
+ * @param sessao O ponteiro para a sessão.
+ * @param mapa O mapa já finalizado (mapaFinalizar() ou abrirMapaArquivo()).
+ */
+void iniciarSessao(Sessao *sessao, const Mapa *mapa);
+
+/**
+ * @brief Como iniciarSessao(), com o primeiro bloco da arena do tamanho pedido.
+ *
+ * O servidor (servidor.h) mantém milhares de sessões abertas, quase todas com
+ * poucas pistas: um bloco inicial pequeno evita reservar ARENA_BLOCO_PADRAO
+ * bytes por jogador, e a arena cresce sozinha se a partida for longa.
+ * @param tamanhoBloco Capacidade do primeiro bloco da arena (0 usa ARENA_BLOCO_PADRAO).
+ */
+void iniciarSessaoComBloco(Sessao *sessao, const Mapa *mapa, size_t tamanhoBloco);
+
+/**
+ * @brief Volta a sessão para a sala raiz, sem pistas coletadas.
+ *
+ * A arena é reaproveitada e só os bits das salas usadas são desmarcados:
+ * partidas seguidas não fazem novas alocações do sistema, e o custo não
+ * depende do tamanho do mapa. A busca continua ativa, com o índice vazio.
+ */
+void reiniciarSessao(Sessao *sessao);
+
+/**
+ * @brief Passa a manter o índice de trigramas das pistas coletadas, para buscarTrecho().
+ *
+ * As pistas já coletadas são indexadas agora; as seguintes, ao entrar no
+ * conjunto em sessaoColetar(). Sem esta chamada (como no modo em lote), a coleta
+ * não paga pelo índice.
+ */
+void sessaoAtivarBusca(Sessao *sessao);
+
+/**
+ * @brief Encerra a sessão, liberando os conjuntos de bits e a arena.
+ */
+void encerrarSessao(Sessao *sessao);
+
+/**
+ * @brief Memória reservada pela sessão: os conjuntos de bits e os blocos da arena.
+ *
+ * Não conta o próprio struct Sessao nem o mapa, que é compartilhado.
+ */
+size_t sessaoMemoria(const Sessao *sessao);
+
+/**
+ * @brief Indica se a pista de uma sala já foi coletada nesta sessão.
+ */
+static inline int sessaoPistaColetada(const Sessao *sessao, uint32_t sala) {
+    if (sessao->coletadas == NULL) {
+        return esparsoContem(&sessao->coletadasEsparsas, sala);
+    }
+    return (sessao->coletadas[sala / 64] >> (sala % 64)) & 1;
+}
+
+/**
+ * @brief Pista da sala ainda disponível para a sessão.
+ *
+ * Uma sala já coletada é recusada antes de ler a pista do mapa.
+ * @return O id da pista, ou TEXTO_NENHUM se não houver ou se já foi coletada.
+ */
+static inline uint32_t sessaoPistaDisponivel(const Sessao *sessao, uint32_t sala) {
+    return sessaoPistaColetada(sessao, sala) ? TEXTO_NENHUM : sessao->mapa->salas[sala].pista;
+}
+
+/**
+ * @brief Marca a pista de uma sala como coletada, guardando a sala para o reinício.
+ *
+ * Só a marca: o conjunto, a hash e o placar ficam como estão. sessaoColetar()
+ * faz a coleta completa; restaurarRetrato() (retrato.h) recoloca as marcas de
+ * uma sessão cujas estruturas copiou do retrato.
+ */
+void sessaoMarcarColetada(Sessao *sessao, uint32_t sala);
+
+// --- Jogadas ---
+
+/**
+ * @brief Coleta a pista da sala atual, se houver.
+ *
+ * A pista entra no conjunto de pistas, a associação pista -> sala de origem entra na hash e
+ * o placar recebe os pesos de todos os suspeitos que a pista incrimina (e
+ * perde os da associação anterior da mesma pista, se houver). A sala é marcada para que a pista não seja coletada de novo.
+ * @param sessao O ponteiro para a sessão.
+ * @return O id da pista coletada, ou TEXTO_NENHUM se a sala não tinha pista.
+ */
+uint32_t sessaoColetar(Sessao *sessao);
+
+/**
+ * @brief Segue uma saída da sala atual, escolhida pela posição e não pela tecla.
+ * @param sessao O ponteiro para a sessão.
+ * @param saida A posição da saída entre as da sala (0 .. mapaTotalSaidas() - 1).
+ * @return MOVIMENTO_OK, MOVIMENTO_BLOQUEADO para posição inexistente (ou destino
+ *         em página inválida do mapa paginado, paginas.h), ou MOVIMENTO_SAIR se a sessão já terminou.
+ */
+Movimento sessaoSeguir(Sessao *sessao, uint32_t saida);
+
+/**
+ * @brief Encerra a exploração da sessão.
+ * @return MOVIMENTO_SAIR.
+ */
+Movimento sessaoSair(Sessao *sessao);
+
+/**
+ * @brief Aplica uma tecla do jogador: 's' sai, e as demais escolhem a saída com essa tecla.
+ *
+ * Maiúsculas são aceitas. Sem saída para a tecla, o resultado é
+ * MOVIMENTO_BLOQUEADO se ela for uma direção (mapaTeclaDirecao()), como um 'd'
+ * em sala sem caminho à direita, e MOVIMENTO_INVALIDO nos outros casos.
+ * @param sessao O ponteiro para a sessão.
+ * @param escolha O caractere da escolha.
+ * @return O resultado do movimento; com MOVIMENTO_OK a sala atual já mudou.
+ */
+Movimento sessaoMover(Sessao *sessao, char escolha);
+
+/**
+ * @brief Avalia a acusação de um suspeito pelo nome.
+ *
+ * Com o diário ativo (diario.h), o veredito é registrado e os eventos da
+ * partida são entregues ao diário.
+ * @param sessao O ponteiro para a sessão.
+ * @param acusado O nome do suspeito acusado.
+ * @param contagem Recebe a pontuação do acusado: a soma dos pesos das pistas contra ele (pode ser NULL).
+ * @return O veredito.
+ */
+Veredito sessaoAcusar(Sessao *sessao, const char *acusado, uint32_t *contagem);
+
+/**
+ * @brief Avalia a acusação de um suspeito pelo id, como sessaoAcusar(), sem registrar nada no diário.
+ * @param suspeito O id do suspeito (TEXTO_NENHUM para um nome desconhecido, que não pontua).
+ */
+Veredito sessaoJulgar(const Sessao *sessao, uint32_t suspeito, uint32_t *contagem);
+
+/**
+ * @brief Copia os ids das pistas de uma BST (pistas.h), em ordem alfabética.
+ *
+ * As pistas de uma sessão saem de listarConjuntoPistas(&sessao->pistas, ...).
+ * @param raiz A raiz da BST de pistas.
+ * @param destino Vetor com espaço para todas as pistas coletadas.
+ * @return A quantidade de ids copiados.
+ */
+uint32_t listarPistas(const PistaNode *raiz, uint32_t *destino);
+
+// --- Simulação ---
+
+/**
+ * @brief Joga uma partida completa a partir de um roteiro, sem entrada e saída.
+ *
+ * Cada caractere do roteiro é uma escolha, como no modo interativo; espaços são
+ * ignorados e o roteiro termina no primeiro 's' ou no fim do texto. A pista de
+ * cada sala visitada é coletada ao entrar, inclusive a da sala inicial.
+ * A sessão é reiniciada antes da partida e fica com o estado final para consulta
+ * (ex.: sessao->pistas); a próxima chamada a reinicia de novo.
+ * @param sessao Uma sessão iniciada com iniciarSessao().
+ * @param roteiro As escolhas do jogador (ex.: "eeds").
+ * @param acusado O nome do suspeito acusado ao final.
+ * @param resultado Recebe o resumo da partida.
+ */
+void simularSessao(Sessao *sessao, const char *roteiro, const char *acusado, ResultadoSessao *resultado);
+
+#endif // MOTOR_H
@@ -0,0 +1,185 @@
+/**
+ * @file paginas.c
+ * @brief Implementação do mapa paginado (validação sob demanda e anel do relógio).
+ */
+
+#define _DEFAULT_SOURCE // madvise()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "instrumentos.h"
+#include "paginas.h"
+
+// --- Validação de uma Página ---
+
+/**
+ * @brief Valida as salas da página e guarda os trechos do arquivo que ela ocupa.
+ * @return 1 se a página for consistente, 0 caso contrário.
+ */
+static int validarPagina(const Mapa *mapa, FaixaPagina *faixa, uint32_t pagina) {
+    uint32_t inicio = pagina * PAGINAS_SALAS;
+    uint32_t fim = mapa->totalSalas - inicio < PAGINAS_SALAS ? mapa->totalSalas : inicio + PAGINAS_SALAS;
+    if (!mapaValidarSalas(mapa, inicio, fim)) {
+        return 0;
+    }
+
+    uint32_t menorNome = UINT32_MAX;
+    uint32_t maiorNome = 0;
+    uint64_t bytesNomes = 0;
+    for (uint32_t i = inicio; i < fim; i++) {
+        const SalaPlana *sala = &mapa->salas[i];
+        if (sala->pista != TEXTO_NENHUM && !validarTextoInternador(&mapa->pistas, sala->pista)) {
+            return 0;
+        }
+        // Os jogos mostram o nome de cada sala vizinha, que pode estar em outra página
+        const SaidaSala *saidas = mapaSaidas(mapa, i);
+        for (uint32_t j = 0; j < mapaTotalSaidas(mapa, i); j++) {
+            uint32_t nome = mapa->salas[saidas[j].destino].nome;
+            if (nome != MAPA_NENHUM && nome >= mapa->tamanhoTextos) {
+                return 0;
+            }
+        }
+        if (sala->nome != MAPA_NENHUM) {
+            uint32_t tamanho = (uint32_t)strlen(mapa->textos + sala->nome) + 1;
+            menorNome = sala->nome < menorNome ? sala->nome : menorNome;
+            maiorNome = sala->nome + tamanho > maiorNome ? sala->nome + tamanho : maiorNome;
+            bytesNomes += tamanho;
+        }
+    }
+
+    faixa->inicioSaidas = mapa->inicioSaidas[inicio];
+    faixa->fimSaidas = mapa->inicioSaidas[fim];
+    faixa->inicioAlvos = mapa->inicioAlvos[inicio];
+    faixa->fimAlvos = mapa->inicioAlvos[fim];
+    // Nomes espalhados pela tabela (ou compartilhados) não são descartados com a página
+    int contiguos = menorNome < maiorNome && (uint64_t)(maiorNome - menorNome) <= 2 * bytesNomes;
+    faixa->inicioNomes = contiguos ? menorNome : 0;
+    faixa->fimNomes = contiguos ? maiorNome : 0;
+    return 1;
+}
+
+// --- Anel do Relógio ---
+
+/**
+ * @brief Devolve ao kernel as páginas de memória inteiramente dentro de [inicio, fim).
+ *
+ * As páginas das pontas, que podem conter dados de salas vizinhas, ficam.
+ */
+static void descartarFaixa(const PaginasMapa *paginas, const void *inicio, const void *fim) {
+    uintptr_t tamanho = paginas->tamanhoPaginaSistema;
+    uintptr_t primeiro = ((uintptr_t)inicio + tamanho - 1) & ~(tamanho - 1);
+    uintptr_t ultimo = (uintptr_t)fim & ~(tamanho - 1);
+    if (primeiro < ultimo) {
+        madvise((void*)primeiro, ultimo - primeiro, MADV_DONTNEED);
+    }
+}
+
+static void descartarPagina(const Mapa *mapa, const PaginasMapa *paginas, uint32_t pagina) {
+    const FaixaPagina *faixa = &paginas->faixas[pagina];
+    uint32_t inicio = pagina * PAGINAS_SALAS;
+    uint32_t fim = mapa->totalSalas - inicio < PAGINAS_SALAS ? mapa->totalSalas : inicio + PAGINAS_SALAS;
+    descartarFaixa(paginas, mapa->salas + inicio, mapa->salas + fim);
+    descartarFaixa(paginas, mapa->inicioSaidas + inicio, mapa->inicioSaidas + fim);
+    descartarFaixa(paginas, mapa->inicioAlvos + inicio, mapa->inicioAlvos + fim);
+    descartarFaixa(paginas, mapa->saidas + faixa->inicioSaidas, mapa->saidas + faixa->fimSaidas);
+    descartarFaixa(paginas, mapa->alvos + faixa->inicioAlvos, mapa->alvos + faixa->fimAlvos);
+    descartarFaixa(paginas, mapa->textos + faixa->inicioNomes, mapa->textos + faixa->fimNomes);
+}
+
+/**
+ * @brief Põe uma página validada no anel, descartando outra se ele estiver cheio. Chamada com a trava.
+ */
+static void admitirPagina(const Mapa *mapa, PaginasMapa *paginas, uint32_t pagina) {
+    if (paginas->totalResidentes < paginas->capacidade) {
+        paginas->anel[paginas->totalResidentes++] = pagina;
+    } else {
+        // Segunda chance: as referenciadas perdem o bit e ficam; a primeira sem ele sai
+        for (;;) {
+            uint32_t candidata = paginas->anel[paginas->ponteiro];
+            unsigned estado = atomic_fetch_and_explicit(&paginas->estados[candidata],
+                                                        (unsigned char)~PAGINA_REFERENCIADA, memory_order_relaxed);
+            if (!(estado & PAGINA_REFERENCIADA)) {
+                atomic_fetch_and_explicit(&paginas->estados[candidata], (unsigned char)~PAGINA_RESIDENTE,
+                                          memory_order_relaxed);
+                descartarPagina(mapa, paginas, candidata);
+                INSTRUMENTAR_CONTAR(CONTADOR_PAGINAS_DESCARTADAS, 1);
+                paginas->anel[paginas->ponteiro] = pagina;
+                break;
+            }
+            paginas->ponteiro = (paginas->ponteiro + 1) % paginas->capacidade;
+        }
+        paginas->ponteiro = (paginas->ponteiro + 1) % paginas->capacidade;
+    }
+    atomic_fetch_or_explicit(&paginas->estados[pagina], PAGINA_RESIDENTE | PAGINA_REFERENCIADA, memory_order_release);
+}
+
+int paginasCarregar(const Mapa *mapa, uint32_t sala) {
+    PaginasMapa *paginas = mapa->paginas;
+    uint32_t pagina = sala / PAGINAS_SALAS;
+    pthread_mutex_lock(&paginas->trava);
+    unsigned estado = atomic_load_explicit(&paginas->estados[pagina], memory_order_relaxed);
+    if (!(estado & (PAGINA_VALIDADA | PAGINA_INVALIDA))) {
+        INSTRUMENTAR_INICIO("pagina");
+        estado = validarPagina(mapa, &paginas->faixas[pagina], pagina) ? PAGINA_VALIDADA : PAGINA_INVALIDA;
+        atomic_fetch_or_explicit(&paginas->estados[pagina], (unsigned char)estado, memory_order_relaxed);
+        INSTRUMENTAR_FIM("pagina");
+    }
+    int valida = !(estado & PAGINA_INVALIDA);
+    // Outra thread pode ter admitido a página enquanto esta esperava a trava
+    if (valida && !(estado & PAGINA_RESIDENTE)) {
+        admitirPagina(mapa, paginas, pagina);
+        INSTRUMENTAR_CONTAR(CONTADOR_PAGINAS_CARREGADAS, 1);
+    }
+    pthread_mutex_unlock(&paginas->trava);
+    return valida;
+}
+
+// --- Ativação ---
+
+int mapaAtivarPaginas(Mapa *mapa, uint32_t capacidade) {
+    if (!mapaValidarEstrutura(mapa)) {
+        return -1;
+    }
+    PaginasMapa *paginas = (PaginasMapa*)calloc(1, sizeof(PaginasMapa));
+    if (paginas == NULL) {
+        printf("Erro de alocação de memória para as Páginas do Mapa!\n");
+        exit(EXIT_FAILURE);
+    }
+    paginas->totalPaginas = (uint32_t)(((uint64_t)mapa->totalSalas + PAGINAS_SALAS - 1) / PAGINAS_SALAS);
+    paginas->capacidade = capacidade > 0 ? capacidade : PAGINAS_RESIDENTES_PADRAO;
+    long tamanhoPagina = sysconf(_SC_PAGESIZE);
+    paginas->tamanhoPaginaSistema = tamanhoPagina > 0 ? (size_t)tamanhoPagina : 4096;
+    // Uma posição a mais: um mapa sem salas ainda tem vetores válidos
+    paginas->estados = (_Atomic unsigned char*)calloc((size_t)paginas->totalPaginas + 1, sizeof(unsigned char));
+    paginas->faixas = (FaixaPagina*)calloc((size_t)paginas->totalPaginas + 1, sizeof(FaixaPagina));
+    paginas->anel = (uint32_t*)malloc(paginas->capacidade * sizeof(uint32_t));
+    if (paginas->estados == NULL || paginas->faixas == NULL || paginas->anel == NULL) {
+        printf("Erro de alocação de memória para as Páginas do Mapa!\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&paginas->trava, NULL);
+    mapa->paginas = paginas;
+
+    if (mapa->totalSalas > 0 && !mapaGarantirSala(mapa, mapa->raiz)) {
+        mapaDesativarPaginas(mapa);
+        return -1;
+    }
+    return 0;
+}
+
+void mapaDesativarPaginas(Mapa *mapa) {
+    PaginasMapa *paginas = mapa->paginas;
+    if (paginas == NULL) {
+        return;
+    }
+    pthread_mutex_destroy(&paginas->trava);
+    free((void*)paginas->estados);
+    free(paginas->faixas);
+    free(paginas->anel);
+    free(paginas);
+    mapa->paginas = NULL;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file paginas.h
+ * @brief Mapa paginado: salas validadas ao primeiro acesso e páginas residentes limitadas.
+ *
+ * Um .dqm aberto com abrirMapaArquivo() já é lido do disco sob demanda pelo
+ * mmap, mas a validação completa (mapaValidar()) percorre todas as salas e
+ * pistas na abertura: em um mapa grande, a partida só começa depois de o
+ * arquivo inteiro passar pela memória, e ele continua residente.
+ *
+ * Com mapaAtivarPaginas(), as salas são agrupadas em páginas de PAGINAS_SALAS
+ * salas consecutivas. A abertura só confere a estrutura (mapaValidarEstrutura())
+ * e a página da raiz; as demais são validadas na primeira vez em que uma
+ * sessão entra nelas (sessaoSeguir() chama mapaGarantirSala()). A validação de
+ * uma página confere as suas salas, saídas e alvos, os textos das suas pistas e
+ * os nomes das salas vizinhas, que os jogos mostram nas saídas.
+ *
+ * As páginas residentes ficam em um anel compartilhado por todas as sessões,
+ * com capacidade fixa, que é uma aproximação de LRU pelo algoritmo do
+ * relógio: cada acesso marca a página como referenciada, e ao faltar espaço o
+ * ponteiro do relógio descarta a primeira página não referenciada, limpando o
+ * bit das que encontra no caminho. Descartar é só um aviso ao kernel
+ * (madvise(MADV_DONTNEED)) para soltar as páginas de memória daquelas salas: o
+ * mapeamento continua válido, e uma sessão que volte a elas apenas as lê de
+ * novo do arquivo. Assim a memória residente acompanha a área explorada
+ * recentemente, e não o tamanho do mapa.
+ *
+ * O acesso a uma página residente e referenciada é uma leitura atômica; só a
+ * carga e o descarte passam pela trava. A ordem alfabética das pistas não é
+ * conferida neste modo: um arquivo fora de ordem lista as pistas fora de ordem,
+ * mas nada é lido fora do mapeamento. As ferramentas que percorrem o mapa
+ * inteiro ou procuram em todas as pistas (solucionador, dicas e busca) devem
+ * usar a validação completa.
+ */
+
+#ifndef PAGINAS_H
+#define PAGINAS_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mapa.h"
+
+// --- Constantes das Páginas ---
+#define PAGINAS_SALAS 4096              // Salas por página (potência de 2)
+#define PAGINAS_RESIDENTES_PADRAO 64    // Páginas residentes quando a capacidade pedida é 0
+
+// Bits do estado de uma página
+#define PAGINA_VALIDADA     0x01u
+#define PAGINA_INVALIDA     0x02u // A validação falhou: as salas da página ficam inalcançáveis
+#define PAGINA_RESIDENTE    0x04u // Está no anel do relógio
+#define PAGINA_REFERENCIADA 0x08u // Acessada desde a última passagem do relógio
+
+// --- Estruturas ---
+
+// Trechos das seções do arquivo que pertencem a uma página, guardados na validação
+typedef struct FaixaPagina {
+    uint32_t inicioSaidas, fimSaidas;
+    uint32_t inicioAlvos, fimAlvos;
+    uint32_t inicioNomes, fimNomes; // Vazio se os nomes da página não forem contíguos no arquivo
+} FaixaPagina;
+
+typedef struct PaginasMapa {
+    _Atomic unsigned char *estados; // Por página: bits PAGINA_*
+    FaixaPagina *faixas;            // Por página, preenchida na validação
+    uint32_t totalPaginas;
+    uint32_t *anel;                 // Páginas residentes, na ordem do relógio
+    uint32_t capacidade;
+    uint32_t totalResidentes;
+    uint32_t ponteiro;              // Próxima posição do anel examinada pelo relógio
+    size_t tamanhoPaginaSistema;
+    pthread_mutex_t trava;          // Protege o anel e a validação
+} PaginasMapa;
+
+// --- Funções das Páginas ---
+
+/**
+ * @brief Passa a validar e a manter residentes as salas do mapa por página.
+ *
+ * Deve ser chamada logo depois de abrirMapaArquivo() com validar = 0, antes de
+ * iniciar sessões. fecharMapaArquivo() desativa as páginas.
+ * @param mapa Um mapa aberto de arquivo.
+ * @param capacidade Páginas residentes ao mesmo tempo (0 usa PAGINAS_RESIDENTES_PADRAO).
+ * @return 0 em caso de sucesso, -1 se a estrutura do mapa ou a página da raiz forem inválidas.
+ */
+int mapaAtivarPaginas(Mapa *mapa, uint32_t capacidade);
+
+/**
+ * @brief Libera as páginas do mapa; os vetores voltam a ser lidos sem controle.
+ */
+void mapaDesativarPaginas(Mapa *mapa);
+
+/**
+ * @brief Caminho lento de mapaGarantirSala(): valida a página, se preciso, e a põe no anel.
+ */
+int paginasCarregar(const Mapa *mapa, uint32_t sala);
+
+/**
+ * @brief Garante que a página de uma sala foi validada e a marca como usada.
+ *
+ * Sem páginas ativas (o caso comum), não faz nada.
+ * @return 1 se a sala pode ser lida, 0 se a sua página é inválida.
+ */
+static inline int mapaGarantirSala(const Mapa *mapa, uint32_t sala) {
+    PaginasMapa *paginas = mapa->paginas;
+    if (paginas == NULL) {
+        return 1;
+    }
+    _Atomic unsigned char *estado = &paginas->estados[sala / PAGINAS_SALAS];
+    unsigned atual = atomic_load_explicit(estado, memory_order_acquire);
+    if (atual & PAGINA_RESIDENTE) {
+        if (!(atual & PAGINA_REFERENCIADA)) {
+            atomic_fetch_or_explicit(estado, PAGINA_REFERENCIADA, memory_order_relaxed);
+        }
+        return 1;
+    }
+    return paginasCarregar(mapa, sala);
+}
+
+#endif // PAGINAS_H
@@ -0,0 +1,320 @@
+/**
+ * @file pistas.c
+ * @brief Implementação da árvore AVL de pistas.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "instrumentos.h"
+#include "pistas.h"
+
+// --- Funções Auxiliares de Balanceamento ---
+
+static int alturaPista(const PistaNode *no) {
+    return no != NULL ? no->altura : 0;
+}
+
+static void atualizarAlturaPista(PistaNode *no) {
+    int esquerda = alturaPista(no->esquerda);
+    int direita = alturaPista(no->direita);
+    no->altura = 1 + (esquerda > direita ? esquerda : direita);
+}
+
+static int fatorBalanceamentoPista(const PistaNode *no) {
+    return alturaPista(no->esquerda) - alturaPista(no->direita);
+}
+
+static PistaNode *rotacionarPistaDireita(PistaNode *no) {
+    PistaNode *novaRaiz = no->esquerda;
+    no->esquerda = novaRaiz->direita;
+    novaRaiz->direita = no;
+    atualizarAlturaPista(no);
+    atualizarAlturaPista(novaRaiz);
+    return novaRaiz;
+}
+
+static PistaNode *rotacionarPistaEsquerda(PistaNode *no) {
+    PistaNode *novaRaiz = no->direita;
+    no->direita = novaRaiz->esquerda;
+    novaRaiz->esquerda = no;
+    atualizarAlturaPista(no);
+    atualizarAlturaPista(novaRaiz);
+    return novaRaiz;
+}
+
+/**
+ * @brief Aplica a rotação simples ou dupla que corrige um nó desbalanceado.
+ * @return A nova raiz da subárvore.
+ */
+static PistaNode *rebalancearPista(PistaNode *no) {
+    int fator = fatorBalanceamentoPista(no);
+    INSTRUMENTAR_CONTAR(CONTADOR_ROTACOES_PISTA, fator > 1 || fator < -1);
+    if (fator > 1) {
+        if (fatorBalanceamentoPista(no->esquerda) < 0) {
+            no->esquerda = rotacionarPistaEsquerda(no->esquerda);
+        }
+        return rotacionarPistaDireita(no);
+    }
+    if (fator < -1) {
+        if (fatorBalanceamentoPista(no->direita) > 0) {
+            no->direita = rotacionarPistaDireita(no->direita);
+        }
+        return rotacionarPistaEsquerda(no);
+    }
+    return no;
+}
+
+// --- Implementação da Árvore de Pistas ---
+
+/**
+ * @brief Cria dinamicamente um novo nó de pista.
+ *
+ * Reaproveita um nó da lista livre do pool quando houver; caso contrário, aloca da arena.
+ * @param pool O pool de nós de pista da sessão.
+ * @param pista O id da pista.
+ * @return Um ponteiro para o novo PistaNode.
+ */
+static PistaNode *criarPistaNode(PoolNos *pool, uint32_t pista) {
+    PistaNode *novoNode = (PistaNode*)poolAlocar(pool);
+    novoNode->pista = pista;
+    novoNode->altura = 1;
+    novoNode->esquerda = NULL;
+    novoNode->direita = NULL;
+    return novoNode;
+}
+
+PistaNode *inserirPista(PoolNos *pool, PistaNode *raiz, uint32_t pista) {
+    PistaNode **caminho[PISTAS_ALTURA_MAXIMA];
+    int profundidade = 0;
+
+    // 1. Descida até a posição de inserção
+    PistaNode **ligacao = &raiz;
+    while (*ligacao != NULL) {
+        uint32_t atual = (*ligacao)->pista;
+        if (pista == atual) {
+            INSTRUMENTAR_CONTAR(CONTADOR_PISTAS_INSERIDAS, 1);
+            INSTRUMENTAR_CONTAR(CONTADOR_PISTAS_REPETIDAS, 1);
+            INSTRUMENTAR_CONTAR(CONTADOR_COMPARACOES_PISTA, profundidade + 1);
+            INSTRUMENTAR_HISTOGRAMA(HISTOGRAMA_DESCIDA_PISTA, profundidade + 1);
+            return raiz; // A pista já existe; não insere duplicata.
+        }
+        caminho[profundidade++] = ligacao;
+        ligacao = pista < atual ? &(*ligacao)->esquerda : &(*ligacao)->direita;
+    }
+    *ligacao = criarPistaNode(pool, pista);
+    INSTRUMENTAR_CONTAR(CONTADOR_PISTAS_INSERIDAS, 1);
+    INSTRUMENTAR_CONTAR(CONTADOR_COMPARACOES_PISTA, profundidade);
+    INSTRUMENTAR_HISTOGRAMA(HISTOGRAMA_DESCIDA_PISTA, profundidade);
+
+    // 2. Subida: atualiza alturas e corrige o primeiro nó desbalanceado
+    while (profundidade > 0) {
+        PistaNode **atual = caminho[--profundidade];
+        PistaNode *no = *atual;
+        int alturaAnterior = no->altura;
+
+        atualizarAlturaPista(no);
+        int fator = fatorBalanceamentoPista(no);
+        if (fator > 1 || fator < -1) {
+            *atual = rebalancearPista(no);
+            break; // Após a rotação a subárvore volta à altura anterior
+        }
+        if (no->altura == alturaAnterior) {
+            break; // Nada mudou acima deste ponto
+        }
+    }
+    return raiz;
+}
+
+// --- Construção em Lote ---
+
+/**
+ * @brief Ordena ids de pista no lugar: radix sort de 8 bits por passada, pulando as passadas sem efeito.
+ */
+static void ordenarIdsPistas(uint32_t *ids, uint32_t total) {
+    uint32_t ordenados = 1;
+    while (ordenados < total && ids[ordenados - 1] <= ids[ordenados]) {
+        ordenados++;
+    }
+    if (ordenados >= total) {
+        return;
+    }
+
+    uint32_t *auxiliar = (uint32_t*)malloc((size_t)total * sizeof(uint32_t));
+    if (auxiliar == NULL) {
+        printf("Erro de alocação de memória para a Árvore de Pistas!\n");
+        exit(EXIT_FAILURE);
+    }
+    uint32_t *origem = ids;
+    uint32_t *destino = auxiliar;
+    for (unsigned deslocamento = 0; deslocamento < 32; deslocamento += 8) {
+        uint32_t contagem[256] = { 0 };
+        for (uint32_t i = 0; i < total; i++) {
+            contagem[(origem[i] >> deslocamento) & 255]++;
+        }
+        if (contagem[(origem[0] >> deslocamento) & 255] == total) {
+            continue; // Todos os ids têm este byte igual (ex.: o byte alto de ids pequenos)
+        }
+        uint32_t posicao = 0;
+        for (unsigned byte = 0; byte < 256; byte++) {
+            uint32_t quantidade = contagem[byte];
+            contagem[byte] = posicao;
+            posicao += quantidade;
+        }
+        for (uint32_t i = 0; i < total; i++) {
+            destino[contagem[(origem[i] >> deslocamento) & 255]++] = origem[i];
+        }
+        uint32_t *troca = origem;
+        origem = destino;
+        destino = troca;
+    }
+    if (origem != ids) {
+        memcpy(ids, origem, (size_t)total * sizeof(uint32_t));
+    }
+    free(auxiliar);
+}
+
+/**
+ * @brief Liga nós já em ordem de pista em uma árvore perfeitamente balanceada.
+ *
+ * O nó do meio de cada intervalo vira a raiz dele; com a metade maior sempre à
+ * esquerda, um intervalo de s nós tem altura igual ao número de bits de s, e
+ * as duas subárvores de cada nó diferem em no máximo um nível. Os intervalos
+ * pendentes ficam em uma pilha explícita, no máximo um por nível mais um.
+ * @return A raiz da árvore.
+ */
+static PistaNode *ligarPistasOrdenadas(PistaNode *nos, uint32_t total) {
+    struct {
+        uint32_t inicio;
+        uint32_t fim;
+        PistaNode **ligacao;
+    } pilha[PISTAS_ALTURA_MAXIMA + 1];
+    int topo = 0;
+    PistaNode *raiz = NULL;
+
+    pilha[topo].inicio = 0;
+    pilha[topo].fim = total;
+    pilha[topo++].ligacao = &raiz;
+    while (topo > 0) {
+        topo--;
+        uint32_t inicio = pilha[topo].inicio;
+        uint32_t fim = pilha[topo].fim;
+        PistaNode **ligacao = pilha[topo].ligacao;
+        if (inicio == fim) {
+            *ligacao = NULL;
+            continue;
+        }
+        uint32_t tamanho = fim - inicio;
+        uint32_t meio = inicio + tamanho / 2;
+        PistaNode *no = &nos[meio];
+        no->altura = 32 - __builtin_clz(tamanho);
+        *ligacao = no;
+
+        // A esquerda sai primeiro da pilha: os nós são visitados em pré-ordem
+        pilha[topo].inicio = meio + 1;
+        pilha[topo].fim = fim;
+        pilha[topo++].ligacao = &no->direita;
+        pilha[topo].inicio = inicio;
+        pilha[topo].fim = meio;
+        pilha[topo++].ligacao = &no->esquerda;
+    }
+    return raiz;
+}
+
+PistaNode *construirPistas(PoolNos *pool, uint32_t *ids, uint32_t total) {
+    if (total == 0) {
+        return NULL;
+    }
+    ordenarIdsPistas(ids, total);
+    uint32_t distintos = 1;
+    for (uint32_t i = 1; i < total; i++) {
+        if (ids[i] != ids[distintos - 1]) {
+            ids[distintos++] = ids[i];
+        }
+    }
+
+    PistaNode *nos = (PistaNode*)arenaAlocar(pool->arena, (size_t)distintos * sizeof(PistaNode));
+    for (uint32_t i = 0; i < distintos; i++) {
+        nos[i].pista = ids[i];
+    }
+    return ligarPistasOrdenadas(nos, distintos);
+}
+
+/**
+ * @brief Conta os nós de uma árvore com um percurso em ordem.
+ */
+static uint32_t contarPistas(const PistaNode *raiz) {
+    IteradorPistas iterador;
+    iniciarIteradorPistas(&iterador, raiz);
+    uint32_t total = 0;
+    while (proximaPista(&iterador) != TEXTO_NENHUM) {
+        total++;
+    }
+    return total;
+}
+
+PistaNode *mesclarPistas(PoolNos *pool, const PistaNode *a, const PistaNode *b) {
+    uint32_t capacidade = contarPistas(a) + contarPistas(b);
+    if (capacidade == 0) {
+        return NULL;
+    }
+    PistaNode *nos = (PistaNode*)arenaAlocar(pool->arena, (size_t)capacidade * sizeof(PistaNode));
+
+    // Intercalação das duas sequências em ordem; TEXTO_NENHUM é maior que qualquer id
+    IteradorPistas iteradorA, iteradorB;
+    iniciarIteradorPistas(&iteradorA, a);
+    iniciarIteradorPistas(&iteradorB, b);
+    uint32_t pistaA = proximaPista(&iteradorA);
+    uint32_t pistaB = proximaPista(&iteradorB);
+    uint32_t total = 0;
+    while (pistaA != TEXTO_NENHUM || pistaB != TEXTO_NENHUM) {
+        uint32_t menor = pistaA < pistaB ? pistaA : pistaB;
+        nos[total++].pista = menor;
+        if (pistaA == menor) {
+            pistaA = proximaPista(&iteradorA);
+        }
+        if (pistaB == menor) {
+            pistaB = proximaPista(&iteradorB);
+        }
+    }
+    return ligarPistasOrdenadas(nos, total);
+}
+
+// --- Funções de Exibição ---
+
+void anexarPistas(Saida *saida, const PistaNode *raiz, const Internador *pistas) {
+    IteradorPistas iterador;
+    iniciarIteradorPistas(&iterador, raiz);
+    for (uint32_t pista = proximaPista(&iterador); pista != TEXTO_NENHUM; pista = proximaPista(&iterador)) {
+        saidaBytes(saida, "  - ", 4);
+        saidaBytes(saida, textoDoId(pistas, pista), tamanhoDoId(pistas, pista));
+        saidaBytes(saida, "\n", 1);
+    }
+}
+
+void exibirPistas(PistaNode *raiz, const Internador *pistas) {
+    Saida saida;
+    iniciarSaida(&saida, STDOUT_FILENO, SAIDA_TEXTO);
+    anexarPistas(&saida, raiz, pistas);
+    saidaDescarregar(&saida);
+    liberarSaida(&saida);
+}
+
+void liberarPistas(PoolNos *pool, PistaNode *raiz) {
+    while (raiz != NULL) {
+        PistaNode *esquerda = raiz->esquerda;
+        if (esquerda == NULL) {
+            // Sem filho à esquerda: o nó sai e o percurso segue pela direita
+            PistaNode *direita = raiz->direita;
+            poolDevolver(pool, raiz);
+            raiz = direita;
+        } else {
+            // Rotação à direita: o filho esquerdo sobe, e a árvore vira uma lista
+            raiz->esquerda = esquerda->direita;
+            esquerda->direita = raiz;
+            raiz = esquerda;
+        }
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * @file pistas.h
+ * @brief Árvore de pistas coletadas: BST balanceada (AVL) em ordem alfabética.
+ *
+ * Mantém a mesma interface da BST original (inserirPista() devolve a nova raiz,
+ * exibirPistas() percorre em ordem), mas rebalanceia a cada inserção. Assim a
+ * altura fica limitada a ~1,44·log2(n) mesmo quando as pistas chegam ordenadas,
+ * e a inserção percorre a árvore com um laço e uma pilha explícita de caminho.
+ *
+ * Os nós guardam o id internado da pista. Como mapaFinalizar() numera as pistas
+ * em ordem alfabética, a árvore compara ids inteiros em vez de strings.
+ *
+ * Nenhum percurso é recursivo: a sequência em ordem sai de um IteradorPistas,
+ * cuja pilha explícita cabe na própria estrutura (a altura da AVL é limitada),
+ * e liberarPistas() desmonta a árvore com rotações, sem pilha alguma.
+ *
+ * Quando as pistas já são conhecidas de antemão (uma retomada, um registro a
+ * reproduzir), construirPistas() monta a árvore de uma vez a partir de um
+ * vetor de ids, e mesclarPistas() junta duas árvores: as duas em O(n), com
+ * todos os nós em uma única fatia da arena e a árvore perfeitamente
+ * balanceada (que é também uma AVL válida para inserções seguintes).
+ *
+ * As sessões do motor (motor.h) guardam as pistas coletadas em um
+ * ConjuntoPistas (conjunto.h), sem nós por pista; a árvore continua disponível
+ * para quem precisa de uma coleção própria de ids.
+ */
+
+#ifndef PISTAS_H
+#define PISTAS_H
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "internador.h"
+#include "saida.h"
+
+// --- Constantes da Árvore de Pistas ---
+// Uma AVL com 2^32 nós tem altura menor que 46
+#define PISTAS_ALTURA_MAXIMA 64
+
+// --- Estrutura do nó da Árvore de Pistas ---
+
+typedef struct PistaNode {
+    uint32_t pista; // Id da pista no internador de pistas do mapa
+    int altura; // Altura da subárvore com raiz neste nó (folha = 1)
+    struct PistaNode *esquerda;
+    struct PistaNode *direita;
+} PistaNode;
+
+// Percurso em ordem sem recursão: a pilha guarda os nós cuja subárvore esquerda
+// já foi empilhada e que ainda não foram visitados; `proximo` é a subárvore
+// direita que falta descer.
+typedef struct IteradorPistas {
+    const PistaNode *pilha[PISTAS_ALTURA_MAXIMA];
+    int topo;
+    const PistaNode *proximo;
+} IteradorPistas;
+
+// --- Funções da Árvore de Pistas ---
+
+/**
+ * @brief Insere uma pista na árvore, mantendo-a balanceada.
+ *
+ * A descida guarda em uma pilha os ponteiros de ligação visitados; na volta, as
+ * alturas são atualizadas e no máximo uma rotação (simples ou dupla) é aplicada.
+ * Se a pista já existir, a árvore não é alterada.
+ * @param pool O pool de onde saem os novos nós.
+ * @param raiz A raiz atual da árvore (NULL para árvore vazia).
+ * @param pista O id da pista a ser inserida.
+ * @return O ponteiro para a raiz atualizada.
+ */
+PistaNode *inserirPista(PoolNos *pool, PistaNode *raiz, uint32_t pista);
+
+// --- Construção em Lote ---
+
+/**
+ * @brief Monta uma árvore perfeitamente balanceada com um lote de ids.
+ *
+ * O vetor é ordenado no lugar (radix sort; um vetor já em ordem é só
+ * conferido) e as repetições são descartadas, como inserirPista() faz com uma
+ * pista que já está na árvore. Os nós saem de uma única fatia da arena do
+ * pool, na ordem das pistas: o percurso em ordem lê a memória em sequência.
+ * Eles podem voltar ao pool com liberarPistas(), como os de inserirPista().
+ * @param pool O pool cuja arena fornece os nós.
+ * @param ids Os ids das pistas, em qualquer ordem e com repetições (é reordenado).
+ * @param total A quantidade de ids.
+ * @return A raiz da árvore (NULL para lote vazio).
+ */
+PistaNode *construirPistas(PoolNos *pool, uint32_t *ids, uint32_t total);
+
+/**
+ * @brief Monta uma nova árvore balanceada com as pistas de duas árvores, sem repetições.
+ *
+ * As duas árvores são percorridas em ordem ao mesmo tempo e não são alteradas
+ * (podem ser liberadas depois). A fatia de nós é reservada para a soma dos dois
+ * tamanhos; as pistas em comum deixam esse espaço sem uso até a arena ser reiniciada.
+ * @param pool O pool cuja arena fornece os nós.
+ * @param a A raiz da primeira árvore (pode ser NULL).
+ * @param b A raiz da segunda árvore (pode ser NULL).
+ * @return A raiz da nova árvore (NULL se as duas forem vazias).
+ */
+PistaNode *mesclarPistas(PoolNos *pool, const PistaNode *a, const PistaNode *b);
+
+// --- Iterador em Ordem ---
+
+/**
+ * @brief Posiciona o iterador antes da menor pista da árvore.
+ * @param iterador O iterador (sem alocação; pode ficar na pilha do chamador).
+ * @param raiz A raiz da árvore de pistas (NULL para árvore vazia).
+ */
+static inline void iniciarIteradorPistas(IteradorPistas *iterador, const PistaNode *raiz) {
+    iterador->topo = 0;
+    iterador->proximo = raiz;
+}
+
+/**
+ * @brief Avança para a próxima pista em ordem alfabética (Esquerda -> Raiz -> Direita).
+ *
+ * A árvore não pode ser alterada enquanto o iterador estiver em uso.
+ * @return O id da pista, ou TEXTO_NENHUM ao final da árvore.
+ */
+static inline uint32_t proximaPista(IteradorPistas *iterador) {
+    for (const PistaNode *no = iterador->proximo; no != NULL; no = no->esquerda) {
+        iterador->pilha[iterador->topo++] = no;
+    }
+    if (iterador->topo == 0) {
+        return TEXTO_NENHUM;
+    }
+    const PistaNode *no = iterador->pilha[--iterador->topo];
+    iterador->proximo = no->direita;
+    return no->pista;
+}
+
+// --- Funções de Exibição ---
+
+/**
+ * @brief Acrescenta a Árvore de Pistas, em ordem alfabética, a uma saída (Caminhamento In-Order).
+ *
+ * Visita: Esquerda -> Raiz -> Direita, uma linha "  - <pista>" por nó, com um
+ * IteradorPistas.
+ * @param saida A saída que recebe as linhas.
+ * @param raiz O nó raiz atual da árvore de pistas.
+ * @param pistas O internador que contém os textos das pistas.
+ */
+void anexarPistas(Saida *saida, const PistaNode *raiz, const Internador *pistas);
+
+/**
+ * @brief Imprime a Árvore de Pistas em ordem alfabética, com uma única escrita.
+ * @param raiz O nó raiz atual da árvore de pistas.
+ * @param pistas O internador que contém os textos das pistas.
+ */
+void exibirPistas(PistaNode *raiz, const Internador *pistas);
+
+/**
+ * @brief Devolve os nós da árvore de pistas ao pool para serem reaproveitados.
+ *
+ * Útil para iniciar uma nova exploração sem novas alocações. A memória em si
+ * só é liberada junto com a arena da sessão. A árvore é desmontada com
+ * rotações à direita, sem pilha, e não precisa estar balanceada.
+ */
+void liberarPistas(PoolNos *pool, PistaNode *raiz);
+
+#endif // PISTAS_H
@@ -0,0 +1,252 @@
+/**
+ * @file protocolo.c
+ * @brief Implementação do protocolo de partidas remotas.
+ */
+
+#include <string.h>
+
+#include "instrumentos.h"
+#include "protocolo.h"
+
+// --- Ciclo de Vida da Partida ---
+
+void iniciarPartida(Partida *partida, const Mapa *mapa, Diario *diario) {
+    iniciarSessaoComBloco(&partida->sessao, mapa, PROTOCOLO_BLOCO_SESSAO);
+    if (diario != NULL) {
+        sessaoAtivarDiario(&partida->sessao, diario);
+    }
+    sessaoColetar(&partida->sessao);
+    partida->estado = PARTIDA_EXPLORANDO;
+}
+
+void encerrarPartida(Partida *partida) {
+    encerrarSessao(&partida->sessao);
+}
+
+size_t partidaMemoria(const Partida *partida) {
+    return sizeof(Partida) + sessaoMemoria(&partida->sessao);
+}
+
+// --- Respostas ---
+
+static const char *nomeVeredito(Veredito veredito) {
+    switch (veredito) {
+        case VEREDITO_SUSTENTADO: return "SUSTENTADA";
+        case VEREDITO_FRACO:      return "FRACA";
+        default:                  return "SEM_PISTAS";
+    }
+}
+
+static void anexarErro(Saida *resposta, const char *mensagem) {
+    saidaTexto(resposta, "{\"evento\":\"erro\",\"mensagem\":");
+    saidaJsonTexto(resposta, mensagem);
+    saidaTexto(resposta, "}\n");
+}
+
+static void anexarLogico(Saida *resposta, int valor) {
+    saidaTexto(resposta, valor ? "true" : "false");
+}
+
+/**
+ * @brief Resposta de "e" (e de "n"): a sala atual com as saídas e as contagens da partida.
+ */
+static void anexarEstado(Saida *resposta, const Partida *partida) {
+    const Sessao *sessao = &partida->sessao;
+    const Mapa *mapa = sessao->mapa;
+    saidaTexto(resposta, "{\"evento\":\"estado\",\"sala\":");
+    if (mapa->totalSalas == 0) {
+        saidaTexto(resposta, "null,\"pista\":null,\"saidas\":[");
+    } else {
+        uint32_t sala = sessao->salaAtual;
+        saidaJsonTexto(resposta, mapaNomeSala(mapa, sala));
+        saidaTexto(resposta, ",\"pista\":");
+        if (mapa->salas[sala].pista != TEXTO_NENHUM) {
+            saidaJsonTexto(resposta, mapaPistaSala(mapa, sala));
+        } else {
+            saidaBytes(resposta, "null", 4);
+        }
+        saidaTexto(resposta, ",\"saidas\":[");
+        const SaidaSala *saidas = mapaSaidas(mapa, sala);
+        uint32_t totalSaidas = mapaTotalSaidas(mapa, sala);
+        for (uint32_t i = 0; i < totalSaidas; i++) {
+            char tecla[2] = { saidas[i].tecla, '\0' };
+            saidaTexto(resposta, i > 0 ? ",{\"tecla\":" : "{\"tecla\":");
+            if (tecla[0] != '\0') {
+                saidaJsonTexto(resposta, tecla);
+            } else {
+                saidaBytes(resposta, "null", 4);
+            }
+            saidaTexto(resposta, ",\"sala\":");
+            saidaJsonTexto(resposta, mapaNomeSala(mapa, saidas[i].destino));
+            saidaBytes(resposta, "}", 1);
+        }
+    }
+    saidaTexto(resposta, "],\"movimentos\":");
+    saidaNumero(resposta, sessao->movimentos);
+    saidaTexto(resposta, ",\"pistas\":");
+    saidaNumero(resposta, sessao->totalPistas);
+    saidaTexto(resposta, ",\"encerrada\":");
+    anexarLogico(resposta, sessao->encerrada);
+    saidaTexto(resposta, ",\"julgada\":");
+    anexarLogico(resposta, partida->estado == PARTIDA_JULGADA);
+    saidaTexto(resposta, "}\n");
+}
+
+// --- Requisições ---
+
+/**
+ * @brief "m <teclas>": cada tecla é um movimento, e a pista de cada sala nova é coletada ao entrar.
+ */
+static void atenderMover(Partida *partida, const char *teclas, Saida *resposta) {
+    Sessao *sessao = &partida->sessao;
+    if (partida->estado == PARTIDA_JULGADA) {
+        anexarErro(resposta, "partida julgada; use \"n\" para recomeçar");
+        return;
+    }
+    uint32_t recusados = 0;
+    int primeira = 1;
+    saidaTexto(resposta, "{\"evento\":\"movimento\",\"coletadas\":[");
+    for (const char *c = teclas; *c != '\0' && !sessao->encerrada; c++) {
+        if (*c == ' ' || *c == '\t') {
+            continue;
+        }
+        Movimento movimento = sessaoMover(sessao, *c);
+        if (movimento == MOVIMENTO_OK) {
+            uint32_t pista = sessaoColetar(sessao);
+            if (pista != TEXTO_NENHUM) {
+                if (!primeira) {
+                    saidaBytes(resposta, ",", 1);
+                }
+                primeira = 0;
+                saidaJsonTexto(resposta, textoDoId(&sessao->mapa->pistas, pista));
+            }
+        } else if (movimento != MOVIMENTO_SAIR) {
+            recusados++;
+        }
+    }
+    saidaTexto(resposta, "],\"sala\":");
+    if (sessao->mapa->totalSalas > 0) {
+        saidaJsonTexto(resposta, mapaNomeSala(sessao->mapa, sessao->salaAtual));
+    } else {
+        saidaBytes(resposta, "null", 4);
+    }
+    saidaTexto(resposta, ",\"movimentos\":");
+    saidaNumero(resposta, sessao->movimentos);
+    saidaTexto(resposta, ",\"recusados\":");
+    saidaNumero(resposta, recusados);
+    saidaTexto(resposta, ",\"pistas\":");
+    saidaNumero(resposta, sessao->totalPistas);
+    saidaTexto(resposta, ",\"encerrada\":");
+    anexarLogico(resposta, sessao->encerrada);
+    saidaTexto(resposta, "}\n");
+}
+
+static void atenderPistas(const Partida *partida, Saida *resposta) {
+    const Sessao *sessao = &partida->sessao;
+    IteradorConjunto iterador;
+    iniciarIteradorConjunto(&iterador, &sessao->pistas);
+    saidaTexto(resposta, "{\"evento\":\"pistas\",\"pistas\":[");
+    int primeira = 1;
+    for (uint32_t pista = proximaPistaConjunto(&iterador); pista != TEXTO_NENHUM; pista = proximaPistaConjunto(&iterador)) {
+        if (!primeira) {
+            saidaBytes(resposta, ",", 1);
+        }
+        primeira = 0;
+        saidaJsonTexto(resposta, textoDoId(&sessao->mapa->pistas, pista));
+    }
+    saidaTexto(resposta, "]}\n");
+}
+
+/**
+ * @brief "a <suspeito>": a mesma avaliação de verificarSuspeitoFinal(), uma vez por partida.
+ */
+static void atenderAcusar(Partida *partida, const char *acusado, Saida *resposta) {
+    if (partida->estado == PARTIDA_JULGADA) {
+        anexarErro(resposta, "partida julgada; use \"n\" para recomeçar");
+        return;
+    }
+    if (acusado[0] == '\0') {
+        anexarErro(resposta, "informe o suspeito: a <nome>");
+        return;
+    }
+    sessaoSair(&partida->sessao);
+    partida->estado = PARTIDA_JULGADA;
+
+    uint32_t contagem;
+    Veredito veredito = sessaoAcusar(&partida->sessao, acusado, &contagem);
+    saidaTexto(resposta, "{\"evento\":\"julgamento\",\"acusado\":");
+    saidaJsonTexto(resposta, acusado);
+    saidaTexto(resposta, ",\"contagem\":");
+    saidaNumero(resposta, contagem);
+    saidaTexto(resposta, ",\"minimo\":");
+    saidaNumero(resposta, PISTAS_MINIMAS_ACUSACAO);
+    saidaTexto(resposta, ",\"veredito\":\"");
+    saidaTexto(resposta, nomeVeredito(veredito));
+    saidaTexto(resposta, "\"}\n");
+}
+
+/**
+ * @brief Separa o comando (primeira palavra) do argumento, tirando os espaços das pontas.
+ * @return O argumento, "" se não houver.
+ */
+static char *separarComando(char *linha) {
+    char *fim = linha + strlen(linha);
+    while (fim > linha && (fim[-1] == ' ' || fim[-1] == '\t' || fim[-1] == '\r')) {
+        *--fim = '\0';
+    }
+    char *argumento = linha;
+    while (*argumento != '\0' && *argumento != ' ' && *argumento != '\t') {
+        argumento++;
+    }
+    if (*argumento != '\0') {
+        *argumento++ = '\0';
+        while (*argumento == ' ' || *argumento == '\t') {
+            argumento++;
+        }
+    }
+    return argumento;
+}
+
+/**
+ * @brief Compara o comando com a forma curta e a longa.
+ */
+static int comandoE(const char *comando, const char *curta, const char *longa) {
+    return strcmp(comando, curta) == 0 || strcmp(comando, longa) == 0;
+}
+
+Atendimento atenderRequisicao(Partida *partida, char *linha, Saida *resposta) {
+    while (*linha == ' ' || *linha == '\t') {
+        linha++;
+    }
+    char *argumento = separarComando(linha);
+    if (linha[0] == '\0') {
+        return ATENDIMENTO_CONTINUAR; // Linha em branco: sem resposta
+    }
+
+    INSTRUMENTAR_INICIO("requisicao");
+    INSTRUMENTAR_RELOGIO(inicio);
+    INSTRUMENTAR_CONTAR(CONTADOR_REQUISICOES, 1);
+    Atendimento atendimento = ATENDIMENTO_CONTINUAR;
+    if (comandoE(linha, "m", "mover")) {
+        atenderMover(partida, argumento, resposta);
+    } else if (comandoE(linha, "e", "estado")) {
+        anexarEstado(resposta, partida);
+    } else if (comandoE(linha, "p", "pistas")) {
+        atenderPistas(partida, resposta);
+    } else if (comandoE(linha, "a", "acusar")) {
+        atenderAcusar(partida, argumento, resposta);
+    } else if (comandoE(linha, "n", "novo")) {
+        reiniciarSessao(&partida->sessao);
+        sessaoColetar(&partida->sessao);
+        partida->estado = PARTIDA_EXPLORANDO;
+        anexarEstado(resposta, partida);
+    } else if (comandoE(linha, "f", "fim")) {
+        saidaTexto(resposta, "{\"evento\":\"fim\"}\n");
+        atendimento = ATENDIMENTO_FECHAR;
+    } else {
+        anexarErro(resposta, "requisição desconhecida; use m, e, p, a, n ou f");
+    }
+    INSTRUMENTAR_DURACAO(HISTOGRAMA_REQUISICAO_NS, inicio);
+    INSTRUMENTAR_FIM("requisicao");
+    return atendimento;
+}
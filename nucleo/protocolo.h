@@ -0,0 +1,98 @@
+/**
+ * @file protocolo.h
+ * @brief Protocolo de requisição e resposta de uma partida remota, sem entrada e saída.
+ *
+ * Uma Partida é a máquina de estados de um jogador conectado ao servidor
+ * (servidor.h): a sessão do motor (sala atual, pistas coletadas, placar dos
+ * suspeitos) e a fase do jogo. atenderRequisicao() recebe uma linha já
+ * separada pelo servidor e acrescenta a resposta, um objeto JSON por linha
+ * como no "--json" do nível mestre, a uma Saida; quem lê o socket e quem
+ * escreve a resposta é o servidor. Assim o protocolo roda igual sobre um
+ * arquivo, um pipe ou milhares de conexões.
+ *
+ * Requisições (uma por linha, sem resposta para linhas em branco; o comando
+ * tem uma forma curta e uma longa):
+ *
+ *   m <teclas>    (mover)   Aplica as teclas em ordem, como um roteiro de simularSessao()
+ *   e             (estado)  Sala atual, saídas e contagens
+ *   p             (pistas)  Pistas coletadas, em ordem alfabética
+ *   a <suspeito>  (acusar)  Encerra a exploração e julga o acusado
+ *   n             (novo)    Recomeça a partida na sala inicial
+ *   f             (fim)     Encerra a conexão
+ *
+ * Respostas:
+ *
+ *   {"evento":"movimento","coletadas":[...],"sala":...,"movimentos":N,"recusados":N,"pistas":N,"encerrada":...}
+ *   {"evento":"estado","sala":...,"pista":...|null,"saidas":[{"tecla":...|null,"sala":...},...],
+ *    "movimentos":N,"pistas":N,"encerrada":...,"julgada":...}
+ *   {"evento":"pistas","pistas":[...]}
+ *   {"evento":"julgamento","acusado":...,"contagem":N,"minimo":N,"veredito":...}
+ *   {"evento":"fim"}
+ *   {"evento":"erro","mensagem":...}
+ *
+ * "coletadas" são as pistas coletadas pelos movimentos da requisição;
+ * "recusados", os movimentos bloqueados ou inválidos dela. Depois do
+ * julgamento a partida só aceita consultas, "n" e "f".
+ */
+
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <stddef.h>
+
+#include "diario.h"
+#include "mapa.h"
+#include "motor.h"
+#include "saida.h"
+
+// --- Constantes do Protocolo ---
+#define PROTOCOLO_BLOCO_SESSAO 4096 // Primeiro bloco da arena de cada partida (iniciarSessaoComBloco())
+
+// --- Estruturas ---
+
+typedef enum EstadoPartida {
+    PARTIDA_EXPLORANDO, // Aceita movimentos; 's' ou a acusação encerram a exploração
+    PARTIDA_JULGADA     // Já houve acusação: só consultas, "n" ou "f"
+} EstadoPartida;
+
+// Resultado de atenderRequisicao()
+typedef enum Atendimento {
+    ATENDIMENTO_CONTINUAR,
+    ATENDIMENTO_FECHAR  // O jogador pediu "f": enviar a resposta e fechar a conexão
+} Atendimento;
+
+typedef struct Partida {
+    Sessao sessao;
+    EstadoPartida estado;
+} Partida;
+
+// --- Funções do Protocolo ---
+
+/**
+ * @brief Inicia uma partida na sala raiz, já com a pista da sala inicial coletada.
+ * @param partida O ponteiro para a partida.
+ * @param mapa O mapa finalizado, compartilhado com as outras partidas.
+ * @param diario O diário em que as partidas da conexão são registradas (NULL: sem diário).
+ */
+void iniciarPartida(Partida *partida, const Mapa *mapa, Diario *diario);
+
+/**
+ * @brief Libera a sessão da partida.
+ */
+void encerrarPartida(Partida *partida);
+
+/**
+ * @brief Memória reservada pela partida, incluindo o próprio struct (sessaoMemoria() e sizeof(Partida)).
+ */
+size_t partidaMemoria(const Partida *partida);
+
+/**
+ * @brief Executa uma requisição e acrescenta a resposta (uma linha JSON) à saída.
+ * @param partida A partida do jogador.
+ * @param linha A requisição, terminada em '\0' e sem o '\n'; pode ser alterada.
+ * @param resposta A saída que recebe a resposta.
+ * @return ATENDIMENTO_FECHAR depois de "f", ATENDIMENTO_CONTINUAR nos demais casos.
+ */
+Atendimento atenderRequisicao(Partida *partida, char *linha, Saida *resposta);
+
+#endif // PROTOCOLO_H
@@ -0,0 +1,222 @@
+/**
+ * @file retrato.c
+ * @brief Implementação do retrato binário de sessões.
+ */
+
+#include <string.h>
+
+#include "diario.h"
+#include "paginas.h"
+#include "retrato.h"
+
+// --- Seções ---
+
+/**
+ * @brief Quantidade de palavras não nulas do conjunto de pistas (as marcadas no resumo).
+ */
+static uint32_t retratoPalavras(const ConjuntoPistas *pistas) {
+    uint32_t total = 0;
+    uint32_t totalGrupos = (pistas->totalPalavras + 63) / 64;
+    for (uint32_t grupo = 0; grupo < totalGrupos; grupo++) {
+        total += (uint32_t)__builtin_popcountll(pistas->resumo[grupo]);
+    }
+    return total;
+}
+
+/**
+ * @brief Copia uma seção para o retrato.
+ * @return O ponto do retrato logo depois dela.
+ */
+static unsigned char *retratoCopiar(unsigned char *destino, const void *origem, size_t tamanho) {
+    if (tamanho > 0) {
+        memcpy(destino, origem, tamanho);
+    }
+    return destino + tamanho;
+}
+
+/**
+ * @brief Copia as seções de um retrato para a sessão reiniciada, conferindo cada uma com o mapa.
+ * @return 0, ou -1 se alguma seção for inválida (a sessão fica então pela metade).
+ */
+static int retratoCarregar(Sessao *sessao, const RetratoCabecalho *cabecalho, const unsigned char *secoes) {
+    const Mapa *mapa = sessao->mapa;
+    const unsigned char *salas = secoes;
+    const unsigned char *indices = salas + (size_t)cabecalho->totalColetadas * sizeof(uint32_t);
+    const unsigned char *palavras = indices + (size_t)cabecalho->totalPalavras * sizeof(uint32_t);
+    const unsigned char *posicoes = palavras + (size_t)cabecalho->totalPalavras * sizeof(uint64_t);
+    const unsigned char *contagens = posicoes + (size_t)cabecalho->capacidadeHash * sizeof(HashPosicao);
+
+    // 1. Conjunto de pistas: palavras em ordem, sem bits além da última pista do mapa
+    ConjuntoPistas *pistas = &sessao->pistas;
+    uint64_t minimo = 0; // Índice mínimo da próxima palavra
+    for (uint32_t i = 0; i < cabecalho->totalPalavras; i++) {
+        uint32_t indice;
+        uint64_t palavra;
+        memcpy(&indice, indices + (size_t)i * sizeof(uint32_t), sizeof(indice));
+        memcpy(&palavra, palavras + (size_t)i * sizeof(uint64_t), sizeof(palavra));
+        if (indice < minimo || indice >= pistas->totalPalavras || palavra == 0 ||
+            (uint64_t)indice * 64 + 63 - (uint64_t)__builtin_clzll(palavra) >= mapa->pistas.total) {
+            return -1;
+        }
+        conjuntoCarregarPalavra(pistas, indice, palavra);
+        minimo = (uint64_t)indice + 1;
+    }
+    if (pistas->total != cabecalho->totalPistas) {
+        return -1;
+    }
+
+    // 2. Hash pista -> sala: uma entrada por pista do conjunto, cada uma com a sala de onde veio
+    SuspeitoHash *hash = &sessao->hashSuspeitos;
+    if (carregarHash(hash, posicoes, cabecalho->capacidadeHash) != 0 || hash->total != pistas->total) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < hash->capacidade; i++) {
+        const HashPosicao *posicao = &hash->posicoes[i];
+        if (posicao->distancia != 0 &&
+            (posicao->pista >= mapa->pistas.total || !conjuntoContem(pistas, posicao->pista) ||
+             posicao->alvo >= mapa->totalSalas || !mapaGarantirSala(mapa, posicao->alvo) ||
+             mapa->salas[posicao->alvo].pista != posicao->pista)) {
+            return -1;
+        }
+    }
+
+    // 3. Placar: recalculado com os pesos das salas de origem da hash, e tem de ser o gravado
+    for (uint32_t i = 0; i < hash->capacidade; i++) {
+        const HashPosicao *posicao = &hash->posicoes[i];
+        if (posicao->distancia == 0) {
+            continue;
+        }
+        const AlvoPeso *alvos = mapaAlvos(mapa, posicao->alvo);
+        for (uint32_t a = 0; a < mapaTotalAlvos(mapa, posicao->alvo); a++) {
+            placarSomar(&sessao->placar, alvos[a].suspeito, alvos[a].peso);
+        }
+    }
+    for (uint32_t suspeito = 0; suspeito < cabecalho->totalSuspeitos; suspeito++) {
+        uint32_t gravada;
+        memcpy(&gravada, contagens + (size_t)suspeito * sizeof(uint32_t), sizeof(gravada));
+        if (gravada != sessao->placar.contagens[suspeito]) {
+            return -1;
+        }
+    }
+
+    // 4. Marcas das salas coletadas (cada sala com uma pista do conjunto, uma única vez)
+    for (uint32_t i = 0; i < cabecalho->totalColetadas; i++) {
+        uint32_t sala;
+        memcpy(&sala, salas + (size_t)i * sizeof(uint32_t), sizeof(sala));
+        if (sala >= mapa->totalSalas || !mapaGarantirSala(mapa, sala)) {
+            return -1;
+        }
+        uint32_t pista = sessaoPistaDisponivel(sessao, sala);
+        if (pista == TEXTO_NENHUM || !conjuntoContem(pistas, pista)) {
+            return -1;
+        }
+        sessaoMarcarColetada(sessao, sala);
+    }
+    return 0;
+}
+
+// --- Implementação do Retrato ---
+
+size_t retratoTamanho(const Sessao *sessao) {
+    return sizeof(RetratoCabecalho) + (size_t)sessao->totalColetadas * sizeof(uint32_t) +
+           (size_t)retratoPalavras(&sessao->pistas) * (sizeof(uint32_t) + sizeof(uint64_t)) +
+           (size_t)sessao->hashSuspeitos.capacidade * sizeof(HashPosicao) +
+           (size_t)sessao->placar.totalSuspeitos * sizeof(uint32_t);
+}
+
+size_t salvarRetrato(const Sessao *sessao, unsigned char *destino, size_t capacidade) {
+    size_t tamanho = retratoTamanho(sessao);
+    if (capacidade < tamanho) {
+        return tamanho;
+    }
+
+    const ConjuntoPistas *pistas = &sessao->pistas;
+    RetratoCabecalho cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magico, RETRATO_MAGICO, sizeof(cabecalho.magico));
+    cabecalho.ordemBytes = RETRATO_ORDEM_BYTES;
+    cabecalho.partida = sessao->diario != NULL ? sessao->diario->sessao : DIARIO_SEM_SESSAO;
+    cabecalho.somaMapa = sessao->mapa->somaVerificacao;
+    cabecalho.salaAtual = sessao->salaAtual;
+    cabecalho.movimentos = sessao->movimentos;
+    cabecalho.encerrada = sessao->encerrada != 0;
+    cabecalho.totalColetadas = sessao->totalColetadas;
+    cabecalho.totalPistas = pistas->total;
+    cabecalho.totalPalavras = retratoPalavras(pistas);
+    cabecalho.capacidadeHash = sessao->hashSuspeitos.capacidade;
+    cabecalho.totalSuspeitos = sessao->placar.totalSuspeitos;
+
+    unsigned char *escrita = retratoCopiar(destino, &cabecalho, sizeof(cabecalho));
+    escrita = retratoCopiar(escrita, sessao->salasColetadas, (size_t)sessao->totalColetadas * sizeof(uint32_t));
+
+    // Os índices das palavras marcadas no resumo e, depois deles, as palavras
+    unsigned char *indices = escrita;
+    unsigned char *palavras = escrita + (size_t)cabecalho.totalPalavras * sizeof(uint32_t);
+    uint32_t totalGrupos = (pistas->totalPalavras + 63) / 64;
+    for (uint32_t grupo = 0; grupo < totalGrupos; grupo++) {
+        for (uint64_t marcadas = pistas->resumo[grupo]; marcadas != 0; marcadas &= marcadas - 1) {
+            uint32_t indice = grupo * 64 + (uint32_t)__builtin_ctzll(marcadas);
+            indices = retratoCopiar(indices, &indice, sizeof(indice));
+            palavras = retratoCopiar(palavras, &pistas->bits[indice], sizeof(uint64_t));
+        }
+    }
+
+    escrita = retratoCopiar(palavras, sessao->hashSuspeitos.posicoes,
+                            (size_t)sessao->hashSuspeitos.capacidade * sizeof(HashPosicao));
+    retratoCopiar(escrita, sessao->placar.contagens, (size_t)sessao->placar.totalSuspeitos * sizeof(uint32_t));
+    return tamanho;
+}
+
+int restaurarRetrato(Sessao *sessao, const unsigned char *dados, size_t tamanho) {
+    const Mapa *mapa = sessao->mapa;
+    reiniciarSessao(sessao);
+
+    // 1. Cabeçalho: assinatura, arquitetura, mapa e tamanho das seções
+    RetratoCabecalho cabecalho;
+    if (tamanho < sizeof(cabecalho)) {
+        return -1;
+    }
+    memcpy(&cabecalho, dados, sizeof(cabecalho));
+    uint64_t esperado = sizeof(cabecalho) + (uint64_t)cabecalho.totalColetadas * sizeof(uint32_t) +
+                        (uint64_t)cabecalho.totalPalavras * (sizeof(uint32_t) + sizeof(uint64_t)) +
+                        (uint64_t)cabecalho.capacidadeHash * sizeof(HashPosicao) +
+                        (uint64_t)cabecalho.totalSuspeitos * sizeof(uint32_t);
+    if (memcmp(cabecalho.magico, RETRATO_MAGICO, sizeof(cabecalho.magico)) != 0 ||
+        cabecalho.ordemBytes != RETRATO_ORDEM_BYTES ||
+        cabecalho.somaMapa != mapa->somaVerificacao ||
+        cabecalho.totalSuspeitos != mapa->suspeitos.total ||
+        cabecalho.salaAtual >= mapa->totalSalas || !mapaGarantirSala(mapa, cabecalho.salaAtual) ||
+        cabecalho.encerrada > 1 ||
+        cabecalho.totalColetadas > mapa->totalSalas ||
+        cabecalho.totalPalavras > sessao->pistas.totalPalavras ||
+        esperado != tamanho) {
+        return -1;
+    }
+
+    // 2. Conjunto, hash e marcas das salas copiados das seções; placar refeito e conferido
+    if (retratoCarregar(sessao, &cabecalho, dados + sizeof(cabecalho)) != 0) {
+        reiniciarSessao(sessao);
+        return -1;
+    }
+    sessao->totalPistas = sessao->pistas.total;
+    if (sessao->buscaAtiva) {
+        IteradorConjunto iterador;
+        iniciarIteradorConjunto(&iterador, &sessao->pistas);
+        for (uint32_t pista = proximaPistaConjunto(&iterador); pista != TEXTO_NENHUM;
+             pista = proximaPistaConjunto(&iterador)) {
+            indexarPista(&sessao->busca, &mapa->pistas, pista);
+        }
+    }
+
+    // 3. Posição e, no diário, só a retomada na partida do retrato
+    sessao->salaAtual = cabecalho.salaAtual;
+    sessao->movimentos = cabecalho.movimentos;
+    sessao->encerrada = (int)cabecalho.encerrada;
+    int jogada = cabecalho.movimentos > 0 || cabecalho.totalColetadas > 0 || cabecalho.encerrada;
+    if (sessao->diario != NULL && (cabecalho.partida != DIARIO_SEM_SESSAO || jogada)) {
+        // Sem id e sem nada jogado, não há o que retomar: a partida começa no diário com o primeiro evento
+        registroRetomarPartida(sessao->diario, cabecalho.partida);
+        sessaoRegistrar(sessao, DIARIO_RETOMADA, sessao->salaAtual, sessao->movimentos, (uint16_t)cabecalho.encerrada);
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file retrato.h
+ * @brief Retrato (snapshot) binário do estado de uma sessão, para pausar e retomar partidas.
+ *
+ * O mapa não entra no retrato: ele é compartilhado e somente leitura, e a
+ * sessão restaurada precisa apenas ser iniciada sobre o mesmo mapa, que o
+ * cabeçalho identifica pela soma de verificação (mapaCalcularSoma()). As
+ * estruturas da sessão são gravadas como estão na memória, em seções que
+ * seguem o cabeçalho:
+ *
+ *   [RetratoCabecalho]
+ *   [salas coletadas, em ordem de coleta]            (uint32_t cada)
+ *   [índices das palavras não nulas do conjunto]     (uint32_t cada)
+ *   [essas palavras do conjunto de pistas]           (uint64_t cada)
+ *   [posições da hash pista -> sala]                 (HashPosicao cada)
+ *   [placar: pontuação de cada suspeito]             (uint32_t cada)
+ *
+ * Restaurar é copiar as seções de volta e marcar as salas da lista, sem
+ * repetir as coletas: o conjunto e a hash saem exatamente como estavam. O
+ * placar é refeito com os pesos das salas de origem guardadas na hash, e um
+ * retrato cujo placar gravado não confere com ele é recusado. O retrato cresce com as pistas coletadas (cerca de 20 bytes por
+ * pista), e não com o tamanho do mapa; só o placar tem uma posição por
+ * suspeito.
+ *
+ * Com o diário ativo (diario.h), o retrato guarda também o id da partida, e a
+ * sessão restaurada continua essa partida com um único evento DIARIO_RETOMADA.
+ */
+
+#ifndef RETRATO_H
+#define RETRATO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "motor.h"
+
+// --- Constantes do Formato ---
+#define RETRATO_MAGICO      "DQSESS2" // Assinatura (8 bytes com o '\0')
+#define RETRATO_ORDEM_BYTES 0x01020304u // Detecta retratos de outra arquitetura
+
+// --- Estruturas ---
+
+typedef struct RetratoCabecalho {
+    char magico[8];
+    uint32_t ordemBytes;
+    uint32_t partida;        // Id da partida no diário (DIARIO_SEM_SESSAO: sem diário)
+    uint64_t somaMapa;       // Soma de verificação do mapa em que o retrato foi tirado
+    uint32_t salaAtual;
+    uint32_t movimentos;
+    uint32_t encerrada;
+    uint32_t totalColetadas; // Salas da primeira seção
+    uint32_t totalPistas;    // Pistas no conjunto
+    uint32_t totalPalavras;  // Palavras não nulas do conjunto
+    uint32_t capacidadeHash; // Posições da hash
+    uint32_t totalSuspeitos; // Posições do placar
+} RetratoCabecalho;
+
+// --- Funções do Retrato ---
+
+/**
+ * @brief Tamanho, em bytes, do retrato atual da sessão.
+ */
+size_t retratoTamanho(const Sessao *sessao);
+
+/**
+ * @brief Grava o retrato da sessão em um buffer.
+ *
+ * Como snprintf(), nada é gravado se o buffer for pequeno demais, e o valor
+ * devolvido é sempre o tamanho necessário.
+ * @param sessao A sessão (não é alterada).
+ * @param destino O buffer de destino (pode ser NULL com capacidade 0).
+ * @param capacidade O tamanho do buffer.
+ * @return O tamanho do retrato, em bytes.
+ */
+size_t salvarRetrato(const Sessao *sessao, unsigned char *destino, size_t capacidade);
+
+/**
+ * @brief Restaura em uma sessão o estado gravado por salvarRetrato().
+ *
+ * A sessão deve ter sido iniciada (iniciarSessao()) sobre o mesmo mapa do
+ * retrato; ela é reiniciada e recebe as estruturas gravadas. Com a busca
+ * ativa, as pistas restauradas são indexadas de novo.
+ * @param sessao A sessão de destino.
+ * @param dados O retrato.
+ * @param tamanho O tamanho do retrato, em bytes.
+ * @return 0 em caso de sucesso, -1 se o retrato for inválido ou de outro mapa
+ *         (a sessão fica então reiniciada, na sala raiz).
+ */
+int restaurarRetrato(Sessao *sessao, const unsigned char *dados, size_t tamanho);
+
+#endif // RETRATO_H
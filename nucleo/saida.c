@@ -0,0 +1,153 @@
+/**
+ * @file saida.c
+ * @brief Implementação da saída em buffer.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "saida.h"
+
+// --- Implementação da Saída ---
+
+void iniciarSaida(Saida *saida, int descritor, FormatoSaida formato) {
+    saida->texto = NULL;
+    saida->tamanho = 0;
+    saida->capacidade = 0;
+    saida->descritor = descritor;
+    saida->formato = formato;
+}
+
+void saidaReservar(Saida *saida, size_t tamanho) {
+    if (saida->capacidade - saida->tamanho >= tamanho) {
+        return;
+    }
+    size_t capacidade = saida->capacidade > 0 ? saida->capacidade : SAIDA_CAPACIDADE_INICIAL;
+    while (capacidade - saida->tamanho < tamanho) {
+        capacidade *= 2;
+    }
+    char *texto = (char*)realloc(saida->texto, capacidade);
+    if (texto == NULL) {
+        printf("Erro de alocação de memória para a Saída!\n");
+        exit(EXIT_FAILURE);
+    }
+    saida->texto = texto;
+    saida->capacidade = capacidade;
+}
+
+void saidaBytes(Saida *saida, const char *bytes, size_t tamanho) {
+    saidaReservar(saida, tamanho);
+    memcpy(saida->texto + saida->tamanho, bytes, tamanho);
+    saida->tamanho += tamanho;
+}
+
+void saidaTexto(Saida *saida, const char *texto) {
+    saidaBytes(saida, texto, strlen(texto));
+}
+
+void saidaNumero(Saida *saida, uint64_t numero) {
+    char digitos[20];
+    size_t total = 0;
+    do {
+        digitos[total++] = (char)('0' + numero % 10);
+        numero /= 10;
+    } while (numero > 0);
+
+    saidaReservar(saida, total);
+    char *destino = saida->texto + saida->tamanho;
+    for (size_t i = 0; i < total; i++) {
+        destino[i] = digitos[total - 1 - i];
+    }
+    saida->tamanho += total;
+}
+
+void saidaAnexar(Saida *saida, const char *formato, ...) {
+    for (;;) {
+        va_list argumentos;
+        va_start(argumentos, formato);
+        size_t livre = saida->capacidade - saida->tamanho;
+        int escritos = vsnprintf(livre > 0 ? saida->texto + saida->tamanho : NULL, livre, formato, argumentos);
+        va_end(argumentos);
+        if (escritos < 0) {
+            return; // Formato inválido: nada a acrescentar
+        }
+        if ((size_t)escritos < livre) {
+            saida->tamanho += (size_t)escritos;
+            return;
+        }
+        saidaReservar(saida, (size_t)escritos + 1);
+    }
+}
+
+void saidaJsonTexto(Saida *saida, const char *texto) {
+    static const char hexadecimal[] = "0123456789abcdef";
+
+    saidaBytes(saida, "\"", 1);
+    const char *trecho = texto; // Início dos caracteres que não precisam de escape
+    for (const char *c = texto;; c++) {
+        unsigned char caractere = (unsigned char)*c;
+        if (caractere != '\0' && caractere >= 0x20 && caractere != '"' && caractere != '\\') {
+            continue;
+        }
+        saidaBytes(saida, trecho, (size_t)(c - trecho));
+        trecho = c + 1;
+        if (caractere == '\0') {
+            break;
+        }
+        char escape[6] = { '\\', 0, 0, 0, 0, 0 };
+        size_t tamanho = 2;
+        switch (caractere) {
+            case '"':  escape[1] = '"';  break;
+            case '\\': escape[1] = '\\'; break;
+            case '\n': escape[1] = 'n';  break;
+            case '\r': escape[1] = 'r';  break;
+            case '\t': escape[1] = 't';  break;
+            default:
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = hexadecimal[caractere >> 4];
+                escape[5] = hexadecimal[caractere & 0xF];
+                tamanho = 6;
+                break;
+        }
+        saidaBytes(saida, escape, tamanho);
+    }
+    saidaBytes(saida, "\"", 1);
+}
+
+int saidaDescarregar(Saida *saida) {
+    if (saida->descritor < 0) {
+        return 0;
+    }
+    if (saida->descritor == STDOUT_FILENO) {
+        fflush(stdout);
+    }
+
+    size_t enviados = 0;
+    int resultado = 0;
+    while (enviados < saida->tamanho) {
+        ssize_t escritos = write(saida->descritor, saida->texto + enviados, saida->tamanho - enviados);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            resultado = -1;
+            break;
+        }
+        enviados += (size_t)escritos;
+    }
+    saida->tamanho = 0;
+    return resultado;
+}
+
+void liberarSaida(Saida *saida) {
+    free(saida->texto);
+    iniciarSaida(saida, saida->descritor, saida->formato);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file saida.h
+ * @brief Saída em buffer: cada turno ou relatório é montado em memória e escrito de uma vez.
+ *
+ * Em vez de um printf por linha, os jogos acrescentam o texto de um turno
+ * inteiro a uma Saida e chamam saidaDescarregar() antes de ler a próxima
+ * escolha, o que resulta em uma única chamada write(2) por turno. O buffer é
+ * reaproveitado entre os descarregamentos, então um jogo longo não faz novas
+ * alocações depois dos primeiros turnos.
+ *
+ * As funções de texto e números não passam pelo printf; saidaAnexar() fica
+ * para os formatos com alinhamento. No formato SAIDA_JSON os jogos escrevem um
+ * objeto JSON por linha (JSON lines), com os textos escapados por saidaJsonTexto().
+ */
+
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// --- Constantes da Saída ---
+#define SAIDA_CAPACIDADE_INICIAL 4096
+
+// --- Estruturas ---
+
+typedef enum FormatoSaida {
+    SAIDA_TEXTO, // Texto para o jogador
+    SAIDA_JSON   // Um objeto JSON por linha, para consumidores automáticos
+} FormatoSaida;
+
+typedef struct Saida {
+    char *texto;
+    size_t tamanho;
+    size_t capacidade;
+    int descritor;        // Destino de saidaDescarregar() (-1: só acumula)
+    FormatoSaida formato;
+} Saida;
+
+// --- Funções da Saída ---
+
+/**
+ * @brief Inicializa uma saída vazia. Nenhuma memória é reservada até o primeiro texto.
+ * @param saida O ponteiro para a saída.
+ * @param descritor O descritor de arquivo de destino (ex.: STDOUT_FILENO), ou -1.
+ * @param formato O formato que os jogos devem usar ao escrever nesta saída.
+ */
+void iniciarSaida(Saida *saida, int descritor, FormatoSaida formato);
+
+/**
+ * @brief Garante espaço para mais `tamanho` bytes no buffer.
+ */
+void saidaReservar(Saida *saida, size_t tamanho);
+
+/**
+ * @brief Acrescenta bytes ao buffer, sem formatação.
+ */
+void saidaBytes(Saida *saida, const char *bytes, size_t tamanho);
+
+/**
+ * @brief Acrescenta um texto terminado em '\0'.
+ */
+void saidaTexto(Saida *saida, const char *texto);
+
+/**
+ * @brief Acrescenta um inteiro sem sinal em decimal.
+ */
+void saidaNumero(Saida *saida, uint64_t numero);
+
+/**
+ * @brief Acrescenta texto formatado como printf.
+ */
+void saidaAnexar(Saida *saida, const char *formato, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Acrescenta um texto como string JSON, entre aspas e com os escapes necessários.
+ *
+ * Caracteres acima de 0x7F (UTF-8) são copiados sem alteração.
+ */
+void saidaJsonTexto(Saida *saida, const char *texto);
+
+/**
+ * @brief Escreve todo o buffer no descritor com write(2) e o esvazia.
+ *
+ * Se o descritor for o de stdout, o buffer do stdio é esvaziado antes, para que
+ * textos impressos com printf não saiam fora de ordem.
+ * @return 0 em caso de sucesso, -1 em caso de erro de escrita.
+ */
+int saidaDescarregar(Saida *saida);
+
+/**
+ * @brief Libera o buffer da saída.
+ */
+void liberarSaida(Saida *saida);
+
+#endif // SAIDA_H
@@ -0,0 +1,395 @@
+/**
+ * @file servidor.c
+ * @brief Implementação do servidor de partidas sobre epoll.
+ */
+
+#define _GNU_SOURCE // accept4() e SOCK_NONBLOCK
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "instrumentos.h"
+#include "servidor.h"
+
+// --- Sockets de Escuta ---
+
+/**
+ * @brief Cria um socket de escuta não bloqueante com SO_REUSEPORT.
+ * @return O descritor, ou -1 (errno indica o motivo).
+ */
+static int abrirEscuta(const struct sockaddr_in *endereco) {
+    int escuta = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (escuta < 0) {
+        return -1;
+    }
+    int um = 1;
+    if (setsockopt(escuta, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um)) != 0 ||
+        setsockopt(escuta, SOL_SOCKET, SO_REUSEPORT, &um, sizeof(um)) != 0 ||
+        bind(escuta, (const struct sockaddr*)endereco, sizeof(*endereco)) != 0 ||
+        listen(escuta, SERVIDOR_FILA_ESCUTA) != 0) {
+        int erro = errno;
+        close(escuta);
+        errno = erro;
+        return -1;
+    }
+    return escuta;
+}
+
+/**
+ * @brief Registra um descritor no epoll de uma thread.
+ */
+static int observar(int epoll, int descritor, uint32_t eventos, void *dado) {
+    struct epoll_event evento;
+    memset(&evento, 0, sizeof(evento));
+    evento.events = eventos;
+    evento.data.ptr = dado;
+    return epoll_ctl(epoll, EPOLL_CTL_ADD, descritor, &evento);
+}
+
+int iniciarServidor(Servidor *servidor, const Mapa *mapa, const char *endereco, uint16_t porta,
+                    unsigned totalThreads) {
+    if (totalThreads == 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        totalThreads = processadores > 0 ? (unsigned)processadores : 1;
+    }
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(porta);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (endereco != NULL && inet_pton(AF_INET, endereco, &local.sin_addr) != 1) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    servidor->mapa = mapa;
+    servidor->diario = NULL;
+    servidor->totalThreads = totalThreads;
+    atomic_init(&servidor->parando, 0);
+    servidor->threads = (ThreadServidor*)calloc(totalThreads, sizeof(ThreadServidor));
+    if (servidor->threads == NULL) {
+        printf("Erro de alocação de memória para o Servidor!\n");
+        exit(EXIT_FAILURE);
+    }
+    for (unsigned i = 0; i < totalThreads; i++) {
+        servidor->threads[i].escuta = -1;
+        servidor->threads[i].epoll = -1;
+        servidor->threads[i].reserva = -1;
+    }
+    servidor->parada = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (servidor->parada < 0) {
+        encerrarServidor(servidor);
+        return -1;
+    }
+
+    for (unsigned i = 0; i < totalThreads; i++) {
+        ThreadServidor *thread = &servidor->threads[i];
+        thread->servidor = servidor;
+        thread->conexoes = NULL;
+        thread->escuta = abrirEscuta(&local);
+        if (thread->escuta < 0) {
+            int erro = errno;
+            encerrarServidor(servidor);
+            errno = erro;
+            return -1;
+        }
+        if (i == 0) {
+            // Com a porta 0, as demais threads escutam na porta que o sistema escolheu para a primeira
+            socklen_t tamanho = sizeof(local);
+            if (getsockname(thread->escuta, (struct sockaddr*)&local, &tamanho) != 0) {
+                int erro = errno;
+                encerrarServidor(servidor);
+                errno = erro;
+                return -1;
+            }
+            servidor->porta = ntohs(local.sin_port);
+        }
+        // A escuta é marcada com NULL e a parada com o endereço do eventfd; as conexões, com o seu Conexao
+        thread->reserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        thread->epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (thread->reserva < 0 || thread->epoll < 0 || observar(thread->epoll, thread->escuta, EPOLLIN, NULL) != 0 ||
+            observar(thread->epoll, servidor->parada, EPOLLIN, &servidor->parada) != 0) {
+            int erro = errno;
+            encerrarServidor(servidor);
+            errno = erro;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// --- Conexões ---
+
+size_t conexaoMemoria(const Conexao *conexao) {
+    return sizeof(Conexao) - sizeof(Partida) + partidaMemoria(&conexao->partida) + conexao->resposta.capacidade;
+}
+
+static void fecharConexao(ThreadServidor *thread, Conexao *conexao) {
+    INSTRUMENTAR_HISTOGRAMA(HISTOGRAMA_MEMORIA_SESSAO, conexaoMemoria(conexao));
+    close(conexao->descritor); // Também tira o descritor do epoll
+    if (conexao->anterior != NULL) {
+        conexao->anterior->proxima = conexao->proxima;
+    } else {
+        thread->conexoes = conexao->proxima;
+    }
+    if (conexao->proxima != NULL) {
+        conexao->proxima->anterior = conexao->anterior;
+    }
+    encerrarPartida(&conexao->partida);
+    liberarSaida(&conexao->resposta);
+    free(conexao);
+}
+
+/**
+ * @brief Sem descritores livres, aceita e fecha a primeira conexão da fila no lugar da reserva.
+ * @return 1 se uma conexão foi recusada, 0 se a reserva não pôde ser usada.
+ */
+static int recusarConexao(ThreadServidor *thread) {
+    if (thread->reserva < 0) {
+        // Outra thread ficou com o descritor que a reserva liberou: só com algum descritor livre de novo
+        thread->reserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        if (thread->reserva < 0) {
+            return 0;
+        }
+    }
+    close(thread->reserva);
+    int descritor = accept4(thread->escuta, NULL, NULL, SOCK_CLOEXEC);
+    if (descritor >= 0) {
+        close(descritor);
+        INSTRUMENTAR_CONTAR(CONTADOR_CONEXOES_RECUSADAS, 1);
+    }
+    thread->reserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    return descritor >= 0;
+}
+
+/**
+ * @brief Aceita todas as conexões na fila da escuta da thread.
+ */
+static void aceitarConexoes(ThreadServidor *thread) {
+    for (;;) {
+        int descritor = accept4(thread->escuta, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (descritor < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if ((errno == EMFILE || errno == ENFILE) && recusarConexao(thread)) {
+                continue;
+            }
+            return; // EAGAIN: fila vazia
+        }
+        int um = 1;
+        setsockopt(descritor, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um)); // Respostas curtas, sem esperar o ACK
+
+        Conexao *conexao = (Conexao*)malloc(sizeof(Conexao));
+        if (conexao == NULL) {
+            printf("Erro de alocação de memória para a Conexão!\n");
+            exit(EXIT_FAILURE);
+        }
+        conexao->descritor = descritor;
+        conexao->eventos = EPOLLIN;
+        conexao->fechar = 0;
+        conexao->tamanhoEntrada = 0;
+        conexao->enviado = 0;
+        iniciarPartida(&conexao->partida, thread->servidor->mapa, thread->servidor->diario);
+        iniciarSaida(&conexao->resposta, -1, SAIDA_JSON);
+        conexao->anterior = NULL;
+        conexao->proxima = thread->conexoes;
+        if (thread->conexoes != NULL) {
+            thread->conexoes->anterior = conexao;
+        }
+        thread->conexoes = conexao;
+        if (observar(thread->epoll, descritor, EPOLLIN, conexao) != 0) {
+            fecharConexao(thread, conexao);
+            continue;
+        }
+        INSTRUMENTAR_CONTAR(CONTADOR_CONEXOES, 1);
+    }
+}
+
+/**
+ * @brief Lê o que chegou e atende cada linha completa.
+ * @return 0, ou -1 se a conexão deve ser fechada já (erro de leitura).
+ */
+static int lerConexao(Conexao *conexao) {
+    ssize_t lidos = read(conexao->descritor, conexao->entrada + conexao->tamanhoEntrada,
+                         SERVIDOR_LINHA_MAXIMA - conexao->tamanhoEntrada);
+    if (lidos < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+    }
+    if (lidos == 0) {
+        conexao->fechar = 1; // Fim da entrada: as respostas já pedidas ainda são enviadas
+        return 0;
+    }
+    conexao->tamanhoEntrada += (uint32_t)lidos;
+
+    char *linha = conexao->entrada;
+    char *fim = conexao->entrada + conexao->tamanhoEntrada;
+    char *quebra;
+    while (!conexao->fechar && (quebra = memchr(linha, '\n', (size_t)(fim - linha))) != NULL) {
+        *quebra = '\0';
+        if (atenderRequisicao(&conexao->partida, linha, &conexao->resposta) == ATENDIMENTO_FECHAR) {
+            conexao->fechar = 1;
+        }
+        linha = quebra + 1;
+    }
+    sessaoDescarregarDiario(&conexao->partida.sessao); // Um acesso ao diário por leitura, não por movimento
+    if (conexao->fechar) {
+        conexao->tamanhoEntrada = 0; // O que veio depois de "f" é descartado
+        return 0;
+    }
+    conexao->tamanhoEntrada = (uint32_t)(fim - linha);
+    memmove(conexao->entrada, linha, conexao->tamanhoEntrada);
+    if (conexao->tamanhoEntrada == SERVIDOR_LINHA_MAXIMA) {
+        saidaTexto(&conexao->resposta, "{\"evento\":\"erro\",\"mensagem\":\"requisição maior que o limite\"}\n");
+        conexao->tamanhoEntrada = 0;
+        conexao->fechar = 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Envia o máximo possível das respostas acumuladas.
+ * @return 0, ou -1 se a conexão caiu.
+ */
+static int enviarConexao(Conexao *conexao) {
+    Saida *resposta = &conexao->resposta;
+    while (conexao->enviado < resposta->tamanho) {
+        ssize_t enviados = send(conexao->descritor, resposta->texto + conexao->enviado,
+                                resposta->tamanho - conexao->enviado, MSG_NOSIGNAL);
+        if (enviados < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+        }
+        conexao->enviado += (size_t)enviados;
+    }
+    resposta->tamanho = 0; // Tudo enviado: o buffer é reaproveitado
+    conexao->enviado = 0;
+    return 0;
+}
+
+/**
+ * @brief Trata os eventos de uma conexão e ajusta o que ela pede ao epoll.
+ */
+static void atenderConexao(ThreadServidor *thread, Conexao *conexao, uint32_t eventos) {
+    if ((eventos & EPOLLIN) && !conexao->fechar && lerConexao(conexao) != 0) {
+        fecharConexao(thread, conexao);
+        return;
+    }
+    if (enviarConexao(conexao) != 0 || (eventos & EPOLLERR)) {
+        fecharConexao(thread, conexao);
+        return;
+    }
+    size_t pendente = conexao->resposta.tamanho - conexao->enviado;
+    if (conexao->fechar && pendente == 0) {
+        fecharConexao(thread, conexao);
+        return;
+    }
+    if ((eventos & EPOLLHUP) && !(eventos & EPOLLIN)) {
+        fecharConexao(thread, conexao); // O cliente fechou os dois sentidos
+        return;
+    }
+
+    uint32_t desejados = 0;
+    if (!conexao->fechar && pendente < SERVIDOR_PENDENTE_MAXIMO) {
+        desejados |= EPOLLIN;
+    }
+    if (pendente > 0) {
+        desejados |= EPOLLOUT;
+    }
+    if (desejados != conexao->eventos) {
+        struct epoll_event evento;
+        memset(&evento, 0, sizeof(evento));
+        evento.events = desejados;
+        evento.data.ptr = conexao;
+        epoll_ctl(thread->epoll, EPOLL_CTL_MOD, conexao->descritor, &evento);
+        conexao->eventos = desejados;
+    }
+}
+
+// --- Laço de Eventos ---
+
+static void *servidorLaco(void *argumento) {
+    ThreadServidor *thread = (ThreadServidor*)argumento;
+    Servidor *servidor = thread->servidor;
+    struct epoll_event eventos[SERVIDOR_EVENTOS];
+
+    while (!atomic_load(&servidor->parando)) {
+        int total = epoll_wait(thread->epoll, eventos, SERVIDOR_EVENTOS, -1);
+        if (total < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (int i = 0; i < total; i++) {
+            void *dado = eventos[i].data.ptr;
+            if (dado == NULL) {
+                aceitarConexoes(thread);
+            } else if (dado != &servidor->parada) {
+                atenderConexao(thread, (Conexao*)dado, eventos[i].events);
+            }
+        }
+    }
+    while (thread->conexoes != NULL) {
+        fecharConexao(thread, thread->conexoes);
+    }
+    return NULL;
+}
+
+void servidorAtivarDiario(Servidor *servidor, Diario *diario) {
+    servidor->diario = diario;
+}
+
+void servidorRodar(Servidor *servidor) {
+    for (unsigned i = 1; i < servidor->totalThreads; i++) {
+        if (pthread_create(&servidor->threads[i].thread, NULL, servidorLaco, &servidor->threads[i]) != 0) {
+            printf("Erro ao criar as threads do Servidor!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    servidorLaco(&servidor->threads[0]);
+    for (unsigned i = 1; i < servidor->totalThreads; i++) {
+        pthread_join(servidor->threads[i].thread, NULL);
+    }
+}
+
+void servidorParar(Servidor *servidor) {
+    // Só operações seguras em tratador de sinal: o eventfd nunca é lido e acorda todas as threads
+    atomic_store(&servidor->parando, 1);
+    uint64_t um = 1;
+    ssize_t escritos = write(servidor->parada, &um, sizeof(um));
+    (void)escritos;
+}
+
+void encerrarServidor(Servidor *servidor) {
+    for (unsigned i = 0; i < servidor->totalThreads; i++) {
+        if (servidor->threads[i].escuta >= 0) {
+            close(servidor->threads[i].escuta);
+        }
+        if (servidor->threads[i].epoll >= 0) {
+            close(servidor->threads[i].epoll);
+        }
+        if (servidor->threads[i].reserva >= 0) {
+            close(servidor->threads[i].reserva);
+        }
+    }
+    if (servidor->parada >= 0) {
+        close(servidor->parada);
+    }
+    free(servidor->threads);
+    servidor->threads = NULL;
+    servidor->totalThreads = 0;
+    servidor->parada = -1;
+}
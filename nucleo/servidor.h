@@ -0,0 +1,130 @@
+/**
+ * @file servidor.h
+ * @brief Servidor TCP orientado a eventos: muitas partidas (protocolo.h) sobre poucas threads.
+ *
+ * Cada thread do servidor tem o seu próprio socket de escuta, todos na mesma
+ * porta com SO_REUSEPORT (o kernel distribui as conexões novas entre eles), e
+ * a sua própria instância de epoll. Uma conexão nasce e morre na thread que a
+ * aceitou, então nenhuma estrutura de conexão é compartilhada e não há trava
+ * no caminho de uma requisição; só o Mapa, somente leitura, é comum a todas.
+ *
+ * Uma conexão é uma Partida mais dois buffers: a entrada guarda a linha ainda
+ * incompleta (até SERVIDOR_LINHA_MAXIMA bytes) e a resposta, uma Saida sem
+ * descritor, acumula as respostas até que o socket aceite enviá-las. Os
+ * sockets são não bloqueantes; com mais de SERVIDOR_PENDENTE_MAXIMO bytes por
+ * enviar, a conexão deixa de ser lida até o cliente consumir as respostas.
+ *
+ * Sem descritores livres (EMFILE/ENFILE), a escuta continuaria legível e o
+ * epoll acordaria a thread sem parar. Cada thread guarda então um descritor
+ * de reserva: ela o fecha, aceita a conexão no lugar dele, fecha a conexão e
+ * reabre a reserva, esvaziando a fila até haver descritores de novo.
+ *
+ * O epoll foi escolhido em vez do io_uring por estar em qualquer kernel Linux
+ * sem bibliotecas extras; as requisições são curtas e o custo de cada uma é o
+ * do motor, não o das chamadas de sistema.
+ */
+
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "diario.h"
+#include "mapa.h"
+#include "protocolo.h"
+#include "saida.h"
+
+// --- Constantes do Servidor ---
+#define SERVIDOR_LINHA_MAXIMA 1024          // Bytes de uma requisição, com o '\n'
+#define SERVIDOR_EVENTOS 256                // Eventos retirados por chamada a epoll_wait()
+#define SERVIDOR_PENDENTE_MAXIMO (64 * 1024) // Respostas por enviar a partir das quais a conexão não é lida
+#define SERVIDOR_FILA_ESCUTA 1024           // Conexões esperando accept(), por thread
+
+// --- Estruturas ---
+
+// Um jogador conectado; só a thread que o aceitou mexe nele
+typedef struct Conexao {
+    int descritor;
+    uint32_t eventos;          // Eventos pedidos ao epoll (EPOLLIN, EPOLLOUT)
+    int fechar;                // Fechar assim que a resposta for enviada ("f", fim da entrada ou linha longa)
+    uint32_t tamanhoEntrada;   // Bytes guardados em entrada
+    size_t enviado;            // Bytes de resposta já enviados
+    struct Conexao *anterior;  // Lista das conexões da thread, para o encerramento
+    struct Conexao *proxima;
+    Partida partida;
+    Saida resposta;
+    char entrada[SERVIDOR_LINHA_MAXIMA];
+} Conexao;
+
+typedef struct Servidor Servidor;
+
+typedef struct ThreadServidor {
+    Servidor *servidor;
+    pthread_t thread;
+    int escuta;         // Socket de escuta da thread (SO_REUSEPORT)
+    int reserva;        // /dev/null, guardado para recusar conexões sem descritores livres (-1: em uso)
+    int epoll;
+    Conexao *conexoes;  // Conexões abertas na thread
+} ThreadServidor;
+
+struct Servidor {
+    const Mapa *mapa;
+    Diario *diario;     // Onde as partidas são registradas (NULL: sem diário)
+    ThreadServidor *threads;
+    unsigned totalThreads;
+    uint16_t porta;     // A porta em uso (a escolhida pelo sistema, se foi pedida a porta 0)
+    int parada;         // eventfd observado por todas as threads; fica legível em servidorParar()
+    atomic_int parando;
+};
+
+// --- Funções do Servidor ---
+
+/**
+ * @brief Cria os sockets de escuta e as instâncias de epoll, sem ainda aceitar conexões.
+ * @param servidor O ponteiro para o servidor.
+ * @param mapa O mapa finalizado, compartilhado por todas as partidas.
+ * @param endereco O endereço IPv4 de escuta (ex.: "127.0.0.1"; NULL: todos os endereços).
+ * @param porta A porta TCP (0: uma porta livre, informada depois em servidor->porta).
+ * @param totalThreads Quantidade de threads (0 usa o total de processadores).
+ * @return 0 em caso de sucesso, -1 se o endereço for inválido ou a porta não puder ser usada (errno indica o motivo).
+ */
+int iniciarServidor(Servidor *servidor, const Mapa *mapa, const char *endereco, uint16_t porta,
+                    unsigned totalThreads);
+
+/**
+ * @brief Registra no diário as partidas das conexões aceitas daqui em diante.
+ *
+ * Deve ser chamada antes de servidorRodar(). Os eventos de cada conexão são
+ * entregues ao diário ao fim de cada leitura, então uma queda perde no máximo
+ * o intervalo da escrita em grupo (DIARIO_INTERVALO_MS).
+ */
+void servidorAtivarDiario(Servidor *servidor, Diario *diario);
+
+/**
+ * @brief Atende conexões até servidorParar(); a thread que chama é uma das threads do servidor.
+ *
+ * Ao parar, as conexões ainda abertas são fechadas sem enviar o que faltava.
+ */
+void servidorRodar(Servidor *servidor);
+
+/**
+ * @brief Pede que as threads parem. Pode ser chamada de um tratador de sinal.
+ */
+void servidorParar(Servidor *servidor);
+
+/**
+ * @brief Memória de uma conexão: o struct, a sessão (partidaMemoria()) e o buffer de respostas.
+ *
+ * É o valor registrado em HISTOGRAMA_MEMORIA_SESSAO quando a conexão é fechada.
+ */
+size_t conexaoMemoria(const Conexao *conexao);
+
+/**
+ * @brief Fecha os sockets e libera as threads, depois que servidorRodar() retornou.
+ */
+void encerrarServidor(Servidor *servidor);
+
+#endif // SERVIDOR_H
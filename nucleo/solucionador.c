@@ -0,0 +1,532 @@
+/**
+ * @file solucionador.c
+ * @brief Implementação do solucionador exaustivo paralelo.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "motor.h"
+#include "solucionador.h"
+
+// --- Constantes do Solucionador ---
+#define SOLUCIONADOR_FILA_MINIMA 4   // Abaixo disso, uma thread com ociosas divide o trabalho
+#define SOLUCIONADOR_TENTATIVAS  64  // Procuras sem achar tarefa antes de a thread ociosa dormir
+
+// --- Estruturas ---
+
+// Salas do caminho da raiz até a origem de uma ou mais tarefas, compartilhadas entre elas
+typedef struct PrefixoCaminho {
+    atomic_uint referencias; // Tarefas que ainda usam o prefixo; a última o libera
+    uint32_t profundidade;
+    uint32_t salas[];
+} PrefixoCaminho;
+
+// Tarefa: percorrer os caminhos que seguem o prefixo e entram na sala
+typedef struct Tarefa {
+    PrefixoCaminho *prefixo; // NULL: a tarefa começa na raiz do mapa
+    uint32_t sala;
+} Tarefa;
+
+// Fila dupla de tarefas protegida por uma trava
+typedef struct FilaTarefas {
+    pthread_mutex_t trava;
+    Tarefa *tarefas;
+    size_t inicio;     // Tarefa mais antiga (lado dos roubos)
+    size_t fim;        // Uma após a mais nova (lado do dono)
+    size_t capacidade;
+} FilaTarefas;
+
+// Sala na pilha do percurso
+typedef struct QuadroCaminho {
+    uint32_t sala;
+    uint32_t anterior; // Sala de origem associada antes à pista desta sala
+    uint32_t proximo;  // Posição da próxima saída da sala a considerar
+    uint32_t seguiu;   // Diferente de 0 se o caminho já continuou por alguma saída
+} QuadroCaminho;
+
+typedef struct Solucionador Solucionador;
+
+typedef struct SolucionadorThread {
+    Solucionador *solucionador;
+    unsigned indice;
+    pthread_t thread;
+    FilaTarefas fila;
+    uint32_t *placar;          // Pontuação de cada suspeito no caminho atual
+    uint32_t *ocorrencias;     // Quantas vezes cada pista aparece no caminho
+    uint32_t *origemAtual;     // Sala de origem da associação de cada pista presente
+    uint32_t pistasDistintas;
+    uint8_t *noCaminho;        // Salas do caminho atual, que não podem ser visitadas de novo
+    QuadroCaminho *pilha;
+    size_t capacidadePilha;
+    uint64_t totalCaminhos;
+    uint64_t caminhosSemPistas;
+    uint64_t *sustentados;
+    uint64_t *fracos;
+    uint32_t *maximoPistas;
+} SolucionadorThread;
+
+struct Solucionador {
+    const Mapa *mapa;
+    SolucionadorThread *threads;
+    unsigned totalThreads;
+    atomic_long pendentes;     // Tarefas criadas e ainda não concluídas
+    atomic_int ociosas;        // Threads procurando trabalho
+    pthread_mutex_t espera;    // As ociosas dormem em trabalho com ela
+    pthread_cond_t trabalho;   // Sinalizada a cada lote de tarefas novas e no fim
+    atomic_ulong geracao;      // Lotes publicados até agora
+    atomic_uint dormindo;      // Threads em solucionadorAguardar()
+};
+
+// --- Funções Auxiliares ---
+
+static void *solucionadorAlocar(size_t tamanho) {
+    void *memoria = calloc(1, tamanho > 0 ? tamanho : 1);
+    if (memoria == NULL) {
+        printf("Erro de alocação de memória para o Solucionador!\n");
+        exit(EXIT_FAILURE);
+    }
+    return memoria;
+}
+
+// --- Espera das Threads Ociosas ---
+
+/**
+ * @brief Avisa as threads ociosas de que há tarefas novas (ou de que não restam pendentes).
+ *
+ * Acorda uma thread por tarefa (todas no fim, com tarefas = 0). A geração
+ * sobe antes de ler quantas dormem, e solucionadorAguardar() faz o inverso:
+ * ou a thread que vai dormir vê a geração nova, ou ela já conta como
+ * dormindo e recebe o sinal. Sem ninguém dormindo, a trava nem é tomada.
+ */
+static void solucionadorAcordar(Solucionador *solucionador, unsigned tarefas) {
+    atomic_fetch_add(&solucionador->geracao, 1);
+    unsigned dormindo = atomic_load(&solucionador->dormindo);
+    if (dormindo == 0) {
+        return;
+    }
+    pthread_mutex_lock(&solucionador->espera);
+    if (tarefas == 0 || tarefas >= dormindo) {
+        pthread_cond_broadcast(&solucionador->trabalho);
+    } else {
+        for (unsigned i = 0; i < tarefas; i++) {
+            pthread_cond_signal(&solucionador->trabalho);
+        }
+    }
+    pthread_mutex_unlock(&solucionador->espera);
+}
+
+/**
+ * @brief Dorme até um lote publicado depois da geração lida ou até não restarem tarefas pendentes.
+ */
+static void solucionadorAguardar(Solucionador *solucionador, unsigned long geracao) {
+    pthread_mutex_lock(&solucionador->espera);
+    atomic_fetch_add(&solucionador->dormindo, 1);
+    while (atomic_load(&solucionador->geracao) == geracao && atomic_load(&solucionador->pendentes) > 0) {
+        pthread_cond_wait(&solucionador->trabalho, &solucionador->espera);
+    }
+    atomic_fetch_sub(&solucionador->dormindo, 1);
+    pthread_mutex_unlock(&solucionador->espera);
+}
+
+// --- Fila de Tarefas ---
+
+static void filaEmpilhar(FilaTarefas *fila, Tarefa tarefa) {
+    pthread_mutex_lock(&fila->trava);
+    if (fila->fim == fila->capacidade) {
+        size_t ocupadas = fila->fim - fila->inicio;
+        if (ocupadas * 2 > fila->capacidade || fila->capacidade == 0) {
+            fila->capacidade = fila->capacidade > 0 ? fila->capacidade * 2 : 64;
+        }
+        Tarefa *tarefas = (Tarefa*)solucionadorAlocar(fila->capacidade * sizeof(Tarefa));
+        if (ocupadas > 0) {
+            memcpy(tarefas, fila->tarefas + fila->inicio, ocupadas * sizeof(Tarefa));
+        }
+        free(fila->tarefas);
+        fila->tarefas = tarefas;
+        fila->inicio = 0;
+        fila->fim = ocupadas;
+    }
+    fila->tarefas[fila->fim++] = tarefa;
+    pthread_mutex_unlock(&fila->trava);
+}
+
+// Retira a tarefa mais nova (uso do dono da fila)
+static int filaDesempilhar(FilaTarefas *fila, Tarefa *tarefa) {
+    pthread_mutex_lock(&fila->trava);
+    int encontrou = fila->fim > fila->inicio;
+    if (encontrou) {
+        *tarefa = fila->tarefas[--fila->fim];
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return encontrou;
+}
+
+// Retira a tarefa mais antiga (uso das outras threads)
+static int filaRoubar(FilaTarefas *fila, Tarefa *tarefa) {
+    pthread_mutex_lock(&fila->trava);
+    int encontrou = fila->fim > fila->inicio;
+    if (encontrou) {
+        *tarefa = fila->tarefas[fila->inicio++];
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return encontrou;
+}
+
+static size_t filaTamanho(FilaTarefas *fila) {
+    pthread_mutex_lock(&fila->trava);
+    size_t tamanho = fila->fim - fila->inicio;
+    pthread_mutex_unlock(&fila->trava);
+    return tamanho;
+}
+
+// --- Placar Incremental do Caminho ---
+
+/**
+ * @brief Soma (ou retira) do placar do caminho os pesos dos suspeitos da pista de uma sala.
+ */
+static void solucionadorAplicarAlvos(SolucionadorThread *thread, uint32_t sala, int somar) {
+    const Mapa *mapa = thread->solucionador->mapa;
+    const AlvoPeso *alvos = mapaAlvos(mapa, sala);
+    uint32_t total = mapaTotalAlvos(mapa, sala);
+    for (uint32_t i = 0; i < total; i++) {
+        if (somar) {
+            thread->placar[alvos[i].suspeito] += alvos[i].peso;
+        } else {
+            thread->placar[alvos[i].suspeito] -= alvos[i].peso;
+        }
+    }
+}
+
+/**
+ * @brief Soma ao placar a pista da sala em que o caminho acabou de entrar.
+ * @return A sala de origem associada antes à pista (para desfazer em solucionadorSair()).
+ */
+static uint32_t solucionadorEntrar(SolucionadorThread *thread, uint32_t sala) {
+    const Mapa *mapa = thread->solucionador->mapa;
+    uint32_t pista = mapa->salas[sala].pista;
+    if (pista == TEXTO_NENHUM) {
+        return TEXTO_NENHUM;
+    }
+    uint32_t anterior = thread->origemAtual[pista];
+    if (thread->ocorrencias[pista] > 0) {
+        solucionadorAplicarAlvos(thread, anterior, 0); // A associação mais recente prevalece
+    } else {
+        anterior = TEXTO_NENHUM;
+        thread->pistasDistintas++;
+    }
+    thread->ocorrencias[pista]++;
+    thread->origemAtual[pista] = sala;
+    solucionadorAplicarAlvos(thread, sala, 1);
+    return anterior;
+}
+
+/**
+ * @brief Desfaz solucionadorEntrar() ao voltar da sala.
+ */
+static void solucionadorSair(SolucionadorThread *thread, uint32_t sala, uint32_t anterior) {
+    const Mapa *mapa = thread->solucionador->mapa;
+    uint32_t pista = mapa->salas[sala].pista;
+    if (pista == TEXTO_NENHUM) {
+        return;
+    }
+    solucionadorAplicarAlvos(thread, sala, 0);
+    if (--thread->ocorrencias[pista] > 0) {
+        thread->origemAtual[pista] = anterior;
+        solucionadorAplicarAlvos(thread, anterior, 1);
+    } else {
+        thread->pistasDistintas--;
+    }
+}
+
+/**
+ * @brief Registra os vereditos de todos os suspeitos ao fim de um caminho.
+ */
+static void solucionadorRegistrarSaida(SolucionadorThread *thread) {
+    thread->totalCaminhos++;
+    if (thread->pistasDistintas == 0) {
+        thread->caminhosSemPistas++;
+        return;
+    }
+    uint32_t totalSuspeitos = thread->solucionador->mapa->suspeitos.total;
+    for (uint32_t suspeito = 0; suspeito < totalSuspeitos; suspeito++) {
+        uint32_t contagem = thread->placar[suspeito];
+        if (contagem >= PISTAS_MINIMAS_ACUSACAO) {
+            thread->sustentados[suspeito]++;
+        } else {
+            thread->fracos[suspeito]++;
+        }
+        if (contagem > thread->maximoPistas[suspeito]) {
+            thread->maximoPistas[suspeito] = contagem;
+        }
+    }
+}
+
+static void solucionadorReservarPilha(SolucionadorThread *thread, size_t quadros) {
+    if (quadros <= thread->capacidadePilha) {
+        return;
+    }
+    size_t capacidade = thread->capacidadePilha > 0 ? thread->capacidadePilha : 64;
+    while (capacidade < quadros) {
+        capacidade *= 2;
+    }
+    QuadroCaminho *pilha = (QuadroCaminho*)realloc(thread->pilha, capacidade * sizeof(QuadroCaminho));
+    if (pilha == NULL) {
+        printf("Erro de alocação de memória para o Solucionador!\n");
+        exit(EXIT_FAILURE);
+    }
+    thread->pilha = pilha;
+    thread->capacidadePilha = capacidade;
+}
+
+static void solucionadorEmpilharQuadro(SolucionadorThread *thread, size_t *topo, uint32_t sala) {
+    solucionadorReservarPilha(thread, *topo + 1);
+    QuadroCaminho *quadro = &thread->pilha[(*topo)++];
+    quadro->sala = sala;
+    quadro->anterior = solucionadorEntrar(thread, sala);
+    quadro->proximo = 0;
+    quadro->seguiu = 0;
+    thread->noCaminho[sala] = 1;
+}
+
+/**
+ * @brief Transforma as saídas restantes do quadro do topo em tarefas, com o caminho atual como prefixo.
+ *
+ * As tarefas criadas de uma vez compartilham a mesma cópia do prefixo.
+ */
+static void solucionadorDividir(SolucionadorThread *thread, size_t topo) {
+    Solucionador *solucionador = thread->solucionador;
+    QuadroCaminho *quadro = &thread->pilha[topo - 1];
+    const SaidaSala *saidas = mapaSaidas(solucionador->mapa, quadro->sala);
+    uint32_t total = mapaTotalSaidas(solucionador->mapa, quadro->sala);
+
+    PrefixoCaminho *prefixo = NULL;
+    unsigned criadas = 0;
+    for (; quadro->proximo < total; quadro->proximo++) {
+        uint32_t destino = saidas[quadro->proximo].destino;
+        if (thread->noCaminho[destino]) {
+            continue;
+        }
+        if (prefixo == NULL) {
+            prefixo = (PrefixoCaminho*)solucionadorAlocar(sizeof(PrefixoCaminho) + topo * sizeof(uint32_t));
+            atomic_init(&prefixo->referencias, 0);
+            prefixo->profundidade = (uint32_t)topo;
+            for (size_t i = 0; i < topo; i++) {
+                prefixo->salas[i] = thread->pilha[i].sala;
+            }
+        }
+        atomic_fetch_add(&prefixo->referencias, 1);
+        atomic_fetch_add(&solucionador->pendentes, 1);
+        Tarefa tarefa = { prefixo, destino };
+        filaEmpilhar(&thread->fila, tarefa);
+        criadas++;
+    }
+    if (criadas > 0) {
+        solucionadorAcordar(solucionador, criadas);
+    }
+}
+
+// --- Execução das Tarefas ---
+
+/**
+ * @brief Percorre todos os caminhos simples que começam pelo prefixo e pela sala da tarefa.
+ *
+ * Primeiro entra nas salas do prefixo, na ordem do caminho (a ordem importa
+ * quando uma pista se repete com suspeitos diferentes), depois percorre as
+ * continuações com uma pilha explícita e, por fim, desfaz o prefixo. Um
+ * caminho termina quando nenhuma saída da sala leva a uma sala fora dele.
+ */
+static void solucionadorExecutarTarefa(SolucionadorThread *thread, Tarefa tarefa) {
+    Solucionador *solucionador = thread->solucionador;
+    const Mapa *mapa = solucionador->mapa;
+    size_t topo = 0;
+
+    // 1. Prefixo: as salas do caminho até a origem da tarefa
+    size_t profundidade = tarefa.prefixo != NULL ? tarefa.prefixo->profundidade : 0;
+    solucionadorReservarPilha(thread, profundidade + 1);
+    for (topo = 0; topo < profundidade; topo++) {
+        QuadroCaminho *quadro = &thread->pilha[topo];
+        quadro->sala = tarefa.prefixo->salas[topo];
+        quadro->anterior = solucionadorEntrar(thread, quadro->sala);
+        thread->noCaminho[quadro->sala] = 1; // O prefixo não é percorrido daqui
+    }
+    size_t base = topo;
+
+    // 2. Percurso das continuações
+    solucionadorEmpilharQuadro(thread, &topo, tarefa.sala);
+    while (topo > base) {
+        QuadroCaminho *quadro = &thread->pilha[topo - 1];
+        const SaidaSala *saidas = mapaSaidas(mapa, quadro->sala);
+        uint32_t total = mapaTotalSaidas(mapa, quadro->sala);
+        while (quadro->proximo < total && thread->noCaminho[saidas[quadro->proximo].destino]) {
+            quadro->proximo++; // A sala já está no caminho: seguir por ali formaria um ciclo
+        }
+        if (quadro->proximo < total) {
+            uint32_t destino = saidas[quadro->proximo++].destino;
+            quadro->seguiu = 1;
+            // Com threads ociosas e pouca fila, as saídas restantes viram tarefas à parte
+            if (quadro->proximo < total && atomic_load_explicit(&solucionador->ociosas, memory_order_relaxed) > 0 &&
+                filaTamanho(&thread->fila) < SOLUCIONADOR_FILA_MINIMA) {
+                solucionadorDividir(thread, topo);
+            }
+            solucionadorEmpilharQuadro(thread, &topo, destino);
+            continue;
+        }
+        if (!quadro->seguiu) {
+            solucionadorRegistrarSaida(thread);
+        }
+        thread->noCaminho[quadro->sala] = 0;
+        solucionadorSair(thread, quadro->sala, quadro->anterior);
+        topo--;
+    }
+
+    // 3. Desfaz o prefixo, do mais profundo para a raiz
+    while (topo > 0) {
+        topo--;
+        thread->noCaminho[thread->pilha[topo].sala] = 0;
+        solucionadorSair(thread, thread->pilha[topo].sala, thread->pilha[topo].anterior);
+    }
+    if (tarefa.prefixo != NULL && atomic_fetch_sub(&tarefa.prefixo->referencias, 1) == 1) {
+        free(tarefa.prefixo);
+    }
+}
+
+static void *solucionadorLaco(void *argumento) {
+    SolucionadorThread *thread = (SolucionadorThread*)argumento;
+    Solucionador *solucionador = thread->solucionador;
+    unsigned vitima = thread->indice;
+
+    for (;;) {
+        Tarefa tarefa;
+        int encontrou = filaDesempilhar(&thread->fila, &tarefa);
+        if (!encontrou) {
+            atomic_fetch_add(&solucionador->ociosas, 1);
+            unsigned tentativas = 0;
+            while (!encontrou && atomic_load(&solucionador->pendentes) > 0) {
+                // A geração é lida antes da procura: um lote publicado durante ela não se perde
+                unsigned long geracao = atomic_load(&solucionador->geracao);
+                for (unsigned i = 1; i <= solucionador->totalThreads && !encontrou; i++) {
+                    vitima = (vitima + 1) % solucionador->totalThreads;
+                    if (vitima != thread->indice) {
+                        encontrou = filaRoubar(&solucionador->threads[vitima].fila, &tarefa);
+                    }
+                }
+                if (!encontrou && ++tentativas < SOLUCIONADOR_TENTATIVAS) {
+                    sched_yield(); // Tarefas curtas costumam vir logo; dormir e acordar custa mais
+                } else if (!encontrou) {
+                    solucionadorAguardar(solucionador, geracao);
+                }
+            }
+            atomic_fetch_sub(&solucionador->ociosas, 1);
+            if (!encontrou) {
+                return NULL; // Nenhuma tarefa pendente em nenhuma fila
+            }
+        }
+        solucionadorExecutarTarefa(thread, tarefa);
+        if (atomic_fetch_sub(&solucionador->pendentes, 1) == 1) {
+            solucionadorAcordar(solucionador, 0); // A última tarefa: as ociosas podem terminar
+        }
+    }
+}
+
+// --- Interface ---
+
+int resolverMapa(const Mapa *mapa, unsigned totalThreads, ResumoSolucao *resumo) {
+    uint32_t totalSuspeitos = mapa->suspeitos.total;
+    memset(resumo, 0, sizeof(ResumoSolucao));
+    resumo->totalSuspeitos = totalSuspeitos;
+    resumo->sustentados = (uint64_t*)solucionadorAlocar(((size_t)totalSuspeitos + 1) * sizeof(uint64_t));
+    resumo->fracos = (uint64_t*)solucionadorAlocar(((size_t)totalSuspeitos + 1) * sizeof(uint64_t));
+    resumo->maximoPistas = (uint32_t*)solucionadorAlocar(((size_t)totalSuspeitos + 1) * sizeof(uint32_t));
+    if (mapa->totalSalas == 0) {
+        return 0;
+    }
+
+    if (mapa->raiz >= mapa->totalSalas) {
+        return -1;
+    }
+
+    Solucionador solucionador;
+    solucionador.mapa = mapa;
+    if (totalThreads == 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        totalThreads = processadores > 0 ? (unsigned)processadores : 1;
+    }
+    solucionador.totalThreads = totalThreads;
+    solucionador.threads = (SolucionadorThread*)solucionadorAlocar(totalThreads * sizeof(SolucionadorThread));
+    atomic_init(&solucionador.pendentes, 1);
+    atomic_init(&solucionador.ociosas, 0);
+    pthread_mutex_init(&solucionador.espera, NULL);
+    pthread_cond_init(&solucionador.trabalho, NULL);
+    atomic_init(&solucionador.geracao, 0);
+    atomic_init(&solucionador.dormindo, 0);
+
+    size_t totalPistas = (size_t)mapa->pistas.total + 1;
+    for (unsigned i = 0; i < totalThreads; i++) {
+        SolucionadorThread *thread = &solucionador.threads[i];
+        thread->solucionador = &solucionador;
+        thread->indice = i;
+        pthread_mutex_init(&thread->fila.trava, NULL);
+        thread->placar = (uint32_t*)solucionadorAlocar(((size_t)totalSuspeitos + 1) * sizeof(uint32_t));
+        thread->ocorrencias = (uint32_t*)solucionadorAlocar(totalPistas * sizeof(uint32_t));
+        thread->origemAtual = (uint32_t*)solucionadorAlocar(totalPistas * sizeof(uint32_t));
+        thread->noCaminho = (uint8_t*)solucionadorAlocar(mapa->totalSalas);
+        thread->sustentados = (uint64_t*)solucionadorAlocar(((size_t)totalSuspeitos + 1) * sizeof(uint64_t));
+        thread->fracos = (uint64_t*)solucionadorAlocar(((size_t)totalSuspeitos + 1) * sizeof(uint64_t));
+        thread->maximoPistas = (uint32_t*)solucionadorAlocar(((size_t)totalSuspeitos + 1) * sizeof(uint32_t));
+    }
+    Tarefa inicial = { NULL, mapa->raiz };
+    filaEmpilhar(&solucionador.threads[0].fila, inicial);
+
+    for (unsigned i = 0; i < totalThreads; i++) {
+        if (pthread_create(&solucionador.threads[i].thread, NULL, solucionadorLaco, &solucionador.threads[i]) != 0) {
+            printf("Erro ao criar as threads do Solucionador!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    // Todas terminam antes da limpeza: as filas seguem acessíveis a roubos até o fim
+    for (unsigned i = 0; i < totalThreads; i++) {
+        pthread_join(solucionador.threads[i].thread, NULL);
+    }
+    for (unsigned i = 0; i < totalThreads; i++) {
+        SolucionadorThread *thread = &solucionador.threads[i];
+        resumo->totalCaminhos += thread->totalCaminhos;
+        resumo->caminhosSemPistas += thread->caminhosSemPistas;
+        for (uint32_t suspeito = 0; suspeito < totalSuspeitos; suspeito++) {
+            resumo->sustentados[suspeito] += thread->sustentados[suspeito];
+            resumo->fracos[suspeito] += thread->fracos[suspeito];
+            if (thread->maximoPistas[suspeito] > resumo->maximoPistas[suspeito]) {
+                resumo->maximoPistas[suspeito] = thread->maximoPistas[suspeito];
+            }
+        }
+
+        pthread_mutex_destroy(&thread->fila.trava);
+        free(thread->fila.tarefas);
+        free(thread->placar);
+        free(thread->ocorrencias);
+        free(thread->origemAtual);
+        free(thread->noCaminho);
+        free(thread->pilha);
+        free(thread->sustentados);
+        free(thread->fracos);
+        free(thread->maximoPistas);
+    }
+    free(solucionador.threads);
+    pthread_mutex_destroy(&solucionador.espera);
+    pthread_cond_destroy(&solucionador.trabalho);
+    return 0;
+}
+
+void liberarResumoSolucao(ResumoSolucao *resumo) {
+    free(resumo->sustentados);
+    free(resumo->fracos);
+    free(resumo->maximoPistas);
+    memset(resumo, 0, sizeof(ResumoSolucao));
+}
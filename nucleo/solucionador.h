@@ -0,0 +1,62 @@
+/**
+ * @file solucionador.h
+ * @brief Solucionador exaustivo: percorre todos os caminhos da raiz até uma saída.
+ *
+ * Os caminhos são simples: nenhuma sala aparece duas vezes, de modo que mapas
+ * com ciclos (portas de volta para o hall) têm uma quantidade finita de
+ * caminhos. Um caminho chega a uma saída quando nenhuma passagem da sala
+ * leva a uma sala fora dele; nas árvores, isso é uma sala sem caminhos. Para
+ * cada caminho, as pistas coletadas são as das salas visitadas, com as mesmas
+ * regras do motor (pista repetida conta uma vez e fica associada aos suspeitos
+ * da última sala em que foi vista, com seus pesos). No fim de cada caminho,
+ * cada suspeito recebe o veredito que uma acusação teria naquele ponto, e o
+ * resumo conta quantos caminhos levam a cada veredito.
+ *
+ * O percurso mantém o placar de forma incremental (entrar em uma sala soma a
+ * pista, voltar desfaz); nas árvores o custo é O(salas + caminhos · suspeitos),
+ * e em grafos com muitos ciclos a quantidade de caminhos simples pode crescer
+ * exponencialmente. As continuações são tarefas: cada thread tem uma fila
+ * dupla, empilha as saídas restantes da sala quando há threads ociosas e as
+ * ociosas roubam as tarefas mais antigas (as maiores) das outras filas; sem
+ * nada para roubar por algumas tentativas, elas dormem em uma variável de
+ * condição até o próximo lote de tarefas ou até o fim, em vez de girar. Cada
+ * tarefa leva uma cópia do caminho até a sua origem (compartilhada entre as
+ * irmãs), com a qual reconstrói o placar.
+ */
+
+#ifndef SOLUCIONADOR_H
+#define SOLUCIONADOR_H
+
+#include <stdint.h>
+
+#include "mapa.h"
+
+// --- Estruturas ---
+
+// Resultado agregado de todos os caminhos
+typedef struct ResumoSolucao {
+    uint64_t totalCaminhos;
+    uint64_t caminhosSemPistas; // Caminhos sem nenhuma pista (acusação impossível)
+    uint32_t totalSuspeitos;
+    uint64_t *sustentados;      // Por suspeito: caminhos com acusação SUSTENTADA
+    uint64_t *fracos;           // Por suspeito: caminhos com acusação FRACA
+    uint32_t *maximoPistas;     // Por suspeito: maior pontuação em um caminho
+} ResumoSolucao;
+
+// --- Interface ---
+
+/**
+ * @brief Percorre todos os caminhos da raiz até uma saída e resume os vereditos.
+ * @param mapa O mapa (somente leitura).
+ * @param totalThreads A quantidade de threads (0 usa os processadores disponíveis).
+ * @param resumo Recebe o resumo; libere com liberarResumoSolucao().
+ * @return 0 em caso de sucesso, -1 se a raiz do mapa não for uma sala válida.
+ */
+int resolverMapa(const Mapa *mapa, unsigned totalThreads, ResumoSolucao *resumo);
+
+/**
+ * @brief Libera os vetores de um resumo preenchido por resolverMapa().
+ */
+void liberarResumoSolucao(ResumoSolucao *resumo);
+
+#endif // SOLUCIONADOR_H
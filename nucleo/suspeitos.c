@@ -0,0 +1,199 @@
+/**
+ * @file suspeitos.c
+ * @brief Implementação da tabela hash pista -> alvo e do placar.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "instrumentos.h"
+#include "suspeitos.h"
+
+// --- Implementação da Tabela Hash ---
+
+/**
+ * @brief Espalha os bits de um identificador (finalizador do MurmurHash3).
+ *
+ * Identificadores são sequenciais; sem a mistura, ids vizinhos ocupariam
+ * posições vizinhas e formariam longas sequências de sondagem.
+ * @param id O identificador da pista.
+ * @return O hash; o índice é obtido aplicando a máscara da tabela.
+ */
+static uint32_t calcularHashId(uint32_t id) {
+    id ^= id >> 16;
+    id *= 0x85ebca6bu;
+    id ^= id >> 13;
+    id *= 0xc2b2ae35u;
+    id ^= id >> 16;
+    return id;
+}
+
+/**
+ * @brief Aloca (na arena) um vetor de posições livres e recalcula o limite de carga.
+ */
+static void hashReservarPosicoes(SuspeitoHash *sh, uint32_t capacidade) {
+    sh->posicoes = (HashPosicao*)arenaAlocar(sh->arena, capacidade * sizeof(HashPosicao));
+    memset(sh->posicoes, 0, capacidade * sizeof(HashPosicao));
+    sh->capacidade = capacidade;
+    sh->limite = (uint32_t)(capacidade * sh->fatorCarga);
+}
+
+void inicializarHash(SuspeitoHash *sh, Arena *arena, double fatorCarga) {
+    if (fatorCarga <= 0) {
+        fatorCarga = HASH_FATOR_CARGA_PADRAO;
+    } else if (fatorCarga < HASH_FATOR_CARGA_MINIMO) {
+        fatorCarga = HASH_FATOR_CARGA_MINIMO;
+    } else if (fatorCarga > HASH_FATOR_CARGA_MAXIMO) {
+        fatorCarga = HASH_FATOR_CARGA_MAXIMO;
+    }
+    sh->arena = arena;
+    sh->fatorCarga = fatorCarga;
+    sh->total = 0;
+    hashReservarPosicoes(sh, HASH_CAPACIDADE_INICIAL);
+}
+
+/**
+ * @brief Coloca uma posição na tabela pelo critério Robin Hood.
+ *
+ * Ao encontrar uma entrada mais próxima da sua posição ideal do que a que está
+ * sendo inserida, as duas trocam de lugar e a inserção continua com a deslocada.
+ * A chave não pode já estar na tabela.
+ */
+static void hashColocar(SuspeitoHash *sh, HashPosicao nova) {
+    uint32_t mascara = sh->capacidade - 1;
+    uint32_t indice = calcularHashId(nova.pista) & mascara;
+    nova.distancia = 1;
+
+    while (sh->posicoes[indice].distancia != 0) {
+        HashPosicao *atual = &sh->posicoes[indice];
+        if (atual->distancia < nova.distancia) {
+            HashPosicao temp = *atual;
+            *atual = nova;
+            nova = temp;
+        }
+        indice = (indice + 1) & mascara;
+        nova.distancia++;
+    }
+    sh->posicoes[indice] = nova;
+}
+
+/**
+ * @brief Dobra a capacidade e reinsere todas as posições ocupadas.
+ *
+ * O vetor antigo fica na arena e é liberado junto com ela; como a capacidade
+ * dobra a cada vez, os vetores antigos somam menos que o vetor atual.
+ */
+static void hashCrescer(SuspeitoHash *sh) {
+    HashPosicao *antigas = sh->posicoes;
+    uint32_t capacidadeAntiga = sh->capacidade;
+
+    INSTRUMENTAR_CONTAR(CONTADOR_CRESCIMENTOS_HASH, 1);
+    hashReservarPosicoes(sh, capacidadeAntiga * 2);
+    for (uint32_t i = 0; i < capacidadeAntiga; i++) {
+        if (antigas[i].distancia != 0) {
+            hashColocar(sh, antigas[i]);
+        }
+    }
+}
+
+/**
+ * @brief Procura a posição ocupada pela chave.
+ * @return A posição, ou NULL se a chave não estiver na tabela.
+ */
+static HashPosicao *hashProcurar(const SuspeitoHash *sh, uint32_t pista) {
+    uint32_t mascara = sh->capacidade - 1;
+    uint32_t indice = calcularHashId(pista) & mascara;
+    INSTRUMENTAR_CONTAR(CONTADOR_CONSULTAS_HASH, 1);
+
+    for (uint32_t distancia = 1;; distancia++) {
+        HashPosicao *atual = &sh->posicoes[indice];
+        // Posição livre ou entrada mais perto de casa: a chave não está na tabela
+        if (atual->distancia < distancia) {
+            INSTRUMENTAR_HISTOGRAMA(HISTOGRAMA_SONDAGEM_HASH, distancia);
+            return NULL;
+        }
+        if (atual->pista == pista) {
+            INSTRUMENTAR_HISTOGRAMA(HISTOGRAMA_SONDAGEM_HASH, distancia);
+            return atual;
+        }
+        indice = (indice + 1) & mascara;
+    }
+}
+
+uint32_t inserirNaHash(SuspeitoHash *sh, uint32_t pista, uint32_t alvo) {
+    HashPosicao *existente = hashProcurar(sh, pista);
+    if (existente != NULL) {
+        uint32_t anterior = existente->alvo;
+        existente->alvo = alvo;
+        return anterior;
+    }
+
+    if (sh->total + 1 > sh->limite) {
+        hashCrescer(sh);
+    }
+    HashPosicao nova = { pista, alvo, 0 };
+    hashColocar(sh, nova);
+    sh->total++;
+    return TEXTO_NENHUM;
+}
+
+uint32_t encontrarSuspeito(const SuspeitoHash *sh, uint32_t pista) {
+    const HashPosicao *posicao = hashProcurar(sh, pista);
+    return posicao != NULL ? posicao->alvo : TEXTO_NENHUM;
+}
+
+int carregarHash(SuspeitoHash *sh, const unsigned char *posicoes, uint32_t capacidade) {
+    if (capacidade < HASH_CAPACIDADE_INICIAL || (capacidade & (capacidade - 1)) != 0) {
+        return -1;
+    }
+    hashReservarPosicoes(sh, capacidade);
+    memcpy(sh->posicoes, posicoes, (size_t)capacidade * sizeof(HashPosicao));
+    uint32_t mascara = capacidade - 1;
+    uint32_t total = 0;
+    int valida = 1;
+    for (uint32_t i = 0; valida && i < capacidade; i++) {
+        const HashPosicao *posicao = &sh->posicoes[i];
+        if (posicao->distancia != 0) {
+            valida = ((i - calcularHashId(posicao->pista)) & mascara) + 1 == posicao->distancia;
+            total++;
+        }
+    }
+    if (!valida || total > sh->limite) {
+        sh->total = 0;
+        hashReservarPosicoes(sh, HASH_CAPACIDADE_INICIAL);
+        return -1;
+    }
+    sh->total = total;
+    return 0;
+}
+
+// --- Placar de Suspeitos ---
+
+void inicializarPlacar(PlacarSuspeitos *placar, Arena *arena, uint32_t totalSuspeitos) {
+    placar->contagens = (uint32_t*)arenaAlocar(arena, ((size_t)totalSuspeitos + 1) * sizeof(uint32_t));
+    memset(placar->contagens, 0, ((size_t)totalSuspeitos + 1) * sizeof(uint32_t));
+    placar->totalSuspeitos = totalSuspeitos;
+}
+
+// Contexto de qsort para a classificação (mesma técnica de internador.c)
+static _Thread_local const PlacarSuspeitos *placarEmOrdenacao;
+
+static int compararSuspeitosPorContagem(const void *a, const void *b) {
+    uint32_t idA = *(const uint32_t*)a;
+    uint32_t idB = *(const uint32_t*)b;
+    uint32_t contagemA = placarEmOrdenacao->contagens[idA];
+    uint32_t contagemB = placarEmOrdenacao->contagens[idB];
+    if (contagemA != contagemB) {
+        return contagemA > contagemB ? -1 : 1;
+    }
+    return idA < idB ? -1 : (idA > idB); // Empate: ordem dos ids
+}
+
+void classificarSuspeitos(const PlacarSuspeitos *placar, uint32_t *ordem) {
+    for (uint32_t id = 0; id < placar->totalSuspeitos; id++) {
+        ordem[id] = id;
+    }
+    placarEmOrdenacao = placar;
+    qsort(ordem, placar->totalSuspeitos, sizeof(uint32_t), compararSuspeitosPorContagem);
+    placarEmOrdenacao = NULL;
+}
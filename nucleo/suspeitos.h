@@ -0,0 +1,138 @@
+/**
+ * @file suspeitos.h
+ * @brief Tabela hash pista -> alvo com endereçamento aberto (Robin Hood).
+ *
+ * Chaves e valores são identificadores de 32 bits: cada posição da tabela
+ * guarda a pista, o alvo e a distância da posição ideal em 12 bytes, e comparar
+ * chaves é comparar inteiros. No motor o alvo é a sala de onde veio a pista, e
+ * os suspeitos que ela incrimina, com seus pesos, ficam no mapa (mapaAlvos()). O critério Robin Hood permite
+ * encerrar a sondagem cedo, e a tabela dobra de tamanho sempre que o fator de
+ * carga configurado é ultrapassado.
+ *
+ * O PlacarSuspeitos acompanha a tabela com a pontuação de cada suspeito (a
+ * soma dos pesos das pistas que o incriminam), atualizada a cada inserção: as
+ * pontuações de todos os suspeitos ficam prontas durante a exploração, uma
+ * acusação é respondida em O(1) e a classificação de todos em O(S log S), sem
+ * percorrer a árvore de pistas.
+ */
+
+#ifndef SUSPEITOS_H
+#define SUSPEITOS_H
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "internador.h"
+
+// --- Constantes para a Tabela Hash ---
+#define HASH_CAPACIDADE_INICIAL 16   // Sempre potência de 2
+#define HASH_FATOR_CARGA_PADRAO 0.75
+#define HASH_FATOR_CARGA_MINIMO 0.10
+#define HASH_FATOR_CARGA_MAXIMO 0.95
+
+// --- Estruturas para a Tabela Hash (Suspeitos) ---
+
+typedef struct HashPosicao {
+    uint32_t pista;     // Chave (id da pista)
+    uint32_t alvo;      // Valor (no motor, a sala de origem da pista)
+    uint32_t distancia; // Distância da posição ideal + 1 (0 = posição livre)
+} HashPosicao;
+
+typedef struct SuspeitoHash {
+    HashPosicao *posicoes;
+    uint32_t capacidade; // Sempre potência de 2
+    uint32_t total;
+    uint32_t limite;     // Quantidade de entradas que dispara o crescimento
+    double fatorCarga;
+    Arena *arena;        // Arena de onde saem os vetores de posições
+} SuspeitoHash;
+
+// Pontuação de cada suspeito: soma dos pesos das pistas coletadas que o incriminam (índice = id do suspeito)
+typedef struct PlacarSuspeitos {
+    uint32_t *contagens;
+    uint32_t totalSuspeitos;
+} PlacarSuspeitos;
+
+// --- Funções da Tabela Hash ---
+
+/**
+ * @brief Inicializa a Tabela Hash.
+ * @param sh O ponteiro para a Tabela Hash.
+ * @param arena A arena de onde os vetores de posições serão alocados.
+ * @param fatorCarga Ocupação máxima antes do crescimento (0 usa HASH_FATOR_CARGA_PADRAO).
+ */
+void inicializarHash(SuspeitoHash *sh, Arena *arena, double fatorCarga);
+
+/**
+ * @brief Insere a associação pista/alvo na tabela hash.
+ *
+ * Se a pista já estiver associada, a associação mais recente prevalece, como
+ * no encadeamento original (inserção no início da lista).
+ * @param sh O ponteiro para a Tabela Hash.
+ * @param pista O id da pista (chave).
+ * @param alvo O id do alvo (valor).
+ * @return O alvo associado antes à pista, ou TEXTO_NENHUM se a pista for nova.
+ */
+uint32_t inserirNaHash(SuspeitoHash *sh, uint32_t pista, uint32_t alvo);
+
+/**
+ * @brief Consulta o alvo correspondente a uma pista.
+ * @param sh O ponteiro para a Tabela Hash.
+ * @param pista O id da pista (chave).
+ * @return O id do alvo ou TEXTO_NENHUM se a pista não for encontrada.
+ */
+uint32_t encontrarSuspeito(const SuspeitoHash *sh, uint32_t pista);
+
+/**
+ * @brief Substitui o conteúdo da tabela por um vetor de posições gravado antes (retrato.h).
+ *
+ * As posições são copiadas como estão, sem reinserção: cada entrada ocupada
+ * precisa estar à distância gravada da sua posição ideal, e o total respeitar
+ * o fator de carga da tabela.
+ * @param sh A tabela, já inicializada; o novo vetor sai da sua arena.
+ * @param posicoes O vetor gravado (sem exigência de alinhamento).
+ * @param capacidade A quantidade de posições (potência de 2, pelo menos HASH_CAPACIDADE_INICIAL).
+ * @return 0, ou -1 se o vetor não for de uma tabela válida (a tabela fica então vazia).
+ */
+int carregarHash(SuspeitoHash *sh, const unsigned char *posicoes, uint32_t capacidade);
+
+// --- Placar de Suspeitos ---
+
+/**
+ * @brief Inicializa o placar com todas as contagens zeradas.
+ * @param placar O ponteiro para o placar.
+ * @param arena A arena de onde o vetor de contagens será alocado.
+ * @param totalSuspeitos A quantidade de suspeitos do mapa (ids 0..totalSuspeitos-1).
+ */
+void inicializarPlacar(PlacarSuspeitos *placar, Arena *arena, uint32_t totalSuspeitos);
+
+/**
+ * @brief Soma pontos a um suspeito.
+ */
+static inline void placarSomar(PlacarSuspeitos *placar, uint32_t suspeito, uint32_t peso) {
+    placar->contagens[suspeito] += peso;
+}
+
+/**
+ * @brief Retira pontos somados antes com placarSomar().
+ */
+static inline void placarSubtrair(PlacarSuspeitos *placar, uint32_t suspeito, uint32_t peso) {
+    placar->contagens[suspeito] -= peso;
+}
+
+/**
+ * @brief Pontuação de um suspeito (com pesos 1, a quantidade de pistas que o incriminam).
+ * @return A pontuação, ou 0 para TEXTO_NENHUM ou id desconhecido.
+ */
+static inline uint32_t placarContagem(const PlacarSuspeitos *placar, uint32_t suspeito) {
+    return suspeito < placar->totalSuspeitos ? placar->contagens[suspeito] : 0;
+}
+
+/**
+ * @brief Classifica todos os suspeitos da maior para a menor pontuação.
+ * @param placar O ponteiro para o placar.
+ * @param ordem Vetor com placar->totalSuspeitos posições que recebe os ids classificados.
+ */
+void classificarSuspeitos(const PlacarSuspeitos *placar, uint32_t *ordem);
+
+#endif // SUSPEITOS_H
@@ -0,0 +1,143 @@
+/**
+ * @file teste.h
+ * @brief Apoio comum aos testes do núcleo (CTest): verificações, sorteios e mapas de teste.
+ *
+ * Cada teste é um executável sem argumentos, ou com os caminhos que o
+ * CMakeLists.txt passar, que termina com EXIT_SUCCESS só se todas as
+ * verificações passaram. Uma verificação que falha não interrompe o teste:
+ * ela é relatada com o arquivo e a linha, e o teste segue, para mostrar de
+ * uma vez tudo o que divergiu.
+ */
+
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mapa.h"
+
+// --- Verificações ---
+
+static unsigned testeFalhas = 0;
+
+#define CHECAR(condicao)                                                                  \
+    do {                                                                                  \
+        if (!(condicao)) {                                                                \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #condicao);        \
+            testeFalhas++;                                                                \
+        }                                                                                 \
+    } while (0)
+
+// Como CHECAR(), com os dois valores inteiros no relato
+#define CHECAR_IGUAL(obtido, esperado)                                                    \
+    do {                                                                                  \
+        unsigned long long testeObtido = (unsigned long long)(obtido);                   \
+        unsigned long long testeEsperado = (unsigned long long)(esperado);               \
+        if (testeObtido != testeEsperado) {                                               \
+            fprintf(stderr, "%s:%d: falhou: %s == %s (%llu, esperado %llu)\n", __FILE__,  \
+                    __LINE__, #obtido, #esperado, testeObtido, testeEsperado);            \
+            testeFalhas++;                                                                \
+        }                                                                                 \
+    } while (0)
+
+/**
+ * @brief Relata o resultado do teste.
+ * @return O código de saída do main: EXIT_SUCCESS sem falhas.
+ */
+static inline int testeResultado(const char *nome) {
+    if (testeFalhas != 0) {
+        fprintf(stderr, "%s: %u verificações falharam\n", nome, testeFalhas);
+        return EXIT_FAILURE;
+    }
+    printf("%s: ok\n", nome);
+    return EXIT_SUCCESS;
+}
+
+// --- Sorteios ---
+
+/**
+ * @brief Próximo número de um gerador xorshift64* (a semente não pode ser 0).
+ */
+static inline uint64_t testeSortear(uint64_t *estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * UINT64_C(0x2545F4914F6CDD1D);
+}
+
+static inline uint32_t testeSortearAte(uint64_t *estado, uint32_t limite) {
+    return (uint32_t)(testeSortear(estado) % limite);
+}
+
+// --- Mapas de Teste ---
+
+/**
+ * @brief Monta e finaliza um grafo com ciclos: uma árvore binária sorteada mais passagens extras.
+ *
+ * As passagens extras vão para qualquer sala, inclusive para trás e para a
+ * própria raiz, e escolhem a sala por algarismo (tecla atribuída em
+ * mapaFinalizar()). As pistas saem de um conjunto pequeno, para que várias
+ * salas repitam a mesma pista, e incriminam de 1 a 3 de 4 suspeitos com pesos
+ * de 1 a 2.
+ * @param mapa O mapa, recém-inicializado com mapaInicializar().
+ * @param totalSalas As salas (>= 1).
+ * @param extras As passagens extras.
+ * @param semente A semente do sorteio (diferente de 0).
+ */
+static inline void testeMapaComCiclos(Mapa *mapa, uint32_t totalSalas, uint32_t extras, uint64_t semente) {
+    static const char *const suspeitos[] = { "D. Branca", "Coronel Mostarda", "Prof. Plum", "Srta. Rosa" };
+    static const char *const palavras[] = { "colete", "veneno", "recado", "taça", "chave", "diário", "luva" };
+    uint64_t estado = semente;
+    for (uint32_t i = 0; i < totalSalas; i++) {
+        char nome[32];
+        char pista[64];
+        snprintf(nome, sizeof(nome), "Sala %u", i);
+        pista[0] = '\0';
+        if (testeSortearAte(&estado, 4) != 0) {
+            uint32_t numero = testeSortearAte(&estado, totalSalas / 2 + 1);
+            snprintf(pista, sizeof(pista), "Um %s de número %u", palavras[numero % 7], numero);
+        }
+        criarSala(mapa, nome, pista, "");
+        if (pista[0] != '\0') {
+            uint32_t alvos = 1 + testeSortearAte(&estado, 3);
+            for (uint32_t a = 0; a < alvos; a++) {
+                mapaAdicionarAlvo(mapa, suspeitos[testeSortearAte(&estado, 4)], 1 + testeSortearAte(&estado, 2));
+            }
+        }
+    }
+    // A árvore: cada sala depois da raiz é filha de uma sala anterior com um lado livre
+    uint32_t *esquerda = (uint32_t*)malloc((size_t)totalSalas * sizeof(uint32_t));
+    uint32_t *direita = (uint32_t*)malloc((size_t)totalSalas * sizeof(uint32_t));
+    if (esquerda == NULL || direita == NULL) {
+        printf("Erro de alocação de memória para o mapa de teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t i = 0; i < totalSalas; i++) {
+        esquerda[i] = MAPA_NENHUM;
+        direita[i] = MAPA_NENHUM;
+    }
+    for (uint32_t i = 1; i < totalSalas; i++) {
+        for (;;) {
+            uint32_t pai = testeSortearAte(&estado, i);
+            uint32_t *lado = testeSortearAte(&estado, 2) == 0 ? &esquerda[pai] : &direita[pai];
+            if (*lado == MAPA_NENHUM) {
+                *lado = i;
+                break;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < totalSalas; i++) {
+        ligarSalas(mapa, i, esquerda[i], direita[i]);
+    }
+    free(esquerda);
+    free(direita);
+    for (uint32_t i = 0; i < extras; i++) {
+        uint32_t origem = testeSortearAte(&estado, totalSalas);
+        mapaAdicionarSaida(mapa, origem, testeSortearAte(&estado, totalSalas), "", '\0');
+    }
+    mapaFinalizar(mapa);
+}
+
+#endif // TESTE_H
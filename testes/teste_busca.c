@@ -0,0 +1,179 @@
+/**
+ * @file teste_busca.c
+ * @brief Confere buscarPrefixo() e buscarTrecho() com a procura direta nas pistas coletadas.
+ *
+ * Uma sessão com a busca ativa coleta pistas de uma mansão gerada; a cada
+ * tanto, prefixos e trechos sorteados de dentro das próprias pistas (em outra
+ * caixa, cortados no meio de um trigrama ou com um byte trocado) são
+ * procurados pelas duas funções e comparados com strncmp() e com uma procura
+ * de substring byte a byte, sem diferenciar maiúsculas ASCII, em todas as
+ * pistas do conjunto, na ordem dos ids.
+ */
+
+#include <string.h>
+
+#include "busca.h"
+#include "gerador.h"
+#include "motor.h"
+#include "teste.h"
+
+// --- Constantes do Teste ---
+#define TESTE_TRECHO_MAXIMO 12
+#define TESTE_CONSULTAS 40 // Consultas de cada tipo por rodada
+
+// --- Referência ---
+
+static unsigned char referenciaMinuscula(unsigned char c) {
+    return c >= 'A' && c <= 'Z' ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+static int referenciaContem(const char *texto, const char *trecho) {
+    size_t tamanho = strlen(trecho);
+    for (; ; texto++) {
+        size_t i = 0;
+        while (i < tamanho && texto[i] != '\0' &&
+               referenciaMinuscula((unsigned char)texto[i]) == referenciaMinuscula((unsigned char)trecho[i])) {
+            i++;
+        }
+        if (i == tamanho) {
+            return 1;
+        }
+        if (*texto == '\0') {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief Procura direta: as pistas coletadas (ids em ordem) que passam no filtro.
+ */
+static uint32_t referenciaBuscar(const uint32_t *coletadas, uint32_t total, const Internador *pistas,
+                                 const char *consulta, int prefixo, uint32_t *destino) {
+    uint32_t achadas = 0;
+    for (uint32_t i = 0; i < total; i++) {
+        const char *texto = textoDoId(pistas, coletadas[i]);
+        if (prefixo ? strncmp(texto, consulta, strlen(consulta)) == 0 : referenciaContem(texto, consulta)) {
+            destino[achadas++] = coletadas[i];
+        }
+    }
+    return achadas;
+}
+
+// --- Casos ---
+
+/**
+ * @brief Sorteia uma consulta a partir de uma pista coletada: um pedaço dela, às vezes alterado.
+ */
+static void sortearConsulta(uint64_t *estado, const char *pista, int prefixo, char *destino) {
+    size_t tamanhoPista = strlen(pista);
+    size_t inicio = prefixo ? 0 : testeSortearAte(estado, (uint32_t)tamanhoPista + 1);
+    size_t tamanho = testeSortearAte(estado, TESTE_TRECHO_MAXIMO + 1);
+    if (inicio + tamanho > tamanhoPista) {
+        tamanho = tamanhoPista - inicio;
+    }
+    memcpy(destino, pista + inicio, tamanho);
+    destino[tamanho] = '\0';
+    switch (testeSortearAte(estado, 4)) {
+    case 0: // Outra caixa em uma letra
+        for (size_t i = 0; i < tamanho; i++) {
+            unsigned char c = (unsigned char)destino[i];
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+                destino[i] = (char)(c ^ 0x20);
+                break;
+            }
+        }
+        break;
+    case 1: // Um byte que não aparece nas pistas
+        if (tamanho > 0) {
+            destino[testeSortearAte(estado, (uint32_t)tamanho)] = '#';
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void conferirConsultas(uint64_t *estado, const Sessao *sessao, uint32_t *coletadas, uint32_t *obtidas,
+                              uint32_t *esperadas) {
+    const Internador *pistas = &sessao->mapa->pistas;
+    uint32_t total = listarConjuntoPistas(&sessao->pistas, coletadas);
+    CHECAR_IGUAL(total, sessao->pistas.total);
+    if (total == 0) {
+        return;
+    }
+    char consulta[TESTE_TRECHO_MAXIMO + 1];
+    for (int prefixo = 0; prefixo <= 1; prefixo++) {
+        for (uint32_t i = 0; i < TESTE_CONSULTAS; i++) {
+            const char *pista = textoDoId(pistas, coletadas[testeSortearAte(estado, total)]);
+            sortearConsulta(estado, pista, prefixo, consulta);
+            uint32_t achadas = prefixo ? buscarPrefixo(&sessao->pistas, pistas, consulta, obtidas)
+                                       : buscarTrecho(&sessao->busca, &sessao->pistas, pistas, consulta, obtidas);
+            uint32_t esperado = referenciaBuscar(coletadas, total, pistas, consulta, prefixo, esperadas);
+            CHECAR_IGUAL(achadas, esperado);
+            if (achadas == esperado && memcmp(obtidas, esperadas, (size_t)achadas * sizeof(uint32_t)) != 0) {
+                fprintf(stderr, "%s \"%s\": pistas diferentes\n", prefixo ? "prefixo" : "trecho", consulta);
+                CHECAR(0);
+            }
+        }
+    }
+    // "" devolve todas, nas duas
+    CHECAR_IGUAL(buscarPrefixo(&sessao->pistas, pistas, "", obtidas), total);
+    CHECAR_IGUAL(buscarTrecho(&sessao->busca, &sessao->pistas, pistas, "", obtidas), total);
+    CHECAR(memcmp(obtidas, coletadas, (size_t)total * sizeof(uint32_t)) == 0);
+}
+
+static void testarMapa(const Mapa *mapa, uint64_t semente, uint32_t rodadas, uint32_t jogadas) {
+    static const char teclas[] = "eedx";
+    uint32_t *coletadas = (uint32_t*)malloc(((size_t)mapa->pistas.total + 1) * sizeof(uint32_t));
+    uint32_t *obtidas = (uint32_t*)malloc(((size_t)mapa->pistas.total + 1) * sizeof(uint32_t));
+    uint32_t *esperadas = (uint32_t*)malloc(((size_t)mapa->pistas.total + 1) * sizeof(uint32_t));
+    if (coletadas == NULL || obtidas == NULL || esperadas == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    Sessao sessao;
+    iniciarSessao(&sessao, mapa);
+    sessaoAtivarBusca(&sessao);
+    uint64_t estado = semente;
+    for (uint32_t rodada = 0; rodada < rodadas; rodada++) {
+        reiniciarSessao(&sessao); // O índice é esvaziado junto com as pistas
+        sessaoColetar(&sessao);
+        for (uint32_t i = 0; i < jogadas; i++) {
+            if (sessaoMover(&sessao, teclas[testeSortearAte(&estado, 4)]) == MOVIMENTO_OK) {
+                sessaoColetar(&sessao);
+            }
+            if (i % 32 == 0) {
+                conferirConsultas(&estado, &sessao, coletadas, obtidas, esperadas);
+            }
+        }
+        conferirConsultas(&estado, &sessao, coletadas, obtidas, esperadas);
+    }
+    encerrarSessao(&sessao);
+    free(coletadas);
+    free(obtidas);
+    free(esperadas);
+}
+
+// --- Main ---
+
+int main(void) {
+    // Poucas pistas distintas, longas e parecidas: muitos trigramas em comum
+    ParametrosGerador parametros;
+    parametrosGeradorPadrao(&parametros);
+    parametros.salas = 20000;
+    parametros.forma = GERADOR_CORRENTE;
+    parametros.pistasDistintas = 3000;
+    parametros.semente = 21;
+    Mapa mapa;
+    mapaInicializar(&mapa);
+    CHECAR(gerarMansao(&mapa, &parametros) == 0);
+    testarMapa(&mapa, 1, 10, 4000);
+    liberarMapa(&mapa);
+
+    // Grafos com ciclos e pistas com acentos ("taça", "diário")
+    mapaInicializar(&mapa);
+    testeMapaComCiclos(&mapa, 2000, 4000, 5);
+    testarMapa(&mapa, 2, 10, 2000);
+    liberarMapa(&mapa);
+    return testeResultado("teste_busca");
+}
@@ -0,0 +1,233 @@
+/**
+ * @file teste_diario.c
+ * @brief Grava partidas intercaladas no diário e confere que reproduzirDiario() as refaz sem divergências.
+ *
+ * Oito sessões jogam ao mesmo tempo, com movimentos válidos e recusados, até
+ * um veredito ou até o fim do teste (partidas abertas), e reiniciam depois de
+ * cada veredito. O estado final de cada partida (sala, movimentos, pistas e
+ * veredito) é guardado pelo id que ela recebeu no diário e comparado ao da
+ * sessão que a reprodução refaz. O diário é então reaberto, com um evento
+ * incompleto no fim, e recebe mais partidas: o evento é cortado, os ids
+ * continuam a numeração e a reprodução segue sem divergências.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "diario.h"
+#include "gerador.h"
+#include "teste.h"
+
+// --- Constantes do Teste ---
+#define TESTE_SESSOES 8
+#define TESTE_JOGADAS 20000
+#define TESTE_PARTIDAS_MAXIMAS 4096
+#define TESTE_ARQUIVO "teste_diario.dqd"
+
+// --- Partidas Esperadas ---
+
+typedef struct PartidaEsperada {
+    int existe;
+    int julgada;
+    uint32_t sala;
+    uint32_t movimentos;
+    uint32_t pistas;
+    uint32_t acusado;
+    uint32_t contagem;
+    Veredito veredito;
+} PartidaEsperada;
+
+typedef struct Conferencia {
+    PartidaEsperada partidas[TESTE_PARTIDAS_MAXIMAS];
+    uint64_t conferidas;
+} Conferencia;
+
+static void guardarPartida(Conferencia *conferencia, const Sessao *sessao) {
+    uint32_t id = sessao->diario->sessao;
+    CHECAR(id < TESTE_PARTIDAS_MAXIMAS);
+    if (id >= TESTE_PARTIDAS_MAXIMAS) {
+        return;
+    }
+    PartidaEsperada *partida = &conferencia->partidas[id];
+    partida->existe = 1;
+    partida->sala = sessao->salaAtual;
+    partida->movimentos = sessao->movimentos;
+    partida->pistas = sessao->pistas.total;
+}
+
+/**
+ * @brief Chamada ao fim de cada partida reproduzida: o estado precisa ser o da partida jogada.
+ */
+static void conferirPartida(void *contexto, uint32_t id, const Sessao *sessao, const EventoDiario *veredito) {
+    Conferencia *conferencia = (Conferencia*)contexto;
+    CHECAR(id < TESTE_PARTIDAS_MAXIMAS && conferencia->partidas[id].existe);
+    if (id >= TESTE_PARTIDAS_MAXIMAS || !conferencia->partidas[id].existe) {
+        return;
+    }
+    const PartidaEsperada *partida = &conferencia->partidas[id];
+    CHECAR_IGUAL(sessao->salaAtual, partida->sala);
+    CHECAR_IGUAL(sessao->movimentos, partida->movimentos);
+    CHECAR_IGUAL(sessao->pistas.total, partida->pistas);
+    CHECAR_IGUAL(veredito != NULL, partida->julgada);
+    if (veredito != NULL && partida->julgada) {
+        CHECAR_IGUAL(veredito->argumento, partida->acusado);
+        CHECAR_IGUAL(veredito->resultado, partida->contagem);
+        CHECAR_IGUAL(veredito->detalhe, partida->veredito);
+    }
+    conferencia->conferidas++;
+}
+
+// --- Jogo ---
+
+/**
+ * @brief Joga TESTE_JOGADAS jogadas sorteadas nas sessões, com um veredito de vez em quando.
+ * @return As partidas julgadas.
+ */
+static uint64_t jogar(const Mapa *mapa, Diario *diario, Conferencia *conferencia, uint64_t semente, uint32_t jogadas,
+                      uint64_t *abertas) {
+    static const char teclas[] = "eedx";
+    Sessao sessoes[TESTE_SESSOES];
+    for (uint32_t i = 0; i < TESTE_SESSOES; i++) {
+        iniciarSessao(&sessoes[i], mapa);
+        sessaoAtivarDiario(&sessoes[i], diario);
+        sessaoColetar(&sessoes[i]);
+    }
+    uint64_t estado = semente;
+    uint64_t julgadas = 0;
+    for (uint32_t jogada = 0; jogada < jogadas; jogada++) {
+        Sessao *sessao = &sessoes[testeSortearAte(&estado, TESTE_SESSOES)];
+        if (testeSortearAte(&estado, 12) != 0) {
+            if (sessaoMover(sessao, teclas[testeSortearAte(&estado, 4)]) == MOVIMENTO_OK) {
+                sessaoColetar(sessao);
+            }
+            continue;
+        }
+        // Veredito: um suspeito do mapa ou um nome desconhecido
+        uint32_t suspeito = testeSortearAte(&estado, mapa->suspeitos.total + 1);
+        const char *nome = suspeito < mapa->suspeitos.total ? textoDoId(&mapa->suspeitos, suspeito) : "Ninguém";
+        uint32_t contagem;
+        Veredito veredito = sessaoAcusar(sessao, nome, &contagem);
+        guardarPartida(conferencia, sessao); // O veredito já deu um id à partida, se ela ainda não tinha
+        uint32_t id = sessao->diario->sessao;
+        if (id < TESTE_PARTIDAS_MAXIMAS) {
+            PartidaEsperada *partida = &conferencia->partidas[id];
+            partida->julgada = 1;
+            partida->acusado = suspeito < mapa->suspeitos.total ? suspeito : TEXTO_NENHUM;
+            partida->contagem = contagem;
+            partida->veredito = veredito;
+        }
+        julgadas++;
+        reiniciarSessao(sessao);
+        sessaoColetar(sessao);
+    }
+    // As partidas sem veredito ficam abertas no diário (as que registraram algum evento)
+    *abertas = 0;
+    for (uint32_t i = 0; i < TESTE_SESSOES; i++) {
+        if (sessoes[i].diario->sessao != DIARIO_SEM_SESSAO) {
+            guardarPartida(conferencia, &sessoes[i]);
+            (*abertas)++;
+        }
+        encerrarSessao(&sessoes[i]);
+    }
+    return julgadas;
+}
+
+static unsigned char *lerArquivo(const char *caminho, size_t *tamanho) {
+    FILE *arquivo = fopen(caminho, "rb");
+    CHECAR(arquivo != NULL);
+    if (arquivo == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    fseek(arquivo, 0, SEEK_END);
+    *tamanho = (size_t)ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+    unsigned char *dados = (unsigned char*)malloc(*tamanho + 1);
+    if (dados == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    CHECAR(fread(dados, 1, *tamanho, arquivo) == *tamanho);
+    fclose(arquivo);
+    return dados;
+}
+
+/**
+ * @brief Reproduz o diário gravado e confere o resumo e cada partida.
+ */
+static void reproduzir(const Mapa *mapa, Conferencia *conferencia, uint64_t julgadas, uint64_t abertas,
+                       size_t bytesIgnorados) {
+    size_t tamanho;
+    unsigned char *dados = lerArquivo(TESTE_ARQUIVO, &tamanho);
+    ResumoReproducao resumo;
+    conferencia->conferidas = 0;
+    CHECAR(reproduzirDiario(mapa, dados, tamanho, conferirPartida, conferencia, &resumo) == 0);
+    CHECAR_IGUAL(resumo.divergencias, 0);
+    CHECAR_IGUAL(resumo.julgadas, julgadas);
+    CHECAR_IGUAL(resumo.abertas, abertas);
+    CHECAR_IGUAL(resumo.sessoes, julgadas + abertas);
+    CHECAR_IGUAL(resumo.bytesIgnorados, bytesIgnorados);
+    CHECAR_IGUAL(conferencia->conferidas, julgadas + abertas);
+    free(dados);
+}
+
+// --- Main ---
+
+int main(void) {
+    ParametrosGerador parametros;
+    parametrosGeradorPadrao(&parametros);
+    parametros.salas = 2000;
+    parametros.pistasDistintas = 100;
+    parametros.suspeitos = 4;
+    parametros.alvosMaximos = 2;
+    parametros.semente = 11;
+    Mapa mapa;
+    mapaInicializar(&mapa);
+    CHECAR(gerarMansao(&mapa, &parametros) == 0);
+    static Conferencia conferencia;
+    unlink(TESTE_ARQUIVO);
+
+    // 1. Diário novo
+    Diario diario;
+    CHECAR(abrirDiario(&diario, &mapa, TESTE_ARQUIVO) == 0);
+    uint64_t abertas;
+    uint64_t julgadas = jogar(&mapa, &diario, &conferencia, 99, TESTE_JOGADAS, &abertas);
+    CHECAR(fecharDiario(&diario) == 0);
+    CHECAR(julgadas > 0);
+    reproduzir(&mapa, &conferencia, julgadas, abertas, 0);
+
+    // 2. Um evento incompleto no fim, como o de uma queda no meio de uma escrita
+    struct stat informacoes;
+    CHECAR(stat(TESTE_ARQUIVO, &informacoes) == 0);
+    off_t completo = informacoes.st_size;
+    FILE *arquivo = fopen(TESTE_ARQUIVO, "ab");
+    CHECAR(arquivo != NULL && fwrite("\1\2\3\4\5", 1, 5, arquivo) == 5);
+    if (arquivo != NULL) {
+        fclose(arquivo);
+    }
+    reproduzir(&mapa, &conferencia, julgadas, abertas, 5);
+
+    // 3. Reaberto: o evento incompleto é cortado e os ids continuam de onde pararam
+    uint32_t partidas = (uint32_t)(julgadas + abertas);
+    CHECAR(abrirDiario(&diario, &mapa, TESTE_ARQUIVO) == 0);
+    CHECAR(stat(TESTE_ARQUIVO, &informacoes) == 0 && informacoes.st_size == completo);
+    CHECAR_IGUAL(atomic_load(&diario.proximaSessao), partidas);
+    uint64_t abertasDepois;
+    uint64_t julgadasDepois = jogar(&mapa, &diario, &conferencia, 123, TESTE_JOGADAS / 4, &abertasDepois);
+    CHECAR(fecharDiario(&diario) == 0);
+    reproduzir(&mapa, &conferencia, julgadas + julgadasDepois, abertas + abertasDepois, 0);
+
+    // 4. Um diário de outro mapa é recusado
+    Mapa outro;
+    parametros.salas = 1999;
+    mapaInicializar(&outro);
+    CHECAR(gerarMansao(&outro, &parametros) == 0);
+    CHECAR(abrirDiario(&diario, &outro, TESTE_ARQUIVO) != 0);
+    liberarMapa(&outro);
+
+    unlink(TESTE_ARQUIVO);
+    liberarMapa(&mapa);
+    return testeResultado("teste_diario");
+}
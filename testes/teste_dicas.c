@@ -0,0 +1,267 @@
+/**
+ * @file teste_dicas.c
+ * @brief Confere as respostas do IndiceDicas com buscas em largura e caminhos jogados no motor.
+ *
+ * Para salas sorteadas de mansões geradas (árvores) e de grafos com ciclos:
+ * - dicaDistancia() é a distância de uma busca em largura direta, e
+ *   MAPA_NENHUM quando o destino não é alcançável;
+ * - a saída de dicaPrimeiroPasso() leva a uma sala um movimento mais perto;
+ * - dicaPistaMaisProxima() devolve uma sala com pista ainda disponível para a
+ *   sessão, à menor distância entre todas elas.
+ * Nas árvores, dicaSustentarAcusacao() é comparada com a sala mais rasa da
+ * subárvore cujo caminho desde a raiz, jogado em uma sessão, sustenta a
+ * acusação.
+ */
+
+#include <string.h>
+
+#include "dicas.h"
+#include "gerador.h"
+#include "motor.h"
+#include "teste.h"
+
+// --- Constantes do Teste ---
+#define TESTE_ORIGENS 40
+#define TESTE_DESTINOS 200 // Por origem
+
+// --- Referência ---
+
+typedef struct Referencia {
+    const Mapa *mapa;
+    uint32_t *distancia; // Da última origem, por sala
+    uint32_t *fila;
+    uint32_t *pai;       // Árvores: sala de que se chega a cada sala
+    uint32_t *saidaPai;  // ... e a posição da saída seguida nela
+    uint32_t *profundidade;
+} Referencia;
+
+static void iniciarReferencia(Referencia *referencia, const Mapa *mapa) {
+    size_t salas = mapa->totalSalas;
+    referencia->mapa = mapa;
+    referencia->distancia = (uint32_t*)malloc(salas * sizeof(uint32_t));
+    referencia->fila = (uint32_t*)malloc(salas * sizeof(uint32_t));
+    referencia->pai = (uint32_t*)malloc(salas * sizeof(uint32_t));
+    referencia->saidaPai = (uint32_t*)malloc(salas * sizeof(uint32_t));
+    referencia->profundidade = (uint32_t*)malloc(salas * sizeof(uint32_t));
+    if (referencia->distancia == NULL || referencia->fila == NULL || referencia->pai == NULL ||
+        referencia->saidaPai == NULL || referencia->profundidade == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void liberarReferencia(Referencia *referencia) {
+    free(referencia->distancia);
+    free(referencia->fila);
+    free(referencia->pai);
+    free(referencia->saidaPai);
+    free(referencia->profundidade);
+}
+
+/**
+ * @brief Busca em largura a partir de uma sala; guarda também o pai e a saída de chegada de cada sala.
+ */
+static void buscarLargura(Referencia *referencia, uint32_t origem) {
+    const Mapa *mapa = referencia->mapa;
+    for (uint32_t i = 0; i < mapa->totalSalas; i++) {
+        referencia->distancia[i] = MAPA_NENHUM;
+        referencia->pai[i] = MAPA_NENHUM;
+    }
+    uint32_t inicio = 0;
+    uint32_t fim = 0;
+    referencia->distancia[origem] = 0;
+    referencia->fila[fim++] = origem;
+    while (inicio < fim) {
+        uint32_t sala = referencia->fila[inicio++];
+        const SaidaSala *saidas = mapaSaidas(mapa, sala);
+        for (uint32_t s = 0; s < mapaTotalSaidas(mapa, sala); s++) {
+            uint32_t destino = saidas[s].destino;
+            if (referencia->distancia[destino] == MAPA_NENHUM) {
+                referencia->distancia[destino] = referencia->distancia[sala] + 1;
+                referencia->pai[destino] = sala;
+                referencia->saidaPai[destino] = s;
+                referencia->fila[fim++] = destino;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Joga em uma sessão o caminho da raiz até uma sala (árvores; pai de buscarLargura() a partir da raiz).
+ */
+static void jogarCaminho(const Referencia *raiz, Sessao *sessao, uint32_t sala) {
+    uint32_t profundidade = 0;
+    for (uint32_t s = sala; s != raiz->mapa->raiz; s = raiz->pai[s]) {
+        raiz->fila[profundidade++] = s; // Do fim para o começo
+    }
+    reiniciarSessao(sessao);
+    sessaoColetar(sessao);
+    while (profundidade > 0) {
+        uint32_t proxima = raiz->fila[--profundidade];
+        CHECAR(sessaoSeguir(sessao, raiz->saidaPai[proxima]) == MOVIMENTO_OK);
+        sessaoColetar(sessao);
+    }
+    CHECAR_IGUAL(sessao->salaAtual, sala);
+}
+
+// --- Casos ---
+
+/**
+ * @brief Distâncias, primeiros passos e a pista mais próxima a partir de salas sorteadas.
+ */
+static void testarBuscas(const Mapa *mapa, IndiceDicas *indice, uint64_t semente) {
+    Referencia referencia;
+    iniciarReferencia(&referencia, mapa);
+    Sessao sessao;
+    iniciarSessao(&sessao, mapa);
+    uint64_t estado = semente;
+    for (uint32_t o = 0; o < TESTE_ORIGENS; o++) {
+        // A sessão anda um pouco, para que algumas pistas já estejam coletadas
+        reiniciarSessao(&sessao);
+        sessaoColetar(&sessao);
+        uint32_t passos = testeSortearAte(&estado, 60);
+        for (uint32_t i = 0; i < passos && mapaTotalSaidas(mapa, sessao.salaAtual) > 0; i++) {
+            CHECAR(sessaoSeguir(&sessao, testeSortearAte(&estado, mapaTotalSaidas(mapa, sessao.salaAtual))) ==
+                   MOVIMENTO_OK);
+            sessaoColetar(&sessao);
+        }
+        uint32_t origem = sessao.salaAtual;
+        buscarLargura(&referencia, origem);
+
+        for (uint32_t d = 0; d < TESTE_DESTINOS; d++) {
+            uint32_t destino = testeSortearAte(&estado, mapa->totalSalas);
+            uint32_t distancia = referencia.distancia[destino];
+            CHECAR_IGUAL(dicaDistancia(indice, origem, destino), distancia);
+            uint32_t passo = dicaPrimeiroPasso(indice, origem, destino);
+            if (distancia == MAPA_NENHUM || distancia == 0) {
+                CHECAR_IGUAL(passo, MAPA_NENHUM);
+            } else {
+                CHECAR(passo < mapaTotalSaidas(mapa, origem));
+                if (passo < mapaTotalSaidas(mapa, origem)) {
+                    uint32_t seguinte = mapaSaidas(mapa, origem)[passo].destino;
+                    CHECAR_IGUAL(dicaDistancia(indice, seguinte, destino), distancia - 1);
+                }
+            }
+        }
+
+        // A pista mais próxima: a menor distância entre as salas com pista disponível
+        uint32_t minima = MAPA_NENHUM;
+        for (uint32_t sala = 0; sala < mapa->totalSalas; sala++) {
+            if (referencia.distancia[sala] < minima && sessaoPistaDisponivel(&sessao, sala) != TEXTO_NENHUM) {
+                minima = referencia.distancia[sala];
+            }
+        }
+        uint32_t movimentos;
+        uint32_t sala = dicaPistaMaisProxima(indice, &sessao, &movimentos);
+        if (minima == MAPA_NENHUM) {
+            CHECAR_IGUAL(sala, MAPA_NENHUM);
+        } else {
+            CHECAR(sala < mapa->totalSalas);
+            CHECAR_IGUAL(movimentos, minima);
+            if (sala < mapa->totalSalas) {
+                CHECAR_IGUAL(referencia.distancia[sala], minima);
+                CHECAR(sessaoPistaDisponivel(&sessao, sala) != TEXTO_NENHUM);
+            }
+        }
+    }
+    encerrarSessao(&sessao);
+    liberarReferencia(&referencia);
+}
+
+/**
+ * @brief Árvores: a acusação sustentada mais próxima, conferida jogando o caminho de cada sala da subárvore.
+ */
+static void testarAcusacao(const Mapa *mapa, IndiceDicas *indice, uint64_t semente) {
+    CHECAR(indice->arvore);
+    Referencia raiz;
+    iniciarReferencia(&raiz, mapa);
+    buscarLargura(&raiz, mapa->raiz);
+    for (uint32_t i = 0; i < mapa->totalSalas; i++) {
+        raiz.profundidade[i] = raiz.distancia[i];
+    }
+    Referencia subarvore;
+    iniciarReferencia(&subarvore, mapa);
+    Sessao sessao;
+    Sessao candidata;
+    iniciarSessao(&sessao, mapa);
+    iniciarSessao(&candidata, mapa);
+    uint64_t estado = semente;
+
+    for (uint32_t o = 0; o < TESTE_ORIGENS; o++) {
+        uint32_t origem = testeSortearAte(&estado, mapa->totalSalas);
+        if (raiz.profundidade[origem] == MAPA_NENHUM) {
+            continue;
+        }
+        jogarCaminho(&raiz, &sessao, origem);
+        buscarLargura(&subarvore, origem);
+        for (uint32_t suspeito = 0; suspeito <= mapa->suspeitos.total; suspeito++) {
+            // A sala mais rasa da subárvore (e, no empate, qualquer uma) em que o caminho sustenta a acusação
+            uint32_t esperado = MAPA_NENHUM;
+            for (uint32_t sala = 0; sala < mapa->totalSalas && suspeito < mapa->suspeitos.total; sala++) {
+                if (subarvore.distancia[sala] >= esperado) {
+                    continue;
+                }
+                jogarCaminho(&raiz, &candidata, sala);
+                if (sessaoJulgar(&candidata, suspeito, NULL) == VEREDITO_SUSTENTADO) {
+                    esperado = subarvore.distancia[sala];
+                }
+            }
+            uint32_t destino;
+            uint32_t movimentos = dicaSustentarAcusacao(indice, &sessao, suspeito, &destino);
+            CHECAR_IGUAL(movimentos, esperado);
+            if (esperado == MAPA_NENHUM) {
+                CHECAR_IGUAL(destino, MAPA_NENHUM);
+            } else if (destino < mapa->totalSalas) {
+                CHECAR_IGUAL(subarvore.distancia[destino], esperado);
+                jogarCaminho(&raiz, &candidata, destino);
+                CHECAR(sessaoJulgar(&candidata, suspeito, NULL) == VEREDITO_SUSTENTADO);
+            } else {
+                CHECAR(0);
+            }
+        }
+    }
+    encerrarSessao(&sessao);
+    encerrarSessao(&candidata);
+    liberarReferencia(&raiz);
+    liberarReferencia(&subarvore);
+}
+
+// --- Main ---
+
+int main(void) {
+    FormaMansao formas[] = { GERADOR_EQUILIBRADA, GERADOR_DESEQUILIBRADA, GERADOR_CORRENTE };
+    for (size_t i = 0; i < sizeof(formas) / sizeof(formas[0]); i++) {
+        ParametrosGerador parametros;
+        parametrosGeradorPadrao(&parametros);
+        parametros.salas = 600;
+        parametros.forma = formas[i];
+        parametros.densidade = 0.5;
+        parametros.pistasDistintas = 60;
+        parametros.suspeitos = 4;
+        parametros.alvosMaximos = 2;
+        parametros.semente = 77 + i;
+        Mapa mapa;
+        mapaInicializar(&mapa);
+        CHECAR(gerarMansao(&mapa, &parametros) == 0);
+        IndiceDicas indice;
+        construirIndiceDicas(&indice, &mapa);
+        testarBuscas(&mapa, &indice, 1 + i);
+        testarAcusacao(&mapa, &indice, 1 + i);
+        liberarIndiceDicas(&indice);
+        liberarMapa(&mapa);
+    }
+
+    // Grafos com ciclos: as respostas saem das buscas em largura guardadas no índice
+    for (uint64_t semente = 1; semente <= 10; semente++) {
+        Mapa mapa;
+        mapaInicializar(&mapa);
+        testeMapaComCiclos(&mapa, 500, 250 * (uint32_t)semente, semente);
+        IndiceDicas indice;
+        construirIndiceDicas(&indice, &mapa);
+        CHECAR(!indice.arvore);
+        testarBuscas(&mapa, &indice, semente);
+        liberarIndiceDicas(&indice);
+        liberarMapa(&mapa);
+    }
+    return testeResultado("teste_dicas");
+}
@@ -0,0 +1,136 @@
+/**
+ * @file teste_hash.c
+ * @brief Confere o hash e a comparação de textos do internador com o djb2 byte a byte.
+ *
+ * O CMakeLists.txt compila este teste duas vezes: ligado à biblioteca (com
+ * SSE2 ou NEON, se DQ_SIMD estiver ligado) e à variante dela compilada com
+ * DQ_SEM_SIMD. Os dois precisam dar o hash do laço de referência abaixo, que
+ * é o gravado nos arquivos .dqm, para textos de todos os tamanhos em torno dos
+ * blocos de 16 bytes, com maiúsculas, bytes UTF-8 e os vizinhos de 'A'..'Z'.
+ */
+
+#include <string.h>
+
+#include "internador.h"
+#include "teste.h"
+
+// --- Constantes do Teste ---
+#define TESTE_TAMANHO_MAXIMO 100 // Bytes dos textos sorteados
+#define TESTE_TEXTOS 20000
+
+// Letras, os vizinhos da faixa 'A'..'Z' e 'a'..'z' e bytes de UTF-8
+static const char alfabeto[] = "AZaz@[`{09 .,-MmQq\xc3\xa7\xc3\x87\xc3\xa3\x80\xff";
+
+// --- Referência ---
+
+static unsigned char referenciaMinuscula(unsigned char c) {
+    return c >= 'A' && c <= 'Z' ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+static uint32_t referenciaHash(const char *texto) {
+    uint32_t hash = 5381;
+    for (; *texto != '\0'; texto++) {
+        hash = hash * 33 + referenciaMinuscula((unsigned char)*texto);
+    }
+    return hash;
+}
+
+static int referenciaIguais(const char *a, const char *b) {
+    for (; *a != '\0' && referenciaMinuscula((unsigned char)*a) == referenciaMinuscula((unsigned char)*b); a++, b++) {
+    }
+    return *a == '\0' && *b == '\0';
+}
+
+static void sortearTexto(uint64_t *estado, char *destino, uint32_t tamanho) {
+    for (uint32_t i = 0; i < tamanho; i++) {
+        destino[i] = alfabeto[testeSortearAte(estado, sizeof(alfabeto) - 1)];
+    }
+    destino[tamanho] = '\0';
+}
+
+/**
+ * @brief Troca maiúsculas por minúsculas e vice-versa, só nas letras ASCII.
+ */
+static void inverterCaixa(char *texto) {
+    for (; *texto != '\0'; texto++) {
+        unsigned char c = (unsigned char)*texto;
+        if (c >= 'A' && c <= 'Z') {
+            *texto = (char)(c - 'A' + 'a');
+        } else if (c >= 'a' && c <= 'z') {
+            *texto = (char)(c - 'a' + 'A');
+        }
+    }
+}
+
+// --- Casos ---
+
+/**
+ * @brief O hash de cada tamanho, em cada alinhamento do texto dentro de um bloco.
+ */
+static void testarHash(void) {
+    uint64_t estado = 42;
+    char buffer[TESTE_TAMANHO_MAXIMO + 32];
+    for (uint32_t tamanho = 0; tamanho <= TESTE_TAMANHO_MAXIMO; tamanho++) {
+        for (uint32_t deslocamento = 0; deslocamento < 16; deslocamento++) {
+            char *texto = buffer + deslocamento;
+            sortearTexto(&estado, texto, tamanho);
+            CHECAR_IGUAL(calcularHash(texto), referenciaHash(texto));
+        }
+    }
+    // Maiúsculas e minúsculas dão o mesmo hash
+    for (uint32_t i = 0; i < 1000; i++) {
+        sortearTexto(&estado, buffer, testeSortearAte(&estado, TESTE_TAMANHO_MAXIMO));
+        uint32_t hash = calcularHash(buffer);
+        inverterCaixa(buffer);
+        CHECAR_IGUAL(calcularHash(buffer), hash);
+    }
+}
+
+/**
+ * @brief Procuras no internador: a mesma pista em outra caixa é encontrada, um byte diferente não.
+ */
+static void testarComparacao(void) {
+    uint64_t estado = 7;
+    Internador internador;
+    inicializarInternador(&internador);
+    char (*textos)[TESTE_TAMANHO_MAXIMO + 1] = malloc(TESTE_TEXTOS * sizeof(*textos));
+    uint32_t *ids = (uint32_t*)malloc(TESTE_TEXTOS * sizeof(uint32_t));
+    if (textos == NULL || ids == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t i = 0; i < TESTE_TEXTOS; i++) {
+        sortearTexto(&estado, textos[i], 1 + testeSortearAte(&estado, TESTE_TAMANHO_MAXIMO));
+        ids[i] = internar(&internador, textos[i]);
+        CHECAR(referenciaIguais(textoDoId(&internador, ids[i]), textos[i]));
+    }
+    CHECAR(validarInternador(&internador) == 1);
+
+    char variante[TESTE_TAMANHO_MAXIMO + 1];
+    for (uint32_t i = 0; i < TESTE_TEXTOS; i++) {
+        strcpy(variante, textos[i]);
+        inverterCaixa(variante);
+        CHECAR_IGUAL(internadorProcurar(&internador, variante), ids[i]);
+
+        // Um byte trocado por um que não é a outra caixa dele: só acha um texto de fato igual
+        size_t posicao = testeSortearAte(&estado, (uint32_t)strlen(variante));
+        variante[posicao] = variante[posicao] == '#' ? '%' : '#';
+        uint32_t achado = internadorProcurar(&internador, variante);
+        CHECAR(achado == TEXTO_NENHUM || referenciaIguais(textoDoId(&internador, achado), variante));
+    }
+    free(textos);
+    free(ids);
+    liberarInternador(&internador);
+}
+
+// --- Main ---
+
+int main(void) {
+    testarHash();
+    testarComparacao();
+#ifdef DQ_SEM_SIMD
+    return testeResultado("teste_hash (sem SIMD)");
+#else
+    return testeResultado("teste_hash");
+#endif
+}
@@ -0,0 +1,282 @@
+/**
+ * @file teste_pistas.c
+ * @brief Confere a construção e a mescla em lote da árvore de pistas e do conjunto de pistas.
+ *
+ * - construirPistas(): lotes sorteados (com repetições, já em ordem, todos
+ *   iguais, vazio) dão a mesma sequência em ordem que inserirPista() um a um,
+ *   a árvore é uma AVL com a altura mínima, os nós ficam em sequência na
+ *   memória e a árvore continua válida para inserções seguintes;
+ * - mesclarPistas(): a união em ordem, sem repetições, de duas árvores, que
+ *   não são alteradas;
+ * - conjuntoInserirLote() e conjuntoUnir(): as mesmas pistas, o mesmo total e
+ *   o mesmo percurso que as inserções uma a uma.
+ */
+
+#include <string.h>
+
+#include "conjunto.h"
+#include "pistas.h"
+#include "teste.h"
+
+// --- Constantes do Teste ---
+#define TESTE_LOTES 200
+#define TESTE_LOTE_MAXIMO 5000
+
+// --- Referência ---
+
+static int compararIds(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Os ids em ordem, sem repetições.
+ * @return A quantidade de ids distintos.
+ */
+static uint32_t referenciaOrdenar(const uint32_t *ids, uint32_t total, uint32_t *destino) {
+    if (total == 0) {
+        return 0;
+    }
+    memcpy(destino, ids, (size_t)total * sizeof(uint32_t));
+    qsort(destino, total, sizeof(uint32_t), compararIds);
+    uint32_t distintos = 1;
+    for (uint32_t i = 1; i < total; i++) {
+        if (destino[i] != destino[distintos - 1]) {
+            destino[distintos++] = destino[i];
+        }
+    }
+    return distintos;
+}
+
+/**
+ * @brief Confere alturas e fatores de balanceamento de uma AVL (a recursão é limitada pela altura).
+ * @return A altura da subárvore, ou -1 se alguma regra falhou.
+ */
+static int conferirAvl(const PistaNode *no) {
+    if (no == NULL) {
+        return 0;
+    }
+    int esquerda = conferirAvl(no->esquerda);
+    int direita = conferirAvl(no->direita);
+    if (esquerda < 0 || direita < 0 || esquerda - direita > 1 || direita - esquerda > 1) {
+        return -1;
+    }
+    int altura = 1 + (esquerda > direita ? esquerda : direita);
+    return no->altura == altura ? altura : -1;
+}
+
+/**
+ * @brief Copia as pistas de uma árvore, em ordem, com um IteradorPistas.
+ * @return A quantidade de pistas.
+ */
+static uint32_t listarPistas(const PistaNode *raiz, uint32_t *destino) {
+    IteradorPistas iterador;
+    iniciarIteradorPistas(&iterador, raiz);
+    uint32_t total = 0;
+    for (uint32_t pista = proximaPista(&iterador); pista != TEXTO_NENHUM; pista = proximaPista(&iterador)) {
+        destino[total++] = pista;
+    }
+    return total;
+}
+
+static void compararLista(const PistaNode *raiz, const uint32_t *esperadas, uint32_t total, uint32_t *lista) {
+    CHECAR_IGUAL(listarPistas(raiz, lista), total);
+    CHECAR(memcmp(lista, esperadas, (size_t)total * sizeof(uint32_t)) == 0);
+}
+
+static void sortearLote(uint64_t *estado, uint32_t *ids, uint32_t total) {
+    uint32_t faixa = 1 + testeSortearAte(estado, 2 * TESTE_LOTE_MAXIMO);
+    switch (testeSortearAte(estado, 4)) {
+    case 0: // Já em ordem, com repetições
+        for (uint32_t i = 0; i < total; i++) {
+            ids[i] = i / 2;
+        }
+        break;
+    case 1: // Em ordem decrescente
+        for (uint32_t i = 0; i < total; i++) {
+            ids[i] = total - i;
+        }
+        break;
+    case 2: // Todos iguais
+        for (uint32_t i = 0; i < total; i++) {
+            ids[i] = faixa;
+        }
+        break;
+    default: // Sorteados, com bytes altos diferentes
+        for (uint32_t i = 0; i < total; i++) {
+            ids[i] = testeSortearAte(estado, faixa) * (faixa % 3 == 0 ? 65537u : 1u);
+        }
+        break;
+    }
+}
+
+// --- Casos ---
+
+static void testarConstruir(uint32_t *ids, uint32_t *guardados, uint32_t *esperadas, uint32_t *lista) {
+    uint64_t estado = 3;
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    PoolNos pool;
+    CHECAR(construirPistas(&pool, ids, 0) == NULL);
+
+    for (uint32_t lote = 0; lote < TESTE_LOTES; lote++) {
+        arenaReiniciar(&arena);
+        poolInicializar(&pool, &arena, sizeof(PistaNode));
+        uint32_t total = 1 + testeSortearAte(&estado, TESTE_LOTE_MAXIMO);
+        sortearLote(&estado, ids, total);
+        memcpy(guardados, ids, (size_t)total * sizeof(uint32_t));
+        uint32_t distintos = referenciaOrdenar(ids, total, esperadas);
+
+        PistaNode *raiz = construirPistas(&pool, ids, total);
+        compararLista(raiz, esperadas, distintos, lista);
+        // Altura mínima: a quantidade de bits do total de nós
+        CHECAR_IGUAL(conferirAvl(raiz), 32 - __builtin_clz(distintos));
+
+        // Os nós formam uma fatia só, na ordem das pistas
+        const PistaNode *primeiro = raiz;
+        while (primeiro->esquerda != NULL) {
+            primeiro = primeiro->esquerda;
+        }
+        int emSequencia = 1;
+        for (uint32_t i = 0; i < distintos; i++) {
+            emSequencia &= primeiro[i].pista == esperadas[i];
+        }
+        CHECAR(emSequencia);
+
+        // A mesma árvore que as inserções uma a uma
+        PistaNode *inserida = NULL;
+        for (uint32_t i = 0; i < total; i++) {
+            inserida = inserirPista(&pool, inserida, guardados[i]);
+        }
+        compararLista(inserida, esperadas, distintos, lista);
+
+        // E continua uma AVL depois de mais inserções
+        uint32_t extras = testeSortearAte(&estado, 200);
+        for (uint32_t i = 0; i < extras; i++) {
+            guardados[total + i] = testeSortearAte(&estado, 3 * TESTE_LOTE_MAXIMO);
+            raiz = inserirPista(&pool, raiz, guardados[total + i]);
+        }
+        distintos = referenciaOrdenar(guardados, total + extras, esperadas);
+        compararLista(raiz, esperadas, distintos, lista);
+        CHECAR(conferirAvl(raiz) > 0);
+        liberarPistas(&pool, raiz);
+        liberarPistas(&pool, inserida);
+    }
+    arenaLiberar(&arena);
+}
+
+static void testarMesclar(uint32_t *ids, uint32_t *guardados, uint32_t *esperadas, uint32_t *lista) {
+    uint64_t estado = 5;
+    Arena arena;
+    arenaInicializar(&arena, ARENA_BLOCO_PADRAO);
+    PoolNos pool;
+    poolInicializar(&pool, &arena, sizeof(PistaNode));
+    CHECAR(mesclarPistas(&pool, NULL, NULL) == NULL);
+
+    for (uint32_t lote = 0; lote < TESTE_LOTES; lote++) {
+        arenaReiniciar(&arena);
+        poolInicializar(&pool, &arena, sizeof(PistaNode));
+        uint32_t totalA = testeSortearAte(&estado, TESTE_LOTE_MAXIMO);
+        uint32_t totalB = testeSortearAte(&estado, TESTE_LOTE_MAXIMO);
+        sortearLote(&estado, ids, totalA + totalB);
+        PistaNode *a = NULL;
+        PistaNode *b = NULL;
+        for (uint32_t i = 0; i < totalA; i++) {
+            a = inserirPista(&pool, a, ids[i]);
+        }
+        for (uint32_t i = totalA; i < totalA + totalB; i++) {
+            b = inserirPista(&pool, b, ids[i]);
+        }
+        uint32_t distintosA = listarPistas(a, guardados);
+
+        PistaNode *uniao = mesclarPistas(&pool, a, b);
+        uint32_t distintos = referenciaOrdenar(ids, totalA + totalB, esperadas);
+        compararLista(uniao, esperadas, distintos, lista);
+        CHECAR(distintos == 0 || conferirAvl(uniao) == 32 - __builtin_clz(distintos));
+        compararLista(a, guardados, distintosA, lista);
+    }
+    arenaLiberar(&arena);
+}
+
+static void testarConjunto(uint32_t *ids, uint32_t *esperadas, uint32_t *lista) {
+    uint64_t estado = 7;
+    uint32_t totalPistas = 3 * TESTE_LOTE_MAXIMO + 1;
+    ConjuntoPistas um;
+    ConjuntoPistas lote;
+    ConjuntoPistas outro;
+    iniciarConjuntoPistas(&um, totalPistas);
+    iniciarConjuntoPistas(&lote, totalPistas);
+    iniciarConjuntoPistas(&outro, totalPistas);
+
+    for (uint32_t rodada = 0; rodada < TESTE_LOTES; rodada++) {
+        esvaziarConjuntoPistas(&um);
+        esvaziarConjuntoPistas(&lote);
+        esvaziarConjuntoPistas(&outro);
+        uint32_t totalA = testeSortearAte(&estado, TESTE_LOTE_MAXIMO);
+        uint32_t totalB = testeSortearAte(&estado, TESTE_LOTE_MAXIMO);
+        for (uint32_t i = 0; i < totalA + totalB; i++) {
+            ids[i] = testeSortearAte(&estado, 1 + testeSortearAte(&estado, totalPistas));
+        }
+
+        // Lote contra uma a uma
+        for (uint32_t i = 0; i < totalA; i++) {
+            conjuntoInserir(&um, ids[i]);
+        }
+        conjuntoInserirLote(&lote, ids, totalA);
+        uint32_t distintos = referenciaOrdenar(ids, totalA, esperadas);
+        CHECAR_IGUAL(lote.total, distintos);
+        CHECAR_IGUAL(listarConjuntoPistas(&lote, lista), distintos);
+        CHECAR(memcmp(lista, esperadas, (size_t)distintos * sizeof(uint32_t)) == 0);
+        CHECAR(memcmp(um.bits, lote.bits, (size_t)um.totalPalavras * sizeof(uint64_t)) == 0);
+
+        // União das coletas de duas sessões
+        conjuntoInserirLote(&outro, ids + totalA, totalB);
+        uint32_t totalOutro = outro.total;
+        conjuntoUnir(&lote, &outro);
+        distintos = referenciaOrdenar(ids, totalA + totalB, esperadas);
+        CHECAR_IGUAL(lote.total, distintos);
+        CHECAR_IGUAL(listarConjuntoPistas(&lote, lista), distintos);
+        CHECAR(memcmp(lista, esperadas, (size_t)distintos * sizeof(uint32_t)) == 0);
+        CHECAR_IGUAL(outro.total, totalOutro);
+
+        // O iterador a partir de um id qualquer usa o resumo atualizado pela união
+        uint32_t menor = testeSortearAte(&estado, totalPistas);
+        IteradorConjunto iterador;
+        iniciarIteradorConjuntoDesde(&iterador, &lote, menor);
+        uint32_t primeira = 0;
+        while (primeira < distintos && esperadas[primeira] < menor) {
+            primeira++;
+        }
+        int iguais = 1;
+        for (uint32_t i = primeira; i < distintos; i++) {
+            iguais &= proximaPistaConjunto(&iterador) == esperadas[i];
+        }
+        CHECAR(iguais && proximaPistaConjunto(&iterador) == TEXTO_NENHUM);
+    }
+    liberarConjuntoPistas(&um);
+    liberarConjuntoPistas(&lote);
+    liberarConjuntoPistas(&outro);
+}
+
+// --- Main ---
+
+int main(void) {
+    size_t tamanho = (2 * (size_t)TESTE_LOTE_MAXIMO + 200) * sizeof(uint32_t);
+    uint32_t *ids = (uint32_t*)malloc(tamanho);
+    uint32_t *guardados = (uint32_t*)malloc(tamanho);
+    uint32_t *esperadas = (uint32_t*)malloc(tamanho);
+    uint32_t *lista = (uint32_t*)malloc(tamanho);
+    if (ids == NULL || guardados == NULL || esperadas == NULL || lista == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    testarConstruir(ids, guardados, esperadas, lista);
+    testarMesclar(ids, guardados, esperadas, lista);
+    testarConjunto(ids, esperadas, lista);
+    free(ids);
+    free(guardados);
+    free(esperadas);
+    free(lista);
+    return testeResultado("teste_pistas");
+}
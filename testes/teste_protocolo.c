@@ -0,0 +1,100 @@
+/**
+ * @file teste_protocolo.c
+ * @brief Conversas completas com atenderRequisicao() na mansão do nível mestre, resposta por resposta.
+ *
+ * Cada passo é uma requisição e a linha JSON exata que ela deve produzir,
+ * cobrindo as formas curta e longa dos comandos, os movimentos recusados, as
+ * duas fases da partida (explorando e julgada), o recomeço e o fim.
+ */
+
+#include <string.h>
+
+#include "mapa_arquivo.h"
+#include "protocolo.h"
+#include "teste.h"
+
+// --- Conversas ---
+
+typedef struct Passo {
+    const char *requisicao;
+    const char *resposta;   // "" para nenhuma resposta
+} Passo;
+
+#define ESTADO_HALL                                                                                   \
+    "{\"evento\":\"estado\",\"sala\":\"Hall de Entrada\",\"pista\":\"A porta estava aberta.\","      \
+    "\"saidas\":[{\"tecla\":\"e\",\"sala\":\"Sala de Estar\"},{\"tecla\":\"d\",\"sala\":\"Cozinha\"}]," \
+    "\"movimentos\":0,\"pistas\":1,\"encerrada\":false,\"julgada\":false}\n"
+
+static const Passo conversa[] = {
+    { "e", ESTADO_HALL },
+    { "estado", ESTADO_HALL },
+    { "", "" },
+    { "p", "{\"evento\":\"pistas\",\"pistas\":[\"A porta estava aberta.\"]}\n" },
+    { "m e",
+      "{\"evento\":\"movimento\",\"coletadas\":[\"Um colete ensanguentado.\"],\"sala\":\"Sala de Estar\","
+      "\"movimentos\":1,\"recusados\":0,\"pistas\":2,\"encerrada\":false}\n" },
+    // 'x' não é saída (recusado); 'e' leva à Biblioteca
+    { "mover xe",
+      "{\"evento\":\"movimento\",\"coletadas\":[\"Um recado escrito 'A Sra. em perigo'.\"],\"sala\":\"Biblioteca\","
+      "\"movimentos\":2,\"recusados\":1,\"pistas\":3,\"encerrada\":false}\n" },
+    // Sala sem caminhos: as duas direções são bloqueadas
+    { "m ed",
+      "{\"evento\":\"movimento\",\"coletadas\":[],\"sala\":\"Biblioteca\","
+      "\"movimentos\":2,\"recusados\":2,\"pistas\":3,\"encerrada\":false}\n" },
+    { "pistas",
+      "{\"evento\":\"pistas\",\"pistas\":[\"A porta estava aberta.\",\"Um colete ensanguentado.\","
+      "\"Um recado escrito 'A Sra. em perigo'.\"]}\n" },
+    { "a D. Branca",
+      "{\"evento\":\"julgamento\",\"acusado\":\"D. Branca\",\"contagem\":2,\"minimo\":2,\"veredito\":\"SUSTENTADA\"}\n" },
+    // Julgada: movimentos e nova acusação recusados, consultas aceitas
+    { "m e", "{\"evento\":\"erro\",\"mensagem\":\"partida julgada; use \\\"n\\\" para recomeçar\"}\n" },
+    { "acusar Prof. Plum", "{\"evento\":\"erro\",\"mensagem\":\"partida julgada; use \\\"n\\\" para recomeçar\"}\n" },
+    { "e",
+      "{\"evento\":\"estado\",\"sala\":\"Biblioteca\",\"pista\":\"Um recado escrito 'A Sra. em perigo'.\","
+      "\"saidas\":[],\"movimentos\":2,\"pistas\":3,\"encerrada\":true,\"julgada\":true}\n" },
+    { "x", "{\"evento\":\"erro\",\"mensagem\":\"requisição desconhecida; use m, e, p, a, n ou f\"}\n" },
+    // Nova partida: volta ao hall só com a pista dele
+    { "n", ESTADO_HALL },
+    { "m dd",
+      "{\"evento\":\"movimento\",\"coletadas\":[\"Um pote de veneno vazio.\",\"Um diário com as iniciais 'C. M.'.\"],"
+      "\"sala\":\"Jardim de Inverno\",\"movimentos\":2,\"recusados\":0,\"pistas\":3,\"encerrada\":false}\n" },
+    // O nome do acusado não diferencia maiúsculas; a resposta repete o nome pedido
+    { "a coronel mostarda",
+      "{\"evento\":\"julgamento\",\"acusado\":\"coronel mostarda\",\"contagem\":2,\"minimo\":2,\"veredito\":\"SUSTENTADA\"}\n" },
+    { "novo", ESTADO_HALL },
+    { "a Ninguem",
+      "{\"evento\":\"julgamento\",\"acusado\":\"Ninguem\",\"contagem\":0,\"minimo\":2,\"veredito\":\"FRACA\"}\n" },
+    { "f", "{\"evento\":\"fim\"}\n" },
+};
+
+// --- Main ---
+
+int main(void) {
+    Mapa mapa;
+    CHECAR(abrirMapaEmbutido(&mapa, &mansaoEmbutida) == 0);
+    Partida partida;
+    iniciarPartida(&partida, &mapa, NULL);
+
+    size_t totalPassos = sizeof(conversa) / sizeof(conversa[0]);
+    for (size_t i = 0; i < totalPassos; i++) {
+        char linha[256];
+        snprintf(linha, sizeof(linha), "%s", conversa[i].requisicao);
+        Saida resposta;
+        iniciarSaida(&resposta, -1, SAIDA_JSON);
+        Atendimento atendimento = atenderRequisicao(&partida, linha, &resposta);
+        size_t esperado = strlen(conversa[i].resposta);
+        int igual = resposta.tamanho == esperado &&
+                    (esperado == 0 || memcmp(resposta.texto, conversa[i].resposta, esperado) == 0);
+        if (!igual) {
+            fprintf(stderr, "requisição \"%s\":\n  obtido:   %.*s  esperado: %s", conversa[i].requisicao,
+                    (int)resposta.tamanho, resposta.tamanho > 0 ? resposta.texto : "", conversa[i].resposta);
+        }
+        CHECAR(igual);
+        CHECAR(atendimento == (i + 1 == totalPassos ? ATENDIMENTO_FECHAR : ATENDIMENTO_CONTINUAR));
+        liberarSaida(&resposta);
+    }
+
+    encerrarPartida(&partida);
+    fecharMapaArquivo(&mapa);
+    return testeResultado("teste_protocolo");
+}
@@ -0,0 +1,357 @@
+/**
+ * @file teste_retrato.c
+ * @brief Salva e restaura sessões pelo retrato e confere que o estado volta igual.
+ *
+ * Uma sessão joga uma sequência sorteada de movimentos e coletas; o retrato
+ * dela é restaurado em outra sessão, que precisa ter a mesma sala, as mesmas
+ * pistas, o mesmo placar, as mesmas salas coletadas e as mesmas respostas da
+ * busca. As duas continuam então com os mesmos movimentos e precisam chegar
+ * ao mesmo retrato, byte a byte, e aos mesmos vereditos. O teste roda em um
+ * mapa com as salas em um vetor de bits e em outro com mais de
+ * SESSAO_SALAS_DENSAS salas (conjunto esparso), confere que retratos de
+ * outro mapa ou corrompidos são recusados e que uma partida retomada continua
+ * a sua partida no diário.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "busca.h"
+#include "diario.h"
+#include "gerador.h"
+#include "retrato.h"
+#include "teste.h"
+
+// --- Constantes do Teste ---
+#define TESTE_ARQUIVO_DIARIO "teste_retrato.dqd"
+
+// --- Apoio ---
+
+/**
+ * @brief Joga movimentos sorteados (por tecla ou por qualquer saída), coletando a pista de cada sala.
+ */
+static void jogar(Sessao *sessao, uint64_t *estado, uint32_t jogadas) {
+    static const char teclas[] = "eedx";
+    for (uint32_t i = 0; i < jogadas; i++) {
+        uint32_t saidas = mapaTotalSaidas(sessao->mapa, sessao->salaAtual);
+        uint32_t sorteio = testeSortearAte(estado, 8);
+        Movimento movimento = sorteio < 4 || saidas == 0 ? sessaoMover(sessao, teclas[sorteio % 4])
+                                                         : sessaoSeguir(sessao, testeSortearAte(estado, saidas));
+        if (movimento == MOVIMENTO_OK) {
+            sessaoColetar(sessao);
+        }
+    }
+}
+
+static unsigned char *tirarRetrato(const Sessao *sessao, size_t *tamanho) {
+    *tamanho = salvarRetrato(sessao, NULL, 0);
+    unsigned char *dados = (unsigned char*)malloc(*tamanho);
+    if (dados == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    CHECAR_IGUAL(salvarRetrato(sessao, dados, *tamanho), *tamanho);
+    CHECAR_IGUAL(retratoTamanho(sessao), *tamanho);
+    return dados;
+}
+
+/**
+ * @brief Confere, campo a campo, que duas sessões do mesmo mapa estão no mesmo estado.
+ */
+static void compararSessoes(const Sessao *a, const Sessao *b) {
+    const Mapa *mapa = a->mapa;
+    CHECAR_IGUAL(a->salaAtual, b->salaAtual);
+    CHECAR_IGUAL(a->movimentos, b->movimentos);
+    CHECAR_IGUAL(a->encerrada, b->encerrada);
+    CHECAR_IGUAL(a->totalPistas, b->totalPistas);
+    CHECAR_IGUAL(a->totalColetadas, b->totalColetadas);
+    CHECAR_IGUAL(a->pistas.total, b->pistas.total);
+    CHECAR_IGUAL(a->hashSuspeitos.total, b->hashSuspeitos.total);
+
+    uint32_t *pistasA = (uint32_t*)malloc(((size_t)a->pistas.total + 1) * sizeof(uint32_t));
+    uint32_t *pistasB = (uint32_t*)malloc(((size_t)a->pistas.total + 1) * sizeof(uint32_t));
+    if (pistasA == NULL || pistasB == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    uint32_t totalA = listarConjuntoPistas(&a->pistas, pistasA);
+    if (totalA == listarConjuntoPistas(&b->pistas, pistasB)) {
+        CHECAR(memcmp(pistasA, pistasB, (size_t)totalA * sizeof(uint32_t)) == 0);
+    } else {
+        CHECAR(0);
+    }
+
+    // Placar e vereditos de todos os suspeitos (e de um nome desconhecido)
+    for (uint32_t suspeito = 0; suspeito < mapa->suspeitos.total; suspeito++) {
+        CHECAR_IGUAL(a->placar.contagens[suspeito], b->placar.contagens[suspeito]);
+    }
+    for (uint32_t suspeito = 0; suspeito <= mapa->suspeitos.total; suspeito++) {
+        uint32_t id = suspeito < mapa->suspeitos.total ? suspeito : TEXTO_NENHUM;
+        uint32_t contagemA;
+        uint32_t contagemB;
+        CHECAR_IGUAL(sessaoJulgar(a, id, &contagemA), sessaoJulgar(b, id, &contagemB));
+        CHECAR_IGUAL(contagemA, contagemB);
+    }
+
+    // Salas coletadas: as da lista e as vizinhas delas, que em geral não foram
+    for (uint32_t i = 0; i < a->totalColetadas; i++) {
+        uint32_t sala = a->salasColetadas[i];
+        CHECAR(sessaoPistaColetada(b, sala));
+        const SaidaSala *saidas = mapaSaidas(mapa, sala);
+        for (uint32_t s = 0; s < mapaTotalSaidas(mapa, sala); s++) {
+            CHECAR_IGUAL(sessaoPistaColetada(a, saidas[s].destino), sessaoPistaColetada(b, saidas[s].destino));
+        }
+    }
+
+    // Busca por trecho: os trigramas reindexados dão as mesmas pistas
+    if (a->buscaAtiva && b->buscaAtiva) {
+        const char *trechos[] = { "", "a", "Pista", "ista 0", "de", "xyz", "vel" };
+        for (size_t i = 0; i < sizeof(trechos) / sizeof(trechos[0]); i++) {
+            uint32_t achadasA = buscarTrecho(&a->busca, &a->pistas, &mapa->pistas, trechos[i], pistasA);
+            uint32_t achadasB = buscarTrecho(&b->busca, &b->pistas, &mapa->pistas, trechos[i], pistasB);
+            CHECAR_IGUAL(achadasA, achadasB);
+            if (achadasA == achadasB) {
+                CHECAR(memcmp(pistasA, pistasB, (size_t)achadasA * sizeof(uint32_t)) == 0);
+            }
+        }
+    }
+    free(pistasA);
+    free(pistasB);
+}
+
+// --- Casos ---
+
+/**
+ * @brief Salvar, restaurar, continuar igual; depois, recusar retratos inválidos e de outro mapa.
+ */
+static void testarIdaEVolta(const Mapa *mapa, const Mapa *outro, uint64_t semente, uint32_t jogadas) {
+    Sessao original;
+    Sessao restaurada;
+    iniciarSessao(&original, mapa);
+    iniciarSessao(&restaurada, mapa);
+    sessaoAtivarBusca(&original);
+    sessaoAtivarBusca(&restaurada);
+    uint64_t estado = semente;
+    sessaoColetar(&original);
+
+    for (uint32_t rodada = 0; rodada < 4; rodada++) {
+        jogar(&original, &estado, jogadas);
+        size_t tamanho;
+        unsigned char *retrato = tirarRetrato(&original, &tamanho);
+        CHECAR(restaurarRetrato(&restaurada, retrato, tamanho) == 0);
+        compararSessoes(&original, &restaurada);
+
+        // Os mesmos movimentos nas duas levam ao mesmo retrato
+        uint64_t estadoA = estado;
+        uint64_t estadoB = estado;
+        jogar(&original, &estadoA, jogadas);
+        jogar(&restaurada, &estadoB, jogadas);
+        compararSessoes(&original, &restaurada);
+        size_t tamanhoA;
+        size_t tamanhoB;
+        unsigned char *retratoA = tirarRetrato(&original, &tamanhoA);
+        unsigned char *retratoB = tirarRetrato(&restaurada, &tamanhoB);
+        CHECAR(tamanhoA == tamanhoB && memcmp(retratoA, retratoB, tamanhoA) == 0);
+        free(retratoA);
+        free(retratoB);
+        free(retrato);
+    }
+
+    // Uma partida encerrada volta encerrada
+    sessaoSair(&original);
+    size_t tamanho;
+    unsigned char *retrato = tirarRetrato(&original, &tamanho);
+    CHECAR(restaurarRetrato(&restaurada, retrato, tamanho) == 0);
+    compararSessoes(&original, &restaurada);
+
+    // Retratos recusados: a sessão fica reiniciada, na raiz e sem pistas
+    unsigned char *alterado = (unsigned char*)malloc(tamanho);
+    if (alterado == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    CHECAR(restaurarRetrato(&restaurada, retrato, tamanho - 1) != 0);
+    CHECAR(restaurarRetrato(&restaurada, retrato, sizeof(RetratoCabecalho) - 1) != 0);
+    memcpy(alterado, retrato, tamanho);
+    alterado[0] ^= 1; // Assinatura
+    CHECAR(restaurarRetrato(&restaurada, alterado, tamanho) != 0);
+    memcpy(alterado, retrato, tamanho);
+    alterado[offsetof(RetratoCabecalho, somaMapa)] ^= 1;
+    CHECAR(restaurarRetrato(&restaurada, alterado, tamanho) != 0);
+    memcpy(alterado, retrato, tamanho);
+    alterado[offsetof(RetratoCabecalho, totalPistas)] ^= 1;
+    CHECAR(restaurarRetrato(&restaurada, alterado, tamanho) != 0);
+    if (original.totalColetadas > 0) {
+        // Uma sala coletada trocada por uma que não está no mapa
+        memcpy(alterado, retrato, tamanho);
+        memset(alterado + sizeof(RetratoCabecalho), 0xFF, sizeof(uint32_t));
+        CHECAR(restaurarRetrato(&restaurada, alterado, tamanho) != 0);
+    }
+    if (mapa->suspeitos.total > 0) {
+        // Um ponto a mais no placar do último suspeito (a última seção) não confere com a hash
+        memcpy(alterado, retrato, tamanho);
+        alterado[tamanho - sizeof(uint32_t)] ^= 1;
+        CHECAR(restaurarRetrato(&restaurada, alterado, tamanho) != 0);
+    }
+    CHECAR_IGUAL(restaurada.salaAtual, mapa->raiz);
+    CHECAR_IGUAL(restaurada.pistas.total, 0);
+    CHECAR_IGUAL(restaurada.movimentos, 0);
+
+    // O mesmo retrato em outro mapa
+    Sessao estranha;
+    iniciarSessao(&estranha, outro);
+    CHECAR(restaurarRetrato(&estranha, retrato, tamanho) != 0);
+    encerrarSessao(&estranha);
+
+    free(alterado);
+    free(retrato);
+    encerrarSessao(&original);
+    encerrarSessao(&restaurada);
+}
+
+/**
+ * @brief Dois mapas com as mesmas contagens e um nome de sala diferente: só a soma de verificação os distingue.
+ */
+static void testarMesmasContagens(void) {
+    Mapa mapas[2];
+    const char *nomes[2] = { "Cozinha", "Copa" };
+    for (int i = 0; i < 2; i++) {
+        mapaInicializar(&mapas[i]);
+        uint32_t hall = criarSala(&mapas[i], "Hall", "Uma luva", "D. Branca");
+        uint32_t sala = criarSala(&mapas[i], nomes[i], "Um copo", "D. Branca");
+        ligarSalas(&mapas[i], hall, sala, MAPA_NENHUM);
+        ligarSalas(&mapas[i], sala, MAPA_NENHUM, MAPA_NENHUM);
+        mapaFinalizar(&mapas[i]);
+    }
+    CHECAR(mapas[0].somaVerificacao != mapas[1].somaVerificacao);
+
+    Sessao sessao;
+    iniciarSessao(&sessao, &mapas[0]);
+    sessaoColetar(&sessao);
+    CHECAR(sessaoMover(&sessao, 'e') == MOVIMENTO_OK);
+    sessaoColetar(&sessao);
+    size_t tamanho;
+    unsigned char *retrato = tirarRetrato(&sessao, &tamanho);
+    Sessao outra;
+    iniciarSessao(&outra, &mapas[1]);
+    CHECAR(restaurarRetrato(&outra, retrato, tamanho) != 0);
+    CHECAR(restaurarRetrato(&sessao, retrato, tamanho) == 0);
+    free(retrato);
+    encerrarSessao(&outra);
+    encerrarSessao(&sessao);
+    liberarMapa(&mapas[0]);
+    liberarMapa(&mapas[1]);
+}
+
+/**
+ * @brief Uma partida com diário, pausada pelo retrato e retomada em outra sessão, reproduz sem divergências.
+ */
+static void testarRetomadaNoDiario(const Mapa *mapa) {
+    unlink(TESTE_ARQUIVO_DIARIO);
+    Diario diario;
+    CHECAR(abrirDiario(&diario, mapa, TESTE_ARQUIVO_DIARIO) == 0);
+    uint64_t estado = 5;
+
+    Sessao antes;
+    iniciarSessao(&antes, mapa);
+    sessaoAtivarDiario(&antes, &diario);
+    sessaoColetar(&antes);
+    jogar(&antes, &estado, 30);
+    sessaoDescarregarDiario(&antes);
+    size_t tamanho;
+    unsigned char *retrato = tirarRetrato(&antes, &tamanho);
+    uint32_t partida = antes.diario->sessao;
+    encerrarSessao(&antes);
+
+    Sessao depois;
+    iniciarSessao(&depois, mapa);
+    sessaoAtivarDiario(&depois, &diario);
+    CHECAR(restaurarRetrato(&depois, retrato, tamanho) == 0);
+    CHECAR_IGUAL(depois.diario->sessao, partida);
+    jogar(&depois, &estado, 30);
+    sessaoAcusar(&depois, textoDoId(&mapa->suspeitos, 0), NULL);
+    encerrarSessao(&depois);
+    CHECAR(fecharDiario(&diario) == 0);
+    free(retrato);
+
+    FILE *arquivo = fopen(TESTE_ARQUIVO_DIARIO, "rb");
+    CHECAR(arquivo != NULL);
+    if (arquivo == NULL) {
+        return;
+    }
+    fseek(arquivo, 0, SEEK_END);
+    size_t tamanhoDiario = (size_t)ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+    unsigned char *dados = (unsigned char*)malloc(tamanhoDiario);
+    if (dados == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+    CHECAR(fread(dados, 1, tamanhoDiario, arquivo) == tamanhoDiario);
+    fclose(arquivo);
+    ResumoReproducao resumo;
+    CHECAR(reproduzirDiario(mapa, dados, tamanhoDiario, NULL, NULL, &resumo) == 0);
+    CHECAR_IGUAL(resumo.sessoes, 1);
+    CHECAR_IGUAL(resumo.julgadas, 1);
+    CHECAR_IGUAL(resumo.divergencias, 0);
+    free(dados);
+    unlink(TESTE_ARQUIVO_DIARIO);
+}
+
+// --- Main ---
+
+int main(void) {
+    ParametrosGerador parametros;
+    parametrosGeradorPadrao(&parametros);
+    parametros.salas = 5000;
+    parametros.pistasDistintas = 300;
+    parametros.suspeitos = 5;
+    parametros.alvosMaximos = 3;
+    parametros.semente = 3;
+    Mapa mapa;
+    Mapa outro;
+    mapaInicializar(&mapa);
+    mapaInicializar(&outro);
+    CHECAR(gerarMansao(&mapa, &parametros) == 0);
+    parametros.semente = 4;
+    CHECAR(gerarMansao(&outro, &parametros) == 0);
+    for (uint64_t semente = 1; semente <= 20; semente++) {
+        testarIdaEVolta(&mapa, &outro, semente, 8);
+    }
+    testarRetomadaNoDiario(&mapa);
+    liberarMapa(&mapa);
+    liberarMapa(&outro);
+
+    // Grafos com ciclos: as salas já coletadas são revisitadas
+    mapaInicializar(&mapa);
+    mapaInicializar(&outro);
+    testeMapaComCiclos(&mapa, 300, 300, 17);
+    testeMapaComCiclos(&outro, 300, 300, 18);
+    for (uint64_t semente = 1; semente <= 20; semente++) {
+        testarIdaEVolta(&mapa, &outro, semente, 60);
+    }
+    liberarMapa(&mapa);
+    liberarMapa(&outro);
+
+    // Mais salas que SESSAO_SALAS_DENSAS: as marcas ficam no conjunto esparso
+    parametros.salas = SESSAO_SALAS_DENSAS + 1000;
+    parametros.forma = GERADOR_DESEQUILIBRADA;
+    parametros.vies = 0.9;
+    parametros.semente = 3;
+    mapaInicializar(&mapa);
+    mapaInicializar(&outro);
+    CHECAR(gerarMansao(&mapa, &parametros) == 0);
+    parametros.semente = 4;
+    CHECAR(gerarMansao(&outro, &parametros) == 0);
+    for (uint64_t semente = 1; semente <= 5; semente++) {
+        testarIdaEVolta(&mapa, &outro, semente, 40);
+    }
+    liberarMapa(&mapa);
+    liberarMapa(&outro);
+
+    testarMesmasContagens();
+    return testeResultado("teste_retrato");
+}
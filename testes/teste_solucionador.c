@@ -0,0 +1,199 @@
+/**
+ * @file teste_solucionador.c
+ * @brief Confere resolverMapa() com a enumeração direta dos caminhos, jogada no motor.
+ *
+ * Cada caminho simples da raiz até uma saída é percorrido por uma Sessao,
+ * como um jogador faria (sessaoSeguir() e sessaoColetar() a cada sala), e os
+ * vereditos de sessaoJulgar() no fim do caminho formam o resumo esperado. O
+ * solucionador precisa chegar ao mesmo resumo com uma e com várias threads,
+ * na mansão do nível mestre, em mansões geradas e em grafos com ciclos.
+ */
+
+#include <string.h>
+
+#include "gerador.h"
+#include "mapa_arquivo.h"
+#include "motor.h"
+#include "solucionador.h"
+#include "teste.h"
+
+// --- Enumeração Direta ---
+
+typedef struct Enumeracao {
+    const Mapa *mapa;
+    Sessao sessao;
+    uint32_t *caminho;   // Posições das saídas seguidas a partir da raiz
+    uint32_t *salas;     // Salas do caminho, com a raiz
+    uint8_t *noCaminho;  // Por sala
+    uint32_t *ordem;     // classificarSuspeitos() no fim do caminho
+    ResumoSolucao esperado;
+} Enumeracao;
+
+/**
+ * @brief Joga o caminho em uma sessão nova e soma os seus vereditos ao resumo esperado.
+ */
+static void contarCaminho(Enumeracao *enumeracao, uint32_t profundidade) {
+    Sessao *sessao = &enumeracao->sessao;
+    ResumoSolucao *esperado = &enumeracao->esperado;
+    reiniciarSessao(sessao);
+    sessaoColetar(sessao);
+    for (uint32_t i = 0; i < profundidade; i++) {
+        CHECAR(sessaoSeguir(sessao, enumeracao->caminho[i]) == MOVIMENTO_OK);
+        sessaoColetar(sessao);
+    }
+    esperado->totalCaminhos++;
+    if (sessao->pistas.total == 0) {
+        esperado->caminhosSemPistas++;
+    }
+    for (uint32_t suspeito = 0; suspeito < esperado->totalSuspeitos; suspeito++) {
+        uint32_t contagem;
+        Veredito veredito = sessaoJulgar(sessao, suspeito, &contagem);
+        if (veredito == VEREDITO_SUSTENTADO) {
+            esperado->sustentados[suspeito]++;
+        } else if (veredito == VEREDITO_FRACO) {
+            esperado->fracos[suspeito]++;
+        }
+        if (contagem > esperado->maximoPistas[suspeito]) {
+            esperado->maximoPistas[suspeito] = contagem;
+        }
+    }
+
+    // A classificação: cada suspeito uma vez, da maior para a menor pontuação e, no empate, pelo id
+    uint32_t *ordem = enumeracao->ordem;
+    classificarSuspeitos(&sessao->placar, ordem);
+    int emOrdem = 1;
+    for (uint32_t i = 0; i < esperado->totalSuspeitos; i++) {
+        emOrdem &= ordem[i] < esperado->totalSuspeitos;
+        if (i > 0 && emOrdem) {
+            uint32_t anterior = placarContagem(&sessao->placar, ordem[i - 1]);
+            uint32_t atual = placarContagem(&sessao->placar, ordem[i]);
+            emOrdem &= anterior > atual || (anterior == atual && ordem[i - 1] < ordem[i]);
+        }
+    }
+    CHECAR(emOrdem);
+}
+
+/**
+ * @brief Percorre os caminhos simples a partir da última sala do caminho; um caminho termina quando nenhuma saída leva para fora dele.
+ */
+static void enumerar(Enumeracao *enumeracao, uint32_t profundidade) {
+    const Mapa *mapa = enumeracao->mapa;
+    uint32_t sala = enumeracao->salas[profundidade];
+    const SaidaSala *saidas = mapaSaidas(mapa, sala);
+    int seguiu = 0;
+    for (uint32_t i = 0; i < mapaTotalSaidas(mapa, sala); i++) {
+        uint32_t destino = saidas[i].destino;
+        if (enumeracao->noCaminho[destino]) {
+            continue;
+        }
+        seguiu = 1;
+        enumeracao->caminho[profundidade] = i;
+        enumeracao->salas[profundidade + 1] = destino;
+        enumeracao->noCaminho[destino] = 1;
+        enumerar(enumeracao, profundidade + 1);
+        enumeracao->noCaminho[destino] = 0;
+    }
+    if (!seguiu) {
+        contarCaminho(enumeracao, profundidade);
+    }
+}
+
+// --- Comparação ---
+
+static void compararResumos(const ResumoSolucao *obtido, const ResumoSolucao *esperado) {
+    CHECAR_IGUAL(obtido->totalCaminhos, esperado->totalCaminhos);
+    CHECAR_IGUAL(obtido->caminhosSemPistas, esperado->caminhosSemPistas);
+    CHECAR_IGUAL(obtido->totalSuspeitos, esperado->totalSuspeitos);
+    if (obtido->totalSuspeitos != esperado->totalSuspeitos) {
+        return;
+    }
+    for (uint32_t suspeito = 0; suspeito < esperado->totalSuspeitos; suspeito++) {
+        CHECAR_IGUAL(obtido->sustentados[suspeito], esperado->sustentados[suspeito]);
+        CHECAR_IGUAL(obtido->fracos[suspeito], esperado->fracos[suspeito]);
+        CHECAR_IGUAL(obtido->maximoPistas[suspeito], esperado->maximoPistas[suspeito]);
+    }
+}
+
+/**
+ * @brief Enumera os caminhos do mapa e confere o solucionador com 1 e com 4 threads.
+ * @return O total de caminhos enumerados.
+ */
+static uint64_t conferirMapa(const Mapa *mapa) {
+    Enumeracao enumeracao;
+    enumeracao.mapa = mapa;
+    iniciarSessao(&enumeracao.sessao, mapa);
+    enumeracao.caminho = (uint32_t*)calloc(mapa->totalSalas, sizeof(uint32_t));
+    enumeracao.salas = (uint32_t*)calloc((size_t)mapa->totalSalas + 1, sizeof(uint32_t));
+    enumeracao.noCaminho = (uint8_t*)calloc(mapa->totalSalas, sizeof(uint8_t));
+    enumeracao.ordem = (uint32_t*)calloc((size_t)mapa->suspeitos.total + 1, sizeof(uint32_t));
+    ResumoSolucao *esperado = &enumeracao.esperado;
+    memset(esperado, 0, sizeof(ResumoSolucao));
+    esperado->totalSuspeitos = mapa->suspeitos.total;
+    esperado->sustentados = (uint64_t*)calloc((size_t)esperado->totalSuspeitos + 1, sizeof(uint64_t));
+    esperado->fracos = (uint64_t*)calloc((size_t)esperado->totalSuspeitos + 1, sizeof(uint64_t));
+    esperado->maximoPistas = (uint32_t*)calloc((size_t)esperado->totalSuspeitos + 1, sizeof(uint32_t));
+    if (enumeracao.caminho == NULL || enumeracao.salas == NULL || enumeracao.noCaminho == NULL || enumeracao.ordem == NULL ||
+        esperado->sustentados == NULL || esperado->fracos == NULL || esperado->maximoPistas == NULL) {
+        printf("Erro de alocação de memória para o teste!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    enumeracao.salas[0] = mapa->raiz;
+    enumeracao.noCaminho[mapa->raiz] = 1;
+    enumerar(&enumeracao, 0);
+
+    unsigned threads[] = { 1, 4 };
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        ResumoSolucao obtido;
+        CHECAR(resolverMapa(mapa, threads[i], &obtido) == 0);
+        compararResumos(&obtido, esperado);
+        liberarResumoSolucao(&obtido);
+    }
+
+    uint64_t total = esperado->totalCaminhos;
+    liberarResumoSolucao(esperado);
+    free(enumeracao.caminho);
+    free(enumeracao.salas);
+    free(enumeracao.noCaminho);
+    free(enumeracao.ordem);
+    encerrarSessao(&enumeracao.sessao);
+    return total;
+}
+
+// --- Main ---
+
+int main(void) {
+    // A mansão do nível mestre: uma árvore de 7 salas, 4 caminhos
+    Mapa mansao;
+    CHECAR(abrirMapaEmbutido(&mansao, &mansaoEmbutida) == 0);
+    CHECAR_IGUAL(conferirMapa(&mansao), 4);
+    fecharMapaArquivo(&mansao);
+
+    // Mansões geradas, com pistas repetidas entre salas (a última sala vista decide os suspeitos)
+    FormaMansao formas[] = { GERADOR_EQUILIBRADA, GERADOR_DESEQUILIBRADA, GERADOR_CORRENTE };
+    for (size_t i = 0; i < sizeof(formas) / sizeof(formas[0]); i++) {
+        ParametrosGerador parametros;
+        parametrosGeradorPadrao(&parametros);
+        parametros.salas = 500;
+        parametros.forma = formas[i];
+        parametros.pistasDistintas = 40;
+        parametros.suspeitos = 3;
+        parametros.alvosMaximos = 2;
+        parametros.semente = 1000 + i;
+        Mapa mapa;
+        mapaInicializar(&mapa);
+        CHECAR(gerarMansao(&mapa, &parametros) == 0);
+        CHECAR(conferirMapa(&mapa) > 0);
+        liberarMapa(&mapa);
+    }
+
+    // Grafos com ciclos: poucas salas, porque os caminhos simples crescem depressa
+    for (uint64_t semente = 1; semente <= 20; semente++) {
+        Mapa mapa;
+        mapaInicializar(&mapa);
+        testeMapaComCiclos(&mapa, 16, 14, semente);
+        CHECAR(conferirMapa(&mapa) > 0);
+        liberarMapa(&mapa);
+    }
+    return testeResultado("teste_solucionador");
+}